@@ -2115,7 +2115,9 @@ void Parser::ParseLV4MeshFloatTriple(float* apOut)
 {
 	ai_assert(NULL != apOut);
 
-	for (unsigned int i = 0; i < 3;++i)
+	// usually all three are on this line, the rest is parsed one by one
+	// to get the warnings right
+	for (unsigned int i = fast_atoreal_span<float>(filePtr,apOut,3,false); i < 3;++i)
 		ParseLV4MeshFloat(apOut[i]);
 }
 // ------------------------------------------------------------------------------------------------
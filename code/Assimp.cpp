@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "GenericProperty.h"
 #include "CInterfaceIOWrapper.h"
 #include "Importer.h"
+#include "ThreadPool.h"
 
 // ------------------------------------------------------------------------------------------------
 #ifdef AI_C_THREADSAFE
@@ -197,6 +198,119 @@ const aiScene* aiImportFileExWithProperties( const char* pFile, unsigned int pFl
 	return scene;
 }
 
+namespace {
+
+	// ------------------------------------------------------------------------------------------------
+	// Reads a single file of an aiImportFilesExWithProperties() batch
+	class ImportFilesTask : public ParallelTask
+	{
+	public:
+
+		ImportFilesTask(const char* const* files, unsigned int flags, aiFileIO* fs, 
+			const PropertyMap* props, unsigned int numThreadsPerFile, 
+			const aiScene** scenes, std::string* errors)
+			: files		(files)
+			, flags		(flags)
+			, fs		(fs)
+			, props		(props)
+			, numThreadsPerFile (numThreadsPerFile)
+			, scenes	(scenes)
+			, errors	(errors)
+		{}
+
+		void Run(unsigned int index)	{
+			std::auto_ptr<Assimp::Importer> imp(new Assimp::Importer());
+
+			// copy properties
+			if(props) {
+				ImporterPimpl* pimpl = imp->Pimpl();
+				pimpl->mIntProperties = props->ints;
+				pimpl->mFloatProperties = props->floats;
+				pimpl->mStringProperties = props->strings;
+			}
+			imp->SetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING,numThreadsPerFile);
+
+			// setup a custom IO system if necessary
+			if (fs)	{
+				imp->SetIOHandler( new CIOSystemWrapper (fs) );
+			}
+
+			const aiScene* scene = imp->ReadFile( files[index], flags);
+
+			// if succeeded, store the importer in the scene and keep it alive
+			if( scene)	{
+				ScenePrivateData* priv = const_cast<ScenePrivateData*>( ScenePriv(scene) );
+				priv->mOrigImporter = imp.release();
+				scenes[index] = scene;
+			} 
+			else	{
+				errors[index] = imp->GetErrorString();
+			}
+		}
+
+	private:
+
+		const char* const* files;
+		unsigned int flags;
+		aiFileIO* fs;
+		const PropertyMap* props;
+		unsigned int numThreadsPerFile;
+		const aiScene** scenes;
+		std::string* errors;
+	};
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int aiImportFilesExWithProperties( const char* const* pFiles, 
+	unsigned int pNumFiles,
+	unsigned int pFlags, 
+	aiFileIO* pFS,
+	const aiPropertyStore* props,
+	const aiScene** pScenesOut,
+	aiString* pErrorsOut)
+{
+	ai_assert(NULL != pFiles && NULL != pScenesOut);
+
+	unsigned int numSucceeded = 0;
+	ASSIMP_BEGIN_EXCEPTION_REGION();
+	if (!pNumFiles) {
+		return 0;
+	}
+	// so the caller may release all entries even if we fail halfway
+	std::fill(pScenesOut,pScenesOut+pNumFiles,static_cast<const aiScene*>(NULL));
+
+	const PropertyMap* pp = reinterpret_cast<const PropertyMap*>(props);
+
+	// Import as many files in parallel as we may use threads, the threads 
+	// which remain are left to the post-processing steps of each import.
+	const unsigned int numThreads = ThreadPool::GetThreadCountForConfig(
+		pp ? GetGenericProperty<int>(pp->ints,AI_CONFIG_GLOB_MULTITHREADING,AI_MULTITHREADING_DEFAULT) : AI_MULTITHREADING_DEFAULT);
+	const unsigned int numWorkers = std::min(numThreads,pNumFiles);
+
+	std::vector<std::string> errors(pNumFiles);
+	ThreadPool pool(numWorkers);
+	ImportFilesTask task(pFiles,pFlags,pFS,pp,std::max(1u,numThreads/numWorkers),pScenesOut,&errors[0]);
+
+	pool.ParallelFor(task,pNumFiles);
+
+	bool haveError = false;
+	for (unsigned int i = 0; i < pNumFiles; ++i) {
+		if (pScenesOut[i]) {
+			++numSucceeded;
+		}
+		else if (!haveError) {
+			gLastErrorString = errors[i];
+			haveError = true;
+		}
+		if (pErrorsOut) {
+			pErrorsOut[i].Set(errors[i]);
+		}
+	}
+
+	ASSIMP_END_EXCEPTION_REGION(unsigned int);
+	return numSucceeded;
+}
+
 // ------------------------------------------------------------------------------------------------
 const aiScene* aiImportFileFromMemory( 
 	const char* pBuffer,
@@ -292,10 +406,13 @@ ASSIMP_API const aiScene* aiApplyPostProcessing(const aiScene* pScene,
 		return NULL;
 	}
 
-	sc = priv->mOrigImporter->ApplyPostProcessing(pFlags);
+	// a failed step deletes the scene along with its private data
+	Importer* importer = priv->mOrigImporter;
+	sc = importer->ApplyPostProcessing(pFlags);
 
 	if (!sc) {
-		aiReleaseImport(pScene);
+		gLastErrorString = importer->GetErrorString();
+		delete importer;
 		return NULL;
 	}
 
@@ -457,6 +574,40 @@ void aiGetMemoryRequirements(const C_STRUCT aiScene* pIn,
 	ASSIMP_END_EXCEPTION_REGION(void);
 }
 
+// ------------------------------------------------------------------------------------------------
+// Get the timings recorded for a particular import.
+const aiProfilingRegion* aiGetProfilingReport(const aiScene* pIn)
+{
+	ASSIMP_BEGIN_EXCEPTION_REGION();
+
+	// find the importer associated with this data
+	const ScenePrivateData* priv = ScenePriv(pIn);
+	if( !priv || !priv->mOrigImporter)	{
+		ReportSceneNotFoundError();
+		return NULL;
+	}
+
+	return priv->mOrigImporter->GetProfilingReport();
+	ASSIMP_END_EXCEPTION_REGION(const aiProfilingRegion*);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get the timings recorded for a particular import as JSON.
+const char* aiGetProfilingReportAsJSON(const aiScene* pIn)
+{
+	ASSIMP_BEGIN_EXCEPTION_REGION();
+
+	// find the importer associated with this data
+	const ScenePrivateData* priv = ScenePriv(pIn);
+	if( !priv || !priv->mOrigImporter)	{
+		ReportSceneNotFoundError();
+		return NULL;
+	}
+
+	return priv->mOrigImporter->GetProfilingReportAsJSON();
+	ASSIMP_END_EXCEPTION_REGION(const char*);
+}
+
 // ------------------------------------------------------------------------------------------------
 ASSIMP_API aiPropertyStore* aiCreatePropertyStore(void)
 {
@@ -25,7 +25,7 @@ ASSIMP_API const char*  aiGetLegalString  ()	{
 // ------------------------------------------------------------------------------------------------
 // Get Assimp minor version
 ASSIMP_API unsigned int aiGetVersionMinor ()	{
-	return 0;
+	return 1;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -70,7 +70,7 @@ BaseImporter::~BaseImporter()
 // Imports the given file and returns the imported data.
 aiScene* BaseImporter::ReadFile(const Importer* pImp, const std::string& pFile, IOSystem* pIOHandler)
 {
-	progress = pImp->GetProgressHandler();
+	progress = pImp->Pimpl()->mImportProgress;
 	ai_assert(progress);
 
 	// Gather configuration properties for this run
@@ -368,9 +368,17 @@ void BaseImporter::TextFileToBuffer(IOStream* stream,
 	}
 
 	data.reserve(fileSize+1); 
-	data.resize(fileSize); 
-	if(fileSize != stream->Read( &data[0], 1, fileSize)) {
-		throw DeadlyImportError("File read error");
+
+	// loaders parse the buffer in place, but at least the stream needn't copy it once more
+	const char* view = static_cast<const char*>(stream->GetView());
+	if (view) {
+		data.assign(view,view+fileSize);
+	}
+	else {
+		data.resize(fileSize); 
+		if(fileSize != stream->Read( &data[0], 1, fileSize)) {
+			throw DeadlyImportError("File read error");
+		}
 	}
 
 	ConvertToUTF8(data);
@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <map>
 #include <vector>
 #include "./../include/assimp/types.h"
+#include "ImportProgressHandler.h"
 
 struct aiScene;
 
@@ -109,6 +110,8 @@ private:
 class BaseImporter
 {
 	friend class Importer;
+	friend class ImporterPimpl;
+	friend class ImporterRegistry;
 
 public:
 
@@ -344,8 +347,9 @@ protected:
 	/** Error description in case there was one. */
 	std::string mErrorText;
 
-	/** Currently set progress handler */
-	ProgressHandler* progress;
+	/** Progress handler of the current import. Wraps the handler set
+	 *  by the user, long loops should #ImportProgressHandler::Poll() it. */
+	ImportProgressHandler* progress;
 };
 
 
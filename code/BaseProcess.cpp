@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AssimpPCH.h"
 #include "BaseImporter.h"
 #include "BaseProcess.h"
+#include "ThreadPool.h"
 
 #include "Importer.h"
 
@@ -54,6 +55,7 @@ using namespace Assimp;
 BaseProcess::BaseProcess()
 : shared()
 , progress()
+, threads()
 {
 }
 
@@ -69,9 +71,11 @@ void BaseProcess::ExecuteOnScene( Importer* pImp)
 {
 	ai_assert(NULL != pImp && NULL != pImp->Pimpl()->mScene);
 
-	progress = pImp->GetProgressHandler();
+	progress = pImp->Pimpl()->mImportProgress;
 	ai_assert(progress);
 
+	threads = pImp->Pimpl()->mThreadPool;
+
 	SetupProperties( pImp );
 
 	// catch exceptions thrown inside the PostProcess-Step
@@ -103,3 +107,20 @@ bool BaseProcess::RequireVerboseFormat() const
 	return true;
 }
 
+// ------------------------------------------------------------------------------------------------
+bool BaseProcess::MaintainsMeshData() const
+{
+	return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+void BaseProcess::ParallelFor(ParallelTask& task, unsigned int count)
+{
+	if (threads) {
+		threads->ParallelFor(task,count);
+		return;
+	}
+	for (unsigned int i = 0; i < count; ++i) {
+		task.Run(i);
+	}
+}
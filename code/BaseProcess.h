@@ -46,19 +46,24 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "../include/assimp/types.h"
 #include "GenericProperty.h"
+#include "ImportProgressHandler.h"
+#include "MeshDataCache.h"
 
 struct aiScene;
 
 namespace Assimp	{
 
 class Importer;
+class ThreadPool;
+class ParallelTask;
 
 // ---------------------------------------------------------------------------
 /** Helper class to allow post-processing steps to interact with each other.
  *
  *  The class maintains a simple property list that can be used by pp-steps
  *  to provide additional information to other steps. This is primarily
- *  intended for cross-step optimizations.
+ *  intended for cross-step optimizations. Data derived from single meshes
+ *  goes to the #MeshDataCache instead, which knows when it becomes stale.
  */
 class SharedPostProcessInfo
 {
@@ -121,6 +126,12 @@ public:
 			delete (*it).second;
 		}
 		pmap.clear();
+		meshData.Clear();
+	}
+
+	//! Get the cache for per-mesh derived data
+	MeshDataCache& GetMeshData()	{
+		return meshData;
 	}
 
 	//! Add a heap property to the list
@@ -179,6 +190,9 @@ private:
 
 	//! Map of all stored properties
 	PropertyMap pmap;
+
+	//! Data derived from the meshes of the scene
+	MeshDataCache meshData;
 };
 
 #if 0
@@ -199,8 +213,6 @@ private:
 #endif
 
 
-#define AI_SPP_SPATIAL_SORT "$Spat"
-
 // ---------------------------------------------------------------------------
 /** The BaseProcess defines a common interface for all post processing steps.
  * A post processing step is run after a successful import if the caller
@@ -239,6 +251,13 @@ public:
 	 *  in verbose format. */
 	virtual bool RequireVerboseFormat() const;
 
+	// -------------------------------------------------------------------
+	/** Check whether the step invalidates the entries of the 
+	 *  #MeshDataCache which its changes to the meshes make stale. If
+	 *  not, the Importer drops the whole cache after the step ran.
+	 *  The default implementation returns false. */
+	virtual bool MaintainsMeshData() const;
+
 	// -------------------------------------------------------------------
 	/** Executes the post processing step on the given imported data.
 	* The function deletes the scene if the postprocess step fails (
@@ -279,13 +298,29 @@ public:
 		return shared;
 	}
 
+protected:
+
+	// -------------------------------------------------------------------
+	/** Run a task for all indices in [0,count), for example once per
+	 *  mesh. The work is distributed over the thread pool of the
+	 *  Importer executing the step, if there is one, and done in the 
+	 *  calling thread otherwise.
+	 * @param task Task to execute, must be thread-safe
+	 * @param count Number of work items
+	*/
+	void ParallelFor(ParallelTask& task, unsigned int count);
+
 protected:
 
 	/** See the doc of #SharedPostProcessInfo for more details */
 	SharedPostProcessInfo* shared;
 
-	/** Currently active progress handler */
-	ProgressHandler* progress;
+	/** Progress handler of the current import, see BaseImporter::progress.
+	 *  Use ImportProgressHandler::CheckDeadline() from within tasks. */
+	ImportProgressHandler* progress;
+
+	/** Thread pool of the Importer executing the step, may be NULL */
+	ThreadPool* threads;
 };
 
 
@@ -52,15 +52,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "BlenderModifier.h"
 
 #include "StreamReader.h"
-#include "MemoryIOWrapper.h"
 
 // zlib is needed for compressed blend files 
 #ifndef ASSIMP_BUILD_NO_COMPRESSED_BLEND
-#	ifdef ASSIMP_BUILD_NO_OWN_ZLIB
-#		include <zlib.h>
-#	else
-#		include "../contrib/zlib/zlib.h"
-#	endif
+#	include "GzipIOWrapper.h"
 #endif
 
 namespace Assimp {
@@ -135,32 +130,22 @@ void BlenderImporter::SetupProperties(const Importer* /*pImp*/)
 	// nothing to be done for the moment
 }
 
-struct free_it
-{
-	free_it(void* free) : free(free) {}
-	~free_it() {
-		::free(this->free);
-	}
-
-	void* free;
-};
-
 // ------------------------------------------------------------------------------------------------
 // Imports the given file into the given scene structure. 
 void BlenderImporter::InternReadFile( const std::string& pFile, 
 	aiScene* pScene, IOSystem* pIOHandler)
 {
-#ifndef ASSIMP_BUILD_NO_COMPRESSED_BLEND
-	Bytef* dest = NULL;
-	free_it free_it_really(dest);
-#endif
-
 	FileDatabase file; 
 	boost::shared_ptr<IOStream> stream(pIOHandler->Open(pFile,"rb"));
 	if (!stream) {
 		ThrowException("Could not open file for reading");
 	}
 
+#ifndef ASSIMP_BUILD_NO_COMPRESSED_BLEND
+	// the file may have been decompressed by the Importer already
+	GzipIOStream* gzip = dynamic_cast<GzipIOStream*>(stream.get());
+#endif
+
 	char magic[8] = {0};
 	stream->Read(magic,7,1);
 	if (strcmp(magic,"BLENDER")) {
@@ -180,52 +165,15 @@ void BlenderImporter::InternReadFile( const std::string& pFile,
 			ThrowException("Unsupported GZIP compression method");
 		}
 
-		// http://www.gzip.org/zlib/rfc-gzip.html#header-trailer
+		// replace the input stream with one which decompresses it as it is read
 		stream->Seek(0L,aiOrigin_SET);
-		boost::shared_ptr<StreamReaderLE> reader = boost::shared_ptr<StreamReaderLE>(new StreamReaderLE(stream));
-
-		// build a zlib stream
-		z_stream zstream;
-		zstream.opaque = Z_NULL;
-		zstream.zalloc = Z_NULL;
-		zstream.zfree  = Z_NULL;
-		zstream.data_type = Z_BINARY;
-
-		// http://hewgill.com/journal/entries/349-how-to-decompress-gzip-stream-with-zlib
-		inflateInit2(&zstream, 16+MAX_WBITS);
-
-		zstream.next_in   = reinterpret_cast<Bytef*>( reader->GetPtr() );
-		zstream.avail_in  = reader->GetRemainingSize();
-
-		size_t total = 0l;
-
-		// and decompress the data .... do 1k chunks in the hope that we won't kill the stack
-#define MYBLOCK 1024
-		Bytef block[MYBLOCK];
-		int ret;
-		do {
-			zstream.avail_out = MYBLOCK;
-			zstream.next_out = block;
-			ret = inflate(&zstream, Z_NO_FLUSH);
-
-			if (ret != Z_STREAM_END && ret != Z_OK) {
-				ThrowException("Failure decompressing this file using gzip, seemingly it is NOT a compressed .BLEND file");
-			}
-			const size_t have = MYBLOCK - zstream.avail_out;
-			total += have;
-			dest = reinterpret_cast<Bytef*>( realloc(dest,total) );
-			memcpy(dest + total - have,block,have);
-		} 
-		while (ret != Z_STREAM_END);
-
-		// terminate zlib
-		inflateEnd(&zstream);
-
-		// replace the input stream with a memory stream
-		stream.reset(new MemoryIOStream(reinterpret_cast<uint8_t*>(dest),total)); 
+		stream.reset(gzip = new GzipIOStream(stream));
 
 		// .. and retry
 		stream->Read(magic,7,1);
+		if (gzip->Failed()) {
+			ThrowException("Failure decompressing this file using gzip, seemingly it is NOT a compressed .BLEND file");
+		}
 		if (strcmp(magic,"BLENDER")) {
 			ThrowException("Found no BLENDER magic word in decompressed GZIP file");
 		}
@@ -243,7 +191,19 @@ void BlenderImporter::InternReadFile( const std::string& pFile,
 		", little endian: ",file.little?"true":"false",")"
 	));
 
-	ParseBlendFile(file,stream);
+	try {
+		ParseBlendFile(file,stream);
+	}
+	catch (const DeadlyImportError&) {
+#ifndef ASSIMP_BUILD_NO_COMPRESSED_BLEND
+		// corrupt data just ends the decompressed stream early, which 
+		// would otherwise be reported as some unrelated parsing error
+		if (gzip && gzip->Failed()) {
+			ThrowException("Failure decompressing this file using gzip, seemingly it is NOT a compressed .BLEND file");
+		}
+#endif
+		throw;
+	}
 
 	Scene scene;
 	ExtractScene(scene,file);
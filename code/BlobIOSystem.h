@@ -158,6 +158,12 @@ public:
 		// ignore
 	}
 
+	// -------------------------------------------------------------------
+	virtual const void* GetView() const
+	{
+		return buffer;
+	}
+
 
 
 private:
@@ -86,14 +86,29 @@ void CalcTangentsProcess::SetupProperties(const Importer* pImp)
 }
 
 // ------------------------------------------------------------------------------------------------
-// Executes the post processing step on the given imported data.
-void CalcTangentsProcess::Execute( aiScene* pScene)
+// Prepares the post processing step for the given imported data.
+void CalcTangentsProcess::BeginMeshes( aiScene* pScene)
 {
 	DefaultLogger::get()->debug("CalcTangentsProcess begin");
 
+	results.reset(new bool[pScene->mNumMeshes]);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Executes the post processing step on a single mesh.
+void CalcTangentsProcess::ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex, MeshPipelineContext& context)
+{
+	results[meshIndex] = ProcessMesh(pMesh,context);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Finishes the post processing step.
+void CalcTangentsProcess::EndMeshes( aiScene* pScene)
+{
 	bool bHas = false;
 	for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
-		if(ProcessMesh( pScene->mMeshes[a],a))bHas = true;
+		if(results[a])bHas = true;
+	results.reset();
 
 	if (bHas)DefaultLogger::get()->info("CalcTangentsProcess finished. Tangents have been calculated");
 	else DefaultLogger::get()->debug("CalcTangentsProcess finished");
@@ -101,7 +116,7 @@ void CalcTangentsProcess::Execute( aiScene* pScene)
 
 // ------------------------------------------------------------------------------------------------
 // Calculates tangents and bitangents for the given mesh
-bool CalcTangentsProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
+bool CalcTangentsProcess::ProcessMesh( aiMesh* pMesh, MeshPipelineContext& context)
 {
 	// we assume that the mesh is still in the verbose vertex format where each face has its own set
 	// of vertices and no vertices are shared between faces. Sadly I don't know any quick test to 
@@ -207,28 +222,10 @@ bool CalcTangentsProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
     }
 
 
-	// create a helper to quickly find locally close vertices among the vertex array
-	// FIX: check whether we can reuse the SpatialSort of a previous step
-	SpatialSort* vertexFinder = NULL;
-	SpatialSort  _vertexFinder;
-	float posEpsilon;
-	if (shared)
-	{
-		std::vector<std::pair<SpatialSort,float> >* avf;
-		shared->GetProperty(AI_SPP_SPATIAL_SORT,avf);
-		if (avf)
-		{
-			std::pair<SpatialSort,float>& blubb = avf->operator [] (meshIndex);
-			vertexFinder = &blubb.first;
-			posEpsilon = blubb.second;;
-		}
-	}
-	if (!vertexFinder)
-	{
-		_vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof( aiVector3D));
-		vertexFinder = &_vertexFinder;
-		posEpsilon = ComputePositionEpsilon(pMesh);
-	}
+	// get a helper to quickly find locally close vertices among the vertex array,
+	// the context reuses the one of a previous step if possible
+	SpatialSort* const vertexFinder = &context.GetSpatialSort();
+	const float posEpsilon = context.GetPositionEpsilon();
 	std::vector<unsigned int> verticesFound;
 
 	const float fLimit = cosf(configMaxAngle); 
@@ -288,5 +285,7 @@ bool CalcTangentsProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
 			meshBitang[ closeVertices[b] ] = smoothBitangent;
 		}
 	}
+
+	context.Invalidate(MeshDataCache::VertexData);
 	return true;
 }
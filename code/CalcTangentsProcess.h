@@ -44,7 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_CALCTANGENTSPROCESS_H_INC
 #define AI_CALCTANGENTSPROCESS_H_INC
 
-#include "BaseProcess.h"
+#include "PerMeshProcess.h"
 
 struct aiMesh;
 
@@ -57,7 +57,7 @@ namespace Assimp
  * because the joining of vertices also considers tangents and bitangents for 
  * uniqueness.
  */
-class ASSIMP_API_WINONLY CalcTangentsProcess : public BaseProcess
+class ASSIMP_API_WINONLY CalcTangentsProcess : public PerMeshProcess
 {
 public:
 
@@ -93,21 +93,27 @@ protected:
 	// -------------------------------------------------------------------
 	/** Calculates tangents and bitangents for a specific mesh.
 	* @param pMesh The mesh to process.
-	* @param meshIndex Index of the mesh
+	* @param context Provides the SpatialSort of the mesh
 	*/
-	bool ProcessMesh( aiMesh* pMesh, unsigned int meshIndex);
+	bool ProcessMesh( aiMesh* pMesh, MeshPipelineContext& context);
+
+public:
 
 	// -------------------------------------------------------------------
-	/** Executes the post processing step on the given imported data.
-	* @param pScene The imported data to work at.
+	/** Parts of the post processing step, see PerMeshProcess.
 	*/
-	void Execute( aiScene* pScene);
+	void BeginMeshes( aiScene* pScene);
+	void ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex, MeshPipelineContext& context);
+	void EndMeshes( aiScene* pScene);
 
 private:
 
 	/** Configuration option: maximum smoothing angle, in radians*/
 	float configMaxAngle;
 	unsigned int configSourceUV;
+
+	/** Return value of ProcessMesh() for each mesh */
+	boost::scoped_array<bool> results;
 };
 
 } // end of namespace Assimp
@@ -53,14 +53,13 @@ namespace Assimp
 // Worker function for exporting a scene to Collada. Prototyped and registered in Exporter.cpp
 void ExportSceneCollada(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene)
 {
-	// invoke the exporter 
-	ColladaExporter iDoTheExportThing( pScene);
-
-	// we're still here - export successfully completed. Write result to the given IOSYstem
 	boost::scoped_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
+	if(!outfile) {
+		throw DeadlyExportError("could not open output .dae file: " + std::string(pFile));
+	}
 
-	// XXX maybe use a small wrapper around IOStream that behaves like std::stringstream in order to avoid the extra copy.
-	outfile->Write( iDoTheExportThing.mOutput.str().c_str(), static_cast<size_t>(iDoTheExportThing.mOutput.tellp()),1);
+	// invoke the exporter, it writes straight to the given IOSystem
+	ColladaExporter iDoTheExportThing( pScene, outfile.get());
 }
 
 } // end of namespace Assimp
@@ -68,11 +67,9 @@ void ExportSceneCollada(const char* pFile,IOSystem* pIOSystem, const aiScene* pS
 
 // ------------------------------------------------------------------------------------------------
 // Constructor for a specific scene to export
-ColladaExporter::ColladaExporter( const aiScene* pScene)
+ColladaExporter::ColladaExporter( const aiScene* pScene, IOStream* pOutfile)
+: mOutput( pOutfile)
 {
-	// make sure that all formatting happens using the standard, C locale and not the user's current locale
-	mOutput.imbue( std::locale("C") );
-
 	mScene = pScene;
 
 	// set up strings
@@ -80,6 +77,7 @@ ColladaExporter::ColladaExporter( const aiScene* pScene)
 
 	// start writing
 	WriteFile();
+	mOutput.Flush();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -162,7 +160,14 @@ void ColladaExporter::WriteImageEntry( const Surface& pSurface, const std::strin
       if( isalnum( *it) || *it == '_' || *it == '.' || *it == '/' || *it == '\\' )
         mOutput << *it;
       else
-        mOutput << '%' << std::hex << size_t( (unsigned char) *it) << std::dec;
+      {
+        static const char hex[] = "0123456789abcdef";
+        const unsigned char c = (unsigned char) *it;
+        mOutput << '%';
+        if( c >= 16 )
+          mOutput << hex[c >> 4];
+        mOutput << hex[c & 0xf];
+      }
     }
     mOutput << "</init_from>" << endstr;
     PopTag();
@@ -45,7 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_COLLADAEXPORTER_H_INC
 
 #include "../include/assimp/assert.h"
-#include <sstream>
+#include "TextWriter.h"
 
 struct aiScene;
 struct aiNode;
@@ -59,7 +59,7 @@ class ColladaExporter
 {
 public:
 	/// Constructor for a specific scene to export
-	ColladaExporter( const aiScene* pScene);
+	ColladaExporter( const aiScene* pScene, IOStream* pOutfile);
 
 protected:
 	/// Starts writing the contents
@@ -96,11 +96,10 @@ protected:
 	/// Creates a mesh ID for the given mesh
 	std::string GetMeshId( size_t pIndex) const { return std::string( "meshId" ) + boost::lexical_cast<std::string> (pIndex); }
 
-public:
-	/// Stringstream to write all output into
-	std::stringstream mOutput;
-
 protected:
+	/// Buffered writer to send all output through
+	TextWriter mOutput;
+
 	/// The scene to be written
 	const aiScene* mScene;
 
@@ -59,6 +59,7 @@ using namespace Assimp;
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 ColladaLoader::ColladaLoader()
+	: mSkipLibraries( 0)
 {}
 
 // ------------------------------------------------------------------------------------------------
@@ -96,6 +97,13 @@ void ColladaLoader::GetExtensionList( std::set<std::string>& extensions )
 	extensions.insert("dae");
 }
 
+// ------------------------------------------------------------------------------------------------
+// Setup configuration properties for the loader
+void ColladaLoader::SetupProperties(const Importer* pImp)
+{
+	mSkipLibraries = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_COLLADA_SKIP_LIBRARIES,0);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Imports the given file into the given scene structure. 
 void ColladaLoader::InternReadFile( const std::string& pFile, aiScene* pScene, IOSystem* pIOHandler)
@@ -112,7 +120,7 @@ void ColladaLoader::InternReadFile( const std::string& pFile, aiScene* pScene, I
 	mTextures.clear();
 
 	// parse the input file
-	ColladaParser parser( pIOHandler, pFile);
+	ColladaParser parser( pIOHandler, pFile, progress, mSkipLibraries);
 
 	if( !parser.mRootNode)
 		throw DeadlyImportError( "Collada: File came out empty. Something is wrong here.");
@@ -159,8 +167,9 @@ void ColladaLoader::InternReadFile( const std::string& pFile, aiScene* pScene, I
 	// store all cameras
 	StoreSceneCameras( pScene);
 
-	// store all animations
-	StoreAnimations( pScene, parser);
+	// store all animations, if they have been read at all
+	if( !(mSkipLibraries & aiComponent_ANIMATIONS))
+		StoreAnimations( pScene, parser);
 
 
 	// If no meshes have been loaded, it's probably just an animated skeleton.
@@ -266,6 +275,10 @@ void ColladaLoader::ApplyVertexToEffectSemanticMapping(Collada::Sampler& sampler
 // Builds lights for the given node and references them
 void ColladaLoader::BuildLightsForNode( const ColladaParser& pParser, const Collada::Node* pNode, aiNode* pTarget)
 {
+	// don't complain about every instance if the library has been skipped
+	if( mSkipLibraries & aiComponent_LIGHTS)
+		return;
+
 	BOOST_FOREACH( const Collada::LightInstance& lid, pNode->mLights)
 	{
 		// find the referred light
@@ -330,6 +343,10 @@ void ColladaLoader::BuildLightsForNode( const ColladaParser& pParser, const Coll
 // Builds cameras for the given node and references them
 void ColladaLoader::BuildCamerasForNode( const ColladaParser& pParser, const Collada::Node* pNode, aiNode* pTarget)
 {
+	// don't complain about every instance if the library has been skipped
+	if( mSkipLibraries & aiComponent_CAMERAS)
+		return;
+
 	BOOST_FOREACH( const Collada::CameraInstance& cid, pNode->mCameras)
 	{
 		// find the referred light
@@ -409,6 +426,10 @@ void ColladaLoader::BuildMeshesForNode( const ColladaParser& pParser, const Coll
 				srcMeshIt = pParser.mMeshLibrary.find( srcController->mMeshId);
 				if( srcMeshIt != pParser.mMeshLibrary.end())
 					srcMesh = srcMeshIt->second;
+
+				// the skin has been skipped, the mesh is used unskinned then
+				if( mSkipLibraries & aiComponent_BONEWEIGHTS)
+					srcController = NULL;
 			}
 
 			if( !srcMesh)
@@ -1125,6 +1146,10 @@ void ColladaLoader::AddTexture ( aiMaterial& mat, const ColladaParser& pParser,
 	const Collada::Sampler& sampler,
 	aiTextureType type, unsigned int idx)
 {
+	// without the image library, there's nothing to refer to
+	if( mSkipLibraries & aiComponent_TEXTURES)
+		return;
+
 	// first of all, basic file name
 	const aiString name = FindFilenameForEffectTexture( pParser, effect, sampler.mName );
 	mat.AddProperty( &name, _AI_MATKEY_TEXTURE_BASE, type, idx );
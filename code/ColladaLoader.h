@@ -94,6 +94,12 @@ protected:
 	 */
 	void GetExtensionList( std::set<std::string>& extensions);
 
+	/** Called prior to ReadFile().
+	 * The function is a request to the importer to update its configuration
+	 * basing on the Importer's configuration property list.
+	 */
+	void SetupProperties(const Importer* pImp);
+
 	/** Imports the given file into the given scene structure. 
 	 * See BaseImporter::InternReadFile() for details
 	 */
@@ -230,6 +236,9 @@ protected:
 
 	/** Accumulated animations for the target scene */
 	std::vector<aiAnimation*> mAnims;
+
+	/** Libraries to skip, see #AI_CONFIG_IMPORT_COLLADA_SKIP_LIBRARIES */
+	unsigned int mSkipLibraries;
 };
 
 } // end of namespace Assimp
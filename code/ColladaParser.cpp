@@ -47,6 +47,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef ASSIMP_BUILD_NO_DAE_IMPORTER
 
 #include "ColladaParser.h"
+#include "ImportProgressHandler.h"
 #include "fast_atof.h"
 #include "ParsingUtils.h"
 
@@ -55,8 +56,11 @@ using namespace Assimp::Collada;
 
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
-ColladaParser::ColladaParser( IOSystem* pIOHandler, const std::string& pFile)
+ColladaParser::ColladaParser( IOSystem* pIOHandler, const std::string& pFile, ImportProgressHandler* pProgress,
+	unsigned int pSkipLibraries)
 	: mFileName( pFile)
+	, mProgress( pProgress)
+	, mSkipLibraries( pSkipLibraries)
 {
 	mRootNode = NULL;
 	mUnitSize = 1.0f;
@@ -71,10 +75,7 @@ ColladaParser::ColladaParser( IOSystem* pIOHandler, const std::string& pFile)
     throw DeadlyImportError( "Failed to open file " + pFile + ".");
 
 	// generate a XML reader for it
-  boost::scoped_ptr<CIrrXML_IOStreamReader> mIOWrapper( new CIrrXML_IOStreamReader( file.get()));
-	mReader = irr::io::createIrrXMLReader( mIOWrapper.get());
-	if( !mReader)
-		ThrowException( "Collada: Unable to open file.");
+	mReader = new XMLReader( file.get());
 
 	// start reading
 	ReadContents();
@@ -114,7 +115,7 @@ void ColladaParser::ReadContents()
 	while( mReader->read())
 	{
 		// handle the root element "COLLADA"
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT)
+		if( mReader->getNodeType() == XML_ELEMENT)
 		{
 			if( IsElement( "COLLADA"))
 			{
@@ -156,16 +157,20 @@ void ColladaParser::ReadStructure()
 {
 	while( mReader->read())
 	{
+		if( mProgress)
+			mProgress->Poll();
+
 		// beginning of elements
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT) 
+		if( mReader->getNodeType() == XML_ELEMENT) 
 		{
+			// libraries the caller is not interested in end up at SkipElement()
 			if( IsElement( "asset"))
 				ReadAssetInfo();
-			else if( IsElement( "library_animations"))
+			else if( IsElement( "library_animations") && !(mSkipLibraries & aiComponent_ANIMATIONS))
 				ReadAnimationLibrary();
 			else if( IsElement( "library_controllers"))
 				ReadControllerLibrary();
-			else if( IsElement( "library_images"))
+			else if( IsElement( "library_images") && !(mSkipLibraries & aiComponent_TEXTURES))
 				ReadImageLibrary();
 			else if( IsElement( "library_materials"))
 				ReadMaterialLibrary();
@@ -175,9 +180,9 @@ void ColladaParser::ReadStructure()
 				ReadGeometryLibrary();
 			else if( IsElement( "library_visual_scenes"))
 				ReadSceneLibrary();
-			else if( IsElement( "library_lights"))
+			else if( IsElement( "library_lights") && !(mSkipLibraries & aiComponent_LIGHTS))
 				ReadLightLibrary();
-			else if( IsElement( "library_cameras"))
+			else if( IsElement( "library_cameras") && !(mSkipLibraries & aiComponent_CAMERAS))
 				ReadCameraLibrary();
 			else if( IsElement( "library_nodes"))
 				ReadSceneNode(NULL); /* some hacking to reuse this piece of code */
@@ -186,7 +191,7 @@ void ColladaParser::ReadStructure()
 			else
 				SkipElement();
 		} 
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END) 
+		else if( mReader->getNodeType() == XML_ELEMENT_END) 
 		{
 			break;
 		}
@@ -202,7 +207,7 @@ void ColladaParser::ReadAssetInfo()
 
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT)
+		if( mReader->getNodeType() == XML_ELEMENT)
 		{
 			if( IsElement( "unit"))
 			{
@@ -237,7 +242,7 @@ void ColladaParser::ReadAssetInfo()
 				SkipElement();
 			}
 		} 
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END)
+		else if( mReader->getNodeType() == XML_ELEMENT_END)
 		{
 			if( strcmp( mReader->getNodeName(), "asset") != 0)
 				ThrowException( "Expected end of \"asset\" element.");
@@ -256,7 +261,10 @@ void ColladaParser::ReadAnimationLibrary()
 
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT) 
+		if( mProgress)
+			mProgress->Poll();
+
+		if( mReader->getNodeType() == XML_ELEMENT) 
 		{
 			if( IsElement( "animation"))
 			{
@@ -268,7 +276,7 @@ void ColladaParser::ReadAnimationLibrary()
 				SkipElement();
 			}
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END) 
+		else if( mReader->getNodeType() == XML_ELEMENT_END) 
 		{
 			if( strcmp( mReader->getNodeName(), "library_animations") != 0)
 				ThrowException( "Expected end of \"library_animations\" element.");
@@ -305,7 +313,7 @@ void ColladaParser::ReadAnimation( Collada::Animation* pParent)
 
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT) 
+		if( mReader->getNodeType() == XML_ELEMENT) 
 		{
 			// we have subanimations
 			if( IsElement( "animation"))
@@ -359,7 +367,7 @@ void ColladaParser::ReadAnimation( Collada::Animation* pParent)
 				SkipElement();
 			}
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END) 
+		else if( mReader->getNodeType() == XML_ELEMENT_END) 
 		{
 			if( strcmp( mReader->getNodeName(), "animation") != 0)
 				ThrowException( "Expected end of \"animation\" element.");
@@ -396,7 +404,7 @@ void ColladaParser::ReadAnimationSampler( Collada::AnimationChannel& pChannel)
 {
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT) 
+		if( mReader->getNodeType() == XML_ELEMENT) 
 		{
 			if( IsElement( "input"))
 			{
@@ -422,7 +430,7 @@ void ColladaParser::ReadAnimationSampler( Collada::AnimationChannel& pChannel)
 				SkipElement();
 			}
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END) 
+		else if( mReader->getNodeType() == XML_ELEMENT_END) 
 		{
 			if( strcmp( mReader->getNodeName(), "sampler") != 0)
 				ThrowException( "Expected end of \"sampler\" element.");
@@ -441,7 +449,10 @@ void ColladaParser::ReadControllerLibrary()
 
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT) 
+		if( mProgress)
+			mProgress->Poll();
+
+		if( mReader->getNodeType() == XML_ELEMENT) 
 		{
 			if( IsElement( "controller"))
 			{
@@ -460,7 +471,7 @@ void ColladaParser::ReadControllerLibrary()
 				SkipElement();
 			}
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END) 
+		else if( mReader->getNodeType() == XML_ELEMENT_END) 
 		{
 			if( strcmp( mReader->getNodeName(), "library_controllers") != 0)
 				ThrowException( "Expected end of \"library_controllers\" element.");
@@ -476,7 +487,7 @@ void ColladaParser::ReadController( Collada::Controller& pController)
 {
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT) 
+		if( mReader->getNodeType() == XML_ELEMENT) 
 		{
 			// two types of controllers: "skin" and "morph". Only the first one is relevant, we skip the other
 			if( IsElement( "morph"))
@@ -490,20 +501,19 @@ void ColladaParser::ReadController( Collada::Controller& pController)
 				// controller, but I refuse to implement every bullshit idea they've come up with
 				int sourceIndex = GetAttribute( "source");
 				pController.mMeshId = mReader->getAttributeValue( sourceIndex) + 1;
+
+				// without bones, only the reference to the mesh is of interest
+				if( mSkipLibraries & aiComponent_BONEWEIGHTS)
+					SkipElement();
 			} 
 			else if( IsElement( "bind_shape_matrix"))
 			{
 				// content is 16 floats to define a matrix... it seems to be important for some models
 	      const char* content = GetTextContent();
 
-	      // read the 16 floats
-	      for( unsigned int a = 0; a < 16; a++)
-	      {
-		      // read a number
-          content = fast_atoreal_move<float>( content, pController.mBindShapeMatrix[a]);
-		      // skip whitespace after it
-		      SkipSpacesAndLineEnd( &content);
-	      }
+	      // read the 16 floats, missing ones are zero
+	      const unsigned int numRead = fast_atoreal_span<float>( content, pController.mBindShapeMatrix, 16);
+	      std::fill( pController.mBindShapeMatrix + numRead, pController.mBindShapeMatrix + 16, 0.f);
 
         TestClosing( "bind_shape_matrix");
 			} 
@@ -526,7 +536,7 @@ void ColladaParser::ReadController( Collada::Controller& pController)
 				SkipElement();
 			}
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END) 
+		else if( mReader->getNodeType() == XML_ELEMENT_END) 
 		{
 			if( strcmp( mReader->getNodeName(), "controller") == 0)
 				break;
@@ -542,7 +552,7 @@ void ColladaParser::ReadControllerJoints( Collada::Controller& pController)
 {
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT) 
+		if( mReader->getNodeType() == XML_ELEMENT) 
 		{
 			// Input channels for joint data. Two possible semantics: "JOINT" and "INV_BIND_MATRIX"
 			if( IsElement( "input"))
@@ -575,7 +585,7 @@ void ColladaParser::ReadControllerJoints( Collada::Controller& pController)
 				SkipElement();
 			}
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END) 
+		else if( mReader->getNodeType() == XML_ELEMENT_END) 
 		{
 			if( strcmp( mReader->getNodeName(), "joints") != 0)
 				ThrowException( "Expected end of \"joints\" element.");
@@ -596,7 +606,7 @@ void ColladaParser::ReadControllerWeights( Collada::Controller& pController)
 
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT) 
+		if( mReader->getNodeType() == XML_ELEMENT) 
 		{
 			// Input channels for weight data. Two possible semantics: "JOINT" and "WEIGHT"
 			if( IsElement( "input"))
@@ -633,14 +643,18 @@ void ColladaParser::ReadControllerWeights( Collada::Controller& pController)
 				// read weight count per vertex
 				const char* text = GetTextContent();
 				size_t numWeights = 0;
-				for( std::vector<size_t>::iterator it = pController.mWeightCounts.begin(); it != pController.mWeightCounts.end(); ++it)
+				unsigned int buffer[256];
+				for( std::vector<size_t>::iterator it = pController.mWeightCounts.begin(); it != pController.mWeightCounts.end(); )
 				{
-					if( *text == 0)
+					const unsigned int num = strtoul10_span( text, buffer, (unsigned int) std::min( pController.mWeightCounts.end() - it, (ptrdiff_t) 256));
+					if( num == 0)
 						ThrowException( "Out of data while reading vcount");
 
-					*it = strtoul10( text, &text);
-					numWeights += *it;
-					SkipSpacesAndLineEnd( &text);
+					for( unsigned int a = 0; a < num; a++, ++it)
+					{
+						*it = buffer[a];
+						numWeights += *it;
+					}
 				}
 
 				TestClosing( "vcount");
@@ -652,17 +666,19 @@ void ColladaParser::ReadControllerWeights( Collada::Controller& pController)
 			{
 				// read JointIndex - WeightIndex pairs
 				const char* text = GetTextContent();
+				unsigned int buffer[256];
 
-				for( std::vector< std::pair<size_t, size_t> >::iterator it = pController.mWeights.begin(); it != pController.mWeights.end(); ++it)
+				for( std::vector< std::pair<size_t, size_t> >::iterator it = pController.mWeights.begin(); it != pController.mWeights.end(); )
 				{
-					if( *text == 0)
-						ThrowException( "Out of data while reading vertex_weights");
-					it->first = strtoul10( text, &text);
-					SkipSpacesAndLineEnd( &text);
-					if( *text == 0)
+					const unsigned int num = strtoul10_span( text, buffer, (unsigned int) std::min( pController.mWeights.end() - it, (ptrdiff_t) 128) * 2);
+					if( num == 0 || (num & 1))
 						ThrowException( "Out of data while reading vertex_weights");
-					it->second = strtoul10( text, &text);
-					SkipSpacesAndLineEnd( &text);
+
+					for( unsigned int a = 0; a < num; a += 2, ++it)
+					{
+						it->first = buffer[a];
+						it->second = buffer[a+1];
+					}
 				}
 
 				TestClosing( "v");
@@ -673,7 +689,7 @@ void ColladaParser::ReadControllerWeights( Collada::Controller& pController)
 				SkipElement();
 			}
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END) 
+		else if( mReader->getNodeType() == XML_ELEMENT_END) 
 		{
 			if( strcmp( mReader->getNodeName(), "vertex_weights") != 0)
 				ThrowException( "Expected end of \"vertex_weights\" element.");
@@ -692,7 +708,10 @@ void ColladaParser::ReadImageLibrary()
 
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT) {
+		if( mProgress)
+			mProgress->Poll();
+
+		if( mReader->getNodeType() == XML_ELEMENT) {
 			if( IsElement( "image"))
 			{
 				// read ID. Another entry which is "optional" by design but obligatory in reality
@@ -710,7 +729,7 @@ void ColladaParser::ReadImageLibrary()
 				SkipElement();
 			}
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END) {
+		else if( mReader->getNodeType() == XML_ELEMENT_END) {
 			if( strcmp( mReader->getNodeName(), "library_images") != 0)
 				ThrowException( "Expected end of \"library_images\" element.");
 
@@ -725,7 +744,7 @@ void ColladaParser::ReadImage( Collada::Image& pImage)
 {
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT){
+		if( mReader->getNodeType() == XML_ELEMENT){
 			// Need to run different code paths here, depending on the Collada XSD version
 			if (IsElement("image")) {
                 SkipElement();
@@ -803,7 +822,7 @@ void ColladaParser::ReadImage( Collada::Image& pImage)
 				SkipElement();
 			}
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END) {
+		else if( mReader->getNodeType() == XML_ELEMENT_END) {
 			if( strcmp( mReader->getNodeName(), "image") == 0)
 				break;
 		}
@@ -819,7 +838,10 @@ void ColladaParser::ReadMaterialLibrary()
 
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT) 
+		if( mProgress)
+			mProgress->Poll();
+
+		if( mReader->getNodeType() == XML_ELEMENT) 
 		{
 			if( IsElement( "material"))
 			{
@@ -835,7 +857,7 @@ void ColladaParser::ReadMaterialLibrary()
 				SkipElement();
 			}
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END) 
+		else if( mReader->getNodeType() == XML_ELEMENT_END) 
 		{
 			if( strcmp( mReader->getNodeName(), "library_materials") != 0)
 				ThrowException( "Expected end of \"library_materials\" element.");
@@ -854,7 +876,10 @@ void ColladaParser::ReadLightLibrary()
 
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT) {
+		if( mProgress)
+			mProgress->Poll();
+
+		if( mReader->getNodeType() == XML_ELEMENT) {
 			if( IsElement( "light"))
 			{
 				// read ID. By now you propably know my opinion about this "specification"
@@ -870,7 +895,7 @@ void ColladaParser::ReadLightLibrary()
 				SkipElement();
 			}
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END)	{
+		else if( mReader->getNodeType() == XML_ELEMENT_END)	{
 			if( strcmp( mReader->getNodeName(), "library_lights") != 0)
 				ThrowException( "Expected end of \"library_lights\" element.");
 
@@ -888,7 +913,10 @@ void ColladaParser::ReadCameraLibrary()
 
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT) {
+		if( mProgress)
+			mProgress->Poll();
+
+		if( mReader->getNodeType() == XML_ELEMENT) {
 			if( IsElement( "camera"))
 			{
 				// read ID. By now you propably know my opinion about this "specification"
@@ -909,7 +937,7 @@ void ColladaParser::ReadCameraLibrary()
 				SkipElement();
 			}
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END)	{
+		else if( mReader->getNodeType() == XML_ELEMENT_END)	{
 			if( strcmp( mReader->getNodeName(), "library_cameras") != 0)
 				ThrowException( "Expected end of \"library_cameras\" element.");
 
@@ -924,7 +952,7 @@ void ColladaParser::ReadMaterial( Collada::Material& pMaterial)
 {
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT) {
+		if( mReader->getNodeType() == XML_ELEMENT) {
 			if (IsElement("material")) {
                 SkipElement();
             }
@@ -945,7 +973,7 @@ void ColladaParser::ReadMaterial( Collada::Material& pMaterial)
 				SkipElement();
 			}
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END) {
+		else if( mReader->getNodeType() == XML_ELEMENT_END) {
 			if( strcmp( mReader->getNodeName(), "material") != 0)
 				ThrowException( "Expected end of \"material\" element.");
 
@@ -960,7 +988,7 @@ void ColladaParser::ReadLight( Collada::Light& pLight)
 {
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT) {
+		if( mReader->getNodeType() == XML_ELEMENT) {
             if (IsElement("light")) {
                 SkipElement();
             }
@@ -1035,7 +1063,7 @@ void ColladaParser::ReadLight( Collada::Light& pLight)
 				TestClosing("hotspot_beam");
 			}
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END) {
+		else if( mReader->getNodeType() == XML_ELEMENT_END) {
 			if( strcmp( mReader->getNodeName(), "light") == 0)
 				break;
 		}
@@ -1048,7 +1076,7 @@ void ColladaParser::ReadCamera( Collada::Camera& pCamera)
 {
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT) {
+		if( mReader->getNodeType() == XML_ELEMENT) {
 			if (IsElement("camera")) {
                 SkipElement();
             }
@@ -1076,7 +1104,7 @@ void ColladaParser::ReadCamera( Collada::Camera& pCamera)
 				TestClosing("zfar");
 			}
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END) {
+		else if( mReader->getNodeType() == XML_ELEMENT_END) {
 			if( strcmp( mReader->getNodeName(), "camera") == 0)
 				break;
 		}
@@ -1093,7 +1121,10 @@ void ColladaParser::ReadEffectLibrary()
 
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT) {
+		if( mProgress)
+			mProgress->Poll();
+
+		if( mReader->getNodeType() == XML_ELEMENT) {
 			if( IsElement( "effect"))
 			{
 				// read ID. Do I have to repeat my ranting about "optional" attributes?
@@ -1113,7 +1144,7 @@ void ColladaParser::ReadEffectLibrary()
 				SkipElement();
 			}
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END) {
+		else if( mReader->getNodeType() == XML_ELEMENT_END) {
 			if( strcmp( mReader->getNodeName(), "library_effects") != 0)
 				ThrowException( "Expected end of \"library_effects\" element.");
 
@@ -1129,14 +1160,14 @@ void ColladaParser::ReadEffect( Collada::Effect& pEffect)
 	// for the moment we don't support any other type of effect.
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT)
+		if( mReader->getNodeType() == XML_ELEMENT)
 		{
 			if( IsElement( "profile_COMMON"))
 				ReadEffectProfileCommon( pEffect);
 			else
 				SkipElement();
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END) 
+		else if( mReader->getNodeType() == XML_ELEMENT_END) 
 		{
 			if( strcmp( mReader->getNodeName(), "effect") != 0)
 				ThrowException( "Expected end of \"effect\" element.");
@@ -1152,7 +1183,7 @@ void ColladaParser::ReadEffectProfileCommon( Collada::Effect& pEffect)
 {
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT) 
+		if( mReader->getNodeType() == XML_ELEMENT) 
 		{
 			if( IsElement( "newparam"))	{
 				// save ID
@@ -1230,7 +1261,7 @@ void ColladaParser::ReadEffectProfileCommon( Collada::Effect& pEffect)
 				SkipElement();
 			}
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END) {
+		else if( mReader->getNodeType() == XML_ELEMENT_END) {
 			if( strcmp( mReader->getNodeName(), "profile_COMMON") == 0)
 			{
 				break;
@@ -1249,7 +1280,7 @@ void ColladaParser::ReadSamplerProperties( Sampler& out )
 
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT) {
+		if( mReader->getNodeType() == XML_ELEMENT) {
 
 			// MAYA extensions
 			// -------------------------------------------------------
@@ -1325,7 +1356,7 @@ void ColladaParser::ReadSamplerProperties( Sampler& out )
 				TestClosing( "amount");
 			}
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END) {
+		else if( mReader->getNodeType() == XML_ELEMENT_END) {
 			if( strcmp( mReader->getNodeName(), "technique") == 0)
 				break;
 		}
@@ -1344,7 +1375,7 @@ void ColladaParser::ReadEffectColor( aiColor4D& pColor, Sampler& pSampler)
 
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT) {
+		if( mReader->getNodeType() == XML_ELEMENT) {
 			if( IsElement( "color"))
 			{
 				// text content contains 4 floats
@@ -1394,7 +1425,7 @@ void ColladaParser::ReadEffectColor( aiColor4D& pColor, Sampler& pSampler)
 				SkipElement();
 			}
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END){
+		else if( mReader->getNodeType() == XML_ELEMENT_END){
 			if (mReader->getNodeName() == curElem)
 				break;
 		}
@@ -1407,7 +1438,7 @@ void ColladaParser::ReadEffectFloat( float& pFloat)
 {
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT){
+		if( mReader->getNodeType() == XML_ELEMENT){
 			if( IsElement( "float"))
 			{
 				// text content contains a single floats
@@ -1422,7 +1453,7 @@ void ColladaParser::ReadEffectFloat( float& pFloat)
 				SkipElement();
 			}
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END){
+		else if( mReader->getNodeType() == XML_ELEMENT_END){
 			break;
 		}
 	}
@@ -1434,7 +1465,7 @@ void ColladaParser::ReadEffectParam( Collada::EffectParam& pParam)
 {
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT) {
+		if( mReader->getNodeType() == XML_ELEMENT) {
 			if( IsElement( "surface"))
 			{
 				// image ID given inside <init_from> tags
@@ -1464,7 +1495,7 @@ void ColladaParser::ReadEffectParam( Collada::EffectParam& pParam)
 				SkipElement();
 			}
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END) {
+		else if( mReader->getNodeType() == XML_ELEMENT_END) {
 			break;
 		}
 	}
@@ -1479,7 +1510,10 @@ void ColladaParser::ReadGeometryLibrary()
 
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT)
+		if( mProgress)
+			mProgress->Poll();
+
+		if( mReader->getNodeType() == XML_ELEMENT)
 		{
 			if( IsElement( "geometry"))
 			{
@@ -1502,7 +1536,7 @@ void ColladaParser::ReadGeometryLibrary()
 				SkipElement();
 			}
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END)
+		else if( mReader->getNodeType() == XML_ELEMENT_END)
 		{
 			if( strcmp( mReader->getNodeName(), "library_geometries") != 0)
 				ThrowException( "Expected end of \"library_geometries\" element.");
@@ -1521,7 +1555,7 @@ void ColladaParser::ReadGeometry( Collada::Mesh* pMesh)
 
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT)
+		if( mReader->getNodeType() == XML_ELEMENT)
 		{
 			if( IsElement( "mesh"))
 			{
@@ -1533,7 +1567,7 @@ void ColladaParser::ReadGeometry( Collada::Mesh* pMesh)
 				SkipElement();
 			}
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END)
+		else if( mReader->getNodeType() == XML_ELEMENT_END)
 		{
 			if( strcmp( mReader->getNodeName(), "geometry") != 0)
 				ThrowException( "Expected end of \"geometry\" element.");
@@ -1552,7 +1586,7 @@ void ColladaParser::ReadMesh( Mesh* pMesh)
 
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT)
+		if( mReader->getNodeType() == XML_ELEMENT)
 		{
 			if( IsElement( "source"))
 			{
@@ -1575,7 +1609,7 @@ void ColladaParser::ReadMesh( Mesh* pMesh)
 				SkipElement();
 			}
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END)
+		else if( mReader->getNodeType() == XML_ELEMENT_END)
 		{
 			if( strcmp( mReader->getNodeName(), "technique_common") == 0)
 			{
@@ -1603,7 +1637,7 @@ void ColladaParser::ReadSource()
 
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT)
+		if( mReader->getNodeType() == XML_ELEMENT)
 		{
 			if( IsElement( "float_array") || IsElement( "IDREF_array") || IsElement( "Name_array"))
 			{
@@ -1622,7 +1656,7 @@ void ColladaParser::ReadSource()
 				SkipElement();
 			}
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END)
+		else if( mReader->getNodeType() == XML_ELEMENT_END)
 		{
 			if( strcmp( mReader->getNodeName(), "source") == 0)
 			{
@@ -1680,19 +1714,27 @@ void ColladaParser::ReadDataArray()
 			}
 		} else
 		{
-			data.mValues.reserve( count);
+			data.mValues.resize( count);
 
-			for( unsigned int a = 0; a < count; a++)
+			// read the numbers in batches of some thousands, between them there's time to poll
+			for( unsigned int a = 0; a < count; )
 			{
-				if( *content == 0)
-					ThrowException( "Expected more values while reading float_array contents.");
+				if( mProgress)
+					mProgress->Poll();
 
-				float value;
-				// read a number
-				content = fast_atoreal_move<float>( content, value);
-				data.mValues.push_back( value);
-				// skip whitespace after it
-				SkipSpacesAndLineEnd( &content);
+				const unsigned int batch = std::min( count - a, 4096u);
+				const unsigned int num = fast_atoreal_span<float>( content, &data.mValues[a], batch);
+				a += num;
+				if( num < batch)
+				{
+					if( *content == 0)
+						ThrowException( "Expected more values while reading float_array contents.");
+
+					// not a number - it has always been read as zero, so keep doing that
+					data.mValues[a++] = 0.f;
+					while( *content != 0 && !IsSpaceOrNewLine( *content))
+						++content;
+				}
 			}
 		}
 
@@ -1733,7 +1775,7 @@ void ColladaParser::ReadAccessor( const std::string& pID)
 	// and read the components
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT)
+		if( mReader->getNodeType() == XML_ELEMENT)
 		{
 			if( IsElement( "param"))
 			{
@@ -1794,7 +1836,7 @@ void ColladaParser::ReadAccessor( const std::string& pID)
 				ThrowException( "Unexpected sub element in tag \"accessor\".");
 			}
 		} 
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END)
+		else if( mReader->getNodeType() == XML_ELEMENT_END)
 		{
 			if( strcmp( mReader->getNodeName(), "accessor") != 0)
 				ThrowException( "Expected end of \"accessor\" element.");
@@ -1815,7 +1857,7 @@ void ColladaParser::ReadVertexData( Mesh* pMesh)
 	// a number of <input> elements
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT)
+		if( mReader->getNodeType() == XML_ELEMENT)
 		{
 			if( IsElement( "input"))
 			{
@@ -1825,7 +1867,7 @@ void ColladaParser::ReadVertexData( Mesh* pMesh)
 				ThrowException( "Unexpected sub element in tag \"vertices\".");
 			}
 		} 
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END)
+		else if( mReader->getNodeType() == XML_ELEMENT_END)
 		{
 			if( strcmp( mReader->getNodeName(), "vertices") != 0)
 				ThrowException( "Expected end of \"vertices\" element.");
@@ -1877,7 +1919,7 @@ void ColladaParser::ReadIndexData( Mesh* pMesh)
 	// also a number of <input> elements, but in addition a <p> primitive collection and propably index counts for all primitives
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT)
+		if( mReader->getNodeType() == XML_ELEMENT)
 		{
 			if( IsElement( "input"))
 			{
@@ -1892,14 +1934,15 @@ void ColladaParser::ReadIndexData( Mesh* pMesh)
 						// case <polylist> - specifies the number of indices for each polygon
 						const char* content = GetTextContent();
 						vcount.reserve( numPrimitives);
-						for( unsigned int a = 0; a < numPrimitives; a++)
+						unsigned int buffer[256];
+						for( size_t a = 0; a < numPrimitives; )
 						{
-							if( *content == 0)
+							const unsigned int num = strtoul10_span( content, buffer, (unsigned int) std::min( numPrimitives - a, (size_t) 256));
+							if( num == 0)
 								ThrowException( "Expected more values while reading vcount contents.");
-							// read a number
-							vcount.push_back( (size_t) strtoul10( content, &content));
-							// skip whitespace after it
-							SkipSpacesAndLineEnd( &content);
+
+							vcount.insert( vcount.end(), buffer, buffer + num);
+							a += num;
 						}
 					}
 
@@ -1918,7 +1961,7 @@ void ColladaParser::ReadIndexData( Mesh* pMesh)
 				ThrowException( "Unexpected sub element in tag \"vertices\".");
 			}
 		} 
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END)
+		else if( mReader->getNodeType() == XML_ELEMENT_END)
 		{
 			if( mReader->getNodeName() != elementName)
 				ThrowException( boost::str( boost::format( "Expected end of \"%s\" element.") % elementName));
@@ -2016,15 +2059,15 @@ void ColladaParser::ReadPrimitives( Mesh* pMesh, std::vector<InputChannel>& pPer
 	if (pNumPrimitives > 0)	// It is possible to not contain any indicies
 	{
 		const char* content = GetTextContent();
-		while( *content != 0)
+		int buffer[256];
+		for( unsigned int num; (num = strtol10_span( content, buffer, 256)) > 0; )
 		{
-			// read a value. 
 			// Hack: (thom) Some exporters put negative indices sometimes. We just try to carry on anyways.
-			int value = std::max( 0, strtol10( content, &content));
-			indices.push_back( size_t( value));
-			// skip whitespace after it
-			SkipSpacesAndLineEnd( &content);
+			for( unsigned int a = 0; a < num; a++)
+				indices.push_back( size_t( std::max( 0, buffer[a])));
 		}
+		if( *content != 0)
+			ThrowException( "Unexpected data in <p> element.");
 	}
 
 	// complain if the index count doesn't fit
@@ -2085,6 +2128,9 @@ void ColladaParser::ReadPrimitives( Mesh* pMesh, std::vector<InputChannel>& pPer
 
 	for( size_t a = 0; a < numPrimitives; a++)
 	{
+		if( mProgress)
+			mProgress->Poll();
+
 		// determine number of points for this primitive
 		size_t numPoints = 0;
 		switch( pPrimType)
@@ -2248,7 +2294,10 @@ void ColladaParser::ReadSceneLibrary()
 
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT)
+		if( mProgress)
+			mProgress->Poll();
+
+		if( mReader->getNodeType() == XML_ELEMENT)
 		{
 			// a visual scene - generate root node under its ID and let ReadNode() do the recursive work
 			if( IsElement( "visual_scene"))
@@ -2276,7 +2325,7 @@ void ColladaParser::ReadSceneLibrary()
 				SkipElement();
 			}
 		}
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END)
+		else if( mReader->getNodeType() == XML_ELEMENT_END)
 		{
 			if( strcmp( mReader->getNodeName(), "library_visual_scenes") == 0)
 				//ThrowException( "Expected end of \"library_visual_scenes\" element.");
@@ -2296,7 +2345,7 @@ void ColladaParser::ReadSceneNode( Node* pNode)
 
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT) 
+		if( mReader->getNodeType() == XML_ELEMENT) 
 		{
 			if( IsElement( "node"))
 			{
@@ -2422,7 +2471,7 @@ void ColladaParser::ReadSceneNode( Node* pNode)
 				SkipElement();
 			}
 		} 
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END) {
+		else if( mReader->getNodeType() == XML_ELEMENT_END) {
 			break;
 		}
 	}
@@ -2449,14 +2498,9 @@ void ColladaParser::ReadNodeTransformation( Node* pNode, TransformType pType)
 	static const unsigned int sNumParameters[] = { 9, 4, 3, 3, 7, 16 };
 	const char* content = GetTextContent();
 
-	// read as many parameters and store in the transformation
-	for( unsigned int a = 0; a < sNumParameters[pType]; a++)
-	{
-		// read a number
-		content = fast_atoreal_move<float>( content, tf.f[a]);
-		// skip whitespace after it
-		SkipSpacesAndLineEnd( &content);
-	}
+	// read as many parameters and store in the transformation, missing ones are zero
+	const unsigned int numRead = fast_atoreal_span<float>( content, tf.f, sNumParameters[pType]);
+	std::fill( tf.f + numRead, tf.f + sNumParameters[pType], 0.f);
 
 	// place the transformation at the queue of the node
 	pNode->mTransforms.push_back( tf);
@@ -2471,7 +2515,7 @@ void ColladaParser::ReadMaterialVertexInputBinding( Collada::SemanticMappingTabl
 {
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT)	{
+		if( mReader->getNodeType() == XML_ELEMENT)	{
 			if( IsElement( "bind_vertex_input"))
 			{
 				Collada::InputSemanticMapEntry vn;
@@ -2495,7 +2539,7 @@ void ColladaParser::ReadMaterialVertexInputBinding( Collada::SemanticMappingTabl
 				DefaultLogger::get()->warn("Collada: Found unsupported <bind> element");
 			}
 		} 
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END)	{
+		else if( mReader->getNodeType() == XML_ELEMENT_END)	{
 			if( strcmp( mReader->getNodeName(), "instance_material") == 0)
 				break;
 		} 
@@ -2520,7 +2564,7 @@ void ColladaParser::ReadNodeGeometry( Node* pNode)
 		// read material associations. Ignore additional elements inbetween
 		while( mReader->read())
 		{
-			if( mReader->getNodeType() == irr::io::EXN_ELEMENT)	
+			if( mReader->getNodeType() == XML_ELEMENT)	
 			{
 				if( IsElement( "instance_material"))
 				{
@@ -2543,7 +2587,7 @@ void ColladaParser::ReadNodeGeometry( Node* pNode)
 					instance.mMaterials[group] = s;
 				} 
 			} 
-			else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END)	
+			else if( mReader->getNodeType() == XML_ELEMENT_END)	
 			{
 				if( strcmp( mReader->getNodeName(), "instance_geometry") == 0 
 					|| strcmp( mReader->getNodeName(), "instance_controller") == 0)
@@ -2565,7 +2609,7 @@ void ColladaParser::ReadScene()
 
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT)	{
+		if( mReader->getNodeType() == XML_ELEMENT)	{
 			if( IsElement( "instance_visual_scene"))
 			{
 				// should be the first and only occurence
@@ -2587,7 +2631,7 @@ void ColladaParser::ReadScene()
 				SkipElement();
 			}
 		} 
-		else if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END){
+		else if( mReader->getNodeType() == XML_ELEMENT_END){
 			break;
 		} 
 	}
@@ -2604,12 +2648,8 @@ void ColladaParser::ThrowException( const std::string& pError) const
 // Skips all data until the end node of the current element
 void ColladaParser::SkipElement()
 {
-	// nothing to skip if it's an <element />
-	if( mReader->isEmptyElement())
-		return;
-
-	// reroute
-	SkipElement( mReader->getNodeName());
+	// jump over the contents without tokenizing them
+	mReader->skipElement();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -2621,7 +2661,7 @@ void ColladaParser::SkipElement( const char* pElement)
 	std::string element = pElement;
 	while( mReader->read())
 	{
-		if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END)
+		if( mReader->getNodeType() == XML_ELEMENT_END)
 			if( mReader->getNodeName() == element)
 				break;
 	}
@@ -2635,11 +2675,11 @@ void ColladaParser::TestOpening( const char* pName)
 	if( !mReader->read())
 		ThrowException( boost::str( boost::format( "Unexpected end of file while beginning of \"%s\" element.") % pName));
 	// whitespace in front is ok, just read again if found
-	if( mReader->getNodeType() == irr::io::EXN_TEXT)
+	if( mReader->getNodeType() == XML_TEXT)
 		if( !mReader->read())
 			ThrowException( boost::str( boost::format( "Unexpected end of file while reading beginning of \"%s\" element.") % pName));
 
-	if( mReader->getNodeType() != irr::io::EXN_ELEMENT || strcmp( mReader->getNodeName(), pName) != 0)
+	if( mReader->getNodeType() != XML_ELEMENT || strcmp( mReader->getNodeName(), pName) != 0)
 		ThrowException( boost::str( boost::format( "Expected start of \"%s\" element.") % pName));
 }
 
@@ -2648,19 +2688,19 @@ void ColladaParser::TestOpening( const char* pName)
 void ColladaParser::TestClosing( const char* pName)
 {
 	// check if we're already on the closing tag and return right away
-	if( mReader->getNodeType() == irr::io::EXN_ELEMENT_END && strcmp( mReader->getNodeName(), pName) == 0)
+	if( mReader->getNodeType() == XML_ELEMENT_END && strcmp( mReader->getNodeName(), pName) == 0)
 		return;
 
 	// if not, read some more
 	if( !mReader->read())
 		ThrowException( boost::str( boost::format( "Unexpected end of file while reading end of \"%s\" element.") % pName));
 	// whitespace in front is ok, just read again if found
-	if( mReader->getNodeType() == irr::io::EXN_TEXT)
+	if( mReader->getNodeType() == XML_TEXT)
 		if( !mReader->read())
 			ThrowException( boost::str( boost::format( "Unexpected end of file while reading end of \"%s\" element.") % pName));
 
 	// but this has the be the closing tag, or we're lost
-	if( mReader->getNodeType() != irr::io::EXN_ELEMENT_END || strcmp( mReader->getNodeName(), pName) != 0)
+	if( mReader->getNodeType() != XML_ELEMENT_END || strcmp( mReader->getNodeName(), pName) != 0)
 		ThrowException( boost::str( boost::format( "Expected end of \"%s\" element.") % pName));
 }
 
@@ -2704,13 +2744,13 @@ const char* ColladaParser::GetTextContent()
 const char* ColladaParser::TestTextContent()
 {
 	// present node should be the beginning of an element
-	if( mReader->getNodeType() != irr::io::EXN_ELEMENT || mReader->isEmptyElement())
+	if( mReader->getNodeType() != XML_ELEMENT || mReader->isEmptyElement())
 		return NULL;
 
 	// read contents of the element
 	if( !mReader->read() )
 		return NULL;
-	if( mReader->getNodeType() != irr::io::EXN_TEXT)
+	if( mReader->getNodeType() != XML_TEXT)
 		return NULL;
 
 	// skip leading whitespace
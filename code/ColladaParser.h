@@ -45,11 +45,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_COLLADAPARSER_H_INC
 #define AI_COLLADAPARSER_H_INC
 
-#include "irrXMLWrapper.h"
+#include "XMLReader.h"
 #include "ColladaHelper.h"
 
 namespace Assimp
 {
+	class ImportProgressHandler;
 
 // ------------------------------------------------------------------------------------------
 /** Parser helper class for the Collada loader. 
@@ -62,8 +63,11 @@ class ColladaParser
 	friend class ColladaLoader;
 
 protected:
-	/** Constructor from XML file */
-	ColladaParser( IOSystem* pIOHandler, const std::string& pFile);
+	/** Constructor from XML file. The progress handler, if any, is polled
+	 *  while parsing the libraries and may abort it. pSkipLibraries is a
+	 *  combination of #aiComponent flags, see #AI_CONFIG_IMPORT_COLLADA_SKIP_LIBRARIES */
+	ColladaParser( IOSystem* pIOHandler, const std::string& pFile, ImportProgressHandler* pProgress,
+		unsigned int pSkipLibraries = 0);
 
 	/** Destructor */
 	~ColladaParser();
@@ -256,8 +260,14 @@ protected:
 	/** Filename, for a verbose error message */
 	std::string mFileName;
 
+	/** Progress handler of the import, may be NULL */
+	ImportProgressHandler* mProgress;
+
+	/** Libraries to skip, as #aiComponent flags */
+	unsigned int mSkipLibraries;
+
 	/** XML reader, member for everyday use */
-	irr::io::IrrXMLReader* mReader;
+	XMLReader* mReader;
 
 	/** All data arrays found in the file by ID. Might be referred to by actually 
 	    everyone. Collada, you are a steaming pile of indirection. */
@@ -321,7 +331,7 @@ protected:
 // Check for element match
 inline bool ColladaParser::IsElement( const char* pName) const
 {
-	ai_assert( mReader->getNodeType() == irr::io::EXN_ELEMENT); 
+	ai_assert( mReader->getNodeType() == XML_ELEMENT); 
 	return ::strcmp( mReader->getNodeName(), pName) == 0; 
 }
 
@@ -76,6 +76,21 @@ bool ComputeUVMappingProcess::IsActive( unsigned int pFlags) const
 	return	(pFlags & aiProcess_GenUVCoords) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+bool ComputeUVMappingProcess::MaintainsMeshData() const
+{
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Hides ::FindMeshCenter(), the bounds are needed again for each mapping of a mesh
+void ComputeUVMappingProcess::FindMeshCenter(aiMesh* mesh, aiVector3D& out, aiVector3D& min, aiVector3D& max)
+{
+	MeshPipelineContext context(mesh,shared);
+	context.GetBoundingBox(min,max);
+	out = min + (max-min)*0.5f;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Check whether a ray intersects a plane and find the intersection point
 inline bool PlaneIntersect(const aiRay& ray, const aiVector3D& planePos,
@@ -481,6 +496,9 @@ void ComputeUVMappingProcess::Execute( aiScene* pScene)
 							default:
 								ai_assert(false);
 							}
+							if (shared) {
+								shared->GetMeshData().Invalidate(mesh,MeshDataCache::VertexData);
+							}
 							if (m && idx != outIdx)
 							{
 								DefaultLogger::get()->warn("UV index mismatch. Not all meshes assigned to "
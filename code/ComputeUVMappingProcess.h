@@ -77,8 +77,18 @@ public:
 	*/
 	void Execute( aiScene* pScene);
 
+	// -------------------------------------------------------------------
+	/** The step only adds UV channels and tells the MeshDataCache */
+	bool MaintainsMeshData() const;
+
 protected:
 
+	// -------------------------------------------------------------------
+	/** Gets the bounds and the center of a mesh, reusing the bounds 
+	 *  from the MeshDataCache if possible
+	*/
+	void FindMeshCenter(aiMesh* mesh, aiVector3D& out, aiVector3D& min, aiVector3D& max);
+
 	// -------------------------------------------------------------------
 	/** Computes spherical UV coordinates for a mesh
 	 *
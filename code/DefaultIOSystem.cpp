@@ -45,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <stdlib.h>
 #include "DefaultIOSystem.h"
 #include "DefaultIOStream.h"
+#include "MappedIOStream.h"
 
 #ifdef __unix__
 #include <sys/param.h>
@@ -56,8 +57,8 @@ using namespace Assimp;
 // ------------------------------------------------------------------------------------------------
 // Constructor. 
 DefaultIOSystem::DefaultIOSystem()
+	: mappingThreshold(SIZE_MAX)
 {
-	// nothing to do here
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -86,6 +87,14 @@ IOStream* DefaultIOSystem::Open( const char* strFile, const char* strMode)
 	ai_assert(NULL != strFile);
 	ai_assert(NULL != strMode);
 
+	// large files are paged in by the OS rather than copied through stdio
+	if (SIZE_MAX != mappingThreshold && !strchr(strMode,'w') && !strchr(strMode,'a') && !strchr(strMode,'+')) {
+		IOStream* mapped = MappedIOStream::Open(strFile,mappingThreshold);
+		if (mapped) {
+			return mapped;
+		}
+	}
+
 	FILE* file = ::fopen( strFile, strMode);
 	if( NULL == file) 
 		return NULL;
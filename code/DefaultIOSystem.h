@@ -44,6 +44,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "../include/assimp/IOSystem.hpp"
 
+/** Default for #AI_CONFIG_GLOB_MEMORY_MAPPING, files are only 
+ *  memory-mapped on request. */
+#define AI_DEFAULTIO_MAPPING_THRESHOLD -1
+
 namespace Assimp	{
 
 // ---------------------------------------------------------------------------
@@ -76,6 +80,17 @@ public:
 	// -------------------------------------------------------------------
 	/** Compare two paths */
 	bool ComparePaths (const char* one, const char* second) const;
+
+	// -------------------------------------------------------------------
+	/** Set the size from which on files opened for reading are
+	 *  memory-mapped instead of being read through the C runtime.
+	 *  @param threshold Size in bytes, SIZE_MAX to never map files */
+	void SetMappingThreshold (size_t threshold) {
+		mappingThreshold = threshold;
+	}
+
+private:
+	size_t mappingThreshold;
 };
 
 } //!ns Assimp
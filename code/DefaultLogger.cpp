@@ -56,6 +56,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #	include <boost/thread/mutex.hpp>
 
 boost::mutex loggerMutex;
+
+// serializes concurrent writes to the log streams
+boost::mutex loggerWriteMutex;
 #endif
 
 namespace Assimp	{
@@ -376,6 +379,10 @@ void DefaultLogger::WriteToStreams(const char *message,
 {
 	ai_assert(NULL != message);
 
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	boost::mutex::scoped_lock lock(loggerWriteMutex);
+#endif
+
 	// Check whether this is a repeated message
 	if (! ::strncmp( message,lastMsg, lastLen-1))
 	{
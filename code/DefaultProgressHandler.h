@@ -53,8 +53,9 @@ class DefaultProgressHandler
 	: public ProgressHandler	{
 
 	
+	// never abort
 	virtual bool Update(float /*percentage*/) {
-		return false;
+		return true;
 	}
 
 
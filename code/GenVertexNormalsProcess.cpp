@@ -82,20 +82,35 @@ void GenVertexNormalsProcess::SetupProperties(const Importer* pImp)
 }
 
 // ------------------------------------------------------------------------------------------------
-// Executes the post processing step on the given imported data.
-void GenVertexNormalsProcess::Execute( aiScene* pScene)
+// Prepares the post processing step for the given imported data.
+void GenVertexNormalsProcess::BeginMeshes( aiScene* pScene)
 {
 	DefaultLogger::get()->debug("GenVertexNormalsProcess begin");
 
 	if (pScene->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT)
 		throw DeadlyImportError("Post-processing order mismatch: expecting pseudo-indexed (\"verbose\") vertices here");
 
+	results.reset(new bool[pScene->mNumMeshes]);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Executes the post processing step on a single mesh.
+void GenVertexNormalsProcess::ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex, MeshPipelineContext& context)
+{
+	results[meshIndex] = GenMeshVertexNormals(pMesh,context);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Finishes the post processing step.
+void GenVertexNormalsProcess::EndMeshes( aiScene* pScene)
+{
 	bool bHas = false;
 	for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
 	{
-		if(GenMeshVertexNormals( pScene->mMeshes[a],a))
+		if(results[a])
 			bHas = true;
 	}
+	results.reset();
 
 	if (bHas)	{
 		DefaultLogger::get()->info("GenVertexNormalsProcess finished. "
@@ -106,8 +121,16 @@ void GenVertexNormalsProcess::Execute( aiScene* pScene)
 }
 
 // ------------------------------------------------------------------------------------------------
-// Executes the post processing step on the given imported data.
+// Computes normals for a specific mesh
 bool GenVertexNormalsProcess::GenMeshVertexNormals (aiMesh* pMesh, unsigned int meshIndex)
+{
+	MeshPipelineContext context(pMesh,shared);
+	return GenMeshVertexNormals(pMesh,context);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Computes normals for a specific mesh
+bool GenVertexNormalsProcess::GenMeshVertexNormals (aiMesh* pMesh, MeshPipelineContext& context)
 {
 	if (NULL != pMesh->mNormals)
 		return false;
@@ -149,26 +172,10 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals (aiMesh* pMesh, unsigned int
 		}
 	}
 
-	// Set up a SpatialSort to quickly find all vertices close to a given position
-	// check whether we can reuse the SpatialSort of a previous step.
-	SpatialSort* vertexFinder = NULL;
-	SpatialSort  _vertexFinder;
-	float posEpsilon = 1e-5f;
-	if (shared)	{
-		std::vector<std::pair<SpatialSort,float> >* avf;
-		shared->GetProperty(AI_SPP_SPATIAL_SORT,avf);
-		if (avf)
-		{
-			std::pair<SpatialSort,float>& blubb = avf->operator [] (meshIndex);
-			vertexFinder = &blubb.first;
-			posEpsilon = blubb.second;
-		}
-	}
-	if (!vertexFinder)	{
-		_vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof( aiVector3D));
-		vertexFinder = &_vertexFinder;
-		posEpsilon = ComputePositionEpsilon(pMesh);
-	}
+	// Use a SpatialSort to quickly find all vertices close to a given position,
+	// the context reuses the one of a previous step if possible.
+	SpatialSort* const vertexFinder = &context.GetSpatialSort();
+	const float posEpsilon = context.GetPositionEpsilon();
 	std::vector<unsigned int> verticesFound;
 	aiVector3D* pcNew = new aiVector3D[pMesh->mNumVertices];
 
@@ -229,5 +236,6 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals (aiMesh* pMesh, unsigned int
 	delete[] pMesh->mNormals;
 	pMesh->mNormals = pcNew;
 
+	context.Invalidate(MeshDataCache::VertexData);
 	return true;
 }
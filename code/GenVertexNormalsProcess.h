@@ -43,7 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_GENVERTEXNORMALPROCESS_H_INC
 #define AI_GENVERTEXNORMALPROCESS_H_INC
 
-#include "BaseProcess.h"
+#include "PerMeshProcess.h"
 #include "../include/assimp/mesh.h"
 
 class GenNormalsTest;
@@ -53,7 +53,7 @@ namespace Assimp {
 // ---------------------------------------------------------------------------
 /** The GenFaceNormalsProcess computes vertex normals for all vertizes
 */
-class ASSIMP_API_WINONLY GenVertexNormalsProcess : public BaseProcess
+class ASSIMP_API_WINONLY GenVertexNormalsProcess : public PerMeshProcess
 {
 public:
 
@@ -78,11 +78,12 @@ public:
 	void SetupProperties(const Importer* pImp);
 
 	// -------------------------------------------------------------------
-	/** Executes the post processing step on the given imported data.
+	/** Parts of the post processing step, see PerMeshProcess.
 	* At the moment a process is not supposed to fail.
-	* @param pScene The imported data to work at.
 	*/
-	void Execute( aiScene* pScene);
+	void BeginMeshes( aiScene* pScene);
+	void ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex, MeshPipelineContext& context);
+	void EndMeshes( aiScene* pScene);
 
 
 	// setter for configMaxAngle
@@ -101,10 +102,21 @@ public:
 	*/
 	bool GenMeshVertexNormals (aiMesh* pcMesh, unsigned int meshIndex);
 
+	// -------------------------------------------------------------------
+	/** Computes normals for a specific mesh
+	*  @param pcMesh Mesh
+	*  @param context Provides the SpatialSort of the mesh
+	*  @return true if vertex normals have been computed
+	*/
+	bool GenMeshVertexNormals (aiMesh* pcMesh, MeshPipelineContext& context);
+
 private:
 
 	/** Configuration option: maximum smoothing angle, in radians*/
 	float configMaxAngle;
+
+	/** Return value of GenMeshVertexNormals() for each mesh */
+	boost::scoped_array<bool> results;
 };
 
 } // end of namespace Assimp
@@ -0,0 +1,486 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+
+/** @file  GzipIOWrapper.cpp
+ *  @brief Implementation of GzipIOStream and GzipIOSystem
+ */
+
+#include "AssimpPCH.h"
+#include "GzipIOWrapper.h"
+
+using namespace Assimp;
+
+namespace {
+
+// ----------------------------------------------------------------------------------
+// Deleter to close streams through the IOSystem which opened them
+struct CloseStream
+{
+	CloseStream(IOSystem* io) : io(io) {}
+
+	void operator() (IOStream* stream) const {
+		io->Close(stream);
+	}
+
+	IOSystem* io;
+};
+
+// ----------------------------------------------------------------------------------
+bool HasGzipSuffix(const std::string& file)
+{
+	return file.length() > 3 && !ASSIMP_stricmp(file.substr(file.length()-3),".gz");
+}
+
+} // ! anon namespace
+
+// ----------------------------------------------------------------------------------
+GzipIOStream::GzipIOStream(boost::shared_ptr<IOStream> source, boost::shared_ptr< std::vector<uint8_t> > shared)
+	: source(source)
+	, data(shared ? shared : boost::shared_ptr< std::vector<uint8_t> >(new std::vector<uint8_t>()))
+	, windowBegin()
+	, windowSize()
+	, pos()
+	, length()
+	, sizeKnown()
+	, buffered()
+	, finished()
+	, failed()
+{
+	ai_assert(source);
+
+	zstream.zalloc = Z_NULL;
+	zstream.zfree = Z_NULL;
+	zstream.opaque = Z_NULL;
+	zstream.next_in = Z_NULL;
+	zstream.avail_in = 0;
+
+	// adding 32 to the window bits lets zlib detect gzip and zlib headers 
+	if (Z_OK != ::inflateInit2(&zstream,32+MAX_WBITS)) {
+		DefaultLogger::get()->error("GZIP: Failed to initialize zlib");
+		sizeKnown = finished = failed = true;
+		return;
+	}
+
+	// another stream has already decompressed the file
+	if (!data->empty()) {
+		length = data->size();
+		sizeKnown = buffered = finished = true;
+		return;
+	}
+	input.resize(AI_GZIPIOSTREAM_BUFFER_SIZE);
+	window.resize(AI_GZIPIOSTREAM_BUFFER_SIZE);
+}
+
+// ----------------------------------------------------------------------------------
+void GzipIOStream::DetermineSize()
+{
+	sizeKnown = true;
+
+	// another stream may have decompressed the file in the meantime
+	if (!data->empty()) {
+		length = data->size();
+		buffered = finished = true;
+		return;
+	}
+
+	// gzip stores the decompressed size in the last four bytes of the file,
+	// zlib doesn't. The size stored is modulo 2^32 and covers only the last 
+	// member of the file, so it is only used if deflate (about 1:1032 at 
+	// best) can't possibly exceed 4 GB and if there is no second member.
+	const size_t compressed = source->FileSize(), at = source->Tell();
+	if (compressed >= 18 && static_cast<uint64_t>(compressed) * 1032 < (static_cast<uint64_t>(1) << 32) && 
+		AI_SUCCESS == source->Seek(0,aiOrigin_SET) && IsGzip(source.get()) && !MayHaveSeveralMembers() && 
+		AI_SUCCESS == source->Seek(compressed-4,aiOrigin_SET)) {
+
+		uint8_t trailer[4];
+		if (1 == source->Read(trailer,4,1)) {
+			length = trailer[0] | (trailer[1] << 8) | (trailer[2] << 16) | (static_cast<size_t>(trailer[3]) << 24);
+		}
+	}
+	source->Seek(at,aiOrigin_SET);
+	if (length && length / 1032 <= compressed) {
+		return;
+	}
+
+	// the data needs to be decompressed to determine its size - keep it then
+	InflateAll();
+}
+
+// ----------------------------------------------------------------------------------
+void GzipIOStream::InflateAll()
+{
+	Restart();
+
+	std::vector<uint8_t>& out = *data;
+	out.clear();
+	while (Inflate()) {
+		out.insert(out.end(),window.begin(),window.begin()+windowSize);
+	}
+	length = out.size();
+	buffered = true;
+
+	// all further reads are served from the buffer
+	std::vector<uint8_t>().swap(window);
+	std::vector<uint8_t>().swap(input);
+	source.reset();
+}
+
+// ----------------------------------------------------------------------------------
+GzipIOStream::~GzipIOStream()
+{
+	::inflateEnd(&zstream);
+}
+
+// ----------------------------------------------------------------------------------
+bool GzipIOStream::IsGzip(IOStream* stream)
+{
+	const size_t at = stream->Tell();
+
+	uint8_t magic[2];
+	const bool gzip = 1 == stream->Read(magic,2,1) && magic[0] == 0x1f && magic[1] == 0x8b;
+
+	stream->Seek(at,aiOrigin_SET);
+	return gzip;
+}
+
+// ----------------------------------------------------------------------------------
+bool GzipIOStream::MayHaveSeveralMembers()
+{
+	// every member starts with the gzip magic number and the deflate method,
+	// look for this sequence anywhere but at the start of the file
+	bool found = false;
+	size_t keep = 0;
+
+	// the input buffer may be in use by inflate(), scan in a separate one
+	std::vector<uint8_t> input(AI_GZIPIOSTREAM_BUFFER_SIZE);
+	const size_t at = source->Tell();
+
+	source->Seek(1,aiOrigin_SET);
+	for (size_t got; !found && (got = source->Read(&input[keep],1,input.size()-keep)) != 0;) {
+		const size_t end = keep+got;
+		for (size_t i = 0; i+2 < end; ++i) {
+			if (input[i] == 0x1f && input[i+1] == 0x8b && input[i+2] == 8) {
+				found = true;
+				break;
+			}
+		}
+
+		// the sequence may cross the border between two chunks
+		keep = std::min(end,static_cast<size_t>(2));
+		::memmove(&input[0],&input[end-keep],keep);
+	}
+	source->Seek(at,aiOrigin_SET);
+	return found;
+}
+
+// ----------------------------------------------------------------------------------
+bool GzipIOStream::NextMember()
+{
+	if (!zstream.avail_in) {
+		const size_t got = source->Read(&input[0],1,input.size());
+		if (!got) {
+			return false;
+		}
+		zstream.next_in = &input[0];
+		zstream.avail_in = static_cast<uInt>(got);
+	}
+
+	// anything but another gzip member is trailing garbage
+	if (0x1f != *zstream.next_in) {
+		DefaultLogger::get()->warn("GZIP: Ignoring trailing data after the compressed stream");
+		return false;
+	}
+	return Z_OK == ::inflateReset(&zstream);
+}
+
+// ----------------------------------------------------------------------------------
+bool GzipIOStream::Inflate()
+{
+	if (finished) {
+		return false;
+	}
+
+	windowBegin += windowSize;
+	windowSize = 0;
+
+	while (windowSize < window.size()) {
+		if (!zstream.avail_in) {
+			const size_t got = source->Read(&input[0],1,input.size());
+			if (!got) {
+				DefaultLogger::get()->error("GZIP: Unexpected end of compressed data");
+				finished = failed = true;
+				break;
+			}
+			zstream.next_in = &input[0];
+			zstream.avail_in = static_cast<uInt>(got);
+		}
+
+		zstream.next_out = &window[windowSize];
+		zstream.avail_out = static_cast<uInt>(window.size()-windowSize);
+
+		const int ret = ::inflate(&zstream,Z_NO_FLUSH);
+		windowSize = window.size()-zstream.avail_out;
+
+		if (Z_STREAM_END == ret) {
+			// gzip files may consist of several members, which are concatenated
+			if (!NextMember()) {
+				finished = true;
+				break;
+			}
+			continue;
+		}
+		if (Z_OK != ret) {
+			DefaultLogger::get()->error(std::string("GZIP: Failed to decompress data: ") + 
+				(zstream.msg ? zstream.msg : "unknown error"));
+			finished = failed = true;
+			break;
+		}
+	}
+	return windowSize > 0;
+}
+
+// ----------------------------------------------------------------------------------
+void GzipIOStream::Restart()
+{
+	::inflateReset(&zstream);
+	source->Seek(0,aiOrigin_SET);
+
+	zstream.next_in = Z_NULL;
+	zstream.avail_in = 0;
+
+	windowBegin = windowSize = 0;
+	finished = false;
+}
+
+// ----------------------------------------------------------------------------------
+size_t GzipIOStream::Read(void* pvBuffer, size_t pSize, size_t pCount)
+{
+	if (!pSize || (sizeKnown && pos >= length)) {
+		return 0;
+	}
+	const size_t want = sizeKnown ? std::min(pSize*pCount,length-pos) : pSize*pCount;
+
+	uint8_t* out = static_cast<uint8_t*>(pvBuffer);
+	size_t got = 0;
+	if (buffered) {
+		got = want;
+		memcpy(out,&(*data)[pos],got);
+	}
+
+	// everything before the window is gone, start over
+	else if (pos < windowBegin) {
+		Restart();
+	}
+
+	while (got < want) {
+		const size_t at = pos+got, windowEnd = windowBegin+windowSize;
+		if (at >= windowEnd) {
+			if (!Inflate()) {
+				break;
+			}
+			continue;
+		}
+
+		const size_t n = std::min(want-got,windowEnd-at);
+		memcpy(out+got,&window[at-windowBegin],n);
+		got += n;
+	}
+
+	// only whole elements count, just like fread() does
+	const size_t cnt = got/pSize;
+	pos += cnt*pSize;
+	return cnt;
+}
+
+// ----------------------------------------------------------------------------------
+size_t GzipIOStream::Write(const void* /*pvBuffer*/, size_t /*pSize*/, size_t /*pCount*/)
+{
+	return 0;
+}
+
+// ----------------------------------------------------------------------------------
+aiReturn GzipIOStream::Seek(size_t pOffset, aiOrigin pOrigin)
+{
+	size_t target;
+	if (aiOrigin_SET == pOrigin) {
+		target = pOffset;
+	}
+	else if (aiOrigin_END == pOrigin) {
+		if (pOffset > FileSize()) {
+			return AI_FAILURE;
+		}
+		target = length-pOffset;
+	}
+	else {
+		if (pOffset > SIZE_MAX-pos) {
+			return AI_FAILURE;
+		}
+		target = pos+pOffset;
+	}
+
+	// data decompressed so far is known to exist, beyond it the size is needed
+	if (target > (buffered ? length : windowBegin+windowSize) && target > FileSize()) {
+		return AI_FAILURE;
+	}
+
+	// the data is decompressed lazily by the next Read()
+	pos = target;
+	return AI_SUCCESS;
+}
+
+// ----------------------------------------------------------------------------------
+size_t GzipIOStream::Tell() const
+{
+	return pos;
+}
+
+// ----------------------------------------------------------------------------------
+size_t GzipIOStream::FileSize() const
+{
+	// determined on first use, so opening the file stays cheap
+	if (!sizeKnown) {
+		const_cast<GzipIOStream*>(this)->DetermineSize();
+	}
+	return length;
+}
+
+// ----------------------------------------------------------------------------------
+void GzipIOStream::Flush()
+{
+}
+
+// ----------------------------------------------------------------------------------
+const void* GzipIOStream::GetView() const
+{
+	return buffered && length ? &(*data)[0] : NULL;
+}
+
+// ----------------------------------------------------------------------------------
+GzipIOSystem::GzipIOSystem(IOSystem* io, const std::string& file)
+	: io(io)
+	, file(file)
+	, name(HasGzipSuffix(file) ? file.substr(0,file.length()-3) : file)
+	, data(new std::vector<uint8_t>())
+{
+	ai_assert(NULL != io);
+}
+
+// ----------------------------------------------------------------------------------
+GzipIOSystem::~GzipIOSystem()
+{
+}
+
+// ----------------------------------------------------------------------------------
+bool GzipIOSystem::IsCompressed(IOSystem* io, const std::string& file)
+{
+	if (HasGzipSuffix(file)) {
+		return true;
+	}
+
+	IOStream* stream = io->Open(file.c_str(),"rb");
+	if (!stream) {
+		return false;
+	}
+	const bool gzip = GzipIOStream::IsGzip(stream);
+	io->Close(stream);
+	return gzip;
+}
+
+// ----------------------------------------------------------------------------------
+bool GzipIOSystem::Exists( const char* pFile) const
+{
+	if (name == pFile) {
+		return io->Exists(file.c_str());
+	}
+	return io->Exists(pFile) || io->Exists((std::string(pFile)+".gz").c_str());
+}
+
+// ----------------------------------------------------------------------------------
+char GzipIOSystem::getOsSeparator() const
+{
+	return io->getOsSeparator();
+}
+
+// ----------------------------------------------------------------------------------
+IOStream* GzipIOSystem::Open( const char* pFile, const char* pMode)
+{
+	if (strchr(pMode,'w') || strchr(pMode,'a') || strchr(pMode,'+')) {
+		return io->Open(pFile,pMode);
+	}
+
+	IOStream* stream;
+	if (name == pFile) {
+		stream = io->Open(file.c_str(),"rb");
+		if (stream) {
+			return new GzipIOStream(boost::shared_ptr<IOStream>(stream,CloseStream(io)),data);
+		}
+	}
+	else {
+		// fall back to a compressed copy only if the file itself is missing
+		stream = io->Open(pFile,pMode);
+		if (stream) {
+			return stream;
+		}
+		stream = io->Open((std::string(pFile)+".gz").c_str(),"rb");
+	}
+
+	if (!stream) {
+		return NULL;
+	}
+	return new GzipIOStream(boost::shared_ptr<IOStream>(stream,CloseStream(io)));
+}
+
+// ----------------------------------------------------------------------------------
+void GzipIOSystem::Close( IOStream* pFile)
+{
+	if (dynamic_cast<GzipIOStream*>(pFile)) {
+		delete pFile;
+		return;
+	}
+	io->Close(pFile);
+}
+
+// ----------------------------------------------------------------------------------
+bool GzipIOSystem::ComparePaths (const char* one, const char* second) const
+{
+	return io->ComparePaths(one,second);
+}
@@ -0,0 +1,255 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+
+/** @file  GzipIOWrapper.h
+ *  @brief Transparent decompression of gzip-compressed input files
+ */
+#ifndef AI_GZIPIOWRAPPER_H_INC
+#define AI_GZIPIOWRAPPER_H_INC
+
+#include "../include/assimp/IOStream.hpp"
+#include "../include/assimp/IOSystem.hpp"
+
+#ifdef ASSIMP_BUILD_NO_OWN_ZLIB
+#	include <zlib.h>
+#else
+#	include "../contrib/zlib/zlib.h"
+#endif
+
+namespace Assimp	{
+
+/** Number of decompressed bytes kept in memory by a GzipIOStream. Seeking
+ *  backwards within this window is free, everything before it requires 
+ *  the stream to be decompressed again from the start. */
+#define AI_GZIPIOSTREAM_BUFFER_SIZE 65536
+
+// ----------------------------------------------------------------------------------
+/** Read-only stream which inflates a gzip (or zlib) compressed stream in 
+ *  chunks as it is read. Only a small window of decompressed data is kept
+ *  in memory, so loaders which read sequentially never hold the whole 
+ *  decompressed file. Seeking forward decompresses and discards the data 
+ *  skipped, seeking backwards beyond the window restarts decompression. 
+ *  gzip files consisting of several members are read as a whole. 
+ *
+ *  The decompressed size is determined on the first call to FileSize() 
+ *  or the first seek beyond the data decompressed so far. gzip files store
+ *  it in their trailer. If it can't be trusted (zlib data, files which may
+ *  consist of several members or exceed 4 GB once decompressed), the whole
+ *  stream is decompressed into memory at this point and served from there,
+ *  including a view (GetView()) of it, so it is never decompressed twice.
+ *
+ *  Decompression errors are logged and end the stream early, which loaders
+ *  treat just like a truncated file. Callers which need to tell both 
+ *  apart can check Failed(). */
+class GzipIOStream : public IOStream
+{
+public:
+	/** Construct from the compressed stream, which must be positioned 
+	 *  at its start. The stream is deleted along with this stream. 
+	 *  @param shared Buffer for the decompressed data, shared by all 
+	 *    streams for the same file. Once one of them had to decompress 
+	 *    the file as a whole, the others are served from it as well. */
+	explicit GzipIOStream (boost::shared_ptr<IOStream> source,
+		boost::shared_ptr< std::vector<uint8_t> > shared = boost::shared_ptr< std::vector<uint8_t> >());
+
+	/** Destructor public to allow simple deletion to close the file. */
+	~GzipIOStream ();
+
+	// -------------------------------------------------------------------
+	/** Check the first bytes of a stream for the gzip magic number. 
+	 *  The stream position is not changed. */
+	static bool IsGzip(IOStream* stream);
+
+	// -------------------------------------------------------------------
+	/** Check whether decompression has failed so far because the data
+	 *  is corrupt or truncated. */
+	bool Failed() const {
+		return failed;
+	}
+
+public:
+
+	// -------------------------------------------------------------------
+	// Read from stream
+	size_t Read(void* pvBuffer, 
+		size_t pSize, 
+		size_t pCount);
+
+	// -------------------------------------------------------------------
+	// Write to stream - not supported
+	size_t Write(const void* pvBuffer, 
+		size_t pSize,
+		size_t pCount);
+
+	// -------------------------------------------------------------------
+	// Seek specific position
+	aiReturn Seek(size_t pOffset,
+		aiOrigin pOrigin);
+
+	// -------------------------------------------------------------------
+	// Get current seek position
+	size_t Tell() const;
+
+	// -------------------------------------------------------------------
+	// Get size of the decompressed file
+	size_t FileSize() const;
+
+	// -------------------------------------------------------------------
+	// Flush file contents - nothing to do
+	void Flush();
+
+	// -------------------------------------------------------------------
+	// Get the decompressed data if it has been buffered as a whole
+	const void* GetView() const;
+
+private:
+
+	// -------------------------------------------------------------------
+	/** Determine the decompressed size, either from the gzip trailer or
+	 *  by decompressing the whole stream with InflateAll(). */
+	void DetermineSize();
+
+	// -------------------------------------------------------------------
+	/** Decompress the whole stream into the shared buffer, which serves
+	 *  all reads from then on. */
+	void InflateAll();
+
+	// -------------------------------------------------------------------
+	/** Decompress the block following the current window into the window.
+	 *  @return false if there is no more data. */
+	bool Inflate();
+
+	// -------------------------------------------------------------------
+	/** Start decompression over from the beginning of the source. */
+	void Restart();
+
+	// -------------------------------------------------------------------
+	/** Prepare to decompress the next member of a gzip file once the
+	 *  current one has ended.
+	 *  @return false if there is no further member. */
+	bool NextMember();
+
+	// -------------------------------------------------------------------
+	/** Scan the source for the start of a second gzip member. This may 
+	 *  give false positives, but never false negatives. The position in
+	 *  the source is not changed. */
+	bool MayHaveSeveralMembers();
+
+private:
+	boost::shared_ptr<IOStream> source;
+	z_stream zstream;
+
+	std::vector<uint8_t> input, window;
+	boost::shared_ptr< std::vector<uint8_t> > data;
+
+	// decompressed offset of the window, bytes used in it
+	size_t windowBegin, windowSize;
+	size_t pos, length;
+	bool sizeKnown, buffered;
+	bool finished, failed;
+};
+
+// ---------------------------------------------------------------------------
+/** Wraps another IOSystem and serves a gzip-compressed file under its 
+ *  uncompressed name, i.e. without the '.gz' suffix, decompressing it on 
+ *  the fly. If the file needs to be decompressed as a whole, it is kept 
+ *  in memory for the lifetime of the IOSystem and served to all streams 
+ *  opened for it. Loaders thus see the file just like an uncompressed one. All 
+ *  other files are passed through to the wrapped IOSystem. If one of them
+ *  doesn't exist but a gzip-compressed copy of it does ('name.gz'), that 
+ *  copy is served instead, so materials and other files referenced by
+ *  compressed models may be stored compressed as well. */
+class GzipIOSystem : public IOSystem
+{
+public:
+	/** Constructor.
+	 *  @param io IOSystem to read the compressed file from
+	 *  @param file Path to the compressed file */
+	GzipIOSystem (IOSystem* io, const std::string& file);
+
+	/** Destructor. */
+	~GzipIOSystem();
+
+	// -------------------------------------------------------------------
+	/** Check whether a file is gzip-compressed, either by its '.gz' 
+	 *  suffix or by the gzip magic number at its start. */
+	static bool IsCompressed(IOSystem* io, const std::string& file);
+
+	// -------------------------------------------------------------------
+	/** Get the name under which the decompressed file is served. */
+	const std::string& GetName() const {
+		return name;
+	}
+
+public:
+
+	// -------------------------------------------------------------------
+	/** Tests for the existence of a file at the given path. */
+	bool Exists( const char* pFile) const;
+
+	// -------------------------------------------------------------------
+	/** Returns the directory separator. */
+	char getOsSeparator() const;
+
+	// -------------------------------------------------------------------
+	/** Open a new file with a given path. */
+	IOStream* Open( const char* pFile, const char* pMode = "rb");
+
+	// -------------------------------------------------------------------
+	/** Closes the given file and releases all resources associated with it. */
+	void Close( IOStream* pFile);
+
+	// -------------------------------------------------------------------
+	/** Compare two paths */
+	bool ComparePaths (const char* one, const char* second) const;
+
+private:
+	IOSystem* io;
+	std::string file, name;
+
+	// the compressed file, once decompressed as a whole
+	boost::shared_ptr< std::vector<uint8_t> > data;
+};
+
+} // ns assimp
+
+#endif //!!AI_GZIPIOWRAPPER_H_INC
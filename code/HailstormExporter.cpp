@@ -60,14 +60,13 @@ void ExportSceneHailstorm( const char* pFile,
                            IOSystem* pIOSystem,
                            const aiScene* pScene )
 {
-	// invoke the exporter 
-	HailstormExporter iDoTheExportThing( pScene);
-
-	// we're still here - export successfully completed. Write result to the given IOSYstem
 	boost::scoped_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
+	if(!outfile) {
+		throw DeadlyExportError("could not open output .model file: " + std::string(pFile));
+	}
 
-	// XXX maybe use a small wrapper around IOStream that behaves like std::stringstream in order to avoid the extra copy.
-	outfile->Write( iDoTheExportThing.mOutput.str().c_str(), static_cast<size_t>(iDoTheExportThing.mOutput.tellp()),1);
+	// invoke the exporter, it writes straight to the given IOSystem
+	HailstormExporter iDoTheExportThing( pScene, outfile.get());
 }
 
 } // end of namespace Assimp
@@ -75,11 +74,9 @@ void ExportSceneHailstorm( const char* pFile,
 
 // ------------------------------------------------------------------------------------------------
 // Constructor for a specific scene to export
-HailstormExporter::HailstormExporter( const aiScene* pScene)
+HailstormExporter::HailstormExporter( const aiScene* pScene, IOStream* pOutfile)
+: mOutput( pOutfile)
 {
-	// make sure that all formatting happens using the standard, C locale and not the user's current locale
-	mOutput.imbue( std::locale("C") );
-
 	mScene = pScene;
 
 	// set up strings
@@ -87,6 +84,7 @@ HailstormExporter::HailstormExporter( const aiScene* pScene)
 
 	// start writing
 	WriteFile();
+	mOutput.Flush();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -170,7 +168,7 @@ void HailstormExporter::WriteShadingParam( const Surface& surface,
 
     if ( surface.texture.empty() )
     {
-        mOutput << Write( surface.color );
+        Write( surface.color );
     }
     else
     {
@@ -402,33 +400,33 @@ void HailstormExporter::WriteGeometry( size_t meshIndex )
         mOutput << "<v ";
 
         // Write position
-        mOutput << Write( pMesh->mVertices[i] );
+        Write( pMesh->mVertices[i] );
 
         // Write normals, if we have them
         if ( pMesh->HasNormals() )
         {
-            mOutput << Write( pMesh->mNormals[i], "n" );
+            Write( pMesh->mNormals[i], "n" );
         }
 
         // Write tangent info
         if ( pMesh->HasTangentsAndBitangents() )
         {
-            mOutput << Write( pMesh->mBitangents[i], "b" )
-                    << Write( pMesh->mTangents[i], "t" );
+            Write( pMesh->mBitangents[i], "b" );
+            Write( pMesh->mTangents[i], "t" );
         }
 
         // Write texture coordinates
         for ( size_t j = 0; j < pMesh->GetNumUVChannels(); ++j )
         {
             assert( pMesh->HasTextureCoords( j ) );
-            mOutput << WriteUV( pMesh->mTextureCoords[j][i], j );
+            WriteUV( pMesh->mTextureCoords[j][i], static_cast<unsigned int>( j ) );
             
         }
 
         // Write vertex color
         if ( pMesh->HasVertexColors( 0 ) )
         {
-            mOutput << Write( pMesh->mColors[0][i] );
+            Write( pMesh->mColors[0][i] );
         }
 
         // Wrap it up
@@ -506,17 +504,17 @@ void HailstormExporter::WriteNode( const aiNode* pNode )
         aiQuaternion rotation;
         mat.Decompose( scale, rotation, translation );
 
-        mOutput << startstr
-                << "<scale " << Write( scale ) << "/>"
-                << endstr;
+        mOutput << startstr << "<scale ";
+        Write( scale );
+        mOutput << "/>" << endstr;
 
-        mOutput << startstr
-                << "<translation " << Write( translation ) << "/>"
-                << endstr;
+        mOutput << startstr << "<translation ";
+        Write( translation );
+        mOutput << "/>" << endstr;
 
-        mOutput << startstr
-                << "<rotation " << Write( rotation ) << "/>"
-                << endstr;
+        mOutput << startstr << "<rotation ";
+        Write( rotation );
+        mOutput << "/>" << endstr;
     }
 
 	// instance every geometry
@@ -584,97 +582,76 @@ std::string HailstormExporter::GetShadingName( aiShadingMode shadingMode ) const
 }
 
 /**
- * Returns a Vec3 suitable for export
+ * Writes a Vec3 suitable for export
  */
-std::string HailstormExporter::Write( const aiVector3D& vec,
-                                      const std::string& prefix ) const
+void HailstormExporter::Write( const aiVector3D& vec,
+                               const std::string& prefix )
 {
-    std::ostringstream ss;
-
-    ss << prefix << "x=\"" << vec[0] << "\" "
-       << prefix << "y=\"" << vec[1] << "\" "
-       << prefix << "z=\"" << vec[2] << "\" ";
-
-    return ss.str();
+    mOutput << prefix << "x=\"" << vec[0] << "\" "
+            << prefix << "y=\"" << vec[1] << "\" "
+            << prefix << "z=\"" << vec[2] << "\" ";
 }
 
 /**
- * Returns a Matrix4x4 suitable for export
+ * Writes a Matrix4x4 suitable for export
  */
-std::string HailstormExporter::Write( const aiQuaternion& quat,
-                                      const std::string& prefix ) const
+void HailstormExporter::Write( const aiQuaternion& quat,
+                               const std::string& prefix )
 {
-    std::ostringstream ss;
-
-    ss << prefix << "w=\"" << quat.w << "\" "
-       << prefix << "x=\"" << quat.x << "\" "
-       << prefix << "y=\"" << quat.y << "\" "
-       << prefix << "z=\"" << quat.z << "\" ";
-
-    return ss.str();
+    mOutput << prefix << "w=\"" << quat.w << "\" "
+            << prefix << "x=\"" << quat.x << "\" "
+            << prefix << "y=\"" << quat.y << "\" "
+            << prefix << "z=\"" << quat.z << "\" ";
 }
 
 /**
- * Returns a Matrix4x4 suitable for export
+ * Writes a Matrix4x4 suitable for export
  */
-std::string HailstormExporter::Write( const aiMatrix4x4& mat,
-                                      const std::string& prefix ) const
+void HailstormExporter::Write( const aiMatrix4x4& mat,
+                               const std::string& prefix )
 {
-    std::ostringstream ss;
-
-    ss << prefix << "m00=\"" << mat.a1 << "\" "
-       << prefix << "m01=\"" << mat.a2 << "\" "
-       << prefix << "m02=\"" << mat.a3 << "\" "
-       << prefix << "m03=\"" << mat.a4 << "\" "
-       << prefix << "m10=\"" << mat.b1 << "\" "
-       << prefix << "m11=\"" << mat.b2 << "\" "
-       << prefix << "m12=\"" << mat.b3 << "\" "
-       << prefix << "m13=\"" << mat.b4 << "\" "
-       << prefix << "m20=\"" << mat.c1 << "\" "
-       << prefix << "m21=\"" << mat.c2 << "\" "
-       << prefix << "m22=\"" << mat.c3 << "\" "
-       << prefix << "m23=\"" << mat.c4 << "\" "
-       << prefix << "m30=\"" << mat.d1 << "\" "
-       << prefix << "m31=\"" << mat.d2 << "\" "
-       << prefix << "m32=\"" << mat.d3 << "\" "
-       << prefix << "m33=\"" << mat.d4 << "\" ";
-
-    return ss.str();
+    mOutput << prefix << "m00=\"" << mat.a1 << "\" "
+            << prefix << "m01=\"" << mat.a2 << "\" "
+            << prefix << "m02=\"" << mat.a3 << "\" "
+            << prefix << "m03=\"" << mat.a4 << "\" "
+            << prefix << "m10=\"" << mat.b1 << "\" "
+            << prefix << "m11=\"" << mat.b2 << "\" "
+            << prefix << "m12=\"" << mat.b3 << "\" "
+            << prefix << "m13=\"" << mat.b4 << "\" "
+            << prefix << "m20=\"" << mat.c1 << "\" "
+            << prefix << "m21=\"" << mat.c2 << "\" "
+            << prefix << "m22=\"" << mat.c3 << "\" "
+            << prefix << "m23=\"" << mat.c4 << "\" "
+            << prefix << "m30=\"" << mat.d1 << "\" "
+            << prefix << "m31=\"" << mat.d2 << "\" "
+            << prefix << "m32=\"" << mat.d3 << "\" "
+            << prefix << "m33=\"" << mat.d4 << "\" ";
 }
 
 /**
- * Returns a Color4 suitable for export
+ * Writes a Color4 suitable for export
  */
-std::string HailstormExporter::Write( const aiColor4D& c,
-                                      const std::string& prefix ) const
+void HailstormExporter::Write( const aiColor4D& c,
+                               const std::string& prefix )
 {
-    std::ostringstream ss;
-
-    ss << prefix << "r=\"" << c.r << "\" "
-       << prefix << "g=\"" << c.g << "\" "
-       << prefix << "b=\"" << c.b << "\" ";
+    mOutput << prefix << "r=\"" << c.r << "\" "
+            << prefix << "g=\"" << c.g << "\" "
+            << prefix << "b=\"" << c.b << "\" ";
 
     if ( c.a < 1.0f )
     {
-        ss << prefix << "a=\"" << c.a << "\" ";
+        mOutput << prefix << "a=\"" << c.a << "\" ";
     }
-
-    return ss.str();
 }
 
 /**
- * Returns a texture coordinate suitable for export
+ * Writes a texture coordinate suitable for export
  */
-std::string HailstormExporter::WriteUV ( const aiVector3D& v,
-                                         unsigned int index ) const
+void HailstormExporter::WriteUV ( const aiVector3D& v,
+                                  unsigned int index )
 {
-    std::ostringstream ss;
-
-    ss << "u" << boost::lexical_cast<std::string>( index )
-              << "=\"" << v[0] << "\" "
-       << "v" << boost::lexical_cast<std::string>( index )
-              << "=\"" << v[1] << "\" ";
-    return ss.str();
+    mOutput << "u" << index << "=\"" << v[0] << "\" "
+            << "v" << index << "=\"" << v[1] << "\" ";
 }
 
 #endif
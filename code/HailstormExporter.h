@@ -50,7 +50,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "../include/assimp/assert.h"
 #include "../include/assimp/material.h"
-#include <sstream>
+#include "TextWriter.h"
 
 struct aiScene;
 struct aiNode;
@@ -63,7 +63,7 @@ class HailstormExporter
 {
 public:
 	/// Constructor for a specific scene to export
-	HailstormExporter( const aiScene* pScene);
+	HailstormExporter( const aiScene* pScene, IOStream* pOutfile);
 
 protected:
 	/// Starts writing the contents
@@ -98,11 +98,10 @@ protected:
 	/// Creates a mesh ID for the given mesh
 	std::string GetMeshId( size_t pIndex) const { return std::string( "meshId" ) + boost::lexical_cast<std::string> (pIndex); }
 
-public:
-	/// Stringstream to write all output into
-	std::stringstream mOutput;
-
 protected:
+	/// Buffered writer to send all output through
+	TextWriter mOutput;
+
 	/// The scene to be written
 	const aiScene* mScene;
 
@@ -147,11 +146,11 @@ protected:
                           const std::string& matName );
 
   std::string GetShadingName( aiShadingMode shadingMode ) const;
-  std::string Write( const aiVector3D& vec, const std::string& prefix="" ) const;
-  std::string Write( const aiQuaternion& q, const std::string& prefix="" ) const;
-  std::string Write( const aiMatrix4x4& m,  const std::string& prefix="" ) const;
-  std::string Write( const aiColor4D& c,    const std::string& prefix="" ) const;
-  std::string WriteUV( const aiVector3D& v, unsigned int index ) const;
+  void Write( const aiVector3D& vec, const std::string& prefix="" );
+  void Write( const aiQuaternion& q, const std::string& prefix="" );
+  void Write( const aiMatrix4x4& m,  const std::string& prefix="" );
+  void Write( const aiColor4D& c,    const std::string& prefix="" );
+  void WriteUV( const aiVector3D& v, unsigned int index );
 };
 
 }
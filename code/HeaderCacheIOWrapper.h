@@ -0,0 +1,259 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file HeaderCacheIOWrapper.h
+ *  IOSystem wrapper used during file format detection. The first few 
+ *  kilobytes of the file to be loaded are read once and served from
+ *  memory to all CanRead() checks of all importers. */
+#ifndef AI_HEADERCACHEIOWRAPPER_H_INC
+#define AI_HEADERCACHEIOWRAPPER_H_INC
+
+namespace Assimp	{
+
+/** Number of bytes to be cached from the start of a file. This covers
+ *  the token and magic checks of all importers we have. */
+#define AI_HEADERCACHE_SIZE 4096
+
+class HeaderCacheIOSystem;
+
+// ----------------------------------------------------------------------------------
+/** Stream returned by HeaderCacheIOSystem for the cached file. Reads within
+ *  the cached header are served from memory, everything beyond is forwarded
+ *  to the real stream, which is opened only once by the owning IOSystem. */
+// ----------------------------------------------------------------------------------
+class HeaderCacheIOStream : public IOStream
+{
+public:
+	HeaderCacheIOStream (const std::vector<uint8_t>& header, IOStream* source, size_t len) 
+		: header (header), source(source), length(len), pos((size_t)0) {
+	}
+
+public:
+	~HeaderCacheIOStream ()	{
+	}
+
+	// -------------------------------------------------------------------
+	// Read from stream
+	size_t Read(void* pvBuffer, size_t pSize, size_t pCount)	{
+		if (!pSize || pos >= length) {
+			return 0;
+		}
+		const size_t want = std::min(pSize*pCount,length-pos);
+		size_t got = 0;
+
+		uint8_t* out = static_cast<uint8_t*>(pvBuffer);
+		if (pos < header.size()) {
+			got = std::min(want,header.size()-pos);
+			memcpy(out,&header[pos],got);
+		}
+		if (got < want && source && AI_SUCCESS == source->Seek(pos+got,aiOrigin_SET)) {
+			got += source->Read(out+got,1,want-got);
+		}
+
+		// only whole elements count, just like fread() does
+		const size_t cnt = got/pSize;
+		pos += cnt*pSize;
+		return cnt;
+	}
+
+	// -------------------------------------------------------------------
+	// Write to stream
+	size_t Write(const void* /*pvBuffer*/, size_t /*pSize*/,size_t /*pCount*/)	{
+		ai_assert(false); // won't be needed
+		return 0;
+	}
+
+	// -------------------------------------------------------------------
+	// Seek specific position
+	aiReturn Seek(size_t pOffset, aiOrigin pOrigin) {
+		if (aiOrigin_SET == pOrigin) {
+			if (pOffset > length) {
+				return AI_FAILURE;
+			}
+			pos = pOffset;
+		}
+		else if (aiOrigin_END == pOrigin) {
+			if (pOffset > length) {
+				return AI_FAILURE;
+			}
+			pos = length-pOffset;
+		}
+		else {
+			if (pOffset+pos > length) {
+				return AI_FAILURE;
+			}
+			pos += pOffset;
+		}
+		return AI_SUCCESS;
+	}
+
+	// -------------------------------------------------------------------
+	// Get current seek position
+	size_t Tell() const {
+		return pos;
+	}
+
+	// -------------------------------------------------------------------
+	// Get size of file
+	size_t FileSize() const {
+		return length;
+	}
+
+	// -------------------------------------------------------------------
+	// Flush file contents
+	void Flush() {
+		ai_assert(false); // won't be needed
+	}
+
+	// -------------------------------------------------------------------
+	// Get the view of the real stream, if it has one
+	const void* GetView() const {
+		return source ? source->GetView() : NULL;
+	}
+
+private:
+	const std::vector<uint8_t>& header;
+	IOStream* source;
+	size_t length,pos;
+};
+
+// ---------------------------------------------------------------------------
+/** Wraps another IOSystem and caches the header of a single file. All other
+ *  files are passed through to the wrapped IOSystem. The cached file is 
+ *  opened at most once, no matter how many importers look at it. */
+class HeaderCacheIOSystem : public IOSystem
+{
+public:
+	/** Constructor. */
+	HeaderCacheIOSystem (IOSystem* io, const std::string& file, size_t cacheSize = AI_HEADERCACHE_SIZE) 
+		: io (io), file (file), cacheSize(cacheSize), source(), length(), loaded(false), opened(false) {
+		ai_assert(NULL != io);
+	}
+
+	/** Destructor. */
+	~HeaderCacheIOSystem() {
+		if (source) {
+			io->Close(source);
+		}
+	}
+
+	// -------------------------------------------------------------------
+	/** Tests for the existence of a file at the given path. */
+	bool Exists( const char* pFile) const {
+		return io->Exists(pFile);
+	}
+
+	// -------------------------------------------------------------------
+	/** Returns the directory separator. */
+	char getOsSeparator() const {
+		return io->getOsSeparator();
+	}
+
+	// -------------------------------------------------------------------
+	/** Open a new file with a given path. */
+	IOStream* Open( const char* pFile, const char* pMode = "rb") {
+		if (file != pFile || strchr(pMode,'w') || strchr(pMode,'a') || strchr(pMode,'+')) {
+			return io->Open(pFile,pMode);
+		}
+		if (!Load()) {
+			return NULL;
+		}
+		return new HeaderCacheIOStream(header,source,length);
+	}
+
+	// -------------------------------------------------------------------
+	/** Closes the given file and releases all resources associated with it. */
+	void Close( IOStream* pFile) {
+		if (dynamic_cast<HeaderCacheIOStream*>(pFile)) {
+			delete pFile;
+			return;
+		}
+		io->Close(pFile);
+	}
+
+	// -------------------------------------------------------------------
+	/** Compare two paths */
+	bool ComparePaths (const char* one, const char* second) const {
+		return io->ComparePaths(one,second);
+	}
+
+private:
+
+	// -------------------------------------------------------------------
+	/** Open the real file and read its header, only done once. */
+	bool Load() {
+		if (!loaded) {
+			loaded = true;
+
+			source = io->Open(file.c_str(),"rb");
+			if (!source) {
+				return false;
+			}
+			opened = true;
+
+			length = source->FileSize();
+			header.resize(std::min(length,cacheSize));
+			if (!header.empty()) {
+				header.resize(source->Read(&header[0],1,header.size()));
+			}
+
+			// small files are cached entirely, no need to keep them open
+			if (header.size() == length) {
+				io->Close(source);
+				source = NULL;
+			}
+		}
+		return opened;
+	}
+
+private:
+	IOSystem* io;
+	std::string file;
+	size_t cacheSize;
+
+	std::vector<uint8_t> header;
+	IOStream* source;
+	size_t length;
+	bool loaded, opened;
+};
+
+} // end namespace Assimp
+
+#endif // AI_HEADERCACHEIOWRAPPER_H_INC
@@ -1795,6 +1795,8 @@ void PopulateMeshCache(const IfcRepresentationItem& item, const std::vector<unsi
 // ------------------------------------------------------------------------------------------------
 bool ProcessRepresentationItem(const IfcRepresentationItem& item, std::vector<unsigned int>& mesh_indices, ConversionData& conv)
 {
+	conv.progress->Poll();
+
 	if (!TryQueryMeshCache(item,mesh_indices,conv)) {
 		if(ProcessGeometricItem(item,mesh_indices,conv)) {
 			if(mesh_indices.size()) {
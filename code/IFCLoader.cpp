@@ -186,14 +186,14 @@ void IFCImporter::InternReadFile( const std::string& pFile,
 	};
 
 	// feed the IFC schema into the reader and pre-parse all lines
-	STEP::ReadFile(*db, schema, types_to_track, inverse_indices_to_track);
+	STEP::ReadFile(*db, schema, types_to_track, inverse_indices_to_track, progress);
 
 	const STEP::LazyObject* proj =  db->GetObject("ifcproject");
 	if (!proj) {
 		ThrowException("missing IfcProject entity");
 	}
 
-	ConversionData conv(*db,proj->To<IfcProject>(),pScene,settings);
+	ConversionData conv(*db,proj->To<IfcProject>(),pScene,settings,progress);
 	SetUnits(conv);
 	SetCoordinateSpace(conv);
 	ProcessSpatialStructures(conv);
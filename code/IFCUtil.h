@@ -98,13 +98,14 @@ struct TempOpening
 // ------------------------------------------------------------------------------------------------
 struct ConversionData 
 {
-	ConversionData(const STEP::DB& db, const IFC::IfcProject& proj, aiScene* out,const IFCImporter::Settings& settings)
+	ConversionData(const STEP::DB& db, const IFC::IfcProject& proj, aiScene* out,const IFCImporter::Settings& settings, ImportProgressHandler* progress)
 		: len_scale(1.0)
 		, angle_scale(1.0)
 		, db(db)
 		, proj(proj)
 		, out(out)
 		, settings(settings)
+		, progress(progress)
 		, apply_openings()
 		, collect_openings()
 	{}
@@ -130,6 +131,9 @@ struct ConversionData
 
 	const IFCImporter::Settings& settings;
 
+	// polled for each geometric item to convert
+	ImportProgressHandler* progress;
+
 	// Intermediate arrays used to resolve openings in walls: only one of them
 	// can be given at a time. apply_openings if present if the current element
 	// is a wall and needs its openings to be poured into its geometry while
@@ -58,8 +58,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/math/common_factor_rt.hpp>
 
 using namespace Assimp;
-using namespace irr;
-using namespace irr::io;
 
 
 // ------------------------------------------------------------------------------------------------
@@ -885,9 +883,9 @@ void IRRImporter::InternReadFile( const std::string& pFile,
 	if( file.get() == NULL)
 		throw DeadlyImportError( "Failed to open IRR file " + pFile + "");
 
-	// Construct the irrXML parser
-	CIrrXML_IOStreamReader st(file.get());
-	reader = createIrrXMLReader((IFileReadCallBack*) &st);
+	// Construct the XML parser
+	boost::scoped_ptr<XMLReader> read( new XMLReader(file.get()) );
+	reader = read.get();
 
 	// The root node of the scene
 	Node* root = new Node(Node::DUMMY);
@@ -919,7 +917,7 @@ void IRRImporter::InternReadFile( const std::string& pFile,
 	// Parse the XML file
 	while (reader->read())	{
 		switch (reader->getNodeType())	{
-		case EXN_ELEMENT:
+		case XML_ELEMENT:
 			
 			if (!ASSIMP_stricmp(reader->getNodeName(),"node"))	{
 				// ***********************************************************************
@@ -1053,7 +1051,7 @@ void IRRImporter::InternReadFile( const std::string& pFile,
 				 *  and process them.
 				 */
 				while (reader->read())	{
-					if (reader->getNodeType() == EXN_ELEMENT)	{
+					if (reader->getNodeType() == XML_ELEMENT)	{
 						if (!ASSIMP_stricmp(reader->getNodeName(),"vector3d"))	{
 							VectorProperty prop;
 							ReadVectorProperty(prop);
@@ -1310,14 +1308,14 @@ void IRRImporter::InternReadFile( const std::string& pFile,
 							}
 						}
 					}
-					else if (reader->getNodeType() == EXN_ELEMENT_END && !ASSIMP_stricmp(reader->getNodeName(),"attributes"))	{
+					else if (reader->getNodeType() == XML_ELEMENT_END && !ASSIMP_stricmp(reader->getNodeName(),"attributes"))	{
 						break;
 					}
 				}
 			}
 			break;
 
-		case EXN_ELEMENT_END:
+		case XML_ELEMENT_END:
 		
 			// If we reached the end of a node, we need to continue processing its parent
 			if (!ASSIMP_stricmp(reader->getNodeName(),"node"))	{
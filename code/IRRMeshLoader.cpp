@@ -48,8 +48,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "fast_atof.h"
 
 using namespace Assimp;
-using namespace irr;
-using namespace irr::io;
 
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
@@ -105,9 +103,9 @@ void IRRMeshImporter::InternReadFile( const std::string& pFile,
 	if( file.get() == NULL)
 		throw DeadlyImportError( "Failed to open IRRMESH file " + pFile + "");
 
-	// Construct the irrXML parser
-	CIrrXML_IOStreamReader st(file.get());
-	reader = createIrrXMLReader((IFileReadCallBack*) &st);
+	// Construct the XML parser
+	boost::scoped_ptr<XMLReader> read( new XMLReader(file.get()) );
+	reader = read.get();
 
 	// final data
 	std::vector<aiMaterial*> materials;
@@ -132,7 +130,7 @@ void IRRMeshImporter::InternReadFile( const std::string& pFile,
 	// Parse the XML file
 	while (reader->read())	{
 		switch (reader->getNodeType())	{
-		case EXN_ELEMENT:
+		case XML_ELEMENT:
 			
 			if (!ASSIMP_stricmp(reader->getNodeName(),"buffer") && (curMat || curMesh))	{
 				// end of previous buffer. A material and a mesh should be there
@@ -286,7 +284,7 @@ void IRRMeshImporter::InternReadFile( const std::string& pFile,
 			}
 			break;
 
-		case EXN_TEXT:
+		case XML_TEXT:
 			{
 			const char* sz = reader->getNodeData();
 			if (textMeaning == 1)	{
@@ -494,6 +492,5 @@ void IRRMeshImporter::InternReadFile( const std::string& pFile,
 		pScene->mRootNode->mMeshes[i] = i;
 
 	// clean up and return
-	delete reader;
 	AI_DEBUG_INVALIDATE_PTR(reader);
 }
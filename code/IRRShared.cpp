@@ -50,8 +50,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "fast_atof.h"
 
 using namespace Assimp;
-using namespace irr;
-using namespace irr::io;
 
 // Transformation matrix to convert from Assimp to IRR space
 const aiMatrix4x4 Assimp::AI_TO_IRR_MATRIX = aiMatrix4x4 ( 
@@ -217,7 +215,7 @@ aiMaterial* IrrlichtBase::ParseMaterial(unsigned int& matFlags)
 	{
 		switch (reader->getNodeType())
 		{
-		case EXN_ELEMENT:
+		case XML_ELEMENT:
 
 			// Hex properties
 			if (!ASSIMP_stricmp(reader->getNodeName(),"color"))
@@ -450,7 +448,7 @@ aiMaterial* IrrlichtBase::ParseMaterial(unsigned int& matFlags)
 				}
 			}
 			break;
-			case EXN_ELEMENT_END:
+			case XML_ELEMENT_END:
 
 				/* Assume there are no further nested nodes in <material> elements
 				 */
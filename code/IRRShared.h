@@ -7,7 +7,7 @@
 #ifndef INCLUDED_AI_IRRSHARED_H
 #define INCLUDED_AI_IRRSHARED_H
 
-#include "irrXMLWrapper.h"
+#include "XMLReader.h"
 #include "BaseImporter.h"
 
 namespace Assimp	{
@@ -77,7 +77,7 @@ protected:
 
 	/** XML reader instance
 	 */
-  irr::io::IrrXMLReader* reader;
+  XMLReader* reader;
 
 	// -------------------------------------------------------------------
 	/** Parse a material description from the XML
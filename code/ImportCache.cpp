@@ -0,0 +1,1078 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+
+/** @file ImportCache.cpp
+ *  @brief Implementation of the on-disk import cache
+ */
+
+#include "AssimpPCH.h"
+#include "ImportCache.h"
+#include "Importer.h"
+#include "ScenePrivate.h"
+#include "DefaultIOSystem.h"
+#include "Hash.h"
+#include "TinyFormatter.h"
+#include "../include/assimp/version.h"
+
+#ifdef _WIN32
+#	include <process.h>
+#else
+#	include <unistd.h>
+#	include <limits.h>
+#endif
+
+using namespace Assimp;
+
+namespace {
+
+	// first bytes of each cache entry, the last digit is the version of the layout
+	const char CacheMagic[8] = {'A','I','C','A','C','H','E','2'};
+
+	// file name extension of cache entries
+	const char* const CacheExtension = ".aicache";
+
+	// files are hashed in chunks of this size
+	const size_t CacheChunkSize = 64 * 1024;
+
+	// Global settings which have no influence on the resulting scene and thus 
+	// aren't part of the key. They only change how the import is carried out.
+	const char* const CacheNeutralProperties[] = {
+		AI_CONFIG_GLOB_IMPORT_CACHE,
+		AI_CONFIG_GLOB_MEASURE_TIME,
+		AI_CONFIG_GLOB_MEASURE_MEMORY,
+		AI_CONFIG_GLOB_TIME_LIMIT,
+		AI_CONFIG_GLOB_MULTITHREADING,
+		AI_CONFIG_GLOB_FUSE_MESH_STEPS,
+		AI_CONFIG_GLOB_MEMORY_MAPPING
+	};
+
+// ------------------------------------------------------------------------------------------------
+// 64 bit hash built from two SuperFastHash() chains with different seeds
+class CacheHash
+{
+public:
+	CacheHash() : a(0x9e3779b9), b(0x7f4a7c15) {}
+
+	void Add(const void* data, size_t size) {
+		const char* cur = static_cast<const char*>(data);
+		while (size) {
+			// SuperFastHash() treats a length of zero as 'use strlen()'
+			const uint32_t len = static_cast<uint32_t>(std::min(size,CacheChunkSize));
+			a = SuperFastHash(cur,len,a);
+			b = SuperFastHash(cur,len,b ^ a);
+			cur  += len;
+			size -= len;
+		}
+	}
+
+	template <typename T>
+	void Add(const T& value) {
+		Add(&value,sizeof(T));
+	}
+
+	uint64_t Get() const {
+		return (static_cast<uint64_t>(a) << 32) | b;
+	}
+
+private:
+	uint32_t a,b;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Identifies the build which wrote a cache entry. The layout of some structures is
+// stored as is, so their sizes are part of it.
+uint32_t GetBuildStamp()
+{
+	CacheHash hash;
+	hash.Add(aiGetVersionMajor());
+	hash.Add(aiGetVersionMinor());
+	hash.Add(aiGetVersionRevision());
+	hash.Add(aiGetCompileFlags());
+	hash.Add(sizeof(void*));
+	hash.Add(sizeof(aiLight));
+	hash.Add(sizeof(aiCamera));
+	hash.Add(sizeof(aiVectorKey));
+	hash.Add(sizeof(aiQuatKey));
+	hash.Add(sizeof(aiMeshKey));
+	hash.Add(sizeof(aiVertexWeight));
+	hash.Add(AI_MAX_NUMBER_OF_TEXTURECOORDS);
+	hash.Add(AI_MAX_NUMBER_OF_COLOR_SETS);
+	return static_cast<uint32_t>(hash.Get());
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get the absolute, canonical form of a path, so the key of a file doesn't depend on how its
+// path is spelled. Paths which don't exist in the file system (i.e. those of a custom IOSystem)
+// are taken as they are.
+std::string NormalizePath(const std::string& path)
+{
+#ifdef _WIN32
+	char buffer[_MAX_PATH];
+	const char* ret = ::_fullpath(buffer,path.c_str(),_MAX_PATH);
+#else
+	char buffer[PATH_MAX];
+	const char* ret = ::realpath(path.c_str(),buffer);
+#endif
+	std::string out = ret ? ret : path;
+	std::replace(out.begin(),out.end(),'\\','/');
+#ifdef _WIN32
+	std::transform(out.begin(),out.end(),out.begin(),::tolower);
+#endif
+	return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Distinguishes the temporary files of processes sharing a cache directory
+unsigned int CurrentProcessId()
+{
+#ifdef _WIN32
+	return static_cast<unsigned int>(::_getpid());
+#else
+	return static_cast<unsigned int>(::getpid());
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+// Appends data to a growing buffer
+class CacheWriter
+{
+public:
+	void WriteBytes(const void* data, size_t size) {
+		if (size) {
+			const size_t pos = buffer.size();
+			buffer.resize(pos + size);
+			::memcpy(&buffer[pos],data,size);
+		}
+	}
+
+	template <typename T>
+	void Write(const T& value) {
+		WriteBytes(&value,sizeof(T));
+	}
+
+	void Write(const aiString& str) {
+		Write(static_cast<uint32_t>(str.length));
+		WriteBytes(str.data,str.length);
+	}
+
+	void Write(const std::string& str) {
+		Write(static_cast<uint32_t>(str.length()));
+		WriteBytes(str.data(),str.length());
+	}
+
+	// arrays are preceded by a flag which tells whether they are present
+	template <typename T>
+	void WriteArray(const T* data, unsigned int num) {
+		const uint8_t present = data && num ? 1 : 0;
+		Write(present);
+		if (present) {
+			WriteBytes(data,sizeof(T) * num);
+		}
+	}
+
+	std::vector<char> buffer;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Reads data from a cache entry in memory, throws if the entry is truncated
+class CacheReader
+{
+public:
+	CacheReader(const std::vector<char>& buffer)
+		: cur(buffer.empty() ? NULL : &buffer[0])
+		, end(cur + buffer.size())
+	{}
+
+	void ReadBytes(void* out, size_t size) {
+		Require(size);
+		::memcpy(out,cur,size);
+		cur += size;
+	}
+
+	// check whether there are enough bytes left before allocating memory for them
+	void Require(size_t size) const {
+		if (size > static_cast<size_t>(end - cur)) {
+			throw DeadlyImportError("Cache entry is truncated");
+		}
+	}
+
+	void Require(size_t size, unsigned int num) const {
+		if (size && num > static_cast<size_t>(end - cur) / size) {
+			throw DeadlyImportError("Cache entry is truncated");
+		}
+	}
+
+	template <typename T>
+	T Read() {
+		T value;
+		ReadBytes(&value,sizeof(T));
+		return value;
+	}
+
+	void Read(aiString& str) {
+		const uint32_t len = Read<uint32_t>();
+		if (len >= MAXLEN) {
+			throw DeadlyImportError("Cache entry is corrupt");
+		}
+		ReadBytes(str.data,len);
+		str.data[len] = '\0';
+		str.length = len;
+	}
+
+	void Read(std::string& str) {
+		const uint32_t len = Read<uint32_t>();
+		Require(len);
+		str.assign(cur,len);
+		cur += len;
+	}
+
+	template <typename T>
+	T* ReadArray(unsigned int num) {
+		if (!Read<uint8_t>()) {
+			return NULL;
+		}
+		Require(sizeof(T),num);
+		T* out = new T[num];
+		ReadBytes(out,sizeof(T) * num);
+		return out;
+	}
+
+	bool AtEnd() const {
+		return cur == end;
+	}
+
+private:
+	const char* cur;
+	const char* end;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Forward declarations of the writers and readers for WritePtrArray() and ReadPtrArray()
+void Write(CacheWriter& out, const aiMesh* src);
+void Write(CacheWriter& out, const aiAnimMesh* src);
+void Write(CacheWriter& out, const aiBone* src);
+void Write(CacheWriter& out, const aiMaterial* src);
+void Write(CacheWriter& out, const aiAnimation* src);
+void Write(CacheWriter& out, const aiNodeAnim* src);
+void Write(CacheWriter& out, const aiMeshAnim* src);
+void Write(CacheWriter& out, const aiTexture* src);
+void Write(CacheWriter& out, const aiLight* src);
+void Write(CacheWriter& out, const aiCamera* src);
+
+void Read(CacheReader& in, aiMesh*& dest);
+void Read(CacheReader& in, aiAnimMesh*& dest);
+void Read(CacheReader& in, aiBone*& dest);
+void Read(CacheReader& in, aiMaterial*& dest);
+void Read(CacheReader& in, aiAnimation*& dest);
+void Read(CacheReader& in, aiNodeAnim*& dest);
+void Read(CacheReader& in, aiMeshAnim*& dest);
+void Read(CacheReader& in, aiTexture*& dest);
+void Read(CacheReader& in, aiLight*& dest);
+void Read(CacheReader& in, aiCamera*& dest);
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+void WritePtrArray(CacheWriter& out, T* const* src, unsigned int num)
+{
+	const uint8_t present = src && num ? 1 : 0;
+	out.Write(present);
+	for (unsigned int i = 0; present && i < num; ++i) {
+		Write(out,src[i]);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// The array is assigned before it is filled, so the owner releases everything read so far 
+// if the entry turns out to be truncated.
+template <typename T>
+void ReadPtrArray(CacheReader& in, T**& dest, unsigned int num)
+{
+	dest = NULL;
+	if (!in.Read<uint8_t>()) {
+		return;
+	}
+	in.Require(1,num);
+	dest = new T*[num]();
+	for (unsigned int i = 0; i < num; ++i) {
+		Read(in,dest[i]);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void Write(CacheWriter& out, const aiMesh* src)
+{
+	out.Write(src->mName);
+	out.Write(src->mPrimitiveTypes);
+	out.Write(src->mMaterialIndex);
+	out.Write(src->mNumVertices);
+	out.Write(src->mNumFaces);
+	out.Write(src->mNumBones);
+	out.Write(src->mNumAnimMeshes);
+	out.WriteBytes(src->mNumUVComponents,sizeof(src->mNumUVComponents));
+
+	out.WriteArray(src->mVertices,  src->mNumVertices);
+	out.WriteArray(src->mNormals,   src->mNumVertices);
+	out.WriteArray(src->mTangents,  src->mNumVertices);
+	out.WriteArray(src->mBitangents,src->mNumVertices);
+	for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
+		out.WriteArray(src->mTextureCoords[n],src->mNumVertices);
+	}
+	for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS; ++n) {
+		out.WriteArray(src->mColors[n],src->mNumVertices);
+	}
+
+	// the sizes of all faces, followed by all indices
+	const uint8_t present = src->mFaces && src->mNumFaces ? 1 : 0;
+	out.Write(present);
+	if (present) {
+		uint32_t numIndices = 0;
+		for (unsigned int i = 0; i < src->mNumFaces; ++i) {
+			const aiFace& face = src->mFaces[i];
+			const unsigned int num = face.mIndices ? face.mNumIndices : 0;
+			out.Write(num);
+			numIndices += num;
+		}
+		out.Write(numIndices);
+		for (unsigned int i = 0; i < src->mNumFaces; ++i) {
+			const aiFace& face = src->mFaces[i];
+			if (face.mIndices) {
+				out.WriteBytes(face.mIndices,sizeof(unsigned int) * face.mNumIndices);
+			}
+		}
+	}
+
+	WritePtrArray(out,src->mBones,src->mNumBones);
+	WritePtrArray(out,src->mAnimMeshes,src->mNumAnimMeshes);
+}
+
+// ------------------------------------------------------------------------------------------------
+void Read(CacheReader& in, aiMesh*& dest)
+{
+	aiMesh* const mesh = dest = new aiMesh();
+
+	in.Read(mesh->mName);
+	mesh->mPrimitiveTypes = in.Read<unsigned int>();
+	mesh->mMaterialIndex  = in.Read<unsigned int>();
+	mesh->mNumVertices    = in.Read<unsigned int>();
+	mesh->mNumFaces       = in.Read<unsigned int>();
+	mesh->mNumBones       = in.Read<unsigned int>();
+	mesh->mNumAnimMeshes  = in.Read<unsigned int>();
+	in.ReadBytes(mesh->mNumUVComponents,sizeof(mesh->mNumUVComponents));
+
+	mesh->mVertices   = in.ReadArray<aiVector3D>(mesh->mNumVertices);
+	mesh->mNormals    = in.ReadArray<aiVector3D>(mesh->mNumVertices);
+	mesh->mTangents   = in.ReadArray<aiVector3D>(mesh->mNumVertices);
+	mesh->mBitangents = in.ReadArray<aiVector3D>(mesh->mNumVertices);
+	for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
+		mesh->mTextureCoords[n] = in.ReadArray<aiVector3D>(mesh->mNumVertices);
+	}
+	for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS; ++n) {
+		mesh->mColors[n] = in.ReadArray<aiColor4D>(mesh->mNumVertices);
+	}
+
+	if (in.Read<uint8_t>()) {
+		in.Require(sizeof(unsigned int),mesh->mNumFaces);
+		mesh->mFaces = new aiFace[mesh->mNumFaces];
+		for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+			mesh->mFaces[i].mNumIndices = in.Read<unsigned int>();
+		}
+
+		const uint32_t numIndices = in.Read<uint32_t>();
+		in.Require(sizeof(unsigned int),numIndices);
+		for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+			aiFace& face = mesh->mFaces[i];
+			if (face.mNumIndices) {
+				in.Require(sizeof(unsigned int),face.mNumIndices);
+				face.mIndices = new unsigned int[face.mNumIndices];
+				in.ReadBytes(face.mIndices,sizeof(unsigned int) * face.mNumIndices);
+			}
+		}
+	}
+
+	ReadPtrArray(in,mesh->mBones,mesh->mNumBones);
+	ReadPtrArray(in,mesh->mAnimMeshes,mesh->mNumAnimMeshes);
+}
+
+// ------------------------------------------------------------------------------------------------
+void Write(CacheWriter& out, const aiAnimMesh* src)
+{
+	out.Write(src->mNumVertices);
+	out.WriteArray(src->mVertices,  src->mNumVertices);
+	out.WriteArray(src->mNormals,   src->mNumVertices);
+	out.WriteArray(src->mTangents,  src->mNumVertices);
+	out.WriteArray(src->mBitangents,src->mNumVertices);
+	for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
+		out.WriteArray(src->mTextureCoords[n],src->mNumVertices);
+	}
+	for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS; ++n) {
+		out.WriteArray(src->mColors[n],src->mNumVertices);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void Read(CacheReader& in, aiAnimMesh*& dest)
+{
+	aiAnimMesh* const mesh = dest = new aiAnimMesh();
+
+	mesh->mNumVertices = in.Read<unsigned int>();
+	mesh->mVertices   = in.ReadArray<aiVector3D>(mesh->mNumVertices);
+	mesh->mNormals    = in.ReadArray<aiVector3D>(mesh->mNumVertices);
+	mesh->mTangents   = in.ReadArray<aiVector3D>(mesh->mNumVertices);
+	mesh->mBitangents = in.ReadArray<aiVector3D>(mesh->mNumVertices);
+	for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
+		mesh->mTextureCoords[n] = in.ReadArray<aiVector3D>(mesh->mNumVertices);
+	}
+	for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS; ++n) {
+		mesh->mColors[n] = in.ReadArray<aiColor4D>(mesh->mNumVertices);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void Write(CacheWriter& out, const aiBone* src)
+{
+	out.Write(src->mName);
+	out.Write(src->mOffsetMatrix);
+	out.Write(src->mNumWeights);
+	out.WriteArray(src->mWeights,src->mNumWeights);
+}
+
+// ------------------------------------------------------------------------------------------------
+void Read(CacheReader& in, aiBone*& dest)
+{
+	aiBone* const bone = dest = new aiBone();
+
+	in.Read(bone->mName);
+	bone->mOffsetMatrix = in.Read<aiMatrix4x4>();
+	bone->mNumWeights   = in.Read<unsigned int>();
+	bone->mWeights      = in.ReadArray<aiVertexWeight>(bone->mNumWeights);
+}
+
+// ------------------------------------------------------------------------------------------------
+void Write(CacheWriter& out, const aiMaterial* src)
+{
+	out.Write(src->mNumProperties);
+	for (unsigned int i = 0; i < src->mNumProperties; ++i) {
+		const aiMaterialProperty* prop = src->mProperties[i];
+
+		out.Write(prop->mKey);
+		out.Write(prop->mSemantic);
+		out.Write(prop->mIndex);
+		out.Write(static_cast<uint32_t>(prop->mType));
+		out.Write(prop->mDataLength);
+		out.WriteArray(prop->mData,prop->mDataLength);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void Read(CacheReader& in, aiMaterial*& dest)
+{
+	aiMaterial* const mat = dest = new aiMaterial();
+
+	const unsigned int num = in.Read<unsigned int>();
+	if (num > mat->mNumAllocated) {
+		in.Require(1,num);
+		delete[] mat->mProperties;
+		mat->mProperties   = new aiMaterialProperty*[num];
+		mat->mNumAllocated = num;
+	}
+
+	// the material owns each property as soon as it is counted
+	for (unsigned int i = 0; i < num; ++i) {
+		aiMaterialProperty* prop = mat->mProperties[mat->mNumProperties++] = new aiMaterialProperty();
+
+		in.Read(prop->mKey);
+		prop->mSemantic   = in.Read<unsigned int>();
+		prop->mIndex      = in.Read<unsigned int>();
+		prop->mType       = static_cast<aiPropertyTypeInfo>(in.Read<uint32_t>());
+		prop->mDataLength = in.Read<unsigned int>();
+		prop->mData       = in.ReadArray<char>(prop->mDataLength);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void Write(CacheWriter& out, const aiAnimation* src)
+{
+	out.Write(src->mName);
+	out.Write(src->mDuration);
+	out.Write(src->mTicksPerSecond);
+	out.Write(src->mNumChannels);
+	out.Write(src->mNumMeshChannels);
+	WritePtrArray(out,src->mChannels,src->mNumChannels);
+	WritePtrArray(out,src->mMeshChannels,src->mNumMeshChannels);
+}
+
+// ------------------------------------------------------------------------------------------------
+void Read(CacheReader& in, aiAnimation*& dest)
+{
+	aiAnimation* const anim = dest = new aiAnimation();
+
+	in.Read(anim->mName);
+	anim->mDuration        = in.Read<double>();
+	anim->mTicksPerSecond  = in.Read<double>();
+	anim->mNumChannels     = in.Read<unsigned int>();
+	anim->mNumMeshChannels = in.Read<unsigned int>();
+	ReadPtrArray(in,anim->mChannels,anim->mNumChannels);
+	ReadPtrArray(in,anim->mMeshChannels,anim->mNumMeshChannels);
+}
+
+// ------------------------------------------------------------------------------------------------
+void Write(CacheWriter& out, const aiNodeAnim* src)
+{
+	out.Write(src->mNodeName);
+	out.Write(static_cast<uint32_t>(src->mPreState));
+	out.Write(static_cast<uint32_t>(src->mPostState));
+	out.Write(src->mNumPositionKeys);
+	out.Write(src->mNumRotationKeys);
+	out.Write(src->mNumScalingKeys);
+	out.WriteArray(src->mPositionKeys,src->mNumPositionKeys);
+	out.WriteArray(src->mRotationKeys,src->mNumRotationKeys);
+	out.WriteArray(src->mScalingKeys, src->mNumScalingKeys);
+}
+
+// ------------------------------------------------------------------------------------------------
+void Read(CacheReader& in, aiNodeAnim*& dest)
+{
+	aiNodeAnim* const anim = dest = new aiNodeAnim();
+
+	in.Read(anim->mNodeName);
+	anim->mPreState        = static_cast<aiAnimBehaviour>(in.Read<uint32_t>());
+	anim->mPostState       = static_cast<aiAnimBehaviour>(in.Read<uint32_t>());
+	anim->mNumPositionKeys = in.Read<unsigned int>();
+	anim->mNumRotationKeys = in.Read<unsigned int>();
+	anim->mNumScalingKeys  = in.Read<unsigned int>();
+	anim->mPositionKeys    = in.ReadArray<aiVectorKey>(anim->mNumPositionKeys);
+	anim->mRotationKeys    = in.ReadArray<aiQuatKey>(anim->mNumRotationKeys);
+	anim->mScalingKeys     = in.ReadArray<aiVectorKey>(anim->mNumScalingKeys);
+}
+
+// ------------------------------------------------------------------------------------------------
+void Write(CacheWriter& out, const aiMeshAnim* src)
+{
+	out.Write(src->mName);
+	out.Write(src->mNumKeys);
+	out.WriteArray(src->mKeys,src->mNumKeys);
+}
+
+// ------------------------------------------------------------------------------------------------
+void Read(CacheReader& in, aiMeshAnim*& dest)
+{
+	aiMeshAnim* const anim = dest = new aiMeshAnim();
+
+	in.Read(anim->mName);
+	anim->mNumKeys = in.Read<unsigned int>();
+	anim->mKeys    = in.ReadArray<aiMeshKey>(anim->mNumKeys);
+}
+
+// ------------------------------------------------------------------------------------------------
+void Write(CacheWriter& out, const aiTexture* src)
+{
+	out.Write(src->mWidth);
+	out.Write(src->mHeight);
+	out.WriteBytes(src->achFormatHint,sizeof(src->achFormatHint));
+
+	// compressed textures store their size in bytes in mWidth
+	const unsigned int size = src->mHeight ? src->mWidth * src->mHeight * sizeof(aiTexel) : src->mWidth;
+	out.WriteArray(reinterpret_cast<const char*>(src->pcData),size);
+}
+
+// ------------------------------------------------------------------------------------------------
+void Read(CacheReader& in, aiTexture*& dest)
+{
+	aiTexture* const tex = dest = new aiTexture();
+
+	tex->mWidth  = in.Read<unsigned int>();
+	tex->mHeight = in.Read<unsigned int>();
+	in.ReadBytes(tex->achFormatHint,sizeof(tex->achFormatHint));
+
+	// the cast is legal, the aiTexel c'tor does nothing important
+	const unsigned int size = tex->mHeight ? tex->mWidth * tex->mHeight * sizeof(aiTexel) : tex->mWidth;
+	tex->pcData = reinterpret_cast<aiTexel*>(in.ReadArray<char>(size));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Lights and cameras don't reference other data, they are stored as they are
+void Write(CacheWriter& out, const aiLight* src)
+{
+	out.Write(*src);
+}
+
+// ------------------------------------------------------------------------------------------------
+void Read(CacheReader& in, aiLight*& dest)
+{
+	dest = new aiLight();
+	in.ReadBytes(dest,sizeof(aiLight));
+}
+
+// ------------------------------------------------------------------------------------------------
+void Write(CacheWriter& out, const aiCamera* src)
+{
+	out.Write(*src);
+}
+
+// ------------------------------------------------------------------------------------------------
+void Read(CacheReader& in, aiCamera*& dest)
+{
+	dest = new aiCamera();
+	in.ReadBytes(dest,sizeof(aiCamera));
+}
+
+// ------------------------------------------------------------------------------------------------
+void WriteNode(CacheWriter& out, const aiNode* src)
+{
+	out.Write(src->mName);
+	out.Write(src->mTransformation);
+	out.Write(src->mNumMeshes);
+	out.WriteArray(src->mMeshes,src->mNumMeshes);
+
+	const unsigned int numChildren = src->mChildren ? src->mNumChildren : 0;
+	out.Write(numChildren);
+	for (unsigned int i = 0; i < numChildren; ++i) {
+		WriteNode(out,src->mChildren[i]);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void ReadNode(CacheReader& in, aiNode*& dest, aiNode* parent)
+{
+	aiNode* const node = dest = new aiNode();
+	node->mParent = parent;
+
+	in.Read(node->mName);
+	node->mTransformation = in.Read<aiMatrix4x4>();
+	node->mNumMeshes      = in.Read<unsigned int>();
+	node->mMeshes         = in.ReadArray<unsigned int>(node->mNumMeshes);
+
+	const unsigned int numChildren = in.Read<unsigned int>();
+	if (numChildren) {
+		in.Require(1,numChildren);
+		node->mChildren    = new aiNode*[numChildren]();
+		node->mNumChildren = numChildren;
+		for (unsigned int i = 0; i < numChildren; ++i) {
+			ReadNode(in,node->mChildren[i],node);
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void WriteScene(CacheWriter& out, const aiScene* scene)
+{
+	out.Write(scene->mFlags);
+	out.Write(static_cast<unsigned int>(ScenePriv(scene) ? ScenePriv(scene)->mPPStepsApplied : 0));
+
+	out.Write(static_cast<uint8_t>(scene->mRootNode ? 1 : 0));
+	if (scene->mRootNode) {
+		WriteNode(out,scene->mRootNode);
+	}
+
+	out.Write(scene->mNumMeshes);
+	WritePtrArray(out,scene->mMeshes,scene->mNumMeshes);
+	out.Write(scene->mNumMaterials);
+	WritePtrArray(out,scene->mMaterials,scene->mNumMaterials);
+	out.Write(scene->mNumAnimations);
+	WritePtrArray(out,scene->mAnimations,scene->mNumAnimations);
+	out.Write(scene->mNumTextures);
+	WritePtrArray(out,scene->mTextures,scene->mNumTextures);
+	out.Write(scene->mNumLights);
+	WritePtrArray(out,scene->mLights,scene->mNumLights);
+	out.Write(scene->mNumCameras);
+	WritePtrArray(out,scene->mCameras,scene->mNumCameras);
+}
+
+// ------------------------------------------------------------------------------------------------
+void ReadScene(CacheReader& in, aiScene* scene)
+{
+	scene->mFlags = in.Read<unsigned int>();
+	ScenePriv(scene)->mPPStepsApplied = in.Read<unsigned int>();
+
+	if (in.Read<uint8_t>()) {
+		ReadNode(in,scene->mRootNode,NULL);
+	}
+
+	// the counts are set first, the scene releases the arrays up to them
+	scene->mNumMeshes = in.Read<unsigned int>();
+	ReadPtrArray(in,scene->mMeshes,scene->mNumMeshes);
+	scene->mNumMaterials = in.Read<unsigned int>();
+	ReadPtrArray(in,scene->mMaterials,scene->mNumMaterials);
+	scene->mNumAnimations = in.Read<unsigned int>();
+	ReadPtrArray(in,scene->mAnimations,scene->mNumAnimations);
+	scene->mNumTextures = in.Read<unsigned int>();
+	ReadPtrArray(in,scene->mTextures,scene->mNumTextures);
+	scene->mNumLights = in.Read<unsigned int>();
+	ReadPtrArray(in,scene->mLights,scene->mNumLights);
+	scene->mNumCameras = in.Read<unsigned int>();
+	ReadPtrArray(in,scene->mCameras,scene->mNumCameras);
+}
+
+} // end of anonymous namespace
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+/** Passes everything through to another IOSystem and keeps a list of 
+ *  all files which have been opened for reading, as well as of all files
+ *  which have been looked for but didn't exist. */
+class RecordingIOSystem : public IOSystem
+{
+public:
+	RecordingIOSystem(IOSystem* io) : io(io) {}
+
+	bool Exists( const char* pFile) const {
+		const bool exists = io->Exists(pFile);
+		if (!exists) {
+			Record(missing,pFile);
+		}
+		return exists;
+	}
+
+	char getOsSeparator() const {
+		return io->getOsSeparator();
+	}
+
+	IOStream* Open( const char* pFile, const char* pMode = "rb") {
+		IOStream* stream = io->Open(pFile,pMode);
+		if (!strchr(pMode,'w') && !strchr(pMode,'a') && !strchr(pMode,'+')) {
+			Record(stream ? files : missing,pFile);
+		}
+		return stream;
+	}
+
+	void Close( IOStream* pFile) {
+		io->Close(pFile);
+	}
+
+	bool ComparePaths (const char* one, const char* second) const {
+		return io->ComparePaths(one,second);
+	}
+
+	static void Record(std::vector<std::string>& list, const char* pFile) {
+		if (std::find(list.begin(),list.end(),pFile) == list.end()) {
+			list.push_back(pFile);
+		}
+	}
+
+	IOSystem* io;
+	std::vector<std::string> files;
+	mutable std::vector<std::string> missing;
+};
+
+} // Namespace Assimp
+
+// ------------------------------------------------------------------------------------------------
+ImportCache::ImportCache(const std::string& directory, IOSystem* io)
+	: directory(directory)
+	, io(io)
+	, recorder()
+	, key()
+	, valid()
+{
+	ai_assert(NULL != io);
+
+	// accept the directory with and without trailing separator
+	if (!this->directory.empty() && this->directory[this->directory.length()-1] != '/' && 
+		this->directory[this->directory.length()-1] != '\\') {
+		this->directory += '/';
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+ImportCache::~ImportCache()
+{
+	delete recorder;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImportCache::HashFile(const std::string& path, uint64_t& size, uint64_t& hash) const
+{
+	IOStream* stream = io->Open(path.c_str(),"rb");
+	if (!stream) {
+		return false;
+	}
+
+	CacheHash fileHash;
+	const void* view = stream->GetView();
+	if (view) {
+		size = stream->FileSize();
+		fileHash.Add(view,static_cast<size_t>(size));
+	}
+	else {
+		std::vector<char> chunk(CacheChunkSize);
+
+		size = 0;
+		for (size_t read; (read = stream->Read(&chunk[0],1,CacheChunkSize)) != 0; size += read) {
+			fileHash.Add(&chunk[0],read);
+		}
+	}
+	io->Close(stream);
+
+	hash = fileHash.Get();
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImportCache::ComputeKey(const std::string& file, unsigned int flags, const ImporterPimpl& importer)
+{
+	this->file = file;
+
+	uint64_t size, contentHash;
+	if (!(valid = HashFile(file,size,contentHash))) {
+		return false;
+	}
+
+	CacheHash hash;
+	hash.Add(GetBuildStamp());
+	hash.Add(size);
+	hash.Add(contentHash);
+	hash.Add(flags);
+
+	// The name of the file ends up in the scene and other files are looked up 
+	// relative to it, so identical files in different places need their own entries.
+	const std::string path = NormalizePath(file);
+	hash.Add(static_cast<uint32_t>(path.length()));
+	hash.Add(path.data(),path.length());
+
+	// the maps are sorted, so the order is always the same
+	std::set<ImporterPimpl::KeyType> neutral;
+	for (unsigned int i = 0; i < sizeof(CacheNeutralProperties) / sizeof(CacheNeutralProperties[0]); ++i) {
+		neutral.insert(SuperFastHash(CacheNeutralProperties[i]));
+	}
+
+	for (ImporterPimpl::IntPropertyMap::const_iterator it = importer.mIntProperties.begin(); 
+		it != importer.mIntProperties.end(); ++it) {
+		if (!neutral.count((*it).first)) {
+			hash.Add((*it).first);
+			hash.Add((*it).second);
+		}
+	}
+	for (ImporterPimpl::FloatPropertyMap::const_iterator it = importer.mFloatProperties.begin(); 
+		it != importer.mFloatProperties.end(); ++it) {
+		if (!neutral.count((*it).first)) {
+			hash.Add((*it).first);
+			hash.Add((*it).second);
+		}
+	}
+	for (ImporterPimpl::StringPropertyMap::const_iterator it = importer.mStringProperties.begin(); 
+		it != importer.mStringProperties.end(); ++it) {
+		if (!neutral.count((*it).first)) {
+			hash.Add((*it).first);
+			hash.Add(static_cast<uint32_t>((*it).second.length()));
+			hash.Add((*it).second.data(),(*it).second.length());
+		}
+	}
+
+	key = hash.Get();
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string ImportCache::GetEntryPath() const
+{
+	char name[17];
+	::sprintf(name,"%08x%08x",static_cast<unsigned int>(key >> 32),static_cast<unsigned int>(key));
+	return directory + name + CacheExtension;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiScene* ImportCache::Load()
+{
+	ai_assert(valid);
+	const std::string path = GetEntryPath();
+
+	// cache entries always live in the file system
+	DefaultIOSystem fs;
+	IOStream* stream = fs.Open(path.c_str(),"rb");
+	if (!stream) {
+		DefaultLogger::get()->debug("ImportCache: no entry for " + file);
+		return NULL;
+	}
+
+	std::vector<char> buffer(stream->FileSize());
+	const size_t read = buffer.empty() ? 0 : stream->Read(&buffer[0],1,buffer.size());
+	fs.Close(stream);
+
+	if (read != buffer.size()) {
+		DefaultLogger::get()->warn("ImportCache: failed to read " + path);
+		return NULL;
+	}
+
+	ScopeGuard<aiScene> scene(new aiScene());
+	try {
+		CacheReader in(buffer);
+
+		char magic[sizeof(CacheMagic)];
+		in.ReadBytes(magic,sizeof(magic));
+		if (::memcmp(magic,CacheMagic,sizeof(magic)) || in.Read<uint32_t>() != GetBuildStamp() || in.Read<uint64_t>() != key) {
+			DefaultLogger::get()->debug("ImportCache: entry " + path + " was written by another build");
+			return NULL;
+		}
+
+		// all other files read by the loader must be unchanged
+		const uint32_t numDependencies = in.Read<uint32_t>();
+		for (uint32_t i = 0; i < numDependencies; ++i) {
+			std::string dep;
+			in.Read(dep);
+			const uint64_t size = in.Read<uint64_t>(), hash = in.Read<uint64_t>();
+
+			uint64_t curSize, curHash;
+			if (!HashFile(dep,curSize,curHash) || curSize != size || curHash != hash) {
+				DefaultLogger::get()->debug("ImportCache: entry for " + file + " is outdated, " + dep + " has changed");
+				return NULL;
+			}
+		}
+
+		// and all files the loader didn't find must still be missing
+		const uint32_t numMissing = in.Read<uint32_t>();
+		for (uint32_t i = 0; i < numMissing; ++i) {
+			std::string dep;
+			in.Read(dep);
+
+			if (io->Exists(dep.c_str())) {
+				DefaultLogger::get()->debug("ImportCache: entry for " + file + " is outdated, " + dep + " has been added");
+				return NULL;
+			}
+		}
+
+		ReadScene(in,scene);
+		if (!in.AtEnd()) {
+			throw DeadlyImportError("Cache entry is corrupt");
+		}
+	}
+	catch (const std::exception& e) {
+		DefaultLogger::get()->warn("ImportCache: failed to read " + path + ": " + e.what());
+		return NULL;
+	}
+
+	DefaultLogger::get()->info("ImportCache: loaded scene from " + path);
+	return scene.dismiss();
+}
+
+// ------------------------------------------------------------------------------------------------
+IOSystem* ImportCache::GetRecordingIOSystem()
+{
+	if (!recorder) {
+		recorder = new RecordingIOSystem(io);
+	}
+	return recorder;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportCache::Store(const aiScene* scene)
+{
+	ai_assert(valid && NULL != scene);
+	CacheWriter out;
+
+	out.WriteBytes(CacheMagic,sizeof(CacheMagic));
+	out.Write(GetBuildStamp());
+	out.Write(key);
+
+	// the file itself is covered by the key
+	std::vector<std::string> deps;
+	if (recorder) {
+		for (std::vector<std::string>::const_iterator it = recorder->files.begin(); it != recorder->files.end(); ++it) {
+			if (*it != file) {
+				deps.push_back(*it);
+			}
+		}
+	}
+
+	out.Write(static_cast<uint32_t>(deps.size()));
+	for (std::vector<std::string>::const_iterator it = deps.begin(); it != deps.end(); ++it) {
+		uint64_t size, hash;
+		if (!HashFile(*it,size,hash)) {
+			DefaultLogger::get()->warn("ImportCache: not caching " + file + ", failed to read " + *it);
+			return;
+		}
+		out.Write(*it);
+		out.Write(size);
+		out.Write(hash);
+	}
+
+	// Files the loader looked for in vain. If one of them appears later (i.e. a
+	// missing material library), the entry must be discarded.
+	std::vector<std::string> missing;
+	if (recorder) {
+		for (std::vector<std::string>::const_iterator it = recorder->missing.begin(); it != recorder->missing.end(); ++it) {
+			if (*it != file && std::find(recorder->files.begin(),recorder->files.end(),*it) == recorder->files.end()) {
+				missing.push_back(*it);
+			}
+		}
+	}
+
+	out.Write(static_cast<uint32_t>(missing.size()));
+	for (std::vector<std::string>::const_iterator it = missing.begin(); it != missing.end(); ++it) {
+		out.Write(*it);
+	}
+
+	WriteScene(out,scene);
+
+	// Write to a temporary file first and move it into place. Concurrent readers 
+	// see either the old or the new entry, but never a partial one.
+	const std::string path = GetEntryPath();
+	const std::string temp = (Formatter::format(path),'.',CurrentProcessId(),'.',
+		reinterpret_cast<uintptr_t>(&out),'.',static_cast<unsigned int>(::clock()),".tmp");
+
+	DefaultIOSystem fs;
+	IOStream* stream = fs.Open(temp.c_str(),"wb");
+	if (!stream) {
+		DefaultLogger::get()->warn("ImportCache: failed to create " + temp);
+		return;
+	}
+	const size_t written = stream->Write(&out.buffer[0],1,out.buffer.size());
+	fs.Close(stream);
+
+	if (written != out.buffer.size()) {
+		DefaultLogger::get()->warn("ImportCache: failed to write " + temp);
+		::remove(temp.c_str());
+		return;
+	}
+
+	// rename() doesn't replace existing files on all platforms
+	if (0 != ::rename(temp.c_str(),path.c_str())) {
+		::remove(path.c_str());
+		if (0 != ::rename(temp.c_str(),path.c_str())) {
+			DefaultLogger::get()->warn("ImportCache: failed to write " + path);
+			::remove(temp.c_str());
+			return;
+		}
+	}
+	DefaultLogger::get()->info((Formatter::format("ImportCache: stored scene in "),path,", ",
+		out.buffer.size()," bytes"));
+}
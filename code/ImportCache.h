@@ -0,0 +1,133 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+
+/** @file ImportCache.h
+ *  @brief On-disk cache of post-processed scenes, see #AI_CONFIG_GLOB_IMPORT_CACHE
+ */
+#ifndef INCLUDED_AI_IMPORTCACHE_H
+#define INCLUDED_AI_IMPORTCACHE_H
+
+struct aiScene;
+namespace Assimp	{
+
+class IOSystem;
+class ImporterPimpl;
+class RecordingIOSystem;
+
+// ------------------------------------------------------------------------------------
+/** @brief Stores imported and post-processed scenes in a directory on disk.
+ *
+ *  Each entry is identified by a key computed from the bytes and the 
+ *  absolute path of the file to be imported, the post-processing flags and
+ *  the importer properties. It keeps the scene in a binary layout which is 
+ *  read back with a handful of allocations per mesh, together with the size
+ *  and hash of every other file the loader has read (i.e. material libraries
+ *  or external textures) and the names of the files it looked for, but 
+ *  didn't find. An entry is only used if all of these are still unchanged.
+ *
+ *  Entries are tied to the exact build of the library which wrote them,
+ *  they are simply ignored and replaced otherwise. 
+ */
+class ImportCache 
+{
+public:
+
+	// ------------------------------------------------------------------------------------
+	/** @param directory Directory to keep the cache entries in, must exist
+	 *  @param io IOSystem to read the file to be imported and its 
+	 *    dependencies. Cache entries are always read and written through
+	 *    the file system. */
+	ImportCache(const std::string& directory, IOSystem* io);
+	~ImportCache();
+
+public:
+
+	// ------------------------------------------------------------------------------------
+	/** Compute the key of an import. Must be called before any of the 
+	 *  other methods.
+	 *  @param file File to be imported
+	 *  @param flags Post-processing steps to be applied
+	 *  @param importer Importer whose properties are taken into account
+	 *  @return false if the file can't be read */
+	bool ComputeKey(const std::string& file, unsigned int flags, const ImporterPimpl& importer);
+
+	// ------------------------------------------------------------------------------------
+	/** Read the scene for the current key from the cache.
+	 *  @return NULL if there is no valid entry. The caller takes ownership. */
+	aiScene* Load();
+
+	// ------------------------------------------------------------------------------------
+	/** Get an IOSystem to pass to the loader. It records all files read 
+	 *  through it, so #Store() can add them to the entry. */
+	IOSystem* GetRecordingIOSystem();
+
+	// ------------------------------------------------------------------------------------
+	/** Write a scene to the cache, replacing the previous entry for the
+	 *  current key. Failures are logged and otherwise ignored.
+	 *  @param scene Scene to be stored, usually the result of the import
+	 *    whose files have been recorded by #GetRecordingIOSystem(). */
+	void Store(const aiScene* scene);
+
+private:
+
+	/** Get the path of the entry for the current key */
+	std::string GetEntryPath() const;
+
+	/** Hash the contents of a file, false if it can't be read */
+	bool HashFile(const std::string& file, uint64_t& size, uint64_t& hash) const;
+
+	// no copying
+	ImportCache(const ImportCache&);
+	ImportCache& operator = (const ImportCache&);
+
+	std::string directory;
+	IOSystem* io;
+	RecordingIOSystem* recorder;
+
+	std::string file;
+	uint64_t key;
+	bool valid;
+
+}; // !class ImportCache
+} // Namespace Assimp
+
+#endif
@@ -0,0 +1,191 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file ImportProgressHandler.cpp
+ *  @brief Implementation of the ImportProgressHandler class
+ */
+
+#include "AssimpPCH.h"
+#include "ImportProgressHandler.h"
+#include "Profiler.h"
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#	include <boost/thread/mutex.hpp>
+#endif
+
+using namespace Assimp;
+
+namespace {
+
+	// number of Poll() calls per Update()
+	const unsigned int PollInterval = 256;
+}
+
+namespace Assimp	{
+
+// ------------------------------------------------------------------------------------------------
+// Cancelled state and reason, which may be accessed by several worker threads at once
+struct ImportProgressData
+{
+	ImportProgressData()
+		: cancelled()
+	{}
+
+	bool cancelled;
+	std::string reason;
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	boost::mutex mutex;
+#endif
+};
+
+} // end of namespace Assimp
+
+// ------------------------------------------------------------------------------------------------
+ImportProgressHandler::ImportProgressHandler()
+	: user()
+	, timeLimit()
+	, deadline()
+	, pollCount()
+	, active()
+	, data(new ImportProgressData())
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+ImportProgressHandler::~ImportProgressHandler()
+{
+	delete data;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportProgressHandler::Begin(ProgressHandler* _user, unsigned int _timeLimit)
+{
+	user      = _user;
+	timeLimit = _timeLimit;
+	deadline  = timeLimit ? Profiling::GetWallTime() + timeLimit * 1e-3 : 0.;
+	pollCount = 0;
+	active    = true;
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	boost::mutex::scoped_lock lock(data->mutex);
+#endif
+	data->cancelled = false;
+	data->reason.clear();
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportProgressHandler::End()
+{
+	active = false;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImportProgressHandler::Update(float percentage /*= -1.f*/)
+{
+	if (IsCancelled()) {
+		return false;
+	}
+	if (user && !user->Update(percentage)) {
+		Cancel("Import cancelled by the progress handler");
+		return false;
+	}
+	return !IsPastDeadline();
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportProgressHandler::Poll()
+{
+	if (++pollCount >= PollInterval) {
+		pollCount = 0;
+		if (!Update()) {
+			throw DeadlyImportError(GetReason());
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportProgressHandler::CheckDeadline()
+{
+	if (IsCancelled() || IsPastDeadline()) {
+		throw DeadlyImportError(GetReason());
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImportProgressHandler::IsCancelled() const
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	boost::mutex::scoped_lock lock(data->mutex);
+#endif
+	return data->cancelled;
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string ImportProgressHandler::GetReason() const
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	boost::mutex::scoped_lock lock(data->mutex);
+#endif
+	return data->reason;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportProgressHandler::Cancel(const std::string& reason)
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	boost::mutex::scoped_lock lock(data->mutex);
+#endif
+	if (data->reason.empty()) {
+		data->reason = reason;
+	}
+	data->cancelled = true;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImportProgressHandler::IsPastDeadline()
+{
+	if (deadline && Profiling::GetWallTime() > deadline) {
+		Cancel((Formatter::format("Import exceeded the time limit of "),timeLimit," ms"));
+		return true;
+	}
+	return false;
+}
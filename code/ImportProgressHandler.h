@@ -0,0 +1,170 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file ImportProgressHandler.h
+ *  @brief Internal progress handler which enforces cancellation and deadlines
+ */
+#ifndef INCLUDED_AI_IMPORTPROGRESSHANDLER_H
+#define INCLUDED_AI_IMPORTPROGRESSHANDLER_H
+
+#include "../include/assimp/ProgressHandler.hpp"
+namespace Assimp	{
+
+struct ImportProgressData;
+
+// ------------------------------------------------------------------------------------
+/** @brief Progress handler passed to loaders and post-processing steps.
+ *
+ *  Forwards all updates to the #ProgressHandler set by the user and keeps
+ *  track of whether the import has been cancelled, either because the user's
+ *  handler returned false or because the deadline configured with
+ *  #AI_CONFIG_GLOB_TIME_LIMIT has passed. Once cancelled, it stays cancelled
+ *  until the next import starts.
+ *
+ *  Long loops call #Poll() or #CheckDeadline(), which throw a 
+ *  #DeadlyImportError if the import has been cancelled. This unwinds the
+ *  loader or post-processing step the usual way.
+ */
+class ImportProgressHandler 
+	: public ProgressHandler	{
+
+public:
+
+	// ------------------------------------------------------------------------------------
+	/** Opens a session for the lifetime of the object, unless there is
+	 *  one already. Sessions started by ApplyPostProcessing() thus end up 
+	 *  in the session of ReadFile() if the latter is the caller. */
+	class Session 
+	{
+	public:
+		Session(ImportProgressHandler& handler, ProgressHandler* user, unsigned int timeLimit)
+			: handler(handler.IsActive() ? NULL : &handler)
+		{
+			if (this->handler) {
+				this->handler->Begin(user,timeLimit);
+			}
+		}
+
+		~Session() {
+			if (handler) {
+				handler->End();
+			}
+		}
+
+	private:
+		ImportProgressHandler* handler;
+	};
+
+public:
+
+	ImportProgressHandler();
+	~ImportProgressHandler();
+
+public:
+
+	// ------------------------------------------------------------------------------------
+	/** Start a new import. 
+	 *  @param user Handler to forward updates to, may be NULL
+	 *  @param timeLimit Deadline in milliseconds from now, 0 for none */
+	void Begin(ProgressHandler* user, unsigned int timeLimit);
+
+	// ------------------------------------------------------------------------------------
+	/** Finish the current import, the cancellation state is kept */
+	void End();
+
+	// ------------------------------------------------------------------------------------
+	/** Check whether an import is in progress */
+	bool IsActive() const {
+		return active;
+	}
+
+	// ------------------------------------------------------------------------------------
+	/** Forward to the user's handler and check the deadline.
+	 *  @return false if the import has been cancelled */
+	virtual bool Update(float percentage = -1.f);
+
+	// ------------------------------------------------------------------------------------
+	/** Cheap check for tight loops. Calls #Update() every few hundred 
+	 *  calls and throws a #DeadlyImportError if the import has been 
+	 *  cancelled by then. Must be called from the importing thread only. */
+	void Poll();
+
+	// ------------------------------------------------------------------------------------
+	/** Check the deadline without calling the user's handler and throw a
+	 *  #DeadlyImportError if the import has been cancelled. Safe to be
+	 *  called from worker threads. */
+	void CheckDeadline();
+
+	// ------------------------------------------------------------------------------------
+	/** Check whether the import has been cancelled. Safe to be called
+	 *  from worker threads. */
+	bool IsCancelled() const;
+
+	// ------------------------------------------------------------------------------------
+	/** Get a description of why the import has been cancelled */
+	std::string GetReason() const;
+
+private:
+
+	/** Latch the cancelled state, the first reason wins */
+	void Cancel(const std::string& reason);
+
+	/** Check the deadline, cancel if it has passed */
+	bool IsPastDeadline();
+
+	// no copying
+	ImportProgressHandler(const ImportProgressHandler&);
+	ImportProgressHandler& operator = (const ImportProgressHandler&);
+
+	ProgressHandler* user;
+	unsigned int timeLimit;
+	double deadline;
+	unsigned int pollCount;
+
+	bool active;
+
+	// the cancelled state and its reason, shared with the worker threads
+	ImportProgressData* data;
+
+}; // !class ImportProgressHandler 
+} // Namespace Assimp
+
+#endif
@@ -67,11 +67,19 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "DefaultIOStream.h"
 #include "DefaultIOSystem.h"
 #include "DefaultProgressHandler.h"
+#include "ImportProgressHandler.h"
 #include "GenericProperty.h"
 #include "ProcessHelper.h"
+#include "PerMeshProcess.h"
 #include "ScenePreprocessor.h"
 #include "MemoryIOWrapper.h"
+#include "HeaderCacheIOWrapper.h"
+#include "GzipIOWrapper.h"
+#include "ZipArchiveIOSystem.h"
+#include "ImportCache.h"
 #include "Profiler.h"
+#include "MemoryTracker.h"
+#include "ThreadPool.h"
 #include "TinyFormatter.h"
 
 #ifndef ASSIMP_BUILD_NO_VALIDATEDS_PROCESS
@@ -81,13 +89,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 using namespace Assimp::Profiling;
 using namespace Assimp::Formatter;
 
-namespace Assimp {
-	// ImporterRegistry.cpp
-	void GetImporterInstanceList(std::vector< BaseImporter* >& out);
-	// PostStepRegistry.cpp
-	void GetPostProcessingStepInstanceList(std::vector< BaseProcess* >& out);
-}
-
 using namespace Assimp;
 using namespace Assimp::Intern;
 
@@ -131,6 +132,96 @@ void AllocateFromAssimpHeap::operator delete[] ( void* data)	{
 	return ::operator delete[](data);
 }
 
+// ------------------------------------------------------------------------------------------------
+// Rebuild the file extension lookup table after the list of importers has changed
+void ImporterPimpl::UpdateExtensionIndex()
+{
+	const ImporterRegistry& registry = ImporterRegistry::Get();
+	mCustomExtensionIndex.clear();
+
+	std::set<std::string> str;
+	for (unsigned int i = 0; i < mImporter.size(); ++i)	{
+		const unsigned int entry = mImporterRegistryIndex[i];
+		if (entry != ImporterRegistry::NO_ENTRY) {
+			str = registry.mEntries[entry].mExtensions;
+		}
+		else {
+			str.clear();
+			mImporter[i]->GetExtensionList(str);
+		}
+
+		for (std::set<std::string>::const_iterator it = str.begin(); it != str.end(); ++it) {
+			mCustomExtensionIndex[*it].push_back(i);
+		}
+	}
+	mExtensionIndex = &mCustomExtensionIndex;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get an importer instance suitable for CanRead() checks
+const BaseImporter* ImporterPimpl::GetImporterPrototype(unsigned int index) const
+{
+	ai_assert(index < mImporter.size());
+	if (mImporter[index]) {
+		return mImporter[index];
+	}
+	return ImporterRegistry::Get().mEntries[mImporterRegistryIndex[index]].mPrototype;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get our own instance of an importer, create it on first use
+BaseImporter* ImporterPimpl::GetImporter(unsigned int index)
+{
+	ai_assert(index < mImporter.size());
+	if (!mImporter[index]) {
+		mImporter[index] = ImporterRegistry::Get().mEntries[mImporterRegistryIndex[index]].mCreate();
+	}
+	return mImporter[index];
+}
+
+// ------------------------------------------------------------------------------------------------
+// Check whether the given flags may activate a post-processing step
+bool ImporterPimpl::IsPostProcessingStepRequested(unsigned int index, unsigned int flags) const
+{
+	ai_assert(index < mPostProcessingSteps.size());
+	if (mPostProcessingSteps[index]) {
+		return mPostProcessingSteps[index]->IsActive(flags);
+	}
+	return 0 != (gPostStepFactories[index].mFlags & flags);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get a post-processing step, create it on first use
+BaseProcess* ImporterPimpl::GetPostProcessingStep(unsigned int index)
+{
+	ai_assert(index < mPostProcessingSteps.size());
+	if (!mPostProcessingSteps[index]) {
+		mPostProcessingSteps[index] = gPostStepFactories[index].mCreate();
+		mPostProcessingSteps[index]->SetSharedData(mPPShared);
+	}
+	return mPostProcessingSteps[index];
+}
+
+// ------------------------------------------------------------------------------------------------
+// Replace the profiler and the memory tracker of the previous call
+void ImporterPimpl::ResetProfiling(bool measureTime, bool measureMemory)
+{
+	delete mProfiler;
+	mProfiler = NULL;
+	delete mMemoryTracker;
+	mMemoryTracker = NULL;
+
+	if (measureMemory) {
+		if (MemoryTracker::IsAvailable()) {
+			mMemoryTracker = new MemoryTracker();
+		}
+		else DefaultLogger::get()->warn("AI_CONFIG_GLOB_MEASURE_MEMORY is not available due to build settings");
+	}
+	if (measureTime || mMemoryTracker) {
+		mProfiler = new Profiler(mMemoryTracker);
+	}
+}
+
 // ------------------------------------------------------------------------------------------------
 // Importer constructor. 
 Importer::Importer() 
@@ -148,18 +239,31 @@ Importer::Importer()
 
 	pimpl->mProgressHandler = new DefaultProgressHandler();
 	pimpl->mIsDefaultProgressHandler = true;
+	pimpl->mImportProgress = new ImportProgressHandler();
 
-	GetImporterInstanceList(pimpl->mImporter);
-	GetPostProcessingStepInstanceList(pimpl->mPostProcessingSteps);
+	// The thread pool is created on demand by ApplyPostProcessing()
+	pimpl->mThreadPool = NULL;
 
-	// Allocate a SharedPostProcessInfo object and store pointers to it in all post-process steps in the list.
-	pimpl->mPPShared = new SharedPostProcessInfo();
-	for (std::vector<BaseProcess*>::iterator it =  pimpl->mPostProcessingSteps.begin();
-		it != pimpl->mPostProcessingSteps.end(); 
-		++it)	{
+	// The profiler and the memory tracker are created by ReadFile() on request
+	pimpl->mProfiler = NULL;
+	pimpl->mMemoryTracker = NULL;
 
-		(*it)->SetSharedData(pimpl->mPPShared);
+	// Importers and post-processing steps are created when they're needed,
+	// for now there is just a placeholder for each of them.
+	const ImporterRegistry& registry = ImporterRegistry::Get();
+	const unsigned int numImporters = static_cast<unsigned int>(registry.mEntries.size());
+
+	pimpl->mImporter.resize(numImporters,NULL);
+	pimpl->mImporterRegistryIndex.resize(numImporters);
+	for (unsigned int i = 0; i < numImporters; ++i) {
+		pimpl->mImporterRegistryIndex[i] = i;
 	}
+	pimpl->mExtensionIndex = &registry.mExtensionIndex;
+
+	pimpl->mPostProcessingSteps.resize(gNumPostStepFactories,NULL);
+
+	// Allocate a SharedPostProcessInfo object, GetPostProcessingStep() passes it to all steps it creates
+	pimpl->mPPShared = new SharedPostProcessInfo();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -177,6 +281,7 @@ Importer::~Importer()
 	// Delete the assigned IO and progress handler
 	delete pimpl->mIOHandler;
 	delete pimpl->mProgressHandler;
+	delete pimpl->mImportProgress;
 
 	// Kill imported scene. Destructors should do that recursivly
 	delete pimpl->mScene;
@@ -184,6 +289,13 @@ Importer::~Importer()
 	// Delete shared post-processing data
 	delete pimpl->mPPShared;
 
+	// Shut down all worker threads
+	delete pimpl->mThreadPool;
+
+	// Delete the last profiling report
+	delete pimpl->mProfiler;
+	delete pimpl->mMemoryTracker;
+
 	// and finally the pimpl itself
 	delete pimpl;
 }
@@ -242,6 +354,8 @@ aiReturn Importer::RegisterLoader(BaseImporter* pImp)
 
 	// add the loader
 	pimpl->mImporter.push_back(pImp);
+	pimpl->mImporterRegistryIndex.push_back(ImporterRegistry::NO_ENTRY);
+	pimpl->UpdateExtensionIndex();
 	DefaultLogger::get()->info("Registering custom importer for these file extensions: " + baked);
 	ASSIMP_END_EXCEPTION_REGION(aiReturn);
 	return AI_SUCCESS;
@@ -261,7 +375,9 @@ aiReturn Importer::UnregisterLoader(BaseImporter* pImp)
 		pimpl->mImporter.end(),pImp);
 
 	if (it != pimpl->mImporter.end())	{
+		pimpl->mImporterRegistryIndex.erase(pimpl->mImporterRegistryIndex.begin() + (it - pimpl->mImporter.begin()));
 		pimpl->mImporter.erase(it);
+		pimpl->UpdateExtensionIndex();
 
 		std::set<std::string> st;
 		pImp->GetExtensionList(st);
@@ -284,7 +400,8 @@ aiReturn Importer::UnregisterPPStep(BaseProcess* pImp)
 	}
 
 	ASSIMP_BEGIN_EXCEPTION_REGION();
-	std::vector<BaseProcess*>::iterator it = std::find(pimpl->mPostProcessingSteps.begin(),
+	// only custom steps can be removed, the built-in ones are never handed out
+	std::vector<BaseProcess*>::iterator it = std::find(pimpl->mPostProcessingSteps.begin() + gNumPostStepFactories,
 		pimpl->mPostProcessingSteps.end(),pImp);
 
 	if (it != pimpl->mPostProcessingSteps.end())	{
@@ -458,7 +575,7 @@ bool Importer::ValidateFlags(unsigned int pFlags) const
 		
 			bool have = false;
 			for( unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); a++)	{
-				if (pimpl->mPostProcessingSteps[a]-> IsActive(mask) ) {
+				if (pimpl->IsPostProcessingStepRequested(a,mask) ) {
 				
 					have = true;
 					break;
@@ -506,6 +623,122 @@ const aiScene* Importer::ReadFileFromMemory( const void* pBuffer,
 	return pimpl->mScene;
 }
 
+namespace {
+
+	// ------------------------------------------------------------------------------------------------
+	// Lends an IOSystem to an Importer for the lifetime of the guard. It is taken back on every
+	// exit path, so the Importer never deletes it, even if the import throws.
+	class BorrowedIOHandler
+	{
+	public:
+
+		BorrowedIOHandler(Importer& imp, IOSystem* io)
+			: imp	(imp)
+			, io	(io)
+		{
+			if (io) {
+				imp.SetIOHandler(io);
+			}
+		}
+
+		~BorrowedIOHandler()	{
+			if (io) {
+				// don't use SetIOHandler(NULL), it would allocate a DefaultIOSystem
+				imp.Pimpl()->mIOHandler = NULL;
+			}
+		}
+
+	private:
+
+		Importer& imp;
+		IOSystem* io;
+	};
+
+	// ------------------------------------------------------------------------------------------------
+	// Reads a single file of a ReadFiles() batch using a private Importer instance
+	class ReadFilesTask : public ParallelTask
+	{
+	public:
+
+		ReadFilesTask(const Importer& config, IOSystem* io, unsigned int numThreadsPerFile,
+			const char* const* files, unsigned int flags, aiScene** scenes, std::string* errors)
+			: config	(config)
+			, io		(io)
+			, numThreadsPerFile (numThreadsPerFile)
+			, files		(files)
+			, flags		(flags)
+			, scenes	(scenes)
+			, errors	(errors)
+		{}
+
+		void Run(unsigned int index)	{
+			// the copy constructor takes over all configuration properties
+			Importer imp(config);
+			imp.SetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING,numThreadsPerFile);
+
+			// the IOSystem is shared by all workers, don't let the Importer delete it
+			BorrowedIOHandler borrowed(imp,io);
+
+			imp.ReadFile(files[index],flags);
+			if (errors) {
+				errors[index] = imp.GetErrorString();
+			}
+			scenes[index] = imp.GetOrphanedScene();
+		}
+
+	private:
+
+		const Importer& config;
+		IOSystem* io;
+		unsigned int numThreadsPerFile;
+		const char* const* files;
+		unsigned int flags;
+		aiScene** scenes;
+		std::string* errors;
+	};
+}
+
+// ------------------------------------------------------------------------------------------------
+// Reads several files concurrently
+unsigned int Importer::ReadFiles( const char* const* pFiles,
+	unsigned int pNumFiles,
+	unsigned int pFlags,
+	aiScene** pScenesOut,
+	std::string* pErrorsOut /*= NULL*/)
+{
+	ai_assert(NULL != pFiles && NULL != pScenesOut);
+
+	unsigned int numSucceeded = 0;
+	ASSIMP_BEGIN_EXCEPTION_REGION();
+	if (!pNumFiles) {
+		return 0;
+	}
+	std::fill(pScenesOut,pScenesOut+pNumFiles,static_cast<aiScene*>(NULL));
+
+	// Import as many files in parallel as we may use threads, the threads 
+	// which remain are left to the post-processing steps of each import.
+	const unsigned int numThreads = ThreadPool::GetThreadCountForConfig(
+		GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING,AI_MULTITHREADING_DEFAULT));
+	const unsigned int numWorkers = std::min(numThreads,pNumFiles);
+
+	ThreadPool pool(numWorkers);
+	ReadFilesTask task(*this,pimpl->mIsDefaultHandler ? NULL : pimpl->mIOHandler, 
+		std::max(1u,numThreads/numWorkers),pFiles,pFlags,pScenesOut,pErrorsOut);
+
+	pool.ParallelFor(task,pNumFiles);
+
+	for (unsigned int i = 0; i < pNumFiles; ++i) {
+		if (pScenesOut[i]) {
+			++numSucceeded;
+		}
+	}
+	DefaultLogger::get()->info(format() << "Batch import finished, " 
+		<< numSucceeded << " of " << pNumFiles << " files succeeded");
+
+	ASSIMP_END_EXCEPTION_REGION(unsigned int);
+	return numSucceeded;
+}
+
 // ------------------------------------------------------------------------------------------------
 void WriteLogOpening(const std::string& file)
 {
@@ -595,44 +828,135 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 			FreeScene();
 		}
 
-		// First check if the file is accessable at all
-		if( !pimpl->mIOHandler->Exists( pFile))	{
+		// First check if the file is accessable at all. Files in zip archives are
+		// addressed by their path through the archive, i.e. 'models.zip/spider/spider.obj'.
+		boost::scoped_ptr<ZipArchiveIOSystem> zipIO;
+		IOSystem* fileIO = pimpl->mIOHandler;
+		if( !fileIO->Exists( pFile))	{
 
-			pimpl->mErrorString = "Unable to open file \"" + pFile + "\".";
-			DefaultLogger::get()->error(pimpl->mErrorString);
-			return NULL;
+			zipIO.reset(ZipArchiveIOSystem::OpenForFile(fileIO,pFile,ThreadPool::GetThreadCountForConfig(
+				GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING,AI_MULTITHREADING_DEFAULT))));
+			if (!zipIO) {
+				pimpl->mErrorString = "Unable to open file \"" + pFile + "\".";
+				DefaultLogger::get()->error(pimpl->mErrorString);
+				return NULL;
+			}
+			fileIO = zipIO.get();
 		}
 
-		boost::scoped_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME,0)?new Profiler():NULL);
-		if (profiler) {
-			profiler->BeginRegion("total");
+		// Start a new profiling report, the previous one is dropped
+		pimpl->ResetProfiling(0 != GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME,0),
+			0 != GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_MEMORY,0));
+
+		// Count our allocations from here on, including those of the worker threads
+		MemoryTracker::Scope trackMemory(pimpl->mMemoryTracker);
+
+		// ended on all paths out of here, the next report must not be nested into this one
+		Profiler* const profiler = pimpl->mProfiler;
+		Profiler::ScopedRegion totalRegion(profiler,"total",pimpl->mScene);
+
+		// Start the clock for AI_CONFIG_GLOB_TIME_LIMIT, post-processing is included
+		ImportProgressHandler::Session progressSession(*pimpl->mImportProgress,pimpl->mProgressHandler,
+			std::max(0,GetPropertyInteger(AI_CONFIG_GLOB_TIME_LIMIT,0)));
+
+		// Tell the default IOSystem which files to map into memory
+		if (DefaultIOSystem* fs = dynamic_cast<DefaultIOSystem*>(pimpl->mIOHandler)) {
+			const int threshold = GetPropertyInteger(AI_CONFIG_GLOB_MEMORY_MAPPING,AI_DEFAULTIO_MAPPING_THRESHOLD);
+			fs->SetMappingThreshold(threshold < 0 ? SIZE_MAX : static_cast<size_t>(threshold));
 		}
 
-		// Find an worker class which can handle the file
-		BaseImporter* imp = NULL;
-		for( unsigned int a = 0; a < pimpl->mImporter.size(); a++)	{
+		// Serve the file from the on-disk cache if it has been imported with the same settings before
+		boost::scoped_ptr<ImportCache> cache;
+		const std::string cacheDirectory = GetPropertyString(AI_CONFIG_GLOB_IMPORT_CACHE,"");
+		if (!cacheDirectory.empty()) {
+			if (profiler) {
+				profiler->BeginRegion("cache");
+			}
+
+			cache.reset(new ImportCache(cacheDirectory,fileIO));
+			if (cache->ComputeKey(pFile,pFlags,*pimpl)) {
+				pimpl->mScene = cache->Load();
+			}
+			else cache.reset();
 
-			if( pimpl->mImporter[a]->CanRead( pFile, pimpl->mIOHandler, false)) {
-				imp = pimpl->mImporter[a];
+			if (profiler) {
+				profiler->EndRegion("cache",pimpl->mScene);
+			}
+
+			if (pimpl->mScene) {
+				return pimpl->mScene;
+			}
+		}
+
+		// The cache needs to know all files the loader reads to tell whether its entry is still valid.
+		IOSystem* io = cache ? cache->GetRecordingIOSystem() : fileIO;
+
+		// Decompress the file and whatever is likely to be read with it on multiple threads
+		if (zipIO) {
+			zipIO->PrefetchRelated(pFile);
+		}
+
+		// Find an worker class which can handle the file. All signature checks
+		// are served from a single cached copy of the file header, so the file
+		// is opened once and not once per importer.
+		boost::scoped_ptr<GzipIOSystem> gzipIO;
+		boost::scoped_ptr<HeaderCacheIOSystem> probeIO(new HeaderCacheIOSystem(io,pFile));
+
+		// gzip-compressed files are decompressed on the fly while they are loaded. 
+		// Loaders see them under their uncompressed name, so the format is detected 
+		// from the extension in front of '.gz'.
+		if (GzipIOSystem::IsCompressed(probeIO.get(),pFile)) {
+			DefaultLogger::get()->info("File is gzip-compressed, decompressing it while loading");
+
+			gzipIO.reset(new GzipIOSystem(io,pFile));
+			io = gzipIO.get();
+			probeIO.reset(new HeaderCacheIOSystem(io,gzipIO->GetName()));
+		}
+		const std::string& file = gzipIO ? gzipIO->GetName() : pFile;
+
+		// Importers which haven't been created yet are probed through their
+		// shared prototypes, only the one chosen is instantiated.
+		static const unsigned int noImporter = ImporterRegistry::NO_ENTRY;
+		unsigned int found = noImporter;
+
+		// Importers registered for the file extension get the first chance
+		static const std::vector<unsigned int> noCandidates;
+		ImporterPimpl::ExtensionIndex::const_iterator fnd = pimpl->mExtensionIndex->find(BaseImporter::GetExtension(file));
+		const std::vector<unsigned int>& candidates = fnd != pimpl->mExtensionIndex->end() ? (*fnd).second : noCandidates;
+
+		for (std::vector<unsigned int>::const_iterator it = candidates.begin(); it != candidates.end(); ++it) {
+			if( pimpl->GetImporterPrototype(*it)->CanRead( file, probeIO.get(), false)) {
+				found = *it;
 				break;
 			}
 		}
 
-		if (!imp)	{
+		// Then all others - for files without extension this is where the signatures are checked
+		if (found == noImporter) {
+			for( unsigned int a = 0; a < pimpl->mImporter.size(); a++)	{
+
+				if (std::find(candidates.begin(),candidates.end(),a) == candidates.end() && pimpl->GetImporterPrototype(a)->CanRead( file, probeIO.get(), false)) {
+					found = a;
+					break;
+				}
+			}
+		}
+
+		if (found == noImporter)	{
 			// not so bad yet ... try format auto detection.
-			const std::string::size_type s = pFile.find_last_of('.');
+			const std::string::size_type s = file.find_last_of('.');
 			if (s != std::string::npos) {
 				DefaultLogger::get()->info("File extension not known, trying signature-based detection");
 				for( unsigned int a = 0; a < pimpl->mImporter.size(); a++)	{
 
-					if( pimpl->mImporter[a]->CanRead( pFile, pimpl->mIOHandler, true)) {
-						imp = pimpl->mImporter[a];
+					if( pimpl->GetImporterPrototype(a)->CanRead( file, probeIO.get(), true)) {
+						found = a;
 						break;
 					}
 				}
 			}
 			// Put a proper error message if no suitable importer was found
-			if( !imp)	{
+			if( found == noImporter)	{
 				pimpl->mErrorString = "No suitable reader found for the file format of file \"" + pFile + "\".";
 				DefaultLogger::get()->error(pimpl->mErrorString);
 				return NULL;
@@ -640,18 +964,26 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 		}
 
 		// Dispatch the reading to the worker class for this format
+		BaseImporter* const imp = pimpl->GetImporter(found);
 		DefaultLogger::get()->info("Found a matching importer for this file format");
-		pimpl->mProgressHandler->Update();
+		if (!pimpl->mImportProgress->Update()) {
+			pimpl->mErrorString = pimpl->mImportProgress->GetReason();
+			DefaultLogger::get()->error(pimpl->mErrorString);
+			return NULL;
+		}
 
 		if (profiler) {
 			profiler->BeginRegion("import");
 		}
 
-		pimpl->mScene = imp->ReadFile( this, pFile, pimpl->mIOHandler);
-		pimpl->mProgressHandler->Update();
+		// Loaders poll for cancellation themselves and fail if it happens
+		pimpl->mScene = imp->ReadFile( this, file, io);
+		if (pimpl->mScene && !pimpl->mImportProgress->Update()) {
+			FreeScene();
+		}
 
 		if (profiler) {
-			profiler->EndRegion("import");
+			profiler->EndRegion("import",pimpl->mScene);
 		}
 
 		// If successful, apply all active post processing steps to the imported data
@@ -671,31 +1003,48 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 
 			// Preprocess the scene and prepare it for post-processing 
 			if (profiler) {
-				profiler->BeginRegion("preprocess");
+				profiler->BeginRegion("preprocess",pimpl->mScene);
 			}
 
 			ScenePreprocessor pre(pimpl->mScene);
 			pre.ProcessScene();
 
-			pimpl->mProgressHandler->Update();
+			if (!pimpl->mImportProgress->Update()) {
+				FreeScene();
+			}
 			if (profiler) {
-				profiler->EndRegion("preprocess");
+				profiler->EndRegion("preprocess",pimpl->mScene);
 			}
+		}
+
+		if( pimpl->mScene)	{
 
 			// Ensure that the validation process won't be called twice
 			ApplyPostProcessing(pFlags & (~aiProcess_ValidateDataStructure));
+
+			if (pimpl->mScene && cache) {
+				if (profiler) {
+					profiler->BeginRegion("cache",pimpl->mScene);
+				}
+				cache->Store(pimpl->mScene);
+				if (profiler) {
+					profiler->EndRegion("cache",pimpl->mScene);
+				}
+			}
 		}
 		// if failed, extract the error string
 		else if( !pimpl->mScene) {
 			pimpl->mErrorString = imp->GetErrorText();
 		}
 
+		// a cancelled import always tells why, whatever step noticed it
+		if (!pimpl->mScene && pimpl->mImportProgress->IsCancelled()) {
+			pimpl->mErrorString = pimpl->mImportProgress->GetReason();
+			DefaultLogger::get()->error(pimpl->mErrorString);
+		}
+
 		// clear any data allocated by post-process steps
 		pimpl->mPPShared->Clean();
-
-		if (profiler) {
-			profiler->EndRegion("total");
-		}
 	}
 #ifdef ASSIMP_CATCH_GLOBAL_EXCEPTIONS
 	catch (std::exception &e)
@@ -737,6 +1086,10 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags)
 	ai_assert(_ValidateFlags(pFlags));
 	DefaultLogger::get()->info("Entering post processing pipeline");
 
+	// Nothing to do if called by ReadFile(), else this starts a new time limit
+	ImportProgressHandler::Session progressSession(*pimpl->mImportProgress,pimpl->mProgressHandler,
+		std::max(0,GetPropertyInteger(AI_CONFIG_GLOB_TIME_LIMIT,0)));
+
 #ifndef ASSIMP_BUILD_NO_VALIDATEDS_PROCESS
 	// The ValidateDS process plays an exceptional role. It isn't contained in the global
 	// list of post-processing steps, so we need to call it manually.
@@ -763,21 +1116,83 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags)
 	}
 #endif // ! DEBUG
 
-	boost::scoped_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME,0)?new Profiler():NULL);
+	// (Re-)create the worker threads for per-mesh work if the configured count changed
+	const unsigned int numThreads = ThreadPool::GetThreadCountForConfig(
+		GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING,AI_MULTITHREADING_DEFAULT));
+
+	if (!pimpl->mThreadPool || pimpl->mThreadPool->GetNumThreads() != numThreads) {
+		delete pimpl->mThreadPool;
+		pimpl->mThreadPool = new ThreadPool(numThreads);
+	}
+
+	// Called by ReadFile(), the timings are added to its report. Otherwise a new report is started.
+	if (!pimpl->mProfiler || !pimpl->mProfiler->IsRegionOpen()) {
+		pimpl->ResetProfiling(0 != GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME,0),
+			0 != GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_MEMORY,0));
+	}
+	MemoryTracker::Scope trackMemory(pimpl->mMemoryTracker);
+
+	Profiler* const profiler = pimpl->mProfiler;
+	Profiler::ScopedRegion postProcessRegion(profiler,"postprocess",pimpl->mScene);
+
+	// Consecutive steps which process each mesh on its own are run in a single pass over 
+	// the meshes, unless the scene is to be revalidated after each step
+	const bool fuseSteps = 0 != GetPropertyInteger(AI_CONFIG_GLOB_FUSE_MESH_STEPS,1) && !pimpl->bExtraVerbose;
+
 	for( unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); a++)	{
 
-		BaseProcess* process = pimpl->mPostProcessingSteps[a];
-		if( process->IsActive( pFlags))	{
+		// steps are only created if their flags have been requested
+		BaseProcess* process = pimpl->IsPostProcessingStepRequested(a,pFlags) ? pimpl->GetPostProcessingStep(a) : NULL;
+		if( process && process->IsActive( pFlags))	{
+
+			std::string name = a < gNumPostStepFactories ? gPostStepFactories[a].mName : "CustomProcess";
+
+			// Collect the active steps following this one as long as they are per-mesh steps,
+			// too. Inactive steps in between don't matter as they don't touch the scene.
+			FusedMeshProcess fused;
+			PerMeshProcess* const perMesh = fuseSteps ? dynamic_cast<PerMeshProcess*>(process) : NULL;
+			if (perMesh) {
+				fused.SetSharedData(pimpl->mPPShared);
+				fused.Add(perMesh,name.c_str());
+
+				for (unsigned int b = a+1; b < pimpl->mPostProcessingSteps.size(); ++b) {
+					BaseProcess* const next = pimpl->IsPostProcessingStepRequested(b,pFlags) ? pimpl->GetPostProcessingStep(b) : NULL;
+					if (!next || !next->IsActive(pFlags)) {
+						continue;
+					}
+					PerMeshProcess* const nextPerMesh = dynamic_cast<PerMeshProcess*>(next);
+					if (!nextPerMesh) {
+						break;
+					}
+					fused.Add(nextPerMesh,b < gNumPostStepFactories ? gPostStepFactories[b].mName : "CustomProcess");
+					a = b;
+				}
+				if (fused.GetNumSteps() > 1) {
+					process = &fused;
+					name = fused.GetName();
+				}
+			}
 
 			if (profiler) {
-				profiler->BeginRegion("postprocess");
+				profiler->BeginRegion(name,pimpl->mScene);
 			}
 
+			// the step fails and drops the scene if it notices the cancellation itself
 			process->ExecuteOnScene	( this );
-			pimpl->mProgressHandler->Update();
+
+			// drop all derived mesh data the step may have made stale without noting it
+			if (!process->MaintainsMeshData()) {
+				pimpl->mPPShared->GetMeshData().Clear();
+			}
+			if (pimpl->mScene && !pimpl->mImportProgress->Update()) {
+				pimpl->mErrorString = pimpl->mImportProgress->GetReason();
+				DefaultLogger::get()->error(pimpl->mErrorString);
+				delete pimpl->mScene;
+				pimpl->mScene = NULL;
+			}
 
 			if (profiler) {
-				profiler->EndRegion("postprocess");
+				profiler->EndRegion(name,pimpl->mScene);
 			}
 		}
 		if( !pimpl->mScene) {
@@ -804,7 +1219,9 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags)
 	}
 
 	// update private scene flags
-	ScenePriv(pimpl->mScene)->mPPStepsApplied |= pFlags;
+	if (pimpl->mScene) {
+		ScenePriv(pimpl->mScene)->mPPStepsApplied |= pFlags;
+	}
 
 	// clear any data allocated by post-process steps
 	pimpl->mPPShared->Clean();
@@ -814,11 +1231,32 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags)
 	return pimpl->mScene;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Strip leading wildcards and dots from a file extension and convert it to lower case
+std::string GetNormalizedExtension(const char* szExtension)
+{
+	// skip over wildcard and dot characters at string head --
+	for(;*szExtension == '*' || *szExtension == '.'; ++szExtension);
+
+	std::string ext(szExtension);
+	std::transform(ext.begin(),ext.end(), ext.begin(), tolower);
+	return ext;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Helper function to check whether an extension is supported by ASSIMP
 bool Importer::IsExtensionSupported(const char* szExtension) const
 {
-	return NULL != FindLoader(szExtension);
+	ai_assert(szExtension);
+	ASSIMP_BEGIN_EXCEPTION_REGION();
+
+	// don't use FindLoader(), no need to create the loader just to answer this
+	const std::string ext = GetNormalizedExtension(szExtension);
+	if (!ext.empty() && pimpl->mExtensionIndex->find(ext) != pimpl->mExtensionIndex->end()) {
+		return true;
+	}
+	ASSIMP_END_EXCEPTION_REGION(bool);
+	return false;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -828,25 +1266,14 @@ BaseImporter* Importer::FindLoader (const char* szExtension) const
 	ai_assert(szExtension);
 	ASSIMP_BEGIN_EXCEPTION_REGION();
 
-	// skip over wildcard and dot characters at string head --
-	for(;*szExtension == '*' || *szExtension == '.'; ++szExtension);
-
-	std::string ext(szExtension);
+	const std::string ext = GetNormalizedExtension(szExtension);
 	if (ext.empty()) {
 		return NULL;
 	}
-	std::transform(ext.begin(),ext.end(), ext.begin(), tolower);
-
-	std::set<std::string> str;
-	for (std::vector<BaseImporter*>::const_iterator i =  pimpl->mImporter.begin();i != pimpl->mImporter.end();++i)	{
-		str.clear();
 
-		(*i)->GetExtensionList(str);
-		for (std::set<std::string>::const_iterator it = str.begin(); it != str.end(); ++it) {
-			if (ext == *it) {
-				return (*i);
-			}
-		}
+	ImporterPimpl::ExtensionIndex::const_iterator it = pimpl->mExtensionIndex->find(ext);
+	if (it != pimpl->mExtensionIndex->end()) {
+		return pimpl->GetImporter((*it).second.front());
 	}
 	ASSIMP_END_EXCEPTION_REGION(BaseImporter*);
 	return NULL;
@@ -857,16 +1284,13 @@ BaseImporter* Importer::FindLoader (const char* szExtension) const
 void Importer::GetExtensionList(aiString& szOut) const
 {
 	ASSIMP_BEGIN_EXCEPTION_REGION();
-	std::set<std::string> str;
-	for (std::vector<BaseImporter*>::const_iterator i =  pimpl->mImporter.begin();i != pimpl->mImporter.end();++i)	{
-		(*i)->GetExtensionList(str);
-	}
-
-	for (std::set<std::string>::const_iterator it = str.begin();; ) {
+	// the extension index knows them all, sorted and without duplicates
+	const ImporterPimpl::ExtensionIndex& index = *pimpl->mExtensionIndex;
+	for (ImporterPimpl::ExtensionIndex::const_iterator it = index.begin(); it != index.end(); ) {
 		szOut.Append("*.");
-		szOut.Append((*it).c_str());
+		szOut.Append((*it).first.c_str());
 
-		if (++it == str.end()) {
+		if (++it == index.end()) {
 			break;
 		}
 		szOut.Append(";");
@@ -928,6 +1352,20 @@ const std::string& Importer::GetPropertyString(const char* szName,
 	return GetGenericProperty<std::string>(pimpl->mStringProperties,szName,iErrorReturn);
 }
 
+// ------------------------------------------------------------------------------------------------
+// Get the timings of the last import
+const aiProfilingRegion* Importer::GetProfilingReport() const
+{
+	return pimpl->mProfiler ? pimpl->mProfiler->GetReport() : NULL;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get the timings of the last import as JSON
+const char* Importer::GetProfilingReportAsJSON() const
+{
+	return pimpl->mProfiler ? pimpl->mProfiler->GetReportAsJSON().c_str() : "";
+}
+
 // ------------------------------------------------------------------------------------------------
 // Get the memory requirements of a single node
 inline void AddNodeWeight(unsigned int& iScene,const aiNode* pcNode)
@@ -948,6 +1386,12 @@ void Importer::GetMemoryRequirements(aiMemoryInfo& in) const
 	in = aiMemoryInfo();
 	aiScene* mScene = pimpl->mScene;
 
+	// heap peak of the last ReadFile() or ApplyPostProcessing() call, if it was measured
+	if (pimpl->mMemoryTracker) {
+		const size_t peak = pimpl->mMemoryTracker->GetCounters().peak;
+		in.peak = peak > UINT_MAX ? UINT_MAX : static_cast<unsigned int>(peak);
+	}
+
 	// return if we have no scene loaded
 	if (!pimpl->mScene)
 		return;
@@ -46,6 +46,12 @@ namespace Assimp	{
 
 	class BaseImporter;
 	class BaseProcess;
+	class ThreadPool;
+	class MemoryTracker;
+	class ImportProgressHandler;
+	namespace Profiling {
+		class Profiler;
+	}
 
 	
 //! @cond never
@@ -69,6 +75,9 @@ public:
 	typedef std::map<KeyType, float> FloatPropertyMap;
 	typedef std::map<KeyType, std::string> StringPropertyMap;
 
+	// maps lower-case file extensions to the indices of all importers claiming them
+	typedef std::map<std::string, std::vector<unsigned int> > ExtensionIndex;
+
 public:
 
 	/** IO handler to use for all file accesses. */
@@ -79,10 +88,28 @@ public:
 	ProgressHandler* mProgressHandler;
 	bool mIsDefaultProgressHandler;
 
-	/** Format-specific importer worker objects - one for each format we can read.*/
+	/** Passed to loaders and steps instead of mProgressHandler, keeps
+	 *  track of cancellation and of #AI_CONFIG_GLOB_TIME_LIMIT. */
+	ImportProgressHandler* mImportProgress;
+
+	/** Format-specific importer worker objects - one for each format we can read.
+	 *  Built-in importers are created when they are chosen to read a file,
+	 *  until then their entry is NULL. */
 	std::vector< BaseImporter* > mImporter;
 
-	/** Post processing steps we can apply at the imported data. */
+	/** Index into the ImporterRegistry for each entry of mImporter,
+	 *  ImporterRegistry::NO_ENTRY for custom importers. */
+	std::vector< unsigned int > mImporterRegistryIndex;
+
+	/** Lookup table from file extensions to the entries of mImporter 
+	 *  supporting them, in registration order. Points to the shared table 
+	 *  of the ImporterRegistry until custom importers are (un)registered. */
+	const ExtensionIndex* mExtensionIndex;
+	ExtensionIndex mCustomExtensionIndex;
+
+	/** Post processing steps we can apply at the imported data. The first
+	 *  entries are the built-in steps from gPostStepFactories, which are
+	 *  created when their flags are requested and are NULL until then. */
 	std::vector< BaseProcess* > mPostProcessingSteps;
 
 	/** The imported data, if ReadFile() was successful, NULL otherwise. */
@@ -106,7 +133,111 @@ public:
 
 	/** Used by post-process steps to share data */
 	SharedPostProcessInfo* mPPShared;
+
+	/** Worker threads for post-process steps, sized by 
+	 *  #AI_CONFIG_GLOB_MULTITHREADING. Created on demand, may be NULL. */
+	ThreadPool* mThreadPool;
+
+	/** Timings of the last ReadFile() or ApplyPostProcessing() call,
+	 *  NULL unless #AI_CONFIG_GLOB_MEASURE_TIME or 
+	 *  #AI_CONFIG_GLOB_MEASURE_MEMORY is set. */
+	Profiling::Profiler* mProfiler;
+
+	/** Heap usage of the last ReadFile() or ApplyPostProcessing() call,
+	 *  NULL unless #AI_CONFIG_GLOB_MEASURE_MEMORY is set and supported. */
+	MemoryTracker* mMemoryTracker;
+
+public:
+
+	/** Rebuild mExtensionIndex after mImporter has been changed */
+	void UpdateExtensionIndex();
+
+	/** Get an importer to call CanRead() on, this is our own instance
+	 *  if there is one and the shared prototype otherwise. */
+	const BaseImporter* GetImporterPrototype(unsigned int index) const;
+
+	/** Get our own instance of an importer, create it if necessary */
+	BaseImporter* GetImporter(unsigned int index);
+
+	/** Check whether a post-processing step might be activated by the
+	 *  given flags without creating it. BaseProcess::IsActive() has the
+	 *  final say. */
+	bool IsPostProcessingStepRequested(unsigned int index, unsigned int flags) const;
+
+	/** Get a post-processing step, create it if necessary */
+	BaseProcess* GetPostProcessingStep(unsigned int index);
+
+	/** Drop the last profiling report and memory counters and set
+	 *  up new ones as requested by the given properties. */
+	void ResetProfiling(bool measureTime, bool measureMemory);
 };
+
+// ---------------------------------------------------------------------------
+/** Process-wide list of all built-in importers, see ImporterRegistry.cpp.
+ *
+ *  Importer instances don't create any importer upfront. Format detection
+ *  runs on the prototypes kept here, which are shared by all Importers as
+ *  CanRead() is const. The registry is built on first use and doesn't 
+ *  change afterwards. */
+class ImporterRegistry
+{
+public:
+
+	typedef BaseImporter* (*Factory)();
+
+	// mImporterRegistryIndex for importers not in the registry
+	static const unsigned int NO_ENTRY = 0xffffffff;
+
+	struct Entry
+	{
+		/** Creates a new instance of the importer */
+		Factory mCreate;
+
+		/** Instance to call CanRead() on. */
+		const BaseImporter* mPrototype;
+
+		/** File extensions handled by the importer */
+		std::set<std::string> mExtensions;
+	};
+
+public:
+
+	/** Get the registry, build it if this is the first call. Only
+	 *  the first call synchronizes with other threads. */
+	static const ImporterRegistry& Get();
+
+	std::vector<Entry> mEntries;
+
+	/** File extensions to indices into mEntries */
+	ImporterPimpl::ExtensionIndex mExtensionIndex;
+
+private:
+
+	ImporterRegistry();
+	~ImporterRegistry();
+
+	/** Build the registry, called exactly once by Get() */
+	static void Create();
+};
+
+// ---------------------------------------------------------------------------
+/** Factory for a built-in post-processing step */
+struct PostStepFactory
+{
+	/** Creates a new instance of the step */
+	BaseProcess* (*mCreate)();
+
+	/** Name of the step for logs and profiling reports */
+	const char* mName;
+
+	/** The step can't be active unless one of these flags is set */
+	unsigned int mFlags;
+};
+
+// PostStepRegistry.cpp, all built-in steps in order of execution
+extern const PostStepFactory gPostStepFactories[];
+extern const unsigned int gNumPostStepFactories;
+
 //! @endcond
 
 
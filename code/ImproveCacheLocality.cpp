@@ -51,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers
 #include "ImproveCacheLocality.h"
 #include "VertexTriangleAdjacency.h"
+#include "ProcessHelper.h"
 
 using namespace Assimp;
 
@@ -83,8 +84,8 @@ void ImproveCacheLocalityProcess::SetupProperties(const Importer* pImp)
 }
 
 // ------------------------------------------------------------------------------------------------
-// Executes the post processing step on the given imported data.
-void ImproveCacheLocalityProcess::Execute( aiScene* pScene)
+// Prepares the post processing step for the given imported data.
+void ImproveCacheLocalityProcess::BeginMeshes( aiScene* pScene)
 {
 	if (!pScene->mNumMeshes) {
 		DefaultLogger::get()->debug("ImproveCacheLocalityProcess skipped; there are no meshes");
@@ -92,17 +93,40 @@ void ImproveCacheLocalityProcess::Execute( aiScene* pScene)
 	}
 
 	DefaultLogger::get()->debug("ImproveCacheLocalityProcess begin");
+	results.reset(new float[pScene->mNumMeshes]);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Executes the post processing step on a single mesh.
+void ImproveCacheLocalityProcess::ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex, MeshPipelineContext& context)
+{
+	// only the order of the faces changes, so derived vertex data stays valid
+	results[meshIndex] = ProcessMesh(pMesh,meshIndex);
+	if (results[meshIndex]) {
+		context.Invalidate(MeshDataCache::Faces);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// Finishes the post processing step.
+void ImproveCacheLocalityProcess::EndMeshes( aiScene* pScene)
+{
+	if (!pScene->mNumMeshes) {
+		return;
+	}
 
 	float out = 0.f;
 	unsigned int numf = 0, numm = 0;
 	for( unsigned int a = 0; a < pScene->mNumMeshes; a++){
-		const float res = ProcessMesh( pScene->mMeshes[a],a);
+		const float res = results[a];
 		if (res) {
 			numf += pScene->mMeshes[a]->mNumFaces;
 			out  += res;
 			++numm;
 		}
 	}
+	results.reset();
+
 	if (!DefaultLogger::isNullLogger()) {
 		char szBuff[128]; // should be sufficiently large in every case
 		::sprintf(szBuff,"Cache relevant are %i meshes (%i faces). Average output ACMR is %f",
@@ -43,7 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_IMPROVECACHELOCALITY_H_INC
 #define AI_IMPROVECACHELOCALITY_H_INC
 
-#include "BaseProcess.h"
+#include "PerMeshProcess.h"
 #include "../include/assimp/types.h"
 
 struct aiMesh;
@@ -58,7 +58,7 @@ namespace Assimp
  *
  *  @note This step expects triagulated input data.
  */
-class ImproveCacheLocalityProcess : public BaseProcess
+class ImproveCacheLocalityProcess : public PerMeshProcess
 {
 public:
 
@@ -72,8 +72,10 @@ public:
 	bool IsActive( unsigned int pFlags) const;
 
 	// -------------------------------------------------------------------
-	// Executes the pp step on a given scene
-	void Execute( aiScene* pScene);
+	// Executes the pp step on a given scene, see PerMeshProcess
+	void BeginMeshes( aiScene* pScene);
+	void ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex, MeshPipelineContext& context);
+	void EndMeshes( aiScene* pScene);
 
 	// -------------------------------------------------------------------
 	// Configures the pp step
@@ -91,6 +93,9 @@ private:
 	//! Configuration parameter: specifies the size of the cache to
 	//! optimize the vertex data for.
 	unsigned int configCacheDepth;
+
+	//! Return value of ProcessMesh() for each mesh
+	boost::scoped_array<float> results;
 };
 
 } // end of namespace Assimp
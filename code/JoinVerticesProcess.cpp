@@ -56,7 +56,6 @@ using namespace Assimp;
 // Constructor to be privately used by Importer
 JoinVerticesProcess::JoinVerticesProcess()
 {
-	// nothing to do here
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -73,23 +72,41 @@ bool JoinVerticesProcess::IsActive( unsigned int pFlags) const
 	return (pFlags & aiProcess_JoinIdenticalVertices) != 0;
 }
 // ------------------------------------------------------------------------------------------------
-// Executes the post processing step on the given imported data.
-void JoinVerticesProcess::Execute( aiScene* pScene)
+// Prepares the post processing step for the given imported data.
+void JoinVerticesProcess::BeginMeshes( aiScene* pScene)
 {
 	DefaultLogger::get()->debug("JoinVerticesProcess begin");
 
-	// get the total number of vertices BEFORE the step is executed
-	int iNumOldVertices = 0;
-	if (!DefaultLogger::isNullLogger()) {
-		for( unsigned int a = 0; a < pScene->mNumMeshes; a++)	{
-			iNumOldVertices +=	pScene->mMeshes[a]->mNumVertices;
-		}
+	oldVertices.reset(new int[pScene->mNumMeshes]);
+	results.reset(new int[pScene->mNumMeshes]);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Executes the post processing step on a single mesh - meshes are independent,
+// so they may be processed concurrently
+void JoinVerticesProcess::ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex, MeshPipelineContext& context)
+{
+	// get the number of vertices BEFORE the step is executed on the mesh
+	oldVertices[meshIndex] = pMesh->mNumVertices;
+	results[meshIndex] = ProcessMesh(pMesh,meshIndex,context);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Finishes the post processing step.
+void JoinVerticesProcess::EndMeshes( aiScene* pScene)
+{
+	// don't bother with the results if the user cancelled meanwhile
+	if (progress && !progress->Update()) {
+		throw DeadlyImportError(progress->GetReason());
 	}
 
-	// execute the step
-	int iNumVertices = 0;
-	for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
-		iNumVertices +=	ProcessMesh( pScene->mMeshes[a],a);
+	int iNumOldVertices = 0, iNumVertices = 0;
+	for( unsigned int a = 0; a < pScene->mNumMeshes; a++)	{
+		iNumOldVertices += oldVertices[a];
+		iNumVertices +=	results[a];
+	}
+	oldVertices.reset();
+	results.reset();
 
 	// if logging is active, print detailed statistics
 	if (!DefaultLogger::isNullLogger())
@@ -114,6 +131,14 @@ void JoinVerticesProcess::Execute( aiScene* pScene)
 // ------------------------------------------------------------------------------------------------
 // Unites identical vertices in the given mesh
 int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
+{
+	MeshPipelineContext context(pMesh,shared);
+	return ProcessMesh(pMesh,meshIndex,context);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Unites identical vertices in the given mesh
+int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex, MeshPipelineContext& context)
 {
 	BOOST_STATIC_ASSERT( AI_MAX_NUMBER_OF_COLOR_SETS    == 8);
 	BOOST_STATIC_ASSERT( AI_MAX_NUMBER_OF_TEXTURECOORDS == 8);
@@ -136,27 +161,13 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
 	std::vector<unsigned int> replaceIndex( pMesh->mNumVertices, 0xffffffff);
 
 	// A little helper to find locally close vertices faster.
-	// Try to reuse the lookup table from the last step.
+	// The context reuses the lookup table from the last step if possible.
 	const static float epsilon = 1e-5f;
-	// float posEpsilonSqr;
-	SpatialSort* vertexFinder = NULL;
-	SpatialSort _vertexFinder;
-
-	typedef std::pair<SpatialSort,float> SpatPair;
-	if (shared)	{
-		std::vector<SpatPair >* avf;
-		shared->GetProperty(AI_SPP_SPATIAL_SORT,avf);
-		if (avf)	{
-			SpatPair& blubb = (*avf)[meshIndex];
-			vertexFinder  = &blubb.first;
-			// posEpsilonSqr = blubb.second;
-		}
-	}
-	if (!vertexFinder)	{
-		// bad, need to compute it.
-		_vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof( aiVector3D));
-		vertexFinder = &_vertexFinder; 
-		// posEpsilonSqr = ComputePositionEpsilon(pMesh);
+	SpatialSort* const vertexFinder = &context.GetSpatialSort();
+
+	// we may run on a worker thread, so only the time limit can be checked here
+	if (progress) {
+		progress->CheckDeadline();
 	}
 
 	// Squared because we check against squared length of the vector difference
@@ -172,6 +183,10 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
 
 	// Now check each vertex if it brings something new to the table
 	for( unsigned int a = 0; a < pMesh->mNumVertices; a++)	{
+		if (progress && !(a & 0xfff)) {
+			progress->CheckDeadline();
+		}
+
 		// collect the vertex data
 		Vertex v(pMesh,a);
 
@@ -285,6 +300,7 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex)
 	}
 
 	// replace vertex data with the unique data sets
+	context.Invalidate(MeshDataCache::All);
 	pMesh->mNumVertices = (unsigned int)uniqueVertices.size();
 
 	// ----------------------------------------------------------------------------
@@ -43,7 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_JOINVERTICESPROCESS_H_INC
 #define AI_JOINVERTICESPROCESS_H_INC
 
-#include "BaseProcess.h"
+#include "PerMeshProcess.h"
 #include "../include/assimp/types.h"
 
 namespace Assimp
@@ -59,7 +59,7 @@ class JoinVerticesTest;
  * erases all but one of the copies. This usually reduces the number of vertices
  * in a mesh by a serious amount and is the standard form to render a mesh.
  */
-class ASSIMP_API_WINONLY JoinVerticesProcess : public BaseProcess
+class ASSIMP_API_WINONLY JoinVerticesProcess : public PerMeshProcess
 {
 public:
 
@@ -76,11 +76,12 @@ public:
 	bool IsActive( unsigned int pFlags) const;
 
 	// -------------------------------------------------------------------
-	/** Executes the post processing step on the given imported data.
+	/** Parts of the post processing step, see PerMeshProcess.
 	* At the moment a process is not supposed to fail.
-	* @param pScene The imported data to work at.
 	*/
-	void Execute( aiScene* pScene);
+	void BeginMeshes( aiScene* pScene);
+	void ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex, MeshPipelineContext& context);
+	void EndMeshes( aiScene* pScene);
 
 public:
 	// -------------------------------------------------------------------
@@ -90,7 +91,22 @@ public:
 	 */
 	int ProcessMesh( aiMesh* pMesh, unsigned int meshIndex);
 
+	// -------------------------------------------------------------------
+	/** Unites identical vertices in the given mesh.
+	 * @param pMesh The mesh to process.
+	 * @param meshIndex Index of the mesh to process
+	 * @param context Provides the SpatialSort of the mesh
+	 */
+	int ProcessMesh( aiMesh* pMesh, unsigned int meshIndex, MeshPipelineContext& context);
+
 private:
+
+	/** Number of vertices of each mesh before the step. They are counted when 
+	 *  the mesh is processed, other fused steps may change them before. */
+	boost::scoped_array<int> oldVertices;
+
+	/** Return value of ProcessMesh() for each mesh */
+	boost::scoped_array<int> results;
 };
 
 } // end of namespace Assimp
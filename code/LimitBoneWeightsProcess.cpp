@@ -46,7 +46,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 using namespace Assimp;
 
-
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 LimitBoneWeightsProcess::LimitBoneWeightsProcess()
@@ -69,13 +68,24 @@ bool LimitBoneWeightsProcess::IsActive( unsigned int pFlags) const
 }
 
 // ------------------------------------------------------------------------------------------------
-// Executes the post processing step on the given imported data.
-void LimitBoneWeightsProcess::Execute( aiScene* pScene)
+// Prepares the post processing step for the given imported data.
+void LimitBoneWeightsProcess::BeginMeshes( aiScene* /*pScene*/)
 {
 	DefaultLogger::get()->debug("LimitBoneWeightsProcess begin");
-	for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
-		ProcessMesh( pScene->mMeshes[a]);
+}
 
+// ------------------------------------------------------------------------------------------------
+// Executes the post processing step on a single mesh.
+void LimitBoneWeightsProcess::ExecuteOnMesh( aiMesh* pMesh, unsigned int /*meshIndex*/, MeshPipelineContext& context)
+{
+	ProcessMesh(pMesh);
+	context.Invalidate(MeshDataCache::Bones);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Finishes the post processing step.
+void LimitBoneWeightsProcess::EndMeshes( aiScene* /*pScene*/)
+{
 	DefaultLogger::get()->debug("LimitBoneWeightsProcess end");
 }
 
@@ -42,7 +42,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_LIMITBONEWEIGHTSPROCESS_H_INC
 #define AI_LIMITBONEWEIGHTSPROCESS_H_INC
 
-#include "BaseProcess.h"
+#include "PerMeshProcess.h"
 
 struct aiMesh;
 class LimitBoneWeightsTest;
@@ -69,7 +69,7 @@ namespace Assimp
 * The other weights on this bone are then renormalized to assure the sum weight
 * to be 1.
 */
-class LimitBoneWeightsProcess : public BaseProcess
+class LimitBoneWeightsProcess : public PerMeshProcess
 {
 public:
 
@@ -102,11 +102,12 @@ public:
 	void ProcessMesh( aiMesh* pMesh);
 
 	// -------------------------------------------------------------------
-	/** Executes the post processing step on the given imported data.
+	/** Parts of the post processing step, see PerMeshProcess.
 	* At the moment a process is not supposed to fail.
-	* @param pScene The imported data to work at.
 	*/
-	void Execute( aiScene* pScene);
+	void BeginMeshes( aiScene* pScene);
+	void ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex, MeshPipelineContext& context);
+	void EndMeshes( aiScene* pScene);
 
 
 public:
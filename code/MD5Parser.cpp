@@ -196,12 +196,12 @@ bool MD5Parser::ParseSection(Section& out)
 	AI_MD5_SKIP_SPACES(); \
 	if ('(' != *sz++) \
 		MD5Parser::ReportWarning("Unexpected token: ( was expected",(*eit).iLineNumber); \
-	AI_MD5_SKIP_SPACES(); \
-	sz = fast_atoreal_move<float>(sz,(float&)vec.x); \
-	AI_MD5_SKIP_SPACES(); \
-	sz = fast_atoreal_move<float>(sz,(float&)vec.y); \
-	AI_MD5_SKIP_SPACES(); \
-	sz = fast_atoreal_move<float>(sz,(float&)vec.z); \
+	{ \
+		float v[3] = { vec.x, vec.y, vec.z }; \
+		if (3 != fast_atoreal_span<float>(sz,v,3,false)) \
+			MD5Parser::ReportWarning("Unexpected end of line",(*eit).iLineNumber); \
+		vec = aiVector3D(v[0],v[1],v[2]); \
+	} \
 	AI_MD5_SKIP_SPACES(); \
 	if (')' != *sz++) \
 		MD5Parser::ReportWarning("Unexpected token: ) was expected",(*eit).iLineNumber);
@@ -294,10 +294,10 @@ MD5MeshParser::MD5MeshParser(SectionList& mSections)
 					VertexDesc& vert = desc.mVertices[idx];	
 					if ('(' != *sz++)
 						MD5Parser::ReportWarning("Unexpected token: ( was expected",(*eit).iLineNumber);
-					AI_MD5_SKIP_SPACES();
-					sz = fast_atoreal_move<float>(sz,(float&)vert.mUV.x);
-					AI_MD5_SKIP_SPACES();
-					sz = fast_atoreal_move<float>(sz,(float&)vert.mUV.y);
+					float uv[2] = { vert.mUV.x, vert.mUV.y };
+					if (2 != fast_atoreal_span<float>(sz,uv,2,false))
+						MD5Parser::ReportWarning("Unexpected end of line",(*eit).iLineNumber);
+					vert.mUV = aiVector2D(uv[0],uv[1]);
 					AI_MD5_SKIP_SPACES();
 					if (')' != *sz++)
 						MD5Parser::ReportWarning("Unexpected token: ) was expected",(*eit).iLineNumber);
@@ -405,9 +405,12 @@ MD5AnimParser::MD5AnimParser(SectionList& mSections)
 			// now read all elements (continous list of floats)
 			for (ElementList::const_iterator eit = (*iter).mElements.begin(), eitEnd = (*iter).mElements.end(); eit != eitEnd; ++eit){
 				const char* sz = (*eit).szStart;
-				while (SkipSpacesAndLineEnd(&sz))	{
-					float f;sz = fast_atoreal_move<float>(sz,f);
-					desc.mValues.push_back(f);
+				float values[64];
+				for (unsigned int num; (num = fast_atoreal_span<float>(sz,values,64)) > 0;) {
+					desc.mValues.insert(desc.mValues.end(),values,values+num);
+				}
+				if (SkipSpacesAndLineEnd(&sz)) {
+					MD5Parser::ReportWarning("Unexpected token: number was expected",(*eit).iLineNumber);
 				}
 			}
 		}
@@ -0,0 +1,215 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+
+/** @file  MappedIOStream.cpp
+ *  @brief Implementation of MappedIOStream for Windows and POSIX systems
+ */
+
+#include "AssimpPCH.h"
+#include "MappedIOStream.h"
+
+#ifdef _WIN32
+#	include <windows.h>
+#elif defined AI_MAPPEDIOSTREAM_AVAILABLE
+#	include <sys/types.h>
+#	include <sys/stat.h>
+#	include <sys/mman.h>
+#	include <fcntl.h>
+#	include <unistd.h>
+#endif
+
+using namespace Assimp;
+
+// ----------------------------------------------------------------------------------
+MappedIOStream::MappedIOStream(const uint8_t* data, size_t length)
+	: data(data)
+	, length(length)
+	, pos()
+{
+}
+
+// ----------------------------------------------------------------------------------
+MappedIOStream::~MappedIOStream()
+{
+#ifdef _WIN32
+	::UnmapViewOfFile(data);
+#elif defined AI_MAPPEDIOSTREAM_AVAILABLE
+	::munmap(const_cast<uint8_t*>(data),length);
+#endif
+}
+
+// ----------------------------------------------------------------------------------
+MappedIOStream* MappedIOStream::Open(const char* file, size_t minSize)
+{
+	ai_assert(NULL != file);
+
+#ifdef _WIN32
+	HANDLE fileHandle = ::CreateFileA(file,GENERIC_READ,FILE_SHARE_READ,NULL,OPEN_EXISTING,
+		FILE_FLAG_SEQUENTIAL_SCAN,NULL);
+	if (INVALID_HANDLE_VALUE == fileHandle) {
+		return NULL;
+	}
+
+	// files which don't fit into the address space are left to the C runtime
+	LARGE_INTEGER size;
+	if (!::GetFileSizeEx(fileHandle,&size) || !size.QuadPart || static_cast<uint64_t>(size.QuadPart) < minSize ||
+		static_cast<uint64_t>(size.QuadPart) > static_cast<uint64_t>(SIZE_MAX)) {
+		::CloseHandle(fileHandle);
+		return NULL;
+	}
+
+	// the view keeps the file open, both handles can be closed right away
+	HANDLE mapping = ::CreateFileMappingA(fileHandle,NULL,PAGE_READONLY,0,0,NULL);
+	::CloseHandle(fileHandle);
+	if (!mapping) {
+		return NULL;
+	}
+
+	const void* view = ::MapViewOfFile(mapping,FILE_MAP_READ,0,0,0);
+	::CloseHandle(mapping);
+	if (!view) {
+		return NULL;
+	}
+	return new MappedIOStream(static_cast<const uint8_t*>(view),static_cast<size_t>(size.QuadPart));
+
+#elif defined AI_MAPPEDIOSTREAM_AVAILABLE
+	const int fd = ::open(file,O_RDONLY);
+	if (-1 == fd) {
+		return NULL;
+	}
+
+	// files which don't fit into the address space are left to the C runtime
+	struct stat fileStat;
+	if (0 != ::fstat(fd,&fileStat) || !S_ISREG(fileStat.st_mode) || !fileStat.st_size || 
+		static_cast<uint64_t>(fileStat.st_size) < minSize || 
+		static_cast<uint64_t>(fileStat.st_size) > static_cast<uint64_t>(SIZE_MAX)) {
+		::close(fd);
+		return NULL;
+	}
+
+	// the mapping keeps the file open, the descriptor can be closed right away
+	const size_t size = static_cast<size_t>(fileStat.st_size);
+	void* view = ::mmap(NULL,size,PROT_READ,MAP_PRIVATE,fd,0);
+	::close(fd);
+	if (MAP_FAILED == view) {
+		return NULL;
+	}
+
+	// nearly all loaders read front to back
+	::madvise(view,size,MADV_SEQUENTIAL);
+	return new MappedIOStream(static_cast<const uint8_t*>(view),size);
+
+#else
+	(void)minSize;
+	return NULL;
+#endif
+}
+
+// ----------------------------------------------------------------------------------
+size_t MappedIOStream::Read(void* pvBuffer, 
+	size_t pSize, 
+	size_t pCount)
+{
+	ai_assert(NULL != pvBuffer && 0 != pSize && 0 != pCount);
+
+	// only whole elements are read, just like fread() does
+	const size_t cnt = std::min(pCount,(length-pos)/pSize);
+	::memcpy(pvBuffer,data+pos,cnt*pSize);
+	pos += cnt*pSize;
+	return cnt;
+}
+
+// ----------------------------------------------------------------------------------
+size_t MappedIOStream::Write(const void* /*pvBuffer*/, 
+	size_t /*pSize*/,
+	size_t /*pCount*/)
+{
+	return 0;
+}
+
+// ----------------------------------------------------------------------------------
+aiReturn MappedIOStream::Seek(size_t pOffset,
+	 aiOrigin pOrigin)
+{
+	if (aiOrigin_SET == pOrigin) {
+		if (pOffset > length) {
+			return AI_FAILURE;
+		}
+		pos = pOffset;
+	}
+	else if (aiOrigin_END == pOrigin) {
+		if (pOffset > length) {
+			return AI_FAILURE;
+		}
+		pos = length-pOffset;
+	}
+	else {
+		if (pOffset > length-pos) {
+			return AI_FAILURE;
+		}
+		pos += pOffset;
+	}
+	return AI_SUCCESS;
+}
+
+// ----------------------------------------------------------------------------------
+size_t MappedIOStream::Tell() const
+{
+	return pos;
+}
+
+// ----------------------------------------------------------------------------------
+size_t MappedIOStream::FileSize() const
+{
+	return length;
+}
+
+// ----------------------------------------------------------------------------------
+void MappedIOStream::Flush()
+{
+}
+
+// ----------------------------------------------------------------------------------
+const void* MappedIOStream::GetView() const
+{
+	return data;
+}
@@ -0,0 +1,125 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+
+/** @file  MappedIOStream.h
+ *  @brief Read-only file access through a memory mapping
+ */
+#ifndef AI_MAPPEDIOSTREAM_H_INC
+#define AI_MAPPEDIOSTREAM_H_INC
+
+#include "../include/assimp/IOStream.hpp"
+
+#if defined _WIN32 || defined __unix__ || defined __APPLE__
+#	define AI_MAPPEDIOSTREAM_AVAILABLE
+#endif
+
+namespace Assimp	{
+
+// ----------------------------------------------------------------------------------
+/** Read-only stream over a file mapped into memory. Created by DefaultIOSystem 
+ *  for large files if requested, see #AI_CONFIG_GLOB_MEMORY_MAPPING. Reading pages the file
+ *  in on demand and copies straight from the OS's file cache, there is no
+ *  intermediate copy in the C runtime's buffers. Readers which use 
+ *  #GetView() don't copy the data at all. If the file is truncated while
+ *  it is mapped, accessing the lost part raises SIGBUS (POSIX). */
+class MappedIOStream : public IOStream
+{
+	friend class DefaultIOSystem;
+
+protected:
+	MappedIOStream (const uint8_t* data, size_t length);
+
+public:
+	/** Destructor public to allow simple deletion to close the file. */
+	~MappedIOStream ();
+
+	// -------------------------------------------------------------------
+	/** Map a file into memory.
+	 *  @param file Path to the file
+	 *  @param minSize Smallest file size for which mapping is worth it
+	 *  @return NULL if the file can't be mapped or is smaller than minSize. 
+	 *    Files of zero length are never mapped. */
+	static MappedIOStream* Open(const char* file, size_t minSize);
+
+public:
+
+	// -------------------------------------------------------------------
+	// Read from stream
+	size_t Read(void* pvBuffer, 
+		size_t pSize, 
+		size_t pCount);
+
+	// -------------------------------------------------------------------
+	// Write to stream - not supported
+	size_t Write(const void* pvBuffer, 
+		size_t pSize,
+		size_t pCount);
+
+	// -------------------------------------------------------------------
+	// Seek specific position
+	aiReturn Seek(size_t pOffset,
+		aiOrigin pOrigin);
+
+	// -------------------------------------------------------------------
+	// Get current seek position
+	size_t Tell() const;
+
+	// -------------------------------------------------------------------
+	// Get size of file
+	size_t FileSize() const;
+
+	// -------------------------------------------------------------------
+	// Flush file contents - nothing to do
+	void Flush();
+
+	// -------------------------------------------------------------------
+	// Get the mapped file
+	const void* GetView() const;
+
+private:
+	const uint8_t* data;
+	size_t length, pos;
+};
+
+} // ns assimp
+
+#endif //!!AI_MAPPEDIOSTREAM_H_INC
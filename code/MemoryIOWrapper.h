@@ -121,6 +121,12 @@ public:
 		ai_assert(false); // won't be needed
 	}
 
+	// -------------------------------------------------------------------
+	// Get the memory buffer
+	const void* GetView() const {
+		return buffer;
+	}
+
 private:
 	const uint8_t* buffer;
 	size_t length,pos;
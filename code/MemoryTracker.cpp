@@ -0,0 +1,299 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  MemoryTracker.cpp
+ *  @brief Implementation of the MemoryTracker helper class and the 
+ *    replacement operator new and delete used to feed it
+ */
+
+#include "AssimpPCH.h"
+#include "MemoryTracker.h"
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#	include <boost/thread/thread.hpp>
+#	include <boost/thread/mutex.hpp>
+#endif
+
+// ------------------------------------------------------------------------------------------------
+// Thread-local storage for the attached tracker. Compiler support is used
+// instead of boost::thread_specific_ptr, which would allocate itself.
+#ifdef ASSIMP_BUILD_SINGLETHREADED
+#	define AI_MEMORYTRACKER_TLS
+#elif defined(_MSC_VER)
+#	define AI_MEMORYTRACKER_TLS __declspec(thread)
+#else
+#	define AI_MEMORYTRACKER_TLS __thread
+#endif
+
+using namespace Assimp;
+
+namespace {
+
+	// tracker attached to the current thread, if any
+	AI_MEMORYTRACKER_TLS MemoryTracker* gAttachedTracker = NULL;
+
+	// source of unique tracker ids, 0 marks untracked blocks
+	size_t gNextTrackerId = 1;
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	boost::mutex gTrackerIdMutex;
+#endif
+}
+
+namespace Assimp	{
+
+// ------------------------------------------------------------------------------------------------
+// Private state of a MemoryTracker
+struct MemoryTrackerData
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	// guards the counters, several worker threads may count at once
+	boost::mutex mutex;
+#endif
+};
+
+} // end of namespace Assimp
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#	define AI_MEMORYTRACKER_LOCK() boost::mutex::scoped_lock lock(data->mutex)
+#else
+#	define AI_MEMORYTRACKER_LOCK()
+#endif
+
+// ------------------------------------------------------------------------------------------------
+MemoryTracker::MemoryTracker()
+: data(new MemoryTrackerData())
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	boost::mutex::scoped_lock lock(gTrackerIdMutex);
+#endif
+	id = gNextTrackerId++;
+}
+
+// ------------------------------------------------------------------------------------------------
+MemoryTracker::~MemoryTracker()
+{
+	ai_assert(gAttachedTracker != this);
+	delete data;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool MemoryTracker::IsAvailable()
+{
+#ifdef ASSIMP_BUILD_MEMORY_TRACKING
+	return true;
+#else
+	return false;
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+MemoryTracker* MemoryTracker::Attach(MemoryTracker* tracker)
+{
+	MemoryTracker* const prev = gAttachedTracker;
+	gAttachedTracker = tracker;
+	return prev;
+}
+
+// ------------------------------------------------------------------------------------------------
+MemoryTracker* MemoryTracker::GetAttached()
+{
+	return gAttachedTracker;
+}
+
+// ------------------------------------------------------------------------------------------------
+MemoryTracker::Counters MemoryTracker::GetCounters() const
+{
+	AI_MEMORYTRACKER_LOCK();
+	return counters;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t MemoryTracker::RestartPeak()
+{
+	AI_MEMORYTRACKER_LOCK();
+	const size_t peak = counters.peak;
+	counters.peak = counters.current;
+	return peak;
+}
+
+// ------------------------------------------------------------------------------------------------
+void MemoryTracker::MergePeak(size_t peak)
+{
+	AI_MEMORYTRACKER_LOCK();
+	counters.peak = std::max(counters.peak,peak);
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t MemoryTracker::OnAllocate(size_t size)
+{
+	AI_MEMORYTRACKER_LOCK();
+	counters.current += size;
+	counters.peak = std::max(counters.peak,counters.current);
+	counters.allocated += size;
+	++counters.allocations;
+	return id;
+}
+
+// ------------------------------------------------------------------------------------------------
+void MemoryTracker::OnRelease(size_t size, size_t owner)
+{
+	if (owner != id) {
+		return;
+	}
+	AI_MEMORYTRACKER_LOCK();
+	counters.current -= size;
+}
+
+#ifdef ASSIMP_BUILD_MEMORY_TRACKING
+
+// ------------------------------------------------------------------------------------------------
+// Replacements for the global operator new and delete. Every block is prefixed with its
+// size and the id of the tracker which counted it. Note that these replace the operators 
+// for the whole process, not just for assimp, so CMake allows them in static builds only.
+// ------------------------------------------------------------------------------------------------
+
+#if __cplusplus >= 201103L
+#	define AI_NEW_THROW
+#	define AI_NO_THROW noexcept
+#else
+#	define AI_NEW_THROW throw(std::bad_alloc)
+#	define AI_NO_THROW throw()
+#endif
+
+namespace {
+
+	struct BlockHeader 
+	{
+		size_t size;
+		size_t owner;
+	};
+
+	// keep the user data aligned as malloc() would
+	union AlignedBlockHeader
+	{
+		BlockHeader header;
+		long double ld;
+		char pad[16];
+	};
+
+	// --------------------------------------------------------------------------------------------
+	void* TrackedAllocate(size_t size)
+	{
+		AlignedBlockHeader* const block = static_cast<AlignedBlockHeader*>(::malloc(sizeof(AlignedBlockHeader) + size));
+		if (!block) {
+			return NULL;
+		}
+
+		MemoryTracker* const tracker = gAttachedTracker;
+		block->header.size  = size;
+		block->header.owner = tracker ? tracker->OnAllocate(size) : 0;
+		return block + 1;
+	}
+
+	// --------------------------------------------------------------------------------------------
+	void TrackedRelease(void* data)
+	{
+		if (!data) {
+			return;
+		}
+		AlignedBlockHeader* const block = static_cast<AlignedBlockHeader*>(data) - 1;
+
+		MemoryTracker* const tracker = gAttachedTracker;
+		if (tracker && block->header.owner) {
+			tracker->OnRelease(block->header.size,block->header.owner);
+		}
+		::free(block);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void* operator new (size_t size) AI_NEW_THROW
+{
+	void* const data = TrackedAllocate(size);
+	if (!data) {
+		throw std::bad_alloc();
+	}
+	return data;
+}
+
+// ------------------------------------------------------------------------------------------------
+void* operator new[] (size_t size) AI_NEW_THROW
+{
+	return ::operator new(size);
+}
+
+// ------------------------------------------------------------------------------------------------
+void* operator new (size_t size, const std::nothrow_t&) AI_NO_THROW
+{
+	return TrackedAllocate(size);
+}
+
+// ------------------------------------------------------------------------------------------------
+void* operator new[] (size_t size, const std::nothrow_t&) AI_NO_THROW
+{
+	return TrackedAllocate(size);
+}
+
+// ------------------------------------------------------------------------------------------------
+void operator delete (void* data) AI_NO_THROW
+{
+	TrackedRelease(data);
+}
+
+// ------------------------------------------------------------------------------------------------
+void operator delete[] (void* data) AI_NO_THROW
+{
+	TrackedRelease(data);
+}
+
+// ------------------------------------------------------------------------------------------------
+void operator delete (void* data, const std::nothrow_t&) AI_NO_THROW
+{
+	TrackedRelease(data);
+}
+
+// ------------------------------------------------------------------------------------------------
+void operator delete[] (void* data, const std::nothrow_t&) AI_NO_THROW
+{
+	TrackedRelease(data);
+}
+
+#endif // !! ASSIMP_BUILD_MEMORY_TRACKING
@@ -0,0 +1,169 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file MemoryTracker.h
+ *  @brief Optional accounting of the heap allocations made during an import
+ */
+#ifndef AI_MEMORYTRACKER_H_INC
+#define AI_MEMORYTRACKER_H_INC
+
+namespace Assimp	{
+
+struct MemoryTrackerData;
+
+// ---------------------------------------------------------------------------
+/** @brief Counts the heap allocations made by the threads it is attached to.
+ *
+ *  Counting requires assimp to be built with ASSIMP_BUILD_MEMORY_TRACKING,
+ *  which replaces the global operator new and delete. This is only safe 
+ *  for static builds, CMake refuses the option otherwise. In other builds
+ *  all counters remain zero, see #IsAvailable().
+ *
+ *  A block counts as released only if it is freed by a thread the tracker
+ *  which counted its allocation is attached to. #ThreadPool workers run 
+ *  with the tracker of the thread that started the job.
+ */
+class MemoryTracker
+{
+public:
+
+	/** Snapshot of the counters */
+	struct Counters 
+	{
+		Counters() 
+			: current(), peak(), allocated(), allocations() 
+		{}
+
+		/** Bytes allocated and not yet released */
+		size_t current;
+
+		/** Maximum value of current since the peak was last restarted */
+		size_t peak;
+
+		/** Bytes allocated in total */
+		size_t allocated;
+
+		/** Number of allocations */
+		size_t allocations;
+	};
+
+	// -------------------------------------------------------------------
+	/** Attaches a tracker to the calling thread for the lifetime of the 
+	 *  object. Passing NULL keeps the tracker attached at the moment, 
+	 *  so nested imports are accounted to the outer one. */
+	class Scope 
+	{
+	public:
+		explicit Scope(MemoryTracker* tracker)
+			: prev(GetAttached())
+		{
+			if (tracker) {
+				Attach(tracker);
+			}
+		}
+
+		~Scope() {
+			Attach(prev);
+		}
+
+	private:
+		MemoryTracker* prev;
+	};
+
+public:
+
+	MemoryTracker();
+	~MemoryTracker();
+
+public:
+
+	// -------------------------------------------------------------------
+	/** Check whether allocations can be counted in this build */
+	static bool IsAvailable();
+
+	// -------------------------------------------------------------------
+	/** Attach a tracker to the calling thread, NULL to detach.
+	 *  @return Previously attached tracker */
+	static MemoryTracker* Attach(MemoryTracker* tracker);
+
+	// -------------------------------------------------------------------
+	/** Get the tracker attached to the calling thread, may be NULL */
+	static MemoryTracker* GetAttached();
+
+	// -------------------------------------------------------------------
+	/** Get a consistent snapshot of all counters */
+	Counters GetCounters() const;
+
+	// -------------------------------------------------------------------
+	/** Start a new peak measurement at the current usage.
+	 *  @return Peak measured so far */
+	size_t RestartPeak();
+
+	// -------------------------------------------------------------------
+	/** Raise the peak to at least the given value, used to
+	 *  continue an outer measurement after #RestartPeak(). */
+	void MergePeak(size_t peak);
+
+public:
+
+	// -------------------------------------------------------------------
+	/** Called by operator new for the attached tracker.
+	 *  @return Id to be passed to #OnRelease() */
+	size_t OnAllocate(size_t size);
+
+	// -------------------------------------------------------------------
+	/** Called by operator delete for the attached tracker. The block
+	 *  is ignored if it was not counted by this tracker. */
+	void OnRelease(size_t size, size_t id);
+
+private:
+
+	// no copying
+	MemoryTracker(const MemoryTracker&);
+	MemoryTracker& operator = (const MemoryTracker&);
+
+	size_t id;
+	Counters counters;
+	MemoryTrackerData* data;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_MEMORYTRACKER_H_INC
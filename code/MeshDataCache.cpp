@@ -0,0 +1,183 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+
+/** @file MeshDataCache.cpp
+ *  @brief Implementation of the MeshDataCache class
+ */
+
+#include "AssimpPCH.h"
+#include "MeshDataCache.h"
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#	include <boost/thread/mutex.hpp>
+#endif
+
+namespace Assimp	{
+
+	// ------------------------------------------------------------------------------------------------
+	// A single cached object
+	struct MeshDataSlot
+	{
+		const void* key;
+		unsigned int dependencies;
+		MeshDataCache::Entry* entry;
+	};
+
+	typedef std::vector<MeshDataSlot> MeshDataSlots;
+
+	// ------------------------------------------------------------------------------------------------
+	struct MeshDataCacheData
+	{
+		std::map<const aiMesh*, MeshDataSlots> meshes;
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+		boost::mutex mutex;
+#endif
+	};
+}
+
+using namespace Assimp;
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#	define AI_MESHDATA_LOCK() boost::mutex::scoped_lock lock(data->mutex)
+#else
+#	define AI_MESHDATA_LOCK()
+#endif
+
+// ------------------------------------------------------------------------------------------------
+MeshDataCache::MeshDataCache()
+: data (new MeshDataCacheData())
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+MeshDataCache::~MeshDataCache()
+{
+	Clear();
+	delete data;
+}
+
+// ------------------------------------------------------------------------------------------------
+MeshDataCache::Entry* MeshDataCache::GetEntry(const aiMesh* mesh, const void* key) const
+{
+	AI_MESHDATA_LOCK();
+
+	std::map<const aiMesh*, MeshDataSlots>::const_iterator it = data->meshes.find(mesh);
+	if (it != data->meshes.end()) {
+		for (MeshDataSlots::const_iterator slot = (*it).second.begin(); slot != (*it).second.end(); ++slot) {
+			if ((*slot).key == key) {
+				return (*slot).entry;
+			}
+		}
+	}
+	return NULL;
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshDataCache::AddEntry(const aiMesh* mesh, const void* key, Entry* entry, unsigned int dependencies)
+{
+	AI_MESHDATA_LOCK();
+
+	MeshDataSlots& slots = data->meshes[mesh];
+	for (MeshDataSlots::iterator slot = slots.begin(); slot != slots.end(); ++slot) {
+		if ((*slot).key == key) {
+			delete (*slot).entry;
+			(*slot).entry = entry;
+			(*slot).dependencies = dependencies;
+			return;
+		}
+	}
+
+	const MeshDataSlot slot = {key,dependencies,entry};
+	slots.push_back(slot);
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshDataCache::RemoveEntry(const aiMesh* mesh, const void* key)
+{
+	AI_MESHDATA_LOCK();
+
+	std::map<const aiMesh*, MeshDataSlots>::iterator it = data->meshes.find(mesh);
+	if (it == data->meshes.end()) {
+		return;
+	}
+	MeshDataSlots& slots = (*it).second;
+	for (MeshDataSlots::iterator slot = slots.begin(); slot != slots.end(); ++slot) {
+		if ((*slot).key == key) {
+			delete (*slot).entry;
+			slots.erase(slot);
+			break;
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshDataCache::Invalidate(const aiMesh* mesh, unsigned int changes)
+{
+	AI_MESHDATA_LOCK();
+
+	std::map<const aiMesh*, MeshDataSlots>::iterator it = data->meshes.find(mesh);
+	if (it == data->meshes.end()) {
+		return;
+	}
+	MeshDataSlots& slots = (*it).second;
+	for (MeshDataSlots::iterator slot = slots.begin(); slot != slots.end(); ) {
+		if ((*slot).dependencies & changes) {
+			delete (*slot).entry;
+			slot = slots.erase(slot);
+		}
+		else ++slot;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshDataCache::Clear()
+{
+	AI_MESHDATA_LOCK();
+
+	for (std::map<const aiMesh*, MeshDataSlots>::iterator it = data->meshes.begin(); it != data->meshes.end(); ++it) {
+		for (MeshDataSlots::iterator slot = (*it).second.begin(); slot != (*it).second.end(); ++slot) {
+			delete (*slot).entry;
+		}
+	}
+	data->meshes.clear();
+}
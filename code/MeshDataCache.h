@@ -0,0 +1,175 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+
+/** @file MeshDataCache.h
+ *  @brief Cache for data derived from meshes, shared by post-processing steps
+ */
+#ifndef AI_MESHDATACACHE_H_INC
+#define AI_MESHDATACACHE_H_INC
+
+struct aiMesh;
+
+namespace Assimp	{
+
+struct MeshDataCacheData;
+
+// ---------------------------------------------------------------------------
+/** @brief Keeps data derived from the meshes of a scene, such as spatial
+ *  sort trees or bounding boxes, so later post-processing steps can reuse
+ *  what earlier ones computed.
+ *
+ *  Entries are keyed by the mesh and their C++ type, each mesh can hold 
+ *  one object of every type. Every entry declares which parts of the mesh
+ *  it depends on (see #Dependency). Steps which modify a mesh call 
+ *  Invalidate() with the parts they changed, which drops all entries 
+ *  depending on them. Steps which don't do this are flagged by
+ *  BaseProcess::MaintainsMeshData(), the Importer clears the whole
+ *  cache after they ran.
+ *
+ *  The cache may be used concurrently for different meshes. Pointers to
+ *  entries stay valid until the entry is invalidated or removed.
+ */
+class MeshDataCache
+{
+public:
+
+	/** Parts of a mesh an entry can depend on */
+	enum Dependency
+	{
+		//! Vertex positions and the number of vertices
+		Positions	= 0x1,
+
+		//! Faces, their indices and the primitive types
+		Faces		= 0x2,
+
+		//! All other vertex components (normals, tangents, UVs, colors)
+		VertexData	= 0x4,
+
+		//! Bones and their weights
+		Bones		= 0x8,
+
+		All			= 0xf
+	};
+
+	/** Base class of all entries */
+	struct Entry
+	{
+		virtual ~Entry()
+		{}
+	};
+
+	/** Stores a single object of type T */
+	template <typename T>
+	struct TEntry : public Entry
+	{
+		T data;
+	};
+
+public:
+
+	MeshDataCache();
+	~MeshDataCache();
+
+public:
+
+	// -------------------------------------------------------------------
+	/** Get the cached object of a particular type for a mesh.
+	 *  @return NULL if there is none */
+	template <typename T>
+	T* Get(const aiMesh* mesh) const {
+		TEntry<T>* const entry = static_cast<TEntry<T>*>(GetEntry(mesh,GetKey<T>()));
+		return entry ? &entry->data : NULL;
+	}
+
+	// -------------------------------------------------------------------
+	/** Add a default-constructed object of a particular type for a mesh,
+	 *  replacing any existing one. 
+	 *  @param dependencies Bitwise combination of #Dependency values
+	 *  @return The new object, to be filled by the caller */
+	template <typename T>
+	T& Add(const aiMesh* mesh, unsigned int dependencies) {
+		TEntry<T>* const entry = new TEntry<T>();
+		AddEntry(mesh,GetKey<T>(),entry,dependencies);
+		return entry->data;
+	}
+
+	// -------------------------------------------------------------------
+	/** Remove the object of a particular type for a mesh, if any */
+	template <typename T>
+	void Remove(const aiMesh* mesh) {
+		RemoveEntry(mesh,GetKey<T>());
+	}
+
+	// -------------------------------------------------------------------
+	/** Drop all entries of a mesh which depend on the given parts
+	 *  @param changes Bitwise combination of #Dependency values */
+	void Invalidate(const aiMesh* mesh, unsigned int changes);
+
+	// -------------------------------------------------------------------
+	/** Drop all entries of all meshes */
+	void Clear();
+
+private:
+
+	// no copying
+	MeshDataCache(const MeshDataCache&);
+	MeshDataCache& operator = (const MeshDataCache&);
+
+	// unique key for each type
+	template <typename T>
+	static const void* GetKey() {
+		static const char key = 0;
+		return &key;
+	}
+
+	Entry* GetEntry(const aiMesh* mesh, const void* key) const;
+	void AddEntry(const aiMesh* mesh, const void* key, Entry* entry, unsigned int dependencies);
+	void RemoveEntry(const aiMesh* mesh, const void* key);
+
+private:
+
+	MeshDataCacheData* data;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_MESHDATACACHE_H_INC
@@ -84,10 +84,9 @@ void NFFImporter::GetExtensionList(std::set<std::string>& extensions)
 	if (!::IsLineEnd(*sz))sz = fast_atoreal_move<float>(sz, (float&)f); 
 
 // ------------------------------------------------------------------------------------------------
+// Components missing at the end of the line are left untouched
 #define AI_NFF_PARSE_TRIPLE(v) \
-	AI_NFF_PARSE_FLOAT(v[0]) \
-	AI_NFF_PARSE_FLOAT(v[1]) \
-	AI_NFF_PARSE_FLOAT(v[2]) 
+	fast_atoreal_span<float>(sz, &v[0], 3, false); 
 
 // ------------------------------------------------------------------------------------------------
 #define AI_NFF_PARSE_SHAPE_INFORMATION() \
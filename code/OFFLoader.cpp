@@ -128,12 +128,11 @@ void OFFImporter::InternReadFile( const std::string& pFile,
 			DefaultLogger::get()->error("OFF: The number of verts in the header is incorrect");
 			break;
 		}
-		aiVector3D& v = tempPositions[i];
+		float v[3] = { 0.f, 0.f, 0.f };
 
-		sz = line; SkipSpaces(&sz);
-		sz = fast_atoreal_move<float>(sz,(float&)v.x); SkipSpaces(&sz);
-		sz = fast_atoreal_move<float>(sz,(float&)v.y); SkipSpaces(&sz);
-		fast_atoreal_move<float>(sz,(float&)v.z);
+		sz = line;
+		fast_atoreal_span<float>(sz,v,3,false);
+		tempPositions[i] = aiVector3D(v[0],v[1],v[2]);
 	}
 
 	
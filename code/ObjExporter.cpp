@@ -53,43 +53,44 @@ namespace Assimp	{
 // Worker function for exporting a scene to Wavefront OBJ. Prototyped and registered in Exporter.cpp
 void ExportSceneObj(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene)
 {
-	// invoke the exporter 
-	ObjExporter exporter(pFile, pScene);
-
-	// we're still here - export successfully completed. Write both the main OBJ file and the material script
-	{
-		boost::scoped_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
-		outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+	// open both the main OBJ file and the material script
+	boost::scoped_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
+	if(!outfile) {
+		throw DeadlyExportError("could not open output .obj file: " + std::string(pFile));
 	}
-	{
-		boost::scoped_ptr<IOStream> outfile (pIOSystem->Open(exporter.GetMaterialLibFileName(),"wt"));
-		outfile->Write( exporter.mOutputMat.str().c_str(), static_cast<size_t>(exporter.mOutputMat.tellp()),1);
+	const std::string& mtl = ObjExporter::GetMaterialLibFileName(pFile);
+	boost::scoped_ptr<IOStream> outfileMat (pIOSystem->Open(mtl,"wt"));
+	if(!outfileMat) {
+		throw DeadlyExportError("could not open output .mtl file: " + mtl);
 	}
+
+	// invoke the exporter, it writes straight to the files
+	ObjExporter exporter(pFile, pScene, outfile.get(), outfileMat.get());
 }
 
 } // end of namespace Assimp
 
 
 // ------------------------------------------------------------------------------------------------
-ObjExporter :: ObjExporter(const char* _filename, const aiScene* pScene)
-: filename(_filename)
+ObjExporter :: ObjExporter(const char* _filename, const aiScene* pScene, IOStream* outfile, IOStream* outfileMat)
+: mOutput(outfile)
+, mOutputMat(outfileMat)
+, filename(_filename)
 , pScene(pScene)
 , endl("\n") 
 {
-	// make sure that all formatting happens using the standard, C locale and not the user's current locale
-	const std::locale& l = std::locale("C");
-	mOutput.imbue(l);
-	mOutputMat.imbue(l);
-
 	WriteGeometryFile();
 	WriteMaterialFile();
+
+	mOutput.Flush();
+	mOutputMat.Flush();
 }
 
 // ------------------------------------------------------------------------------------------------
 std::string ObjExporter :: GetMaterialLibName()
 {	
 	// within the Obj file, we use just the relative file name with the path stripped
-	const std::string& s = GetMaterialLibFileName();
+	const std::string& s = GetMaterialLibFileName(filename);
 	std::string::size_type il = s.find_last_of("/\\");
 	if (il != std::string::npos) {
 		return s.substr(il + 1);
@@ -99,13 +100,13 @@ std::string ObjExporter :: GetMaterialLibName()
 }
 
 // ------------------------------------------------------------------------------------------------
-std::string ObjExporter :: GetMaterialLibFileName()
+std::string ObjExporter :: GetMaterialLibFileName(const std::string& filename)
 {	
 	return filename + ".mtl";
 }
 
 // ------------------------------------------------------------------------------------------------
-void ObjExporter :: WriteHeader(std::ostringstream& out)
+void ObjExporter :: WriteHeader(TextWriter& out)
 {
 	out << "# File produced by Open Asset Import Library (http://www.assimp.sf.net)" << endl;
 	out << "# (assimp v" << aiGetVersionMajor() << '.' << aiGetVersionMinor() << '.' << aiGetVersionRevision() << ")" << endl  << endl;
@@ -44,7 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_OBJEXPORTER_H_INC
 #define AI_OBJEXPORTER_H_INC
 
-#include <sstream>
+#include "TextWriter.h"
 
 struct aiScene;
 struct aiNode;
@@ -59,17 +59,12 @@ class ObjExporter
 {
 public:
 	/// Constructor for a specific scene to export
-	ObjExporter(const char* filename, const aiScene* pScene);
+	ObjExporter(const char* filename, const aiScene* pScene, IOStream* outfile, IOStream* outfileMat);
 
 public:
 
 	std::string GetMaterialLibName();
-	std::string GetMaterialLibFileName();
-	
-public:
-
-	/// public stringstreams to write all output into
-	std::ostringstream mOutput, mOutputMat;
+	static std::string GetMaterialLibFileName(const std::string& filename);
 
 private:
 
@@ -96,7 +91,7 @@ private:
 		std::vector<Face> faces;
 	};
 
-	void WriteHeader(std::ostringstream& out);
+	void WriteHeader(TextWriter& out);
 
 	void WriteMaterialFile();
 	void WriteGeometryFile();
@@ -108,6 +103,9 @@ private:
 
 private:
 
+	/// buffered writers to send all output through
+	TextWriter mOutput, mOutputMat;
+
 	const std::string filename;
 	const aiScene* const pScene;
 
@@ -58,51 +58,32 @@ struct Material;
 
 // ------------------------------------------------------------------------------------------------
 //!	\struct	Face
-//!	\brief	Data structure for a simple obj-face, describes discredit,l.ation and materials
+//!	\brief	Data structure for a simple obj-face, its indices are stored in the index buffers 
+//!			of the model (see Model::m_VertexIndices)
 struct Face
 {
-	typedef std::vector<unsigned int> IndexArray;
-
 	//!	Primitive type
 	aiPrimitiveType m_PrimitiveType;
-	//!	Vertex indices
-	IndexArray *m_pVertices;
-	//!	Normal indices
-	IndexArray *m_pNormals;
-	//!	Texture coordinates indices
-	IndexArray *m_pTexturCoords;
-	//!	Pointer to assigned material
-	Material *m_pMaterial;
+	//!	Position of the first index in the index buffers
+	unsigned int m_uiFirstIndex;
+	//!	Number of vertex indices
+	unsigned int m_uiNumIndices;
+	//!	True, if texture coordinate indices are stored
+	bool m_hasTexCoords;
+	//!	True, if normal indices are stored
+	bool m_hasNormals;
 	
 	//!	\brief	Default constructor
-	//!	\param	pVertices	Pointer to assigned vertex indexbuffer
-	//!	\param	pNormals	Pointer to assigned normals indexbuffer
-	//!	\param	pTexCoords	Pointer to assigned texture indexbuffer
-	Face( std::vector<unsigned int> *pVertices, 
-			std::vector<unsigned int> *pNormals, 
-			std::vector<unsigned int> *pTexCoords,
-			aiPrimitiveType pt = aiPrimitiveType_POLYGON) : 
+	//!	\param	pt	Primitive type
+	Face( aiPrimitiveType pt = aiPrimitiveType_POLYGON ) : 
 		m_PrimitiveType( pt ), 
-		m_pVertices( pVertices ), 
-		m_pNormals( pNormals ),
-		m_pTexturCoords( pTexCoords ), 
-		m_pMaterial( 0L )
+		m_uiFirstIndex( 0 ),
+		m_uiNumIndices( 0 ),
+		m_hasTexCoords( false ),
+		m_hasNormals( false )
 	{
 		// empty
 	}
-	
-	//!	\brief	Destructor	
-	~Face()
-	{	
-		delete m_pVertices;
-		m_pVertices = NULL;
-
-		delete m_pNormals;
-		m_pNormals = NULL;
-
-		delete m_pTexturCoords;
-		m_pTexturCoords = NULL;
-	}
 };
 
 // ------------------------------------------------------------------------------------------------
@@ -200,8 +181,10 @@ struct Mesh
 {
 	static const unsigned int NoMaterial = ~0u;
 
-	///	Array with pointer to all stored faces
-	std::vector<Face*> m_Faces;
+	///	Position of the first face in the faces of the model
+	unsigned int m_uiFirstFace;
+	///	Number of faces, they are stored consecutively
+	unsigned int m_uiNumFaces;
 	///	Assigned material
 	Material *m_pMaterial;
 	///	Number of stored indices.
@@ -214,6 +197,8 @@ struct Mesh
 	bool m_hasNormals;
 	///	Constructor
 	Mesh() :
+		m_uiFirstFace(0),
+		m_uiNumFaces(0),
 		m_pMaterial(NULL),
 		m_uiNumIndices(0),
 		m_uiMaterialIndex( NoMaterial ),
@@ -225,11 +210,7 @@ struct Mesh
 	///	Destructor
 	~Mesh() 
 	{
-		for (std::vector<Face*>::iterator it = m_Faces.begin();
-			it != m_Faces.end(); ++it)
-		{
-			delete *it;
-		}
+		// empty
 	}
 };
 
@@ -268,6 +249,14 @@ struct Model
 	std::string m_strActiveGroup;
 	//!	Vector with generated texture coordinates
 	std::vector<aiVector2D> m_TextureCoord;
+	//!	Vector with all faces
+	std::vector<Face> m_Faces;
+	//!	Vertex indices of all faces
+	std::vector<unsigned int> m_VertexIndices;
+	//!	Texture coordinate and normal indices of all faces, parallel to the 
+	//!	vertex indices. They are only stored up to the last face using them.
+	std::vector<unsigned int> m_TexCoordIndices;
+	std::vector<unsigned int> m_NormalIndices;
 	//!	Current mesh instance
 	Mesh *m_pCurrentMesh;
 	//!	Vector with stored meshes
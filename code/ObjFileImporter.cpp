@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ObjFileImporter.h"
 #include "ObjFileParser.h"
 #include "ObjFileData.h"
+#include "ThreadPool.h"
 
 namespace Assimp	{
 
@@ -56,7 +57,8 @@ using namespace std;
 ObjFileImporter::ObjFileImporter() :
 	m_Buffer(),	
 	m_pRootObject( NULL ),
-	m_strAbsPath( "" )
+	m_strAbsPath( "" ),
+	m_NumThreads( 1 )
 {
     DefaultIOSystem io;
 	m_strAbsPath = io.getOsSeparator();
@@ -89,6 +91,14 @@ bool ObjFileImporter::CanRead( const std::string& pFile, IOSystem*  pIOHandler ,
 	}
 }
 
+// ------------------------------------------------------------------------------------------------
+//	Setup configuration properties for the loader.
+void ObjFileImporter::SetupProperties( const Importer* pImp )
+{
+	// Large files are parsed on as many threads as post-processing uses
+	m_NumThreads = ThreadPool::GetThreadCountForConfig( pImp->GetPropertyInteger( AI_CONFIG_GLOB_MULTITHREADING, AI_MULTITHREADING_DEFAULT ) );
+}
+
 // ------------------------------------------------------------------------------------------------
 //	Obj-file import implementation
 void ObjFileImporter::InternReadFile( const std::string& pFile, aiScene* pScene, IOSystem* pIOHandler)
@@ -122,7 +132,7 @@ void ObjFileImporter::InternReadFile( const std::string& pFile, aiScene* pScene,
 	}
 	
 	// parse the file into a temporary representation
-	ObjFileParser parser(m_Buffer, strModelName, pIOHandler);
+	ObjFileParser parser(m_Buffer, strModelName, pIOHandler, m_NumThreads);
 
 	// And create the proper return structures out of it
 	CreateDataFromImport(parser.GetModel(), pScene);
@@ -251,16 +261,17 @@ void ObjFileImporter::createTopology(const ObjFile::Model* pModel,
 	// Create faces
 	ObjFile::Mesh *pObjMesh = pModel->m_Meshes[ uiMeshIndex ];
 	ai_assert( NULL != pObjMesh );
+	const ObjFile::Face *pFaces = pObjMesh->m_uiNumFaces ? &pModel->m_Faces[ pObjMesh->m_uiFirstFace ] : NULL;
 
 	pMesh->mNumFaces = 0;
-	for (size_t index = 0; index < pObjMesh->m_Faces.size(); index++)
+	for (unsigned int index = 0; index < pObjMesh->m_uiNumFaces; index++)
 	{
-		ObjFile::Face* const inp = pObjMesh->m_Faces[ index ];
-		if (inp->m_PrimitiveType == aiPrimitiveType_LINE) {
-			pMesh->mNumFaces += inp->m_pVertices->size() - 1;
+		const ObjFile::Face &inp = pFaces[ index ];
+		if (inp.m_PrimitiveType == aiPrimitiveType_LINE) {
+			pMesh->mNumFaces += inp.m_uiNumIndices - 1;
 		}
-		else if (inp->m_PrimitiveType == aiPrimitiveType_POINT) {
-			pMesh->mNumFaces += inp->m_pVertices->size();
+		else if (inp.m_PrimitiveType == aiPrimitiveType_POINT) {
+			pMesh->mNumFaces += inp.m_uiNumIndices;
 		}
 		else {
 			++pMesh->mNumFaces;
@@ -276,34 +287,34 @@ void ObjFileImporter::createTopology(const ObjFile::Model* pModel,
 			pMesh->mMaterialIndex = pObjMesh->m_uiMaterialIndex;
 		}
 
-		unsigned int outIndex = 0;
-
-		// Copy all data from all stored meshes
-		for (size_t index = 0; index < pObjMesh->m_Faces.size(); index++)
+		// Each face corner gets its own vertex, see createVertexArray(). So the 
+		// faces just index the vertices in order.
+		aiFace *pFace = pMesh->mFaces;
+		for (unsigned int index = 0; index < pObjMesh->m_uiNumFaces; index++)
 		{
-			ObjFile::Face* const inp = pObjMesh->m_Faces[ index ];
-			if (inp->m_PrimitiveType == aiPrimitiveType_LINE) {
-				for(size_t i = 0; i < inp->m_pVertices->size() - 1; ++i) {
-					aiFace& f = pMesh->mFaces[ outIndex++ ];
-					uiIdxCount += f.mNumIndices = 2;
-					f.mIndices = new unsigned int[2];
+			const ObjFile::Face &inp = pFaces[ index ];
+			if (inp.m_PrimitiveType == aiPrimitiveType_LINE) {
+				for(unsigned int i = 1; i < inp.m_uiNumIndices; ++i, ++pFace) {
+					pFace->mNumIndices = 2;
+					pFace->mIndices = new unsigned int[2];
+					pFace->mIndices[0] = uiIdxCount++;
+					pFace->mIndices[1] = uiIdxCount++;
 				}
-				continue;
 			}
-			else if (inp->m_PrimitiveType == aiPrimitiveType_POINT) {
-				for(size_t i = 0; i < inp->m_pVertices->size(); ++i) {
-					aiFace& f = pMesh->mFaces[ outIndex++ ];
-					uiIdxCount += f.mNumIndices = 1;
-					f.mIndices = new unsigned int[1];
+			else if (inp.m_PrimitiveType == aiPrimitiveType_POINT) {
+				for(unsigned int i = 0; i < inp.m_uiNumIndices; ++i, ++pFace) {
+					pFace->mNumIndices = 1;
+					pFace->mIndices = new unsigned int[1];
+					pFace->mIndices[0] = uiIdxCount++;
 				}
-				continue;
 			}
-
-			aiFace *pFace = &pMesh->mFaces[ outIndex++ ];
-			const unsigned int uiNumIndices = (unsigned int) pObjMesh->m_Faces[ index ]->m_pVertices->size();
-			uiIdxCount += pFace->mNumIndices = (unsigned int) uiNumIndices;
-			if (pFace->mNumIndices > 0) {
-				pFace->mIndices = new unsigned int[ uiNumIndices ];			
+			else {
+				pFace->mNumIndices = inp.m_uiNumIndices;
+				pFace->mIndices = new unsigned int[ inp.m_uiNumIndices ];
+				for(unsigned int i = 0; i < inp.m_uiNumIndices; ++i) {
+					pFace->mIndices[i] = uiIdxCount++;
+				}
+				++pFace;
 			}
 		}
 	}
@@ -347,97 +358,58 @@ void ObjFileImporter::createVertexArray(const ObjFile::Model* pModel,
 		pMesh->mTextureCoords[ 0 ] = new aiVector3D[ pMesh->mNumVertices ];
 	}
 	
-	// Copy vertices, normals and textures into aiMesh instance
-	unsigned int newIndex = 0, outIndex = 0;
-	for ( size_t index=0; index < pObjMesh->m_Faces.size(); index++ )
+	// Copy vertices, normals and textures of all face corners into aiMesh instance. 
+	// Inner vertices of lines belong to two line segments and are copied twice.
+	const ObjFile::Face *pFaces = &pModel->m_Faces[ pObjMesh->m_uiFirstFace ];
+	const unsigned int uiNumVertices = (unsigned int) pModel->m_Vertices.size();
+	const unsigned int uiNumNormals = (unsigned int) pModel->m_Normals.size();
+	const unsigned int uiNumTexCoords = (unsigned int) pModel->m_TextureCoord.size();
+	unsigned int newIndex = 0;
+	for ( unsigned int index = 0; index < pObjMesh->m_uiNumFaces; index++ )
 	{
-		// Get source face
-		ObjFile::Face *pSourceFace = pObjMesh->m_Faces[ index ]; 
-
-		// Copy all index arrays
-		for ( size_t vertexIndex = 0, outVertexIndex = 0; vertexIndex < pSourceFace->m_pVertices->size(); vertexIndex++ )
+		// Get source face and its indices
+		const ObjFile::Face &sourceFace = pFaces[ index ];
+		const unsigned int *pVertices = &pModel->m_VertexIndices[ sourceFace.m_uiFirstIndex ];
+		const unsigned int *pNormals = ( sourceFace.m_hasNormals && pMesh->mNormals ) 
+			? &pModel->m_NormalIndices[ sourceFace.m_uiFirstIndex ] : NULL;
+		const unsigned int *pTexCoords = ( sourceFace.m_hasTexCoords && pMesh->mTextureCoords[ 0 ] ) 
+			? &pModel->m_TexCoordIndices[ sourceFace.m_uiFirstIndex ] : NULL;
+
+		const unsigned int uiNumIndices = sourceFace.m_uiNumIndices;
+		for ( unsigned int vertexIndex = 0; vertexIndex < uiNumIndices; vertexIndex++ )
 		{
-			const unsigned int vertex = pSourceFace->m_pVertices->at( vertexIndex );
-			if ( vertex >= pModel->m_Vertices.size() ) 
-				throw DeadlyImportError( "OBJ: vertex index out of range" );
-			
-			pMesh->mVertices[ newIndex ] = pModel->m_Vertices[ vertex ];
-			
-			// Copy all normals 
-			if ( !pSourceFace->m_pNormals->empty() && !pModel->m_Normals.empty())
-			{
-				const unsigned int normal = pSourceFace->m_pNormals->at( vertexIndex );
-				if ( normal >= pModel->m_Normals.size() )
-					throw DeadlyImportError("OBJ: vertex normal index out of range");
-
-				pMesh->mNormals[ newIndex ] = pModel->m_Normals[ normal ];
-			}
-			
-			// Copy all texture coordinates
-			if ( !pModel->m_TextureCoord.empty() )
+			unsigned int copies = 1;
+			if ( sourceFace.m_PrimitiveType == aiPrimitiveType_LINE )
 			{
-				if ( !pSourceFace->m_pTexturCoords->empty() )
-				{
-					const unsigned int tex = pSourceFace->m_pTexturCoords->at( vertexIndex );
-					ai_assert( tex < pModel->m_TextureCoord.size() );
-					for ( size_t i=0; i < pMesh->GetNumUVChannels(); i++ )
-					{
-						if ( tex >= pModel->m_TextureCoord.size() )
-							throw DeadlyImportError("OBJ: texture coord index out of range");
-
-						aiVector2D coord2d = pModel->m_TextureCoord[ tex ];
-						pMesh->mTextureCoords[ i ][ newIndex ] = aiVector3D( coord2d.x, coord2d.y, 0.0 );
-					}
-				}
+				if ( uiNumIndices < 2 )
+					break;
+				if ( vertexIndex > 0 && vertexIndex < uiNumIndices - 1 )
+					copies = 2;
 			}
 
-			ai_assert( pMesh->mNumVertices > newIndex );
-
-			// Get destination face
-			aiFace *pDestFace = &pMesh->mFaces[ outIndex ];
-
-			const bool last = ( vertexIndex == pSourceFace->m_pVertices->size() - 1 ); 
-			if (pSourceFace->m_PrimitiveType != aiPrimitiveType_LINE || !last) 
-			{
-				pDestFace->mIndices[ outVertexIndex ] = newIndex;
-				outVertexIndex++;
-			}
+			const unsigned int vertex = pVertices[ vertexIndex ];
+			if ( vertex >= uiNumVertices ) 
+				throw DeadlyImportError( "OBJ: vertex index out of range" );
+			if ( pNormals && pNormals[ vertexIndex ] >= uiNumNormals )
+				throw DeadlyImportError("OBJ: vertex normal index out of range");
+			if ( pTexCoords && pTexCoords[ vertexIndex ] >= uiNumTexCoords )
+				throw DeadlyImportError("OBJ: texture coord index out of range");
 
-			if (pSourceFace->m_PrimitiveType == aiPrimitiveType_POINT) 
-			{
-				outIndex++;
-				outVertexIndex = 0;
-			}
-			else if (pSourceFace->m_PrimitiveType == aiPrimitiveType_LINE) 
+			for ( ; copies > 0; --copies, ++newIndex )
 			{
-				outVertexIndex = 0;
-
-				if(!last) 
-					outIndex++;
-
-				if (vertexIndex) {
-					if(!last) {
-						pMesh->mVertices[ newIndex+1 ] = pMesh->mVertices[ newIndex ];
-						if ( !pSourceFace->m_pNormals->empty() && !pModel->m_Normals.empty()) {
-							pMesh->mNormals[ newIndex+1 ] = pMesh->mNormals[newIndex ];
-						}
-						if ( !pModel->m_TextureCoord.empty() ) {
-							for ( size_t i=0; i < pMesh->GetNumUVChannels(); i++ ) {
-								pMesh->mTextureCoords[ i ][ newIndex+1 ] = pMesh->mTextureCoords[ i ][ newIndex ];
-							}
-						}
-						++newIndex;
-					}
-
-					pDestFace[-1].mIndices[1] = newIndex;
+				ai_assert( pMesh->mNumVertices > newIndex );
+				pMesh->mVertices[ newIndex ] = pModel->m_Vertices[ vertex ];
+				if ( pNormals )
+					pMesh->mNormals[ newIndex ] = pModel->m_Normals[ pNormals[ vertexIndex ] ];
+				if ( pTexCoords )
+				{
+					const aiVector2D &coord2d = pModel->m_TextureCoord[ pTexCoords[ vertexIndex ] ];
+					pMesh->mTextureCoords[ 0 ][ newIndex ] = aiVector3D( coord2d.x, coord2d.y, 0.0 );
 				}
 			}
-			else if (last) {
-				outIndex++;
-			}
-			++newIndex;
 		}
-	}	
+	}
+	ai_assert( newIndex == pMesh->mNumVertices );
 }
 
 // ------------------------------------------------------------------------------------------------
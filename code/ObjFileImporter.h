@@ -80,6 +80,9 @@ private:
 	//! \brief	Appends the supported extention.
 	void GetExtensionList(std::set<std::string>& extensions);
 
+	//!	\brief	Setup configuration properties for the loader.
+	void SetupProperties(const Importer* pImp);
+
 	//!	\brief	File import implementation.
 	void InternReadFile(const std::string& pFile, aiScene* pScene, IOSystem* pIOHandler);
 	
@@ -117,6 +120,8 @@ private:
 	ObjFile::Object *m_pRootObject;
 	//!	Absolute pathname of model in filesystem
 	std::string m_strAbsPath;
+	//!	Number of threads used to parse large files
+	unsigned int m_NumThreads;
 };
 
 // ------------------------------------------------------------------------------------------------
@@ -49,6 +49,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ParsingUtils.h"
 #include "../include/assimp/types.h"
 #include "DefaultIOSystem.h"
+#include "ThreadPool.h"
 
 namespace Assimp	
 {
@@ -56,78 +57,148 @@ namespace Assimp
 // -------------------------------------------------------------------
 const std::string ObjFileParser::DEFAULT_MATERIAL = AI_DEFAULT_MATERIAL_NAME; 
 
-// -------------------------------------------------------------------
-//	Constructor with loaded data and directories.
-ObjFileParser::ObjFileParser(std::vector<char> &Data,const std::string &strModelName, IOSystem *io ) :
-	m_DataIt(Data.begin()),
-	m_DataItEnd(Data.end()),
-	m_pModel(NULL),
-	m_uiLine(0),
-	m_pIO( io )
-{
-	std::fill_n(m_buffer,BUFFERSIZE,0);
+// Files smaller than this are not split for parallel parsing
+static const size_t MIN_CHUNK_SIZE = 256 * 1024;
 
-	// Create the model instance to store all the data
-	m_pModel = new ObjFile::Model();
-	m_pModel->m_ModelName = strModelName;
-	
-	m_pModel->m_pDefaultMaterial = new ObjFile::Material();
-	m_pModel->m_pDefaultMaterial->MaterialName.Set( DEFAULT_MATERIAL );
-	m_pModel->m_MaterialLib.push_back( DEFAULT_MATERIAL );
-	m_pModel->m_MaterialMap[ DEFAULT_MATERIAL ] = m_pModel->m_pDefaultMaterial;
-	
-	// Start parsing the file
-	parseFile();
-}
+namespace ObjFile
+{
 
 // -------------------------------------------------------------------
-//	Destructor
-ObjFileParser::~ObjFileParser()
+//	A face read from a chunk. Its indices follow the ones of the 
+//	previous face in the index arrays of the chunk.
+struct ChunkFace
 {
-	/*delete m_pModel->m_pDefaultMaterial;
-	m_pModel->m_pDefaultMaterial = NULL;*/
+	//!	Primitive type of the face
+	aiPrimitiveType m_PrimitiveType;
+	//!	Number of vertex, texture coordinate and normal indices
+	unsigned int m_uiNumIndices[3];
+	//!	Number of vertices, texture coordinates and normals defined 
+	//!	before the face in the same chunk
+	unsigned int m_uiNumDefined[3];
+	//!	Start of the index list in the buffer
+	const char *m_pIndices;
+	//!	True, if the indices were read differently if there were no 
+	//!	texture coordinates, but normals (see ReadFaceIndices())
+	bool m_bDependsOnContext;
+};
 
-	delete m_pModel;
-	m_pModel = NULL;
-}
+// -------------------------------------------------------------------
+//	Data read from a range of whole lines of the file. Vertex data 
+//	and faces are read independently of the other chunks, relative 
+//	indices are resolved and all other statements are executed in 
+//	file order while merging the chunks (see ObjFileParser::parseFile).
+struct Chunk
+{
+	//!	Range of the chunk in the buffer
+	const char *m_pBegin;
+	const char *m_pEnd;
+	//!	Vertex data defined in the chunk
+	std::vector<aiVector3D> m_Vertices;
+	std::vector<aiVector3D> m_Normals;
+	std::vector<aiVector2D> m_TextureCoord;
+	//!	Faces defined in the chunk
+	std::vector<ChunkFace> m_Faces;
+	//!	Vertex, texture coordinate and normal indices as read, i.e. 
+	//!	1-based or negative for relative ones
+	std::vector<int> m_Indices[3];
+	//!	Other statements along with the number of faces preceding them
+	std::vector< std::pair<unsigned int, const char*> > m_Statements;
+};
+
+} // Namespace ObjFile
+
+namespace
+{
 
 // -------------------------------------------------------------------
-//	Returns a pointer to the model instance.
-ObjFile::Model *ObjFileParser::GetModel() const
+//	Reads the indices of a face statement, pPtr points behind the 
+//	keyword. Indices are appended as read to the vertex, texture 
+//	coordinate and normal index arrays. If there are no texture 
+//	coordinates, but normals, an index directly behind the first 
+//	slash is skipped. Returns true if the line contains such an index.
+bool ReadFaceIndices(const char *pPtr, aiPrimitiveType type, bool skipTexCoord, std::vector<int> (&indices)[3])
 {
-	return m_pModel;
+	bool dependsOnContext = false;
+	unsigned int iPos = 0;
+	while ( !IsLineEnd( *pPtr ) )
+	{
+		if ( *pPtr == '/' )
+		{
+			if (type == aiPrimitiveType_POINT) {
+				DefaultLogger::get()->error("Obj: Separator unexpected in point statement");
+			}
+			if ( iPos == 0 )
+			{
+				// 'v//n' is the same either way
+				if ( pPtr[ 1 ] != '/' && !IsLineEnd( pPtr[ 1 ] ) )
+					dependsOnContext = true;
+				if ( skipTexCoord )
+				{
+					iPos = 1;
+					if ( !IsLineEnd( pPtr[ 1 ] ) )
+						++pPtr;
+				}
+			}
+			++iPos;
+			++pPtr;
+		}
+		else if ( isSeparator( *pPtr ) )
+		{
+			iPos = 0;
+			++pPtr;
+		}
+		else
+		{
+			//OBJ USES 1 Base ARRAYS!!!!
+			const char *pNext = pPtr;
+			const int iVal = strtol10( pPtr, &pNext );
+			if ( iVal != 0 )
+			{
+				if ( iPos < 3 )
+					indices[ iPos ].push_back( iVal );
+				else
+					DefaultLogger::get()->error("OBJ: Not supported token in face description detected");
+			}
+			pPtr = ( pNext == pPtr ? pPtr + 1 : pNext );
+		}
+	}
+	return dependsOnContext;
 }
 
 // -------------------------------------------------------------------
-//	File parsing method.
-void ObjFileParser::parseFile()
+//	Reads all vertex data and faces of a chunk.
+void ReadChunk(ObjFile::Chunk &chunk)
 {
-	if (m_DataIt == m_DataItEnd)
-		return;
-
-	while (m_DataIt != m_DataItEnd)
+	const char *pPtr = chunk.m_pBegin;
+	while ( pPtr < chunk.m_pEnd )
 	{
-		switch (*m_DataIt)
+		// from time to time there are spaces at the beginning of a line
+		while ( *pPtr == ' ' || *pPtr == '\t' )
+			++pPtr;
+
+		switch ( *pPtr )
 		{
-		case 'v': // Parse a vertex texture coordinate
+		case 'v': // Parse a vertex, texture coordinate or normal
 			{
-				++m_DataIt;
-				if (*m_DataIt == ' ')
+				++pPtr;
+				// the buffer is zero-terminated, parse the components in place. Missing ones are 0.
+				if ( *pPtr == ' ' )
 				{
-					// Read in vertex definition
-					getVector3(m_pModel->m_Vertices);
+					float v[3] = { 0.f, 0.f, 0.f };
+					fast_atoreal_span<float>(pPtr, v, 3, false);
+					chunk.m_Vertices.push_back( aiVector3D( v[0], v[1], v[2] ) );
 				}
-				else if (*m_DataIt == 't')
+				else if ( *pPtr == 't' )
 				{
-					// Read in texture coordinate (2D)
-					++m_DataIt;
-					getVector2(m_pModel->m_TextureCoord);
+					float v[2] = { 0.f, 0.f };
+					fast_atoreal_span<float>(++pPtr, v, 2, false);
+					chunk.m_TextureCoord.push_back( aiVector2D( v[0], v[1] ) );
 				}
-				else if (*m_DataIt == 'n')
+				else if ( *pPtr == 'n' )
 				{
-					// Read in normal vector definition
-					++m_DataIt;
-					getVector3( m_pModel->m_Normals );
+					float v[3] = { 0.f, 0.f, 0.f };
+					fast_atoreal_span<float>(++pPtr, v, 3, false);
+					chunk.m_Normals.push_back( aiVector3D( v[0], v[1], v[2] ) );
 				}
 			}
 			break;
@@ -136,221 +207,353 @@ void ObjFileParser::parseFile()
 		case 'l':
 		case 'f':
 			{
-				getFace(*m_DataIt == 'f' ? aiPrimitiveType_POLYGON : (*m_DataIt == 'l' 
-					? aiPrimitiveType_LINE : aiPrimitiveType_POINT));
-			}
-			break;
-
-		case '#': // Parse a comment
-			{
-				getComment();
-			}
-			break;
-
-		case 'u': // Parse a material desc. setter
-			{
-				getMaterialDesc();
-			}
-			break;
-
-		case 'm': // Parse a material library
-			{
-				getMaterialLib();
-			}
-			break;
-
-		case 'g': // Parse group name
-			{
-				getGroupName();
+				ObjFile::ChunkFace face;
+				face.m_PrimitiveType = *pPtr == 'f' ? aiPrimitiveType_POLYGON : (*pPtr == 'l' 
+					? aiPrimitiveType_LINE : aiPrimitiveType_POINT);
+
+				while ( *pPtr && !isSeparator( *pPtr ) )
+					++pPtr;
+				while ( IsSpace( *pPtr ) )
+					++pPtr;
+				if ( IsLineEnd( *pPtr ) )
+					break;
+
+				// Read the indices as if the chunk was the whole file
+				face.m_uiNumDefined[0] = (unsigned int)chunk.m_Vertices.size();
+				face.m_uiNumDefined[1] = (unsigned int)chunk.m_TextureCoord.size();
+				face.m_uiNumDefined[2] = (unsigned int)chunk.m_Normals.size();
+				face.m_pIndices = pPtr;
+
+				size_t numIndices[3];
+				for ( unsigned int i = 0; i < 3; ++i )
+					numIndices[ i ] = chunk.m_Indices[ i ].size();
+
+				face.m_bDependsOnContext = ReadFaceIndices( pPtr, face.m_PrimitiveType, 
+					!face.m_uiNumDefined[1] && face.m_uiNumDefined[2], chunk.m_Indices );
+				for ( unsigned int i = 0; i < 3; ++i )
+					face.m_uiNumIndices[ i ] = (unsigned int)( chunk.m_Indices[ i ].size() - numIndices[ i ] );
+
+				chunk.m_Faces.push_back( face );
 			}
 			break;
 
-		case 's': // Parse group number
+		case 'u': // Material desc. setter, material library, group and object 
+		case 'm': // names are executed while merging the chunks
+		case 'g':
+		case 'o':
 			{
-				getGroupNumber();
+				chunk.m_Statements.push_back( std::make_pair( (unsigned int)chunk.m_Faces.size(), pPtr ) );
 			}
 			break;
 
-		case 'o': // Parse object name
-			{
-				getObjectName();
-			}
-			break;
-		
-		default:
-			{
-				m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
-			}
+		default: // Comments, group numbers and unknown statements are skipped
 			break;
 		}
+
+		// Skip the rest of the line
+		while ( pPtr < chunk.m_pEnd && !isNewLine( *pPtr ) )
+			++pPtr;
+		while ( pPtr < chunk.m_pEnd && isNewLine( *pPtr ) )
+			++pPtr;
 	}
 }
 
 // -------------------------------------------------------------------
-//	Copy the next word in a temporary buffer
-void ObjFileParser::copyNextWord(char *pBuffer, size_t length)
+//	Reads the chunks of a file in parallel
+class ReadChunkTask : public ParallelTask
 {
-	size_t index = 0;
-	m_DataIt = getNextWord<DataArrayIt>(m_DataIt, m_DataItEnd);
-	while ( m_DataIt != m_DataItEnd && !isSeparator(*m_DataIt) )
-	{
-		pBuffer[index] = *m_DataIt;
-		index++;
-		if (index == length-1)
-			break;
-		++m_DataIt;
+public:
+	ReadChunkTask(std::vector<ObjFile::Chunk> &chunks) 
+		: m_Chunks(chunks) {}
+
+	void Run(unsigned int index) {
+		ReadChunk(m_Chunks[index]);
 	}
-	pBuffer[index] = '\0';
-}
+
+private:
+	std::vector<ObjFile::Chunk> &m_Chunks;
+};
 
 // -------------------------------------------------------------------
-// Copy the next line into a temporary buffer
-void ObjFileParser::copyNextLine(char *pBuffer, size_t length)
+//	Moves the data of a chunk to the end of an array of the model
+template <typename T>
+void moveToModel(std::vector<T> &chunkData, std::vector<T> &modelData)
 {
-	size_t index = 0;
-	while (m_DataIt != m_DataItEnd)
+	if ( modelData.empty() )
 	{
-		if (*m_DataIt == '\n' || *m_DataIt == '\r' || index == length-1)
-			break;
-
-		pBuffer[ index ] = *m_DataIt;
-		++index;
-		++m_DataIt;
+		modelData.swap( chunkData );
 	}
-	pBuffer[ index ] = '\0';
+	else
+	{
+		modelData.insert( modelData.end(), chunkData.begin(), chunkData.end() );
+	}
+	std::vector<T>().swap( chunkData );
 }
 
+} // anonymous namespace
+
 // -------------------------------------------------------------------
-//	Get values for a new 3D vector instance
-void ObjFileParser::getVector3(std::vector<aiVector3D> &point3d_array)
+//	Constructor with loaded data and directories.
+ObjFileParser::ObjFileParser(std::vector<char> &Data,const std::string &strModelName, IOSystem *io,
+	unsigned int numThreads ) :
+	m_DataIt(Data.begin()),
+	m_DataItEnd(Data.end()),
+	m_pModel(NULL),
+	m_uiLine(0),
+	m_pIO( io ),
+	m_uiNumThreads( numThreads )
 {
-	float x, y, z;
-	copyNextWord(m_buffer, BUFFERSIZE);
-	x = (float) fast_atof(m_buffer);	
+	// Create the model instance to store all the data
+	m_pModel = new ObjFile::Model();
+	m_pModel->m_ModelName = strModelName;
 	
-	copyNextWord(m_buffer, BUFFERSIZE);
-	y = (float) fast_atof(m_buffer);
-
-	copyNextWord(m_buffer, BUFFERSIZE);
-	z = (float) fast_atof(m_buffer);
-
-	point3d_array.push_back( aiVector3D( x, y, z ) );
-	//skipLine();
-	m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
+	m_pModel->m_pDefaultMaterial = new ObjFile::Material();
+	m_pModel->m_pDefaultMaterial->MaterialName.Set( DEFAULT_MATERIAL );
+	m_pModel->m_MaterialLib.push_back( DEFAULT_MATERIAL );
+	m_pModel->m_MaterialMap[ DEFAULT_MATERIAL ] = m_pModel->m_pDefaultMaterial;
+	
+	// Start parsing the file
+	parseFile();
 }
 
 // -------------------------------------------------------------------
-//	Get values for a new 2D vector instance
-void ObjFileParser::getVector2( std::vector<aiVector2D> &point2d_array )
+//	Destructor
+ObjFileParser::~ObjFileParser()
 {
-	float x, y;
-	copyNextWord(m_buffer, BUFFERSIZE);
-	x = (float) fast_atof(m_buffer);	
-	
-	copyNextWord(m_buffer, BUFFERSIZE);
-	y = (float) fast_atof(m_buffer);
+	/*delete m_pModel->m_pDefaultMaterial;
+	m_pModel->m_pDefaultMaterial = NULL;*/
 
-	point2d_array.push_back(aiVector2D(x, y));
+	delete m_pModel;
+	m_pModel = NULL;
+}
 
-	m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
+// -------------------------------------------------------------------
+//	Returns a pointer to the model instance.
+ObjFile::Model *ObjFileParser::GetModel() const
+{
+	return m_pModel;
 }
 
 // -------------------------------------------------------------------
-//	Get values for a new face instance
-void ObjFileParser::getFace(aiPrimitiveType type)
+//	File parsing method.
+void ObjFileParser::parseFile()
 {
-	copyNextLine(m_buffer, BUFFERSIZE);
 	if (m_DataIt == m_DataItEnd)
 		return;
 
-	char *pPtr = m_buffer;
-	char *pEnd = &pPtr[BUFFERSIZE];
-	pPtr = getNextToken<char*>(pPtr, pEnd);
-	if (pPtr == pEnd || *pPtr == '\0')
-		return;
+	// The buffer is zero-terminated. Split it into chunks of whole lines,
+	// large files are read in parallel.
+	const DataArrayIt itBegin = m_DataIt;
+	const char *pBegin = &(*m_DataIt);
+	const char *pEnd = pBegin + ( m_DataItEnd - m_DataIt ) - 1;
+	const size_t size = pEnd - pBegin;
 
-	std::vector<unsigned int> *pIndices = new std::vector<unsigned int>;
-	std::vector<unsigned int> *pTexID = new std::vector<unsigned int>;
-	std::vector<unsigned int> *pNormalID = new std::vector<unsigned int>;
-	bool hasNormal = false;
+	size_t numChunks = 1;
+	if ( m_uiNumThreads > 1 )
+		numChunks = std::max( (size_t)1, std::min( size / MIN_CHUNK_SIZE, (size_t)m_uiNumThreads * 4 ) );
 
-	const bool vt = (!m_pModel->m_TextureCoord.empty());
-	const bool vn = (!m_pModel->m_Normals.empty());
-	int iStep = 0, iPos = 0;
-	while (pPtr != pEnd)
+	std::vector<ObjFile::Chunk> chunks( numChunks );
+	for ( size_t i = 0; i < numChunks; ++i )
 	{
-		iStep = 1;
+		ObjFile::Chunk &chunk = chunks[ i ];
+		chunk.m_pBegin = ( i == 0 ? pBegin : chunks[ i-1 ].m_pEnd );
+		chunk.m_pEnd = std::max( chunk.m_pBegin, pBegin + size * ( i+1 ) / numChunks );
+		while ( chunk.m_pEnd < pEnd && *chunk.m_pEnd != '\n' )
+			++chunk.m_pEnd;
+		if ( chunk.m_pEnd < pEnd )
+			++chunk.m_pEnd;
+	}
 
-		if (IsLineEnd(*pPtr))
-			break;
+	if ( numChunks > 1 )
+	{
+		ReadChunkTask task( chunks );
+		ThreadPool pool( m_uiNumThreads );
+		pool.ParallelFor( task, (unsigned int)numChunks );
+	}
+	else
+	{
+		ReadChunk( chunks[ 0 ] );
+	}
 
-		if (*pPtr=='/' )
+	// The index buffers and faces are built while merging, reserve them for all chunks
+	size_t numFaces = 0, numIndices = 0;
+	bool hasIndices[3] = { true, false, false };
+	for ( std::vector<ObjFile::Chunk>::const_iterator it = chunks.begin(); it != chunks.end(); ++it )
+	{
+		numFaces += it->m_Faces.size();
+		numIndices += it->m_Indices[ 0 ].size();
+		for ( unsigned int j = 1; j < 3; ++j )
+			hasIndices[ j ] = hasIndices[ j ] || !it->m_Indices[ j ].empty();
+	}
+	m_pModel->m_Faces.reserve( numFaces );
+	m_pModel->m_VertexIndices.reserve( numIndices );
+	if ( hasIndices[ 1 ] )
+		m_pModel->m_TexCoordIndices.reserve( numIndices );
+	if ( hasIndices[ 2 ] )
+		m_pModel->m_NormalIndices.reserve( numIndices );
+
+	// The vertex data of the first chunk is taken over as it is, the model 
+	// grows once to the total size before the other chunks are appended
+	mergeChunk( chunks[ 0 ], itBegin );
+	if ( numChunks > 1 )
+	{
+		size_t numData[3] = { m_pModel->m_Vertices.size(), m_pModel->m_TextureCoord.size(), 
+			m_pModel->m_Normals.size() };
+		for ( size_t i = 1; i < numChunks; ++i )
 		{
-			if (type == aiPrimitiveType_POINT) {
-				DefaultLogger::get()->error("Obj: Separator unexpected in point statement");
-			}
-			if (iPos == 0)
+			numData[ 0 ] += chunks[ i ].m_Vertices.size();
+			numData[ 1 ] += chunks[ i ].m_TextureCoord.size();
+			numData[ 2 ] += chunks[ i ].m_Normals.size();
+		}
+		m_pModel->m_Vertices.reserve( numData[ 0 ] );
+		m_pModel->m_TextureCoord.reserve( numData[ 1 ] );
+		m_pModel->m_Normals.reserve( numData[ 2 ] );
+
+		for ( size_t i = 1; i < numChunks; ++i )
+			mergeChunk( chunks[ i ], itBegin );
+	}
+	m_DataIt = m_DataItEnd;
+}
+
+// -------------------------------------------------------------------
+//	Appends the data of a chunk to the model, executing all other 
+//	statements of the chunk in order. The chunk is left empty.
+void ObjFileParser::mergeChunk(ObjFile::Chunk &chunk, DataArrayIt itBegin)
+{
+	const char *pBegin = &(*itBegin);
+
+	// Number of vertices, texture coordinates and normals in the preceding chunks
+	const unsigned int numBefore[3] = {
+		(unsigned int)m_pModel->m_Vertices.size(),
+		(unsigned int)m_pModel->m_TextureCoord.size(),
+		(unsigned int)m_pModel->m_Normals.size() 
+	};
+	moveToModel( chunk.m_Vertices, m_pModel->m_Vertices );
+	moveToModel( chunk.m_TextureCoord, m_pModel->m_TextureCoord );
+	moveToModel( chunk.m_Normals, m_pModel->m_Normals );
+
+	std::vector<int> indices[3];
+	size_t offset[3] = { 0, 0, 0 };
+	std::vector< std::pair<unsigned int, const char*> >::const_iterator statement = chunk.m_Statements.begin();
+	for ( unsigned int i = 0; ; ++i )
+	{
+		// Execute the statements preceding the face
+		for ( ; statement != chunk.m_Statements.end() && statement->first == i; ++statement )
+		{
+			m_DataIt = itBegin + ( statement->second - pBegin );
+			switch ( *m_DataIt )
 			{
-				//if there are no texture coordinates in the file, but normals
-				if (!vt && vn) {
-					iPos = 1;
-					iStep++;
-				}
+			case 'u': // Parse a material desc. setter
+				getMaterialDesc();
+				break;
+
+			case 'm': // Parse a material library
+				getMaterialLib();
+				break;
+
+			case 'g': // Parse group name
+				getGroupName();
+				break;
+
+			case 'o': // Parse object name
+				getObjectName();
+				break;
 			}
-			iPos++;
 		}
-		else if ( isSeparator(*pPtr) )
+		if ( i == chunk.m_Faces.size() )
 		{
-			iPos = 0;
+			// the faces are part of the model now
+			std::vector<ObjFile::ChunkFace>().swap( chunk.m_Faces );
+			for ( unsigned int j = 0; j < 3; ++j )
+				std::vector<int>().swap( chunk.m_Indices[ j ] );
+			break;
+		}
+
+		const ObjFile::ChunkFace &face = chunk.m_Faces[ i ];
+		const int *pIndices[3];
+		for ( unsigned int j = 0; j < 3; ++j )
+		{
+			pIndices[ j ] = face.m_uiNumIndices[ j ] ? &chunk.m_Indices[ j ][ offset[ j ] ] : NULL;
+			offset[ j ] += face.m_uiNumIndices[ j ];
 		}
-		else 
+		unsigned int numIndices[3] = { face.m_uiNumIndices[0], face.m_uiNumIndices[1], face.m_uiNumIndices[2] };
+
+		// Read the face again if the texture coordinates or normals defined in the 
+		// preceding chunks change the meaning of its indices
+		const bool skipTexCoord = !( numBefore[1] + face.m_uiNumDefined[1] ) && ( numBefore[2] + face.m_uiNumDefined[2] );
+		if ( face.m_bDependsOnContext && skipTexCoord != ( !face.m_uiNumDefined[1] && face.m_uiNumDefined[2] ) )
 		{
-			//OBJ USES 1 Base ARRAYS!!!!
-			const int iVal = atoi( pPtr );
-			int tmp = iVal;
-			while ( ( tmp = tmp / 10 )!=0 )
-				++iStep;
+			for ( unsigned int j = 0; j < 3; ++j )
+				indices[ j ].clear();
+			ReadFaceIndices( face.m_pIndices, face.m_PrimitiveType, skipTexCoord, indices );
+			for ( unsigned int j = 0; j < 3; ++j )
+			{
+				pIndices[ j ] = indices[ j ].empty() ? NULL : &indices[ j ][ 0 ];
+				numIndices[ j ] = (unsigned int)indices[ j ].size();
+			}
+		}
 
-			if ( iVal > 0 )
+		// Convert to 0-based indices in the index buffers of the model, negative 
+		// ones are relative to the last element defined before the face
+		ObjFile::Face objFace( face.m_PrimitiveType );
+		objFace.m_uiFirstIndex = (unsigned int)m_pModel->m_VertexIndices.size();
+		std::vector<unsigned int> *pBuffers[3] = { &m_pModel->m_VertexIndices, 
+			&m_pModel->m_TexCoordIndices, &m_pModel->m_NormalIndices };
+		unsigned int numStored[3];
+		for ( unsigned int j = 0; j < 3; ++j )
+		{
+			std::vector<unsigned int> &buffer = *pBuffers[ j ];
+			if ( j > 0 && numIndices[ j ] )
+				buffer.resize( objFace.m_uiFirstIndex, ~0u );
+
+			for ( unsigned int k = 0; k < numIndices[ j ]; ++k )
 			{
-				// Store parsed index
-				if ( 0 == iPos )
+				const int iVal = pIndices[ j ][ k ];
+				if ( iVal > 0 )
 				{
-					pIndices->push_back( iVal-1 );
+					buffer.push_back( iVal-1 );
 				}
-				else if ( 1 == iPos )
-				{	
-					pTexID->push_back( iVal-1 );
-				}
-				else if ( 2 == iPos )
+				else if ( -iVal <= (int)( numBefore[ j ] + face.m_uiNumDefined[ j ] ) )
 				{
-					pNormalID->push_back( iVal-1 );
-					hasNormal = true;
+					buffer.push_back( numBefore[ j ] + face.m_uiNumDefined[ j ] + iVal );
 				}
 				else
 				{
-					reportErrorTokenInFace();
+					DefaultLogger::get()->error("OBJ: Invalid relative index in face description");
 				}
 			}
+			numStored[ j ] = numIndices[ j ] ? (unsigned int)buffer.size() - objFace.m_uiFirstIndex : 0;
 		}
-		pPtr += iStep;
-	}
 
-	if ( pIndices->empty() ) 
-	{
-		DefaultLogger::get()->error("Obj: Ignoring empty face");
-		m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
-		return;
-	}
+		if ( !numStored[ 0 ] ) 
+		{
+			DefaultLogger::get()->error("Obj: Ignoring empty face");
+			for ( unsigned int j = 1; j < 3; ++j )
+			{
+				if ( pBuffers[ j ]->size() > objFace.m_uiFirstIndex )
+					pBuffers[ j ]->resize( objFace.m_uiFirstIndex );
+			}
+			continue;
+		}
 
-	ObjFile::Face *face = new ObjFile::Face( pIndices, pNormalID, pTexID, type );
-	
-	// Set active material, if one set
-	if (NULL != m_pModel->m_pCurrentMaterial) 
-		face->m_pMaterial = m_pModel->m_pCurrentMaterial;
-	else 
-		face->m_pMaterial = m_pModel->m_pDefaultMaterial;
+		// Texture coordinate and normal indices are parallel to the vertex 
+		// indices, missing ones are marked as invalid
+		objFace.m_uiNumIndices = numStored[ 0 ];
+		objFace.m_hasTexCoords = numStored[ 1 ] > 0;
+		objFace.m_hasNormals = numStored[ 2 ] > 0;
+		for ( unsigned int j = 1; j < 3; ++j )
+		{
+			if ( numStored[ j ] )
+				pBuffers[ j ]->resize( objFace.m_uiFirstIndex + objFace.m_uiNumIndices, ~0u );
+		}
+		storeFace( objFace );
+	}
+}
 
+// -------------------------------------------------------------------
+//	Adds a face to the current mesh
+void ObjFileParser::storeFace(const ObjFile::Face &face)
+{
 	// Create a default object, if nothing is there
 	if ( NULL == m_pModel->m_pCurrent )
 		createObject( "defaultobject" );
@@ -361,16 +564,21 @@ void ObjFileParser::getFace(aiPrimitiveType type)
 		createMesh();
 	}
 	
-	// Store the face
-	m_pModel->m_pCurrentMesh->m_Faces.push_back( face );
-	m_pModel->m_pCurrentMesh->m_uiNumIndices += (unsigned int)face->m_pVertices->size();
-	m_pModel->m_pCurrentMesh->m_uiUVCoordinates[ 0 ] += (unsigned int)face->m_pTexturCoords[0].size(); 
-	if( !m_pModel->m_pCurrentMesh->m_hasNormals && hasNormal ) 
+	// Store the face, a mesh never gets faces again once another one was created
+	ObjFile::Mesh *pMesh = m_pModel->m_pCurrentMesh;
+	if ( 0 == pMesh->m_uiNumFaces )
+		pMesh->m_uiFirstFace = (unsigned int)m_pModel->m_Faces.size();
+	ai_assert( pMesh->m_uiFirstFace + pMesh->m_uiNumFaces == m_pModel->m_Faces.size() );
+
+	m_pModel->m_Faces.push_back( face );
+	++pMesh->m_uiNumFaces;
+	pMesh->m_uiNumIndices += face.m_uiNumIndices;
+	if ( face.m_hasTexCoords )
+		pMesh->m_uiUVCoordinates[ 0 ] += face.m_uiNumIndices; 
+	if( !pMesh->m_hasNormals && face.m_hasNormals ) 
 	{
-		m_pModel->m_pCurrentMesh->m_hasNormals = true;
+		pMesh->m_hasNormals = true;
 	}
-	// Skip the rest of the line
-	m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
 }
 
 // -------------------------------------------------------------------
@@ -382,7 +590,7 @@ void ObjFileParser::getMaterialDesc()
 	// So, we create a new object only if the current on is already initialized !
 	if (m_pModel->m_pCurrent != NULL &&
 		(	m_pModel->m_pCurrent->m_Meshes.size() > 1 ||
-			(m_pModel->m_pCurrent->m_Meshes.size() == 1 && m_pModel->m_Meshes[m_pModel->m_pCurrent->m_Meshes[0]]->m_Faces.size() != 0)	)
+			(m_pModel->m_pCurrent->m_Meshes.size() == 1 && m_pModel->m_Meshes[m_pModel->m_pCurrent->m_Meshes[0]]->m_uiNumFaces != 0)	)
 		)
 		m_pModel->m_pCurrent = NULL;
 
@@ -423,24 +631,6 @@ void ObjFileParser::getMaterialDesc()
 	m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
 }
 
-// -------------------------------------------------------------------
-//	Get a comment, values will be skipped
-void ObjFileParser::getComment()
-{
-	while (m_DataIt != m_DataItEnd)
-	{
-		if ( '\n' == (*m_DataIt))
-		{
-			++m_DataIt;
-			break;
-		}
-		else
-		{
-			++m_DataIt;
-		}
-	}
-}
-
 // -------------------------------------------------------------------
 //	Get material library from file.
 void ObjFileParser::getMaterialLib()
@@ -565,15 +755,6 @@ void ObjFileParser::getGroupName()
 	m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
 }
 
-// -------------------------------------------------------------------
-//	Not supported
-void ObjFileParser::getGroupNumber()
-{
-	// Not used
-
-	m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
-}
-
 // -------------------------------------------------------------------
 //	Stores values for a new object instance, name will be used to 
 //	identify it.
@@ -670,14 +851,6 @@ bool ObjFileParser::needsNewMesh( const std::string &rMaterialName )
 	return newMat;
 }
 
-// -------------------------------------------------------------------
-//	Shows an error in parsing process.
-void ObjFileParser::reportErrorTokenInFace()
-{		
-	m_DataIt = skipLine<DataArrayIt>( m_DataIt, m_DataItEnd, m_uiLine );
-	DefaultLogger::get()->error("OBJ: Not supported token in face description detected");
-}
-
 // -------------------------------------------------------------------
 
 }	// Namespace Assimp
@@ -56,6 +56,8 @@ struct Object;
 struct Material;
 struct Point3;
 struct Point2;
+struct Face;
+struct Chunk;
 }
 class ObjFileImporter;
 class IOSystem;
@@ -65,14 +67,14 @@ class IOSystem;
 class ObjFileParser
 {
 public:
-	static const size_t BUFFERSIZE = 4096;
 	typedef std::vector<char> DataArray;
 	typedef std::vector<char>::iterator DataArrayIt;
 	typedef std::vector<char>::const_iterator ConstDataArrayIt;
 
 public:
 	///	\brief	Constructor with data array.
-	ObjFileParser(std::vector<char> &Data,const std::string &strModelName, IOSystem* io);
+	ObjFileParser(std::vector<char> &Data,const std::string &strModelName, IOSystem* io,
+		unsigned int numThreads = 1);
 	///	\brief	Destructor
 	~ObjFileParser();
 	///	\brief	Model getter.
@@ -81,27 +83,17 @@ public:
 private:
 	///	Parse the loadedfile
 	void parseFile();
-	///	Method to copy the new delimited word in the current line.
-	void copyNextWord(char *pBuffer, size_t length);
-	///	Method to copy the new line.
-	void copyNextLine(char *pBuffer, size_t length);
-	///	Stores the following 3d vector.
-	void getVector3( std::vector<aiVector3D> &point3d_array );
-	///	Stores the following 3d vector.
-	void getVector2(std::vector<aiVector2D> &point2d_array);
-	///	Stores the following face.
-	void getFace(aiPrimitiveType type);
+	///	Moves the data read from a chunk to the model.
+	void mergeChunk(ObjFile::Chunk &chunk, DataArrayIt itBegin);
+	///	Adds a face to the current mesh.
+	void storeFace(const ObjFile::Face &face);
 	void getMaterialDesc();
-	///	Gets a comment.
-	void getComment();
 	/// Gets a a material library.
 	void getMaterialLib();
 	/// Creates a new material.
 	void getNewMaterial();
 	/// Gets the groupname from file.
 	void getGroupName();
-	/// Gets the group number from file.
-	void getGroupNumber();
 	/// Returns the index of the material. Is -1 if not material was found.
 	int getMaterialIndex( const std::string &strMaterialName );
 	/// Parse object name
@@ -112,8 +104,6 @@ private:
 	void createMesh(); 
 	///	Returns true, if a new mesh instance must be created.
 	bool needsNewMesh( const std::string &rMaterialName );
-	///	Error report in token
-	void reportErrorTokenInFace();
 
 private:
 	///	Default material name
@@ -126,10 +116,10 @@ private:
 	ObjFile::Model *m_pModel;
 	//!	Current line (for debugging)
 	unsigned int m_uiLine;
-	//!	Helper buffer
-	char m_buffer[BUFFERSIZE];
 	///	Pointer to IO system instance.
 	IOSystem *m_pIO;
+	///	Number of threads used to read large files
+	unsigned int m_uiNumThreads;
 };
 
 }	// Namespace Assimp
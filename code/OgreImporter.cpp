@@ -50,7 +50,7 @@ using namespace std;
 
 #include "OgreImporter.hpp"
 #include "TinyFormatter.h"
-#include "irrXMLWrapper.h"
+#include "XMLReader.h"
 
 namespace Assimp
 {
@@ -86,10 +86,8 @@ void OgreImporter::InternReadFile(const std::string &pFile, aiScene *pScene, Ass
 		throw DeadlyImportError("Failed to open file "+pFile+".");
 
 	//Read the Mesh File:
-	boost::scoped_ptr<CIrrXML_IOStreamReader> mIOWrapper( new CIrrXML_IOStreamReader( file.get()));
-	XmlReader* MeshFile = irr::io::createIrrXMLReader(mIOWrapper.get());
-	if(!MeshFile)//parse the xml file
-		throw DeadlyImportError("Failed to create XML Reader for "+pFile);
+	boost::scoped_ptr<XmlReader> MeshFileReader(new XmlReader(file.get()));
+	XmlReader* MeshFile = MeshFileReader.get();
 
 
 	DefaultLogger::get()->debug("Mesh File opened");
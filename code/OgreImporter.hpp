@@ -3,7 +3,7 @@
 #include <vector>
 
 #include "OgreXmlHelper.hpp"
-#include "irrXMLWrapper.h"
+#include "XMLReader.h"
 
 /// Ogre Importer TODO
 /*	- Read Vertex Colors
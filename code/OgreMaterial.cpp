@@ -56,7 +56,7 @@ using namespace std;
 //using namespace boost;
 
 #include "OgreImporter.hpp"
-#include "irrXMLWrapper.h"
+#include "XMLReader.h"
 #include "TinyFormatter.h"
 
 namespace Assimp
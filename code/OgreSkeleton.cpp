@@ -72,10 +72,8 @@ void OgreImporter::LoadSkeleton(std::string FileName, vector<Bone> &Bones, vecto
 		throw DeadlyImportError("Failed to open skeleton file "+FileName+".");
 
 	//Read the Mesh File:
-	boost::scoped_ptr<CIrrXML_IOStreamReader> mIOWrapper(new CIrrXML_IOStreamReader(File.get()));
-	XmlReader* SkeletonFile = irr::io::createIrrXMLReader(mIOWrapper.get());
-	if(!SkeletonFile)
-		throw DeadlyImportError(string("Failed to create XML Reader for ")+FileName);
+	boost::scoped_ptr<XmlReader> SkeletonFileReader(new XmlReader(File.get()));
+	XmlReader* SkeletonFile = SkeletonFileReader.get();
 
 	//Quick note: Whoever read this should know this one thing: irrXml fucking sucks!!!
 
@@ -1,5 +1,5 @@
 
-#include "irrXMLWrapper.h"
+#include "XMLReader.h"
 #include "fast_atof.h"
 
 namespace Assimp
@@ -7,7 +7,7 @@ namespace Assimp
 namespace Ogre
 {
 	
-typedef irr::io::IrrXMLReader XmlReader;
+typedef Assimp::XMLReader XmlReader;
 
 
 //------------Helper Funktion to Get a Attribute Save---------------
@@ -71,7 +71,7 @@ inline bool XmlRead(XmlReader* Reader)
 		if(!Reader->read())
 			return false;
 	}
-	while(Reader->getNodeType()!=irr::io::EXN_ELEMENT);
+	while(Reader->getNodeType()!=XML_ELEMENT);
 	return true;
 }
 
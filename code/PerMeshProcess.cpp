@@ -0,0 +1,267 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+
+/** @file PerMeshProcess.cpp
+ *  @brief Implementation of the PerMeshProcess and FusedMeshProcess classes
+ */
+
+#include "AssimpPCH.h"
+#include "PerMeshProcess.h"
+#include "ProcessHelper.h"
+
+using namespace Assimp;
+
+namespace {
+
+	// Cached bounds of the vertex positions of a mesh
+	struct BoundingBox
+	{
+		aiVector3D min, max;
+	};
+
+	// ------------------------------------------------------------------------------------------------
+	// Task to run a single per-mesh step on all meshes of a scene
+	class MeshTask : public ParallelTask
+	{
+	public:
+
+		MeshTask(PerMeshProcess* const* steps, size_t numSteps, aiScene* scene, 
+			SharedPostProcessInfo* shared, ImportProgressHandler* progress)
+			: steps		(steps)
+			, numSteps	(numSteps)
+			, scene		(scene)
+			, shared	(shared)
+			, progress	(progress)
+		{}
+
+		void Run(unsigned int index) {
+			aiMesh* const mesh = scene->mMeshes[index];
+			MeshPipelineContext context(mesh,shared);
+
+			for (size_t i = 0; i < numSteps; ++i) {
+				// we may run on a worker thread, so only the time limit can be checked here
+				if (progress) {
+					progress->CheckDeadline();
+				}
+				steps[i]->ExecuteOnMesh(mesh,index,context);
+			}
+		}
+
+	private:
+		PerMeshProcess* const* steps;
+		size_t numSteps;
+		aiScene* scene;
+		SharedPostProcessInfo* shared;
+		ImportProgressHandler* progress;
+	};
+}
+
+// ------------------------------------------------------------------------------------------------
+MeshPipelineContext::MeshPipelineContext(aiMesh* mesh, SharedPostProcessInfo* shared)
+: mesh			(mesh)
+, cache			(shared ? &shared->GetMeshData() : NULL)
+, localCache	()
+{
+	if (!cache) {
+		cache = localCache = new MeshDataCache();
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+MeshPipelineContext::~MeshPipelineContext()
+{
+	delete localCache;
+}
+
+// ------------------------------------------------------------------------------------------------
+SpatialSort& MeshPipelineContext::GetSpatialSort()
+{
+	SpatialSort* sort = cache->Get<SpatialSort>(mesh);
+	if (!sort) {
+		sort = &cache->Add<SpatialSort>(mesh,MeshDataCache::Positions);
+		sort->Fill(mesh->mVertices,mesh->mNumVertices,sizeof(aiVector3D));
+	}
+	return *sort;
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshPipelineContext::ReleaseSpatialSort()
+{
+	cache->Remove<SpatialSort>(mesh);
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshPipelineContext::GetBoundingBox(aiVector3D& min, aiVector3D& max)
+{
+	BoundingBox* box = cache->Get<BoundingBox>(mesh);
+	if (!box) {
+		box = &cache->Add<BoundingBox>(mesh,MeshDataCache::Positions);
+		ArrayBounds(mesh->mVertices,mesh->mNumVertices,box->min,box->max);
+	}
+	min = box->min;
+	max = box->max;
+}
+
+// ------------------------------------------------------------------------------------------------
+float MeshPipelineContext::GetPositionEpsilon()
+{
+	// same as ComputePositionEpsilon(), but with the cached bounds
+	const float epsilon = 1e-4f;
+
+	aiVector3D minVec, maxVec;
+	GetBoundingBox(minVec,maxVec);
+	return (maxVec - minVec).Length() * epsilon;
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshPipelineContext::Invalidate(unsigned int changes)
+{
+	cache->Invalidate(mesh,changes);
+}
+
+// ------------------------------------------------------------------------------------------------
+PerMeshProcess::PerMeshProcess()
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+PerMeshProcess::~PerMeshProcess()
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+bool PerMeshProcess::MaintainsMeshData() const
+{
+	// all implementations invalidate the data through their MeshPipelineContext
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void PerMeshProcess::BeginMeshes( aiScene* /*pScene*/)
+{
+	// the default implementation does nothing
+}
+
+// ------------------------------------------------------------------------------------------------
+void PerMeshProcess::EndMeshes( aiScene* /*pScene*/)
+{
+	// the default implementation does nothing
+}
+
+// ------------------------------------------------------------------------------------------------
+void PerMeshProcess::Execute( aiScene* pScene)
+{
+	BeginMeshes(pScene);
+
+	PerMeshProcess* self = this;
+	MeshTask task(&self,1,pScene,shared,progress);
+	ParallelFor(task,pScene->mNumMeshes);
+
+	EndMeshes(pScene);
+}
+
+// ------------------------------------------------------------------------------------------------
+FusedMeshProcess::FusedMeshProcess()
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+FusedMeshProcess::~FusedMeshProcess()
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+void FusedMeshProcess::Add(PerMeshProcess* step, const char* stepName)
+{
+	ai_assert(NULL != step);
+	steps.push_back(step);
+
+	if (!name.empty()) {
+		name += '+';
+	}
+	name += stepName;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool FusedMeshProcess::MaintainsMeshData() const
+{
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool FusedMeshProcess::IsActive( unsigned int /*pFlags*/) const
+{
+	// the Importer only adds active steps
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void FusedMeshProcess::SetupProperties(const Importer* pImp)
+{
+	for (std::vector<PerMeshProcess*>::iterator it = steps.begin(); it != steps.end(); ++it) {
+		(*it)->SetupProperties(pImp);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void FusedMeshProcess::Execute( aiScene* pScene)
+{
+	if (steps.empty()) {
+		return;
+	}
+	DefaultLogger::get()->debug("Running fused per-mesh steps: " + name);
+
+	// scene-level preparations of all steps first, see PerMeshProcess
+	for (std::vector<PerMeshProcess*>::iterator it = steps.begin(); it != steps.end(); ++it) {
+		PerMeshProcess* const step = *it;
+		step->progress = progress;
+		step->threads = threads;
+		step->BeginMeshes(pScene);
+	}
+
+	MeshTask task(&steps[0],steps.size(),pScene,shared,progress);
+	ParallelFor(task,pScene->mNumMeshes);
+
+	for (std::vector<PerMeshProcess*>::iterator it = steps.begin(); it != steps.end(); ++it) {
+		(*it)->EndMeshes(pScene);
+	}
+}
@@ -0,0 +1,229 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+
+/** @file PerMeshProcess.h
+ *  @brief Base class for post-processing steps which work on each mesh
+ *    independently, and the fused pipeline running several of them at once
+ */
+#ifndef AI_PERMESHPROCESS_H_INC
+#define AI_PERMESHPROCESS_H_INC
+
+#include <vector>
+#include <string>
+
+#include "BaseProcess.h"
+
+struct aiMesh;
+
+namespace Assimp	{
+
+class SpatialSort;
+class FusedMeshProcess;
+
+// ---------------------------------------------------------------------------
+/** @brief Gives access to the data derived from a single mesh.
+ *
+ *  The data is kept in the #MeshDataCache of the post-processing pipeline,
+ *  so it is computed once and shared by all steps which need it - within a 
+ *  fused pass (see #FusedMeshProcess) and across steps. Steps which change 
+ *  the mesh must call Invalidate() afterwards.
+ */
+class MeshPipelineContext
+{
+public:
+
+	// -------------------------------------------------------------------
+	/** @param mesh Mesh the context belongs to
+	 *  @param shared Shared data of the pipeline, may be NULL. The
+	 *    derived data lives only as long as the context then. */
+	MeshPipelineContext(aiMesh* mesh, SharedPostProcessInfo* shared);
+	~MeshPipelineContext();
+
+public:
+
+	// -------------------------------------------------------------------
+	/** Get a SpatialSort of the current vertex positions of the mesh.
+	 *  It is built on first use. */
+	SpatialSort& GetSpatialSort();
+
+	// -------------------------------------------------------------------
+	/** Free the SpatialSort early, it is rebuilt if needed again */
+	void ReleaseSpatialSort();
+
+	// -------------------------------------------------------------------
+	/** Get the bounding box of the vertex positions of the mesh */
+	void GetBoundingBox(aiVector3D& min, aiVector3D& max);
+
+	// -------------------------------------------------------------------
+	/** Get the epsilon to use for position comparisons, i.e. along with
+	 *  GetSpatialSort(). Same as ComputePositionEpsilon(). */
+	float GetPositionEpsilon();
+
+	// -------------------------------------------------------------------
+	/** Drop all derived data depending on the given parts of the mesh
+	 *  @param changes Bitwise combination of MeshDataCache::Dependency
+	 *    values, i.e. MeshDataCache::Faces if the faces were modified */
+	void Invalidate(unsigned int changes);
+
+private:
+
+	// no copying
+	MeshPipelineContext(const MeshPipelineContext&);
+	MeshPipelineContext& operator = (const MeshPipelineContext&);
+
+	aiMesh* mesh;
+	MeshDataCache* cache;
+
+	// only used if there is no shared data
+	MeshDataCache* localCache;
+};
+
+// ---------------------------------------------------------------------------
+/** @brief Base class for post-processing steps which process each mesh
+ *  independently of the others.
+ *
+ *  Execute() is split into three parts: BeginMeshes() and EndMeshes() run 
+ *  once per scene in the calling thread, ExecuteOnMesh() runs for each 
+ *  mesh in between, possibly concurrently. Consecutive steps of this kind 
+ *  are combined by the Importer into a single #FusedMeshProcess, which 
+ *  applies all of them to one mesh before moving on to the next.
+ *
+ *  As a consequence, ExecuteOnMesh() may only rely on the scene-level
+ *  effects of preceding steps (i.e. scene flags) if these are made by
+ *  BeginMeshes(), and BeginMeshes() may not rely on the results of
+ *  preceding per-mesh steps.
+ */
+class ASSIMP_API_WINONLY PerMeshProcess : public BaseProcess
+{
+	friend class FusedMeshProcess;
+
+public:
+
+	PerMeshProcess();
+	~PerMeshProcess();
+
+public:
+
+	// -------------------------------------------------------------------
+	/** Runs BeginMeshes(), ExecuteOnMesh() for all meshes and EndMeshes().
+	 *  @param pScene The imported data to work at. */
+	void Execute( aiScene* pScene);
+
+	// -------------------------------------------------------------------
+	/** Implementations must invalidate the derived data of the meshes
+	 *  they modify, see MeshPipelineContext::Invalidate() */
+	bool MaintainsMeshData() const;
+
+public:
+
+	// -------------------------------------------------------------------
+	/** Called once before any mesh is processed, i.e. to check the scene
+	 *  flags and to set up storage for per-mesh results. 
+	 *  The default implementation does nothing. */
+	virtual void BeginMeshes( aiScene* pScene);
+
+	// -------------------------------------------------------------------
+	/** Process a single mesh. Must be thread-safe.
+	 *  @param pMesh Mesh to work at
+	 *  @param meshIndex Index of the mesh in the scene
+	 *  @param context Derived data of the mesh, shared with other steps */
+	virtual void ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex, 
+		MeshPipelineContext& context) = 0;
+
+	// -------------------------------------------------------------------
+	/** Called once after all meshes have been processed, i.e. to log
+	 *  statistics and to update the scene flags.
+	 *  The default implementation does nothing. */
+	virtual void EndMeshes( aiScene* pScene);
+};
+
+// ---------------------------------------------------------------------------
+/** @brief Runs a sequence of #PerMeshProcess steps in a single pass over
+ *  the meshes of a scene.
+ *
+ *  The per-mesh work of all steps is done in one ParallelFor(), each mesh
+ *  passes through all steps in their regular order. This saves one trip 
+ *  through memory per step and allows the steps to share acceleration
+ *  structures via #MeshPipelineContext. The results are the same as if
+ *  the steps were executed one after another.
+ *
+ *  Fusing is controlled by #AI_CONFIG_GLOB_FUSE_MESH_STEPS.
+ */
+class FusedMeshProcess : public BaseProcess
+{
+public:
+
+	FusedMeshProcess();
+	~FusedMeshProcess();
+
+public:
+
+	// -------------------------------------------------------------------
+	/** Append a step to the pipeline. The step is not owned. */
+	void Add(PerMeshProcess* step, const char* name);
+
+	// -------------------------------------------------------------------
+	/** Get the number of steps in the pipeline */
+	size_t GetNumSteps() const {
+		return steps.size();
+	}
+
+	// -------------------------------------------------------------------
+	/** Get the names of all steps, separated by '+' */
+	const std::string& GetName() const {
+		return name;
+	}
+
+	bool IsActive( unsigned int pFlags) const;
+	bool MaintainsMeshData() const;
+	void SetupProperties(const Importer* pImp);
+	void Execute( aiScene* pScene);
+
+private:
+
+	std::vector<PerMeshProcess*> steps;
+	std::string name;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_PERMESHPROCESS_H_INC
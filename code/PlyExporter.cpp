@@ -52,12 +52,13 @@ namespace Assimp	{
 // Worker function for exporting a scene to PLY. Prototyped and registered in Exporter.cpp
 void ExportScenePly(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene)
 {
-	// invoke the exporter 
-	PlyExporter exporter(pFile, pScene);
-
-	// we're still here - export successfully completed. Write the file.
 	boost::scoped_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
-	outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+	if(!outfile) {
+		throw DeadlyExportError("could not open output .ply file: " + std::string(pFile));
+	}
+
+	// invoke the exporter, it writes straight to the file
+	PlyExporter exporter(pFile, pScene, outfile.get());
 }
 
 } // end of namespace Assimp
@@ -68,15 +69,12 @@ void ExportScenePly(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene
 #define PLY_EXPORT_HAS_COLORS (PLY_EXPORT_HAS_TEXCOORDS << AI_MAX_NUMBER_OF_TEXTURECOORDS)
 
 // ------------------------------------------------------------------------------------------------
-PlyExporter :: PlyExporter(const char* _filename, const aiScene* pScene)
-: filename(_filename)
+PlyExporter :: PlyExporter(const char* _filename, const aiScene* pScene, IOStream* outfile)
+: mOutput(outfile)
+, filename(_filename)
 , pScene(pScene)
 , endl("\n") 
 {
-	// make sure that all formatting happens using the standard, C locale and not the user's current locale
-	const std::locale& l = std::locale("C");
-	mOutput.imbue(l);
-
 	unsigned int faces = 0u, vertices = 0u, components = 0u;
 	for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
 		const aiMesh& m = *pScene->mMeshes[i];
@@ -165,6 +163,7 @@ PlyExporter :: PlyExporter(const char* _filename, const aiScene* pScene)
 		WriteMeshIndices(pScene->mMeshes[i],ofs);
 		ofs += pScene->mMeshes[i]->mNumVertices;
 	}
+	mOutput.Flush();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -44,7 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_PLYEXPORTER_H_INC
 #define AI_PLYEXPORTER_H_INC
 
-#include <sstream>
+#include "TextWriter.h"
 
 struct aiScene;
 struct aiNode;
@@ -59,12 +59,7 @@ class PlyExporter
 {
 public:
 	/// Constructor for a specific scene to export
-	PlyExporter(const char* filename, const aiScene* pScene);
-
-public:
-
-	/// public stringstreams to write all output into
-	std::ostringstream mOutput;
+	PlyExporter(const char* filename, const aiScene* pScene, IOStream* outfile);
 
 private:
 
@@ -73,6 +68,9 @@ private:
 
 private:
 
+	/// buffered writer to send all output through
+	TextWriter mOutput;
+
 	const std::string filename;
 	const aiScene* const pScene;
 
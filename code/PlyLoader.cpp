@@ -48,9 +48,166 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // internal headers
 #include "PlyLoader.h"
+#include "ByteSwap.h"
 
 using namespace Assimp;
 
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Byte swapping for the data types of a binary PLY file, single bytes are left alone
+template <typename T>
+inline void SwapValue(T* p)		{ ByteSwap::Swap(p); }
+inline void SwapValue(int8_t*)	{}
+inline void SwapValue(uint8_t*)	{}
+
+// ------------------------------------------------------------------------------------------------
+// Convert one property of all instances of a fixed-size element. iStride is the size of
+// an element instance in the file, iOutStride the distance between two output values.
+template <typename T, typename TOut>
+void DecodeProperty(const char* pCur, size_t iStride, unsigned int iNum,
+	TOut* pOut, unsigned int iOutStride, bool p_bBE)
+{
+	// keep the endianess check out of the loops, so they compile to tight code
+	if (p_bBE) {
+		for (unsigned int i = 0; i < iNum; ++i, pCur += iStride, pOut += iOutStride) {
+			T v;
+			::memcpy(&v,pCur,sizeof(T));
+			SwapValue(&v);
+			*pOut = static_cast<TOut>(v);
+		}
+	}
+	else {
+		for (unsigned int i = 0; i < iNum; ++i, pCur += iStride, pOut += iOutStride) {
+			T v;
+			::memcpy(&v,pCur,sizeof(T));
+			*pOut = static_cast<TOut>(v);
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// Select the conversion kernel for a PLY data type
+template <typename TOut>
+void DecodeProperty(PLY::EDataType eType, const char* pCur, size_t iStride, unsigned int iNum,
+	TOut* pOut, unsigned int iOutStride, bool p_bBE)
+{
+	switch (eType)
+	{
+	case PLY::EDT_Char:
+		DecodeProperty<int8_t>(pCur,iStride,iNum,pOut,iOutStride,p_bBE);
+		break;
+	case PLY::EDT_UChar:
+		DecodeProperty<uint8_t>(pCur,iStride,iNum,pOut,iOutStride,p_bBE);
+		break;
+	case PLY::EDT_Short:
+		DecodeProperty<int16_t>(pCur,iStride,iNum,pOut,iOutStride,p_bBE);
+		break;
+	case PLY::EDT_UShort:
+		DecodeProperty<uint16_t>(pCur,iStride,iNum,pOut,iOutStride,p_bBE);
+		break;
+	case PLY::EDT_Int:
+		DecodeProperty<int32_t>(pCur,iStride,iNum,pOut,iOutStride,p_bBE);
+		break;
+	case PLY::EDT_UInt:
+		DecodeProperty<uint32_t>(pCur,iStride,iNum,pOut,iOutStride,p_bBE);
+		break;
+	case PLY::EDT_Float:
+		DecodeProperty<float>(pCur,iStride,iNum,pOut,iOutStride,p_bBE);
+		break;
+	case PLY::EDT_Double:
+		DecodeProperty<double>(pCur,iStride,iNum,pOut,iOutStride,p_bBE);
+		break;
+	default:
+		ai_assert(false);
+	};
+}
+
+// ------------------------------------------------------------------------------------------------
+// Map decoded color values to [0...1], must match PLYImporter::NormalizeColorValue()
+void NormalizeColorChannel(PLY::EDataType eType, float* pOut, unsigned int iNum, 
+	unsigned int iOutStride)
+{
+	float fBias = 0.f, fRange;
+	switch (eType)
+	{
+	case PLY::EDT_UChar:
+		fRange = (float)0xFF;
+		break;
+	case PLY::EDT_Char:
+		fBias = (float)(0xFF/2);
+		fRange = (float)0xFF;
+		break;
+	case PLY::EDT_UShort:
+	case PLY::EDT_UInt:
+		fRange = (float)0xFFFF;
+		break;
+	case PLY::EDT_Short:
+		fBias = (float)(0xFFFF/2);
+		fRange = (float)0xFFFF;
+		break;
+	case PLY::EDT_Int:
+		for (unsigned int i = 0; i < iNum; ++i, pOut += iOutStride) {
+			*pOut = (*pOut / (float)0xFF) + 0.5f;
+		}
+		return;
+	default:
+		// floating-point colors are taken as they are
+		return;
+	};
+	for (unsigned int i = 0; i < iNum; ++i, pOut += iOutStride) {
+		*pOut = (*pOut + fBias) / fRange;
+	}
+}
+
+// vertex components read by the fixed-layout path, in the order of the output
+// components: position (0-2), normal (3-5), color (6-9), texture coordinates (10-11)
+const PLY::ESemantic aeVertexSemantics[] = {
+	PLY::EST_XCoord, PLY::EST_YCoord, PLY::EST_ZCoord,
+	PLY::EST_XNormal, PLY::EST_YNormal, PLY::EST_ZNormal,
+	PLY::EST_Red, PLY::EST_Green, PLY::EST_Blue, PLY::EST_Alpha,
+	PLY::EST_UTextureCoord, PLY::EST_VTextureCoord
+};
+const unsigned int iNumVertexSemantics = sizeof(aeVertexSemantics) / sizeof(aeVertexSemantics[0]);
+
+// ------------------------------------------------------------------------------------------------
+// Convert the vertex element of a fixed-layout binary file. Output arrays for components
+// not contained in the file may be NULL.
+void DecodeVertices(const char* pCur, size_t iStride, unsigned int iNum,
+	const unsigned int* aiOffsets, const PLY::EDataType* aiTypes, bool p_bBE,
+	aiVector3D* pvPositions, aiVector3D* pvNormals, aiColor4D* pvColors, aiVector3D* pvUV)
+{
+	for (unsigned int s = 0; s < iNumVertexSemantics; ++s)
+	{
+		if (0xFFFFFFFF == aiOffsets[s])
+			continue;
+
+		float* pOut;
+		unsigned int iOutStride = 3;
+		if (s < 3)
+			pOut = &pvPositions->x + s;
+		else if (s < 6)
+			pOut = &pvNormals->x + (s-3);
+		else if (s < 10) {
+			pOut = &pvColors->r + (s-6);
+			iOutStride = 4;
+		}
+		else pOut = &pvUV->x + (s-10);
+
+		DecodeProperty(aiTypes[s],pCur + aiOffsets[s],iStride,iNum,pOut,iOutStride,p_bBE);
+		if (iOutStride == 4) 
+			NormalizeColorChannel(aiTypes[s],pOut,iNum,iOutStride);
+	}
+
+	// assume 1.0 for the alpha channel if it is not set
+	if (pvColors && 0xFFFFFFFF == aiOffsets[9]) {
+		for (unsigned int i = 0; i < iNum; ++i)
+			pvColors[i].a = 1.0f;
+	}
+}
+
+} // end anonymous namespace
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 PLYImporter::PLYImporter()
@@ -134,8 +291,19 @@ void PLYImporter::InternReadFile( const std::string& pFile,
 			if ('b' == *szMe || 'B' == *szMe)bIsBE = true;
 #endif // ! AI_BUILD_BIG_ENDIAN
 
-			// skip the line, parse the rest of the header and build the DOM
+			// skip the line and parse the rest of the header
 			SkipLine(szMe,(const char**)&szMe);
+
+			PLY::DOM sHeader;
+			const char* szData;
+			if(!sHeader.ParseHeader(szMe,&szData,true))
+				throw DeadlyImportError( "Invalid .ply file: Unable to build DOM (#2)");
+
+			// if the size of all vertices and faces is fixed, the data can be read
+			// straight into the output scene. Otherwise, build the DOM.
+			if (LoadFixedLayoutBinary(&sHeader,szData,&mBuffer2.back(),bIsBE,pScene))
+				return;
+
 			if(!PLY::DOM::ParseInstanceBinary(szMe,&sPlyDom,bIsBE))
 				throw DeadlyImportError( "Invalid .ply file: Unable to build DOM (#2)");
 		}
@@ -143,8 +311,6 @@ void PLYImporter::InternReadFile( const std::string& pFile,
 	}
 	else
 	{
-		delete[] this->mBuffer;
-		AI_DEBUG_INVALIDATE_PTR(this->mBuffer);
 		throw DeadlyImportError( "Invalid .ply file: Missing format specification");
 	}
 	this->pcDOM = &sPlyDom;
@@ -179,9 +345,9 @@ void PLYImporter::InternReadFile( const std::string& pFile,
 		for (unsigned int i = 0; i< iNum;++i)
 		{
 			PLY::Face sFace;
-			sFace.mIndices.push_back((iNum*3));
-			sFace.mIndices.push_back((iNum*3)+1);
-			sFace.mIndices.push_back((iNum*3)+2);
+			sFace.mIndices[0] = (i*3);
+			sFace.mIndices[1] = (i*3)+1;
+			sFace.mIndices[2] = (i*3)+2;
 			avFaces.push_back(sFace);
 		}
 	}
@@ -233,6 +399,273 @@ void PLYImporter::InternReadFile( const std::string& pFile,
 		pScene->mRootNode->mMeshes[i] = i;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Read vertices and faces of a binary file without building the DOM
+bool PLYImporter::LoadFixedLayoutBinary(const PLY::DOM* pcHeader,
+	const char* pCur, const char* pEnd, bool p_bBE, aiScene* pScene)
+{
+	ai_assert(NULL != pcHeader && NULL != pCur && NULL != pEnd && NULL != pScene);
+
+	// offsets and data types of the vertex components, see aeVertexSemantics
+	unsigned int aiOffsets[iNumVertexSemantics];
+	PLY::EDataType aiTypes[iNumVertexSemantics];
+	for (unsigned int s = 0; s < iNumVertexSemantics; ++s) {
+		aiOffsets[s] = 0xFFFFFFFF;
+		aiTypes[s] = EDT_Float;
+	}
+
+	const PLY::Element* pcVertex = NULL, *pcFace = NULL;
+	const char* szVertexData = NULL, *szFaceData = NULL;
+	size_t iVertexStride = 0, iFaceStride = 0;
+
+	// position of the vertex index list in a face, data types and number of indices
+	size_t iListOffset = 0;
+	PLY::EDataType eCountType = EDT_UChar, eIndexType = EDT_UInt;
+	unsigned int iNumIndices = 0;
+
+	// Walk all elements to find out where their data starts. This works as long
+	// as all elements in front of the vertices and faces have a fixed size.
+	const char* szData = pCur;
+	for (std::vector<PLY::Element>::const_iterator i = pcHeader->alElements.begin();
+		i != pcHeader->alElements.end();++i)
+	{
+		if (PLY::EEST_TriStrip == (*i).eSemantic || PLY::EEST_Material == (*i).eSemantic)
+			return false;
+
+		// size of an instance without its list, position of the list
+		const PLY::Property* pcList = NULL;
+		size_t iSize = 0, iListPos = 0;
+		bool bFixed = true;
+		for (std::vector<PLY::Property>::const_iterator a = (*i).alProperties.begin();
+			a != (*i).alProperties.end();++a)
+		{
+			if (!PLY::Property::GetTypeSize((*a).eType))
+				bFixed = false;
+			else if (!(*a).bIsList)
+				iSize += PLY::Property::GetTypeSize((*a).eType);
+			else if (pcList || !PLY::Property::GetTypeSize((*a).eFirstType))
+				bFixed = false;
+			else {
+				pcList = &(*a);
+				iListPos = iSize;
+			}
+		}
+
+		if (PLY::EEST_Vertex == (*i).eSemantic)
+		{
+			if (pcVertex || pcList || !bFixed || !szData)
+				return false;
+
+			pcVertex = &(*i);
+			szVertexData = szData;
+			iVertexStride = iSize;
+
+			size_t iOffset = 0;
+			for (std::vector<PLY::Property>::const_iterator a = (*i).alProperties.begin();
+				a != (*i).alProperties.end();++a)
+			{
+				for (unsigned int s = 0; s < iNumVertexSemantics; ++s)
+				{
+					if (aeVertexSemantics[s] != (*a).Semantic)
+						continue;
+
+					// the DOM path has its own rules for duplicate components
+					if (0xFFFFFFFF != aiOffsets[s])
+						return false;
+					aiOffsets[s] = (unsigned int)iOffset;
+					aiTypes[s] = (*a).eType;
+				}
+				iOffset += PLY::Property::GetTypeSize((*a).eType);
+			}
+
+			if (pcVertex->NumOccur && iVertexStride > (size_t)(pEnd - szData) / pcVertex->NumOccur)
+				throw DeadlyImportError( "Invalid .ply file: Unexpected end of vertex data");
+			szData += iVertexStride * pcVertex->NumOccur;
+		}
+		else if (PLY::EEST_Face == (*i).eSemantic)
+		{
+			if (pcFace || !pcList || !bFixed || !szData || PLY::EST_VertexIndex != pcList->Semantic)
+				return false;
+			for (std::vector<PLY::Property>::const_iterator a = (*i).alProperties.begin();
+				a != (*i).alProperties.end();++a)
+			{
+				if (PLY::EST_MaterialIndex == (*a).Semantic)
+					return false;
+			}
+
+			pcFace = &(*i);
+			szFaceData = szData;
+			iListOffset = iListPos;
+			eCountType = pcList->eFirstType;
+			eIndexType = pcList->eType;
+
+			const size_t iCountSize = PLY::Property::GetTypeSize(eCountType);
+			if (pcFace->NumOccur)
+			{
+				// take the size of the first face and check whether all others match
+				if (iListOffset + iCountSize > (size_t)(pEnd - szData))
+					throw DeadlyImportError( "Invalid .ply file: Unexpected end of face data");
+				DecodeProperty(eCountType,szData + iListOffset,0,1,&iNumIndices,1,p_bBE);
+				if (!iNumIndices)
+					return false;
+
+				iFaceStride = iSize + iCountSize + iNumIndices * PLY::Property::GetTypeSize(eIndexType);
+				if (iFaceStride > (size_t)(pEnd - szData) / pcFace->NumOccur)
+					return false;
+
+				std::vector<unsigned int> aiCounts(pcFace->NumOccur);
+				DecodeProperty(eCountType,szData + iListOffset,iFaceStride,pcFace->NumOccur,
+					&aiCounts[0],1,p_bBE);
+				for (std::vector<unsigned int>::const_iterator n = aiCounts.begin(); n != aiCounts.end(); ++n) {
+					if (*n != iNumIndices)
+						return false;
+				}
+			}
+			szData += iFaceStride * pcFace->NumOccur;
+		}
+		else if (szData)
+		{
+			// elements we don't need must still be skipped
+			if (pcList || !bFixed || ((*i).NumOccur && iSize > (size_t)(pEnd - szData) / (*i).NumOccur))
+				szData = NULL;
+			else szData += iSize * (*i).NumOccur;
+		}
+	}
+
+	// let the DOM path report files without usable vertices
+	if (!pcVertex || !pcVertex->NumOccur || (0xFFFFFFFF == aiOffsets[0] &&
+		0xFFFFFFFF == aiOffsets[1] && 0xFFFFFFFF == aiOffsets[2]))
+		return false;
+
+	const unsigned int iNumVertices = pcVertex->NumOccur;
+	const unsigned int iNumFaces = pcFace ? pcFace->NumOccur : 0;
+	if (!iNumFaces && iNumVertices < 3)
+		return false;
+
+	// read and validate the vertex indices of all faces
+	std::vector<unsigned int> aiIndices;
+	if (iNumFaces)
+	{
+		if ((uint64_t)iNumFaces * iNumIndices > 0xFFFFFFFF)
+			throw DeadlyImportError( "Invalid .ply file: Too many face indices");
+
+		aiIndices.resize(iNumFaces * iNumIndices);
+		const size_t iIndexSize = PLY::Property::GetTypeSize(eIndexType);
+		const char* szIndices = szFaceData + iListOffset + PLY::Property::GetTypeSize(eCountType);
+		for (unsigned int a = 0; a < iNumIndices;++a)	{
+			DecodeProperty(eIndexType,szIndices + a*iIndexSize,iFaceStride,iNumFaces,
+				&aiIndices[a],iNumIndices,p_bBE);
+		}
+		for (std::vector<unsigned int>::const_iterator a = aiIndices.begin(); a != aiIndices.end(); ++a) {
+			if (*a >= iNumVertices)
+				throw DeadlyImportError( "Invalid .ply file: Vertex index out of range");
+		}
+	}
+	DefaultLogger::get()->debug("PLY: Reading binary data with a fixed layout");
+
+	const bool bNormals = 0xFFFFFFFF != aiOffsets[3] || 0xFFFFFFFF != aiOffsets[4] || 0xFFFFFFFF != aiOffsets[5];
+	const bool bColors  = 0xFFFFFFFF != aiOffsets[6] || 0xFFFFFFFF != aiOffsets[7] || 
+		0xFFFFFFFF != aiOffsets[8] || 0xFFFFFFFF != aiOffsets[9];
+	const bool bUV      = 0xFFFFFFFF != aiOffsets[10] || 0xFFFFFFFF != aiOffsets[11];
+
+	aiMesh* pcMesh = new aiMesh();
+	pcMesh->mMaterialIndex = 0;
+
+	pScene->mNumMeshes = 1;
+	pScene->mMeshes = new aiMesh*[1];
+	pScene->mMeshes[0] = pcMesh;
+
+	if (!iNumFaces)
+	{
+		// if no face list is existing we assume that the vertex list is
+		// containing a list of triangles, so it can be read directly
+		const unsigned int iNum = iNumVertices / 3 * 3;
+		pcMesh->mNumVertices = iNum;
+		pcMesh->mVertices = new aiVector3D[iNum];
+		if (bNormals)
+			pcMesh->mNormals = new aiVector3D[iNum];
+		if (bColors)
+			pcMesh->mColors[0] = new aiColor4D[iNum];
+		if (bUV) {
+			pcMesh->mNumUVComponents[0] = 2;
+			pcMesh->mTextureCoords[0] = new aiVector3D[iNum];
+		}
+		DecodeVertices(szVertexData,iVertexStride,iNum,aiOffsets,aiTypes,p_bBE,
+			pcMesh->mVertices,pcMesh->mNormals,pcMesh->mColors[0],pcMesh->mTextureCoords[0]);
+
+		pcMesh->mNumFaces = iNum / 3;
+		pcMesh->mFaces = new aiFace[pcMesh->mNumFaces];
+		for (unsigned int a = 0; a < pcMesh->mNumFaces;++a)	{
+			aiFace& face = pcMesh->mFaces[a];
+			face.mNumIndices = 3;
+			face.mIndices = new unsigned int[3];
+			face.mIndices[0] = a*3;
+			face.mIndices[1] = a*3+1;
+			face.mIndices[2] = a*3+2;
+		}
+	}
+	else
+	{
+		// decode all vertices, then build an unique set of vertices for each face
+		std::vector<aiVector3D> avPositions(iNumVertices), avNormals, avTexCoords;
+		std::vector<aiColor4D> avColors;
+		if (bNormals)
+			avNormals.resize(iNumVertices);
+		if (bColors)
+			avColors.resize(iNumVertices);
+		if (bUV)
+			avTexCoords.resize(iNumVertices);
+		DecodeVertices(szVertexData,iVertexStride,iNumVertices,aiOffsets,aiTypes,p_bBE,
+			&avPositions[0],bNormals ? &avNormals[0] : NULL,bColors ? &avColors[0] : NULL,
+			bUV ? &avTexCoords[0] : NULL);
+
+		const unsigned int iNum = (unsigned int)aiIndices.size();
+		pcMesh->mNumVertices = iNum;
+		pcMesh->mVertices = new aiVector3D[iNum];
+		for (unsigned int a = 0; a < iNum;++a)
+			pcMesh->mVertices[a] = avPositions[aiIndices[a]];
+
+		if (bNormals) {
+			pcMesh->mNormals = new aiVector3D[iNum];
+			for (unsigned int a = 0; a < iNum;++a)
+				pcMesh->mNormals[a] = avNormals[aiIndices[a]];
+		}
+		if (bColors) {
+			pcMesh->mColors[0] = new aiColor4D[iNum];
+			for (unsigned int a = 0; a < iNum;++a)
+				pcMesh->mColors[0][a] = avColors[aiIndices[a]];
+		}
+		if (bUV) {
+			pcMesh->mNumUVComponents[0] = 2;
+			pcMesh->mTextureCoords[0] = new aiVector3D[iNum];
+			for (unsigned int a = 0; a < iNum;++a)
+				pcMesh->mTextureCoords[0][a] = avTexCoords[aiIndices[a]];
+		}
+
+		pcMesh->mNumFaces = iNumFaces;
+		pcMesh->mFaces = new aiFace[iNumFaces];
+		unsigned int iVertex = 0;
+		for (unsigned int a = 0; a < iNumFaces;++a)	{
+			aiFace& face = pcMesh->mFaces[a];
+			face.mNumIndices = iNumIndices;
+			face.mIndices = new unsigned int[iNumIndices];
+			for (unsigned int q = 0; q < iNumIndices;++q)
+				face.mIndices[q] = iVertex++;
+		}
+	}
+
+	// one default material and a simple node structure
+	pScene->mNumMaterials = 1;
+	pScene->mMaterials = new aiMaterial*[1];
+	pScene->mMaterials[0] = CreateDefaultMaterial();
+
+	pScene->mRootNode = new aiNode();
+	pScene->mRootNode->mNumMeshes = 1;
+	pScene->mRootNode->mMeshes = new unsigned int[1];
+	pScene->mRootNode->mMeshes[0] = 0;
+	return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Split meshes by material IDs
 void PLYImporter::ConvertMeshes(std::vector<PLY::Face>* avFaces,
@@ -342,28 +775,33 @@ void PLYImporter::ReplaceDefaultMaterial(std::vector<PLY::Face>* avFaces,
 	}
 
 	if (bNeedDefaultMat)	{
-		// generate a default material
-		aiMaterial* pcHelper = new aiMaterial();
+		avMaterials->push_back(CreateDefaultMaterial());
+	}
+}
 
-		// fill in a default material
-		int iMode = (int)aiShadingMode_Gouraud;
-		pcHelper->AddProperty<int>(&iMode, 1, AI_MATKEY_SHADING_MODEL);
+// ------------------------------------------------------------------------------------------------
+// Generate the material for faces without material index
+aiMaterial* PLYImporter::CreateDefaultMaterial()
+{
+	aiMaterial* pcHelper = new aiMaterial();
 
-		aiColor3D clr;
-		clr.b = clr.g = clr.r = 0.6f;
-		pcHelper->AddProperty<aiColor3D>(&clr, 1,AI_MATKEY_COLOR_DIFFUSE);
-		pcHelper->AddProperty<aiColor3D>(&clr, 1,AI_MATKEY_COLOR_SPECULAR);
+	// fill in a default material
+	int iMode = (int)aiShadingMode_Gouraud;
+	pcHelper->AddProperty<int>(&iMode, 1, AI_MATKEY_SHADING_MODEL);
 
-		clr.b = clr.g = clr.r = 0.05f;
-		pcHelper->AddProperty<aiColor3D>(&clr, 1,AI_MATKEY_COLOR_AMBIENT);
+	aiColor3D clr;
+	clr.b = clr.g = clr.r = 0.6f;
+	pcHelper->AddProperty<aiColor3D>(&clr, 1,AI_MATKEY_COLOR_DIFFUSE);
+	pcHelper->AddProperty<aiColor3D>(&clr, 1,AI_MATKEY_COLOR_SPECULAR);
 
-		// The face order is absolutely undefined for PLY, so we have to
-		// use two-sided rendering to be sure it's ok.
-		const int two_sided = 1;
-		pcHelper->AddProperty(&two_sided,1,AI_MATKEY_TWOSIDED);
+	clr.b = clr.g = clr.r = 0.05f;
+	pcHelper->AddProperty<aiColor3D>(&clr, 1,AI_MATKEY_COLOR_AMBIENT);
 
-		avMaterials->push_back(pcHelper);
-	}
+	// The face order is absolutely undefined for PLY, so we have to
+	// use two-sided rendering to be sure it's ok.
+	const int two_sided = 1;
+	pcHelper->AddProperty(&two_sided,1,AI_MATKEY_TWOSIDED);
+	return pcHelper;
 }
 
 // ------------------------------------------------------------------------------------------------
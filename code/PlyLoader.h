@@ -120,12 +120,27 @@ protected:
 	void LoadMaterial(std::vector<aiMaterial*>* pvOut);
 
 
+	// -------------------------------------------------------------------
+	/** Read the vertex and face data of a binary file straight into
+	*  the output scene, bypassing the DOM. This works only if the
+	*  size of each face is the same for the whole file. Returns false
+	*  if the layout of the file requires the DOM path.
+	*/
+	bool LoadFixedLayoutBinary(const PLY::DOM* pcHeader,
+		const char* pCur, const char* pEnd, bool p_bBE,
+		aiScene* pScene);
+
 	// -------------------------------------------------------------------
 	/** Validate material indices, replace default material identifiers
 	*/
 	void ReplaceDefaultMaterial(std::vector<PLY::Face>* avFaces,
 		std::vector<aiMaterial*>* avMaterials);
 
+	// -------------------------------------------------------------------
+	/** Generate the material assigned to faces without material
+	*/
+	static aiMaterial* CreateDefaultMaterial();
+
 
 	// -------------------------------------------------------------------
 	/** Convert all meshes into our ourer representation
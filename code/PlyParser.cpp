@@ -100,6 +100,28 @@ PLY::EDataType PLY::Property::ParseDataType(const char* pCur,const char** pCurOu
 	return eOut;
 }
 
+// ------------------------------------------------------------------------------------------------
+unsigned int PLY::Property::GetTypeSize(PLY::EDataType eType)
+{
+	switch (eType)
+	{
+	case EDT_Char:
+	case EDT_UChar:
+		return 1;
+	case EDT_Short:
+	case EDT_UShort:
+		return 2;
+	case EDT_Int:
+	case EDT_UInt:
+	case EDT_Float:
+		return 4;
+	case EDT_Double:
+		return 8;
+	default:
+		return 0;
+	}
+}
+
 // ------------------------------------------------------------------------------------------------
 PLY::ESemantic PLY::Property::ParseSemantic(const char* pCur,const char** pCurOut)
 {
@@ -379,6 +401,7 @@ bool PLY::Element::ParseElement (const char* pCur,
 	{
 		// if the exact semantic can't be determined, just store
 		// the original string identifier
+		while (!IsSpaceOrNewLine(*pCur))++pCur;
 		uintptr_t iDiff = (uintptr_t)pCur - (uintptr_t)szCur;
 		pOut->szName = std::string(szCur,iDiff);
 	}
@@ -427,7 +450,8 @@ bool PLY::DOM::SkipComments (const char* pCur,
 }
 
 // ------------------------------------------------------------------------------------------------
-bool PLY::DOM::ParseHeader (const char* pCur,const char** pCurOut)
+bool PLY::DOM::ParseHeader (const char* pCur,const char** pCurOut,
+	bool p_bBinary)
 {
 	ai_assert(NULL != pCur && NULL != pCurOut);
 	DefaultLogger::get()->debug("PLY::DOM::ParseHeader() begin");
@@ -458,7 +482,14 @@ bool PLY::DOM::ParseHeader (const char* pCur,const char** pCurOut)
 			SkipLine(&pCur);
 		}
 	}
-	SkipSpacesAndLineEnd(pCur,&pCur);
+	if (p_bBinary)
+	{
+		// TokenMatch() consumed one character of the line break, binary
+		// data starts right after it. Anything else could be data, too.
+		if ('\r' == pCur[-1] && '\n' == *pCur)
+			++pCur;
+	}
+	else SkipSpacesAndLineEnd(pCur,&pCur);
 	*pCurOut = pCur;
 
 	DefaultLogger::get()->debug("PLY::DOM::ParseHeader() succeeded");
@@ -527,7 +558,7 @@ bool PLY::DOM::ParseInstanceBinary (const char* pCur,DOM* p_pcOut,bool p_bBE)
 
 	DefaultLogger::get()->debug("PLY::DOM::ParseInstanceBinary() begin");
 
-	if(!p_pcOut->ParseHeader(pCur,&pCur))
+	if(!p_pcOut->ParseHeader(pCur,&pCur,true))
 	{
 		DefaultLogger::get()->debug("PLY::DOM::ParseInstanceBinary() failure");
 		return false;
@@ -634,6 +665,10 @@ bool PLY::ElementInstance::ParseInstance (
 	// allocate enough storage
 	p_pcOut->alProperties.resize(pcElement->alProperties.size());
 
+	// fast path for rows of plain floats, which is what vertices usually look like
+	if (ParseFloatInstance(pCur,pCurOut,pcElement,p_pcOut))
+		return true;
+
 	std::vector<PLY::PropertyInstance>::iterator i = p_pcOut->alProperties.begin();
 	std::vector<PLY::Property>::const_iterator  a = pcElement->alProperties.begin();
 	for (;i != p_pcOut->alProperties.end();++i,++a)
@@ -654,6 +689,40 @@ bool PLY::ElementInstance::ParseInstance (
 	return true;
 }
 
+// ------------------------------------------------------------------------------------------------
+bool PLY::ElementInstance::ParseFloatInstance (
+	const char* pCur,
+	const char** pCurOut,
+	const PLY::Element* pcElement,
+	PLY::ElementInstance* p_pcOut)
+{
+	float afValues[16];
+	const unsigned int iNum = (unsigned int)pcElement->alProperties.size();
+	if (iNum > 16)
+		return false;
+
+	for (std::vector<PLY::Property>::const_iterator a = pcElement->alProperties.begin();
+		a != pcElement->alProperties.end();++a)
+	{
+		if ((*a).bIsList || EDT_Float != (*a).eType)
+			return false;
+	}
+
+	// if the row is incomplete the regular path takes care of it
+	if (iNum != fast_atoreal_span<float>(pCur,afValues,iNum))
+		return false;
+
+	for (unsigned int n = 0; n < iNum;++n)
+	{
+		PLY::PropertyInstance::ValueUnion v;
+		v.fFloat = afValues[n];
+		p_pcOut->alProperties[n].avList.push_back(v);
+	}
+	SkipSpacesAndLineEnd(pCur, &pCur);
+	*pCurOut = pCur;
+	return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 bool PLY::ElementInstance::ParseInstanceBinary (
 	const char* pCur,
@@ -851,7 +920,7 @@ bool PLY::PropertyInstance::ParseValueBinary(
 
 	case EDT_UShort:
 		{
-		int16_t i = *((uint16_t*)pCur);
+		uint16_t i = *((uint16_t*)pCur);
 
 		// Swap endianess
 		if (p_bBE)ByteSwap::Swap(&i);
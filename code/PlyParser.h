@@ -243,6 +243,11 @@ public:
 	// -------------------------------------------------------------------
 	//! Parse a semantic from a string
 	static ESemantic ParseSemantic(const char* pCur,const char** pCurOut);
+
+	// -------------------------------------------------------------------
+	//! Get the size of a data type in a binary file, in bytes.
+	//! Returns 0 for EDT_INVALID.
+	static unsigned int GetTypeSize(EDataType eType);
 };
 
 // ---------------------------------------------------------------------------------
@@ -373,6 +378,12 @@ public:
 	static bool ParseInstance (const char* pCur,const char** pCurOut,
 		const Element* pcElement, ElementInstance* p_pcOut);
 
+	// -------------------------------------------------------------------
+	//! Parse an element instance consisting of float properties only.
+	//! Returns false if the element doesn't look like this.
+	static bool ParseFloatInstance (const char* pCur,const char** pCurOut,
+		const Element* pcElement, ElementInstance* p_pcOut);
+
 	// -------------------------------------------------------------------
 	//! Parse a binary element instance
 	static bool ParseInstanceBinary (const char* pCur,const char** pCurOut,
@@ -430,11 +441,14 @@ public:
 	//! Skip all comment lines after this
 	static bool SkipComments (const char* pCur,const char** pCurOut);
 
-private:
-
 	// -------------------------------------------------------------------
-	//! Handle the file header and read all element descriptions
-	bool ParseHeader (const char* pCur,const char** pCurOut);
+	//! Handle the file header and read all element descriptions.
+	//! For binary files pCurOut receives the first byte of the data,
+	//! which directly follows the line break after 'end_header'.
+	bool ParseHeader (const char* pCur,const char** pCurOut,
+		bool p_bBinary = false);
+
+private:
 
 	// -------------------------------------------------------------------
 	//! Read in all element instance lists
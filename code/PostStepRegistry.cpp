@@ -121,64 +121,89 @@ corresponding preprocessor flag to selectively disable steps.
 #	include "DeboneProcess.h"
 #endif
 
+#include "Importer.h"
+
 namespace Assimp {
 
+namespace {
+	// ------------------------------------------------------------------------------------------------
+	// Factory function for a post processing step
+	template <typename T>
+	BaseProcess* CreateStep() {
+		return new T();
+	}
+}
+
 // ------------------------------------------------------------------------------------------------
-void GetPostProcessingStepInstanceList(std::vector< BaseProcess* >& out)
-{
-	// ----------------------------------------------------------------------------
-	// Add an instance of each post processing step here in the order 
-	// of sequence it is executed. Steps that are added here are not
-	// validated - as RegisterPPStep() does - all dependencies must be given.
-	// ----------------------------------------------------------------------------
-	out.reserve(25);
+// Add a factory for each post processing step here in the order 
+// of sequence it is executed, together with its name and the 
+// aiPostProcessSteps flags that activate it. Steps that are added here are not
+// validated - as RegisterPPStep() does - all dependencies must be given.
+// ------------------------------------------------------------------------------------------------
+const PostStepFactory gPostStepFactories[] = {
 #if (!defined ASSIMP_BUILD_NO_REMOVEVC_PROCESS)
-	out.push_back( new RemoveVCProcess());
+	{ &CreateStep< RemoveVCProcess >, "RemoveVCProcess",
+		aiProcess_RemoveComponent },
 #endif
 #if (!defined ASSIMP_BUILD_NO_REMOVE_REDUNDANTMATERIALS_PROCESS)
-	out.push_back( new RemoveRedundantMatsProcess());
+	{ &CreateStep< RemoveRedundantMatsProcess >, "RemoveRedundantMatsProcess",
+		aiProcess_RemoveRedundantMaterials },
 #endif
 #if (!defined ASSIMP_BUILD_NO_FINDINSTANCES_PROCESS)
-	out.push_back( new FindInstancesProcess());
+	{ &CreateStep< FindInstancesProcess >, "FindInstancesProcess",
+		aiProcess_FindInstances },
 #endif
 #if (!defined ASSIMP_BUILD_NO_OPTIMIZEGRAPH_PROCESS)
-	out.push_back( new OptimizeGraphProcess());
+	{ &CreateStep< OptimizeGraphProcess >, "OptimizeGraphProcess",
+		aiProcess_OptimizeGraph },
 #endif
 #if (!defined ASSIMP_BUILD_NO_OPTIMIZEMESHES_PROCESS)
-	out.push_back( new OptimizeMeshesProcess());
+	{ &CreateStep< OptimizeMeshesProcess >, "OptimizeMeshesProcess",
+		aiProcess_OptimizeMeshes },
 #endif
 #if (!defined ASSIMP_BUILD_NO_FINDDEGENERATES_PROCESS)
-	out.push_back( new FindDegeneratesProcess());
+	{ &CreateStep< FindDegeneratesProcess >, "FindDegeneratesProcess",
+		aiProcess_FindDegenerates },
 #endif
 #ifndef ASSIMP_BUILD_NO_GENUVCOORDS_PROCESS
-	out.push_back( new ComputeUVMappingProcess());
+	{ &CreateStep< ComputeUVMappingProcess >, "ComputeUVMappingProcess",
+		aiProcess_GenUVCoords },
 #endif
 #ifndef ASSIMP_BUILD_NO_TRANSFORMTEXCOORDS_PROCESS
-	out.push_back( new TextureTransformStep());
+	{ &CreateStep< TextureTransformStep >, "TextureTransformStep",
+		aiProcess_TransformUVCoords },
 #endif
 #if (!defined ASSIMP_BUILD_NO_PRETRANSFORMVERTICES_PROCESS)
-	out.push_back( new PretransformVertices());
+	{ &CreateStep< PretransformVertices >, "PretransformVertices",
+		aiProcess_PreTransformVertices },
 #endif
 #if (!defined ASSIMP_BUILD_NO_TRIANGULATE_PROCESS)
-	out.push_back( new TriangulateProcess());
+	{ &CreateStep< TriangulateProcess >, "TriangulateProcess",
+		aiProcess_Triangulate },
 #endif
 #if (!defined ASSIMP_BUILD_NO_SORTBYPTYPE_PROCESS)
-	out.push_back( new SortByPTypeProcess());
+	{ &CreateStep< SortByPTypeProcess >, "SortByPTypeProcess",
+		aiProcess_SortByPType },
 #endif
 #if (!defined ASSIMP_BUILD_NO_FINDINVALIDDATA_PROCESS)
-	out.push_back( new FindInvalidDataProcess());
+	{ &CreateStep< FindInvalidDataProcess >, "FindInvalidDataProcess",
+		aiProcess_FindInvalidData },
 #endif
 #if (!defined ASSIMP_BUILD_NO_FIXINFACINGNORMALS_PROCESS)
-	out.push_back( new FixInfacingNormalsProcess());
+	{ &CreateStep< FixInfacingNormalsProcess >, "FixInfacingNormalsProcess",
+		aiProcess_FixInfacingNormals },
 #endif
 #if (!defined ASSIMP_BUILD_NO_SPLITBYBONECOUNT_PROCESS)
-	out.push_back( new SplitByBoneCountProcess());
+	{ &CreateStep< SplitByBoneCountProcess >, "SplitByBoneCountProcess",
+		aiProcess_SplitByBoneCount },
 #endif
 #if (!defined ASSIMP_BUILD_NO_SPLITLARGEMESHES_PROCESS)
-	out.push_back( new SplitLargeMeshesProcess_Triangle());
+	{ &CreateStep< SplitLargeMeshesProcess_Triangle >, "SplitLargeMeshesProcess_Triangle",
+		aiProcess_SplitLargeMeshes },
 #endif
 #if (!defined ASSIMP_BUILD_NO_GENFACENORMALS_PROCESS)
-	out.push_back( new GenFaceNormalsProcess());
+	{ &CreateStep< GenFaceNormalsProcess >, "GenFaceNormalsProcess",
+		aiProcess_GenNormals },
 #endif
 
 	// .........................................................................
@@ -186,44 +211,67 @@ void GetPostProcessingStepInstanceList(std::vector< BaseProcess* >& out)
 	// XXX this is actually a design weakness that dates back to the time
 	// when Importer would maintain the postprocessing step list exclusively.
 	// Now that others access it too, we need a better solution.
-	out.push_back( new ComputeSpatialSortProcess());
+	{ &CreateStep< ComputeSpatialSortProcess >, "ComputeSpatialSortProcess",
+		aiProcess_CalcTangentSpace | aiProcess_GenNormals | aiProcess_JoinIdenticalVertices },
 	// .........................................................................
 
 #if (!defined ASSIMP_BUILD_NO_GENVERTEXNORMALS_PROCESS)
-	out.push_back( new GenVertexNormalsProcess());
+	{ &CreateStep< GenVertexNormalsProcess >, "GenVertexNormalsProcess",
+		aiProcess_GenSmoothNormals },
 #endif
 #if (!defined ASSIMP_BUILD_NO_CALCTANGENTS_PROCESS)
-	out.push_back( new CalcTangentsProcess());
+	{ &CreateStep< CalcTangentsProcess >, "CalcTangentsProcess",
+		aiProcess_CalcTangentSpace },
 #endif
 #if (!defined ASSIMP_BUILD_NO_JOINVERTICES_PROCESS)
-	out.push_back( new JoinVerticesProcess());
+	{ &CreateStep< JoinVerticesProcess >, "JoinVerticesProcess",
+		aiProcess_JoinIdenticalVertices },
 #endif
 
 	// .........................................................................
-	out.push_back( new DestroySpatialSortProcess());
+	{ &CreateStep< DestroySpatialSortProcess >, "DestroySpatialSortProcess",
+		aiProcess_CalcTangentSpace | aiProcess_GenNormals | aiProcess_JoinIdenticalVertices },
 	// .........................................................................
 
 #if (!defined ASSIMP_BUILD_NO_SPLITLARGEMESHES_PROCESS)
-	out.push_back( new SplitLargeMeshesProcess_Vertex());
+	{ &CreateStep< SplitLargeMeshesProcess_Vertex >, "SplitLargeMeshesProcess_Vertex",
+		aiProcess_SplitLargeMeshes },
 #endif
 #if (!defined ASSIMP_BUILD_NO_MAKELEFTHANDED_PROCESS)
-	out.push_back( new MakeLeftHandedProcess());
+	{ &CreateStep< MakeLeftHandedProcess >, "MakeLeftHandedProcess",
+		aiProcess_MakeLeftHanded },
 #endif
 #if (!defined ASSIMP_BUILD_NO_FLIPUVS_PROCESS)
-	out.push_back( new FlipUVsProcess());
+	{ &CreateStep< FlipUVsProcess >, "FlipUVsProcess",
+		aiProcess_FlipUVs },
 #endif
 #if (!defined ASSIMP_BUILD_NO_FLIPWINDINGORDER_PROCESS)
-	out.push_back( new FlipWindingOrderProcess());
+	{ &CreateStep< FlipWindingOrderProcess >, "FlipWindingOrderProcess",
+		aiProcess_FlipWindingOrder },
 #endif
 #if (!defined ASSIMP_BUILD_DEBONE_PROCESS)
-	out.push_back( new DeboneProcess());
+	{ &CreateStep< DeboneProcess >, "DeboneProcess",
+		aiProcess_Debone },
 #endif
 #if (!defined ASSIMP_BUILD_NO_LIMITBONEWEIGHTS_PROCESS)
-	out.push_back( new LimitBoneWeightsProcess());
+	{ &CreateStep< LimitBoneWeightsProcess >, "LimitBoneWeightsProcess",
+		aiProcess_LimitBoneWeights },
 #endif
 #if (!defined ASSIMP_BUILD_NO_IMPROVECACHELOCALITY_PROCESS)
-	out.push_back( new ImproveCacheLocalityProcess());
+	{ &CreateStep< ImproveCacheLocalityProcess >, "ImproveCacheLocalityProcess",
+		aiProcess_ImproveCacheLocality },
 #endif
+};
+
+const unsigned int gNumPostStepFactories = sizeof(gPostStepFactories)/sizeof(gPostStepFactories[0]);
+
+// ------------------------------------------------------------------------------------------------
+void GetPostProcessingStepInstanceList(std::vector< BaseProcess* >& out)
+{
+	out.reserve(gNumPostStepFactories);
+	for (unsigned int i = 0; i < gNumPostStepFactories; ++i) {
+		out.push_back( gPostStepFactories[i].mCreate() );
+	}
 }
 
 }
@@ -45,7 +45,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "SpatialSort.h"
 #include "BaseProcess.h"
+#include "PerMeshProcess.h"
 #include "ParsingUtils.h"
+#include "ThreadPool.h"
 
 // -------------------------------------------------------------------------------
 // Some extensions to std namespace. Mainly std::min and std::max for all
@@ -316,9 +318,10 @@ const char* MappingTypeToString(aiTextureMapping in);
 aiMesh* MakeSubmesh(const aiMesh *superMesh, const std::vector<unsigned int> &subMeshFaces, unsigned int subFlags);
 
 // -------------------------------------------------------------------------------
-// Utility postprocess step to share the spatial sort tree between
-// all steps which use it to speedup its computations.
-class ComputeSpatialSortProcess : public BaseProcess
+// Utility postprocess step to build the spatial sort trees for all steps
+// which use them to speedup their computations. The trees are kept in
+// the MeshDataCache, see MeshPipelineContext::GetSpatialSort().
+class ComputeSpatialSortProcess : public PerMeshProcess
 {
 	bool IsActive( unsigned int pFlags) const
 	{
@@ -326,28 +329,20 @@ class ComputeSpatialSortProcess : public BaseProcess
 			aiProcess_GenNormals | aiProcess_JoinIdenticalVertices));
 	}
 
-	void Execute( aiScene* pScene)
+	void BeginMeshes( aiScene* /*pScene*/)
 	{
-		typedef std::pair<SpatialSort, float> _Type; 
 		DefaultLogger::get()->debug("Generate spatially-sorted vertex cache");
+	}
 
-		std::vector<_Type>* p = new std::vector<_Type>(pScene->mNumMeshes); 
-		std::vector<_Type>::iterator it = p->begin();
-
-		for (unsigned int i = 0; i < pScene->mNumMeshes; ++i, ++it)	{
-			aiMesh* mesh = pScene->mMeshes[i];
-			_Type& blubb = *it;
-			blubb.first.Fill(mesh->mVertices,mesh->mNumVertices,sizeof(aiVector3D));
-			blubb.second = ComputePositionEpsilon(mesh);
-		}
-
-		shared->AddProperty(AI_SPP_SPATIAL_SORT,p);
+	void ExecuteOnMesh( aiMesh* /*pMesh*/, unsigned int /*meshIndex*/, MeshPipelineContext& context)
+	{
+		context.GetSpatialSort();
 	}
 };
 
 // -------------------------------------------------------------------------------
 // ... and the same again to cleanup the whole stuff
-class DestroySpatialSortProcess : public BaseProcess
+class DestroySpatialSortProcess : public PerMeshProcess
 {
 	bool IsActive( unsigned int pFlags) const
 	{
@@ -355,9 +350,9 @@ class DestroySpatialSortProcess : public BaseProcess
 			aiProcess_GenNormals | aiProcess_JoinIdenticalVertices));
 	}
 
-	void Execute( aiScene* /*pScene*/)
+	void ExecuteOnMesh( aiMesh* /*pMesh*/, unsigned int /*meshIndex*/, MeshPipelineContext& context)
 	{
-		shared->RemoveProperty(AI_SPP_SPATIAL_SORT);
+		context.ReleaseSpatialSort();
 	}
 };
 
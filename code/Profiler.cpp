@@ -0,0 +1,262 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  Profiler.cpp
+ *  @brief Implementation of the Profiler helper class
+ */
+
+#include "AssimpPCH.h"
+#include "Profiler.h"
+
+#ifdef _WIN32
+#	include <windows.h>
+#else
+#	include <sys/time.h>
+#endif
+
+using namespace Assimp;
+using namespace Assimp::Profiling;
+
+// ------------------------------------------------------------------------------------------------
+// Get a wall-clock time stamp, in seconds
+double Profiling::GetWallTime()
+{
+#ifdef _WIN32
+	LARGE_INTEGER freq, now;
+	::QueryPerformanceFrequency(&freq);
+	::QueryPerformanceCounter(&now);
+	return static_cast<double>(now.QuadPart) / freq.QuadPart;
+#else
+	timeval tv;
+	::gettimeofday(&tv,NULL);
+	return tv.tv_sec + tv.tv_usec * 1e-6;
+#endif
+}
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Get the processor time used by the process, in seconds
+double GetCpuTime()
+{
+	return static_cast<double>(::clock()) / CLOCKS_PER_SEC;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Count the vertices and faces in all meshes of a scene
+void CountVerticesAndFaces(const aiScene* scene, unsigned int& numVertices, unsigned int& numFaces)
+{
+	numVertices = numFaces = 0;
+	if (!scene) {
+		return;
+	}
+	for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+		numVertices += scene->mMeshes[i]->mNumVertices;
+		numFaces += scene->mMeshes[i]->mNumFaces;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// Append a string to a JSON document, including quotes
+void WriteJSONString(std::ostringstream& out, const char* s)
+{
+	out << '\"';
+	for (; *s; ++s) {
+		const unsigned char c = static_cast<unsigned char>(*s);
+		if (c == '\"' || c == '\\') {
+			out << '\\' << *s;
+		}
+		else if (c < 0x20) {
+			static const char hex[] = "0123456789abcdef";
+			out << "\\u00" << hex[c >> 4] << hex[c & 0xf];
+		}
+		else out << *s;
+	}
+	out << '\"';
+}
+
+// ------------------------------------------------------------------------------------------------
+// Append a region and all of its children to a JSON document
+void WriteJSONRegion(std::ostringstream& out, const aiProfilingRegion* region, unsigned int depth)
+{
+	const std::string indent(depth*2,' ');
+	out << indent << "{\n";
+	out << indent << "  \"name\": ";
+	WriteJSONString(out,region->mName.C_Str());
+	out << ",\n";
+	out << indent << "  \"wall_time\": "       << region->mWallTime          << ",\n";
+	out << indent << "  \"cpu_time\": "        << region->mCpuTime           << ",\n";
+	out << indent << "  \"vertices_before\": " << region->mNumVerticesBefore << ",\n";
+	out << indent << "  \"vertices_after\": "  << region->mNumVerticesAfter  << ",\n";
+	out << indent << "  \"faces_before\": "    << region->mNumFacesBefore    << ",\n";
+	out << indent << "  \"faces_after\": "     << region->mNumFacesAfter     << ",\n";
+	out << indent << "  \"peak_memory\": "     << region->mPeakMemory        << ",\n";
+	out << indent << "  \"allocated_memory\": "<< region->mAllocatedMemory   << ",\n";
+	out << indent << "  \"allocations\": "     << region->mNumAllocations    << ",\n";
+	out << indent << "  \"children\": [";
+
+	for (unsigned int i = 0; i < region->mNumChildren; ++i) {
+		out << (i ? ",\n" : "\n");
+		WriteJSONRegion(out,region->mChildren[i],depth+2);
+	}
+	if (region->mNumChildren) {
+		out << "\n" << indent << "  ";
+	}
+	out << "]\n";
+	out << indent << "}";
+}
+
+}
+
+// ------------------------------------------------------------------------------------------------
+Profiler::Profiler(MemoryTracker* tracker /*= NULL*/)
+	: root()
+	, tracker(tracker)
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+Profiler::~Profiler()
+{
+	// regions which were never ended are not yet linked to their parents
+	for (std::vector<OpenRegion>::iterator it = stack.begin(); it != stack.end(); ++it) {
+		for (std::vector<aiProfilingRegion*>::iterator child = (*it).children.begin(); child != (*it).children.end(); ++child) {
+			delete *child;
+		}
+		delete (*it).region;
+	}
+	delete root;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Profiler::BeginRegion(const std::string& region, const aiScene* scene /*= NULL*/)
+{
+	// a new outermost region replaces the previous report
+	if (stack.empty()) {
+		delete root;
+		root = NULL;
+		json.clear();
+	}
+
+	stack.push_back(OpenRegion());
+	OpenRegion& open = stack.back();
+
+	open.region = new aiProfilingRegion();
+	open.region->mName.Set(region);
+	CountVerticesAndFaces(scene,open.region->mNumVerticesBefore,open.region->mNumFacesBefore);
+
+	DefaultLogger::get()->debug((format("START `"),region,"`"));
+
+	// measure the peak of this region separately, the outer region gets it back in EndRegion()
+	if (tracker) {
+		open.memStart  = tracker->GetCounters();
+		open.outerPeak = tracker->RestartPeak();
+	}
+
+	// take the time stamps last so we don't measure ourselves
+	open.cpuStart  = GetCpuTime();
+	open.wallStart = GetWallTime();
+}
+
+// ------------------------------------------------------------------------------------------------
+void Profiler::EndRegion(const std::string& region, const aiScene* scene /*= NULL*/)
+{
+	const double wallEnd = GetWallTime();
+	const double cpuEnd  = GetCpuTime();
+
+	bool found = false;
+	for (std::vector<OpenRegion>::const_iterator it = stack.begin(); it != stack.end(); ++it) {
+		found = found || region == (*it).region->mName.C_Str();
+	}
+	if (!found) {
+		return;
+	}
+
+	// regions nested into this one are still open if an exception skipped their end
+	while (region != stack.back().region->mName.C_Str()) {
+		EndRegion(std::string(stack.back().region->mName.C_Str()),scene);
+	}
+
+	OpenRegion& open = stack.back();
+	aiProfilingRegion* const r = open.region;
+
+	r->mWallTime = wallEnd - open.wallStart;
+	r->mCpuTime  = cpuEnd - open.cpuStart;
+	CountVerticesAndFaces(scene,r->mNumVerticesAfter,r->mNumFacesAfter);
+
+	if (tracker) {
+		const MemoryTracker::Counters mem = tracker->GetCounters();
+		r->mPeakMemory      = mem.peak;
+		r->mAllocatedMemory = mem.allocated - open.memStart.allocated;
+		r->mNumAllocations  = mem.allocations - open.memStart.allocations;
+		tracker->MergePeak(open.outerPeak);
+	}
+
+	if (!open.children.empty()) {
+		r->mNumChildren = static_cast<unsigned int>(open.children.size());
+		r->mChildren = new aiProfilingRegion*[r->mNumChildren];
+		std::copy(open.children.begin(),open.children.end(),r->mChildren);
+	}
+	stack.pop_back();
+
+	if (tracker) {
+		DefaultLogger::get()->debug((format("END   `"),region,"`, dt= ",r->mWallTime," s, cpu= ",r->mCpuTime,
+			" s, peak= ",r->mPeakMemory," B, allocated= ",r->mAllocatedMemory," B in ",r->mNumAllocations," allocations"));
+	}
+	else DefaultLogger::get()->debug((format("END   `"),region,"`, dt= ",r->mWallTime," s, cpu= ",r->mCpuTime," s"));
+
+	if (stack.empty()) {
+		root = r;
+	}
+	else stack.back().children.push_back(r);
+}
+
+// ------------------------------------------------------------------------------------------------
+const std::string& Profiler::GetReportAsJSON() const
+{
+	if (json.empty() && root) {
+		std::ostringstream out;
+		out.imbue(std::locale("C"));
+		WriteJSONRegion(out,root,0);
+		out << "\n";
+		json = out.str();
+	}
+	return json;
+}
@@ -44,54 +44,111 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef INCLUDED_PROFILER_H
 #define INCLUDED_PROFILER_H
 
-#include "boost/timer.hpp"
-
 #include "../include/assimp/DefaultLogger.hpp"
 #include "TinyFormatter.h"
+#include "MemoryTracker.h"
 
 namespace Assimp {
 	namespace Profiling {
 
 		using namespace Formatter;
 
+// ------------------------------------------------------------------------------------------------
+/** Get a wall-clock time stamp, in seconds from an unspecified point in time */
+double GetWallTime();
 
 // ------------------------------------------------------------------------------------------------
-/** Simple wrapper around boost::timer to simplify reporting. Timings are automatically
- *  dumped to the log file.
+/** Records a tree of named regions with their wall-clock and CPU times and the 
+ *  size of the scene before and after each of them. Begin and end of each 
+ *  region are also written to the log. The finished tree can be retrieved
+ *  as aiProfilingRegion hierarchy and as JSON.
  */
 class Profiler
 {
 
 public:
 
-	Profiler() {}
+	/** Keeps a region open for the lifetime of the object, so it is ended
+	 *  on every path out of the enclosing scope, including exceptions.
+	 *  The scene counts are taken from whatever the given pointer refers 
+	 *  to at the begin and end of the region. */
+	class ScopedRegion 
+	{
+	public:
+		ScopedRegion(Profiler* profiler, const std::string& region, aiScene* const& scene)
+			: profiler(profiler)
+			, region(region)
+			, scene(scene)
+		{
+			if (profiler) {
+				profiler->BeginRegion(region,scene);
+			}
+		}
+
+		~ScopedRegion() {
+			if (profiler) {
+				profiler->EndRegion(region,scene);
+			}
+		}
+
+	private:
+		Profiler* profiler;
+		std::string region;
+		aiScene* const& scene;
+	};
+
+public:
+
+	/** @param tracker Tracker to take heap usage from, NULL to skip it */
+	explicit Profiler(MemoryTracker* tracker = NULL);
+	~Profiler();
 
 public:
 	
-	/** Start a named timer */
-	void BeginRegion(const std::string& region) {
-		regions[region] = boost::timer();
-		DefaultLogger::get()->debug((format("START `"),region,"`"));
-	}
-	
+	/** Start a named region, nested into the region which is currently open.
+	 *  @param scene Scene to take the vertex and face counts from, may be NULL */
+	void BeginRegion(const std::string& region, const aiScene* scene = NULL);
 	
-	/** End a specific named timer and write its end time to the log */
-	void EndRegion(const std::string& region) {
-		RegionMap::const_iterator it = regions.find(region);
-		if (it == regions.end()) {
-			return;
-		}
+	/** End the region which is currently open and write its duration to the log.
+	 *  Regions nested into it which are still open are ended as well. Ignored
+	 *  if there is no open region of this name. */
+	void EndRegion(const std::string& region, const aiScene* scene = NULL);
+
+	/** Check whether there is a region which has not yet been ended */
+	bool IsRegionOpen() const {
+		return !stack.empty();
+	}
 
-		DefaultLogger::get()->debug((format("END   `"),region,"`, dt= ",(*it).second.elapsed()," s"));
+	/** Get the outermost region, NULL until it has been ended */
+	const aiProfilingRegion* GetReport() const {
+		return root;
 	}
 
+	/** Get the report as JSON, an empty string until it is finished */
+	const std::string& GetReportAsJSON() const;
+
 private:
 
-	typedef std::map<std::string,boost::timer> RegionMap;
-	RegionMap regions;
+	struct OpenRegion 
+	{
+		aiProfilingRegion* region;
+		double wallStart, cpuStart;
+		std::vector<aiProfilingRegion*> children;
+
+		// memory counters at the start and peak of the parent region so far
+		MemoryTracker::Counters memStart;
+		size_t outerPeak;
+	};
+
+	std::vector<OpenRegion> stack;
+	aiProfilingRegion* root;
+	MemoryTracker* tracker;
+
+	// generated on demand
+	mutable std::string json;
 };
 
 	}
 }
 
-#endif
+#endif // INCLUDED_PROFILER_H
@@ -43,7 +43,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //#include <windows.h> 
 #include "DefaultIOSystem.h"
 #include "Q3BSPFileImporter.h"
-#include "Q3BSPZipArchive.h"
+#include "ZipArchiveIOSystem.h"
+#include "ThreadPool.h"
 #include "Q3BSPFileParser.h"
 #include "Q3BSPFileData.h"
 
@@ -127,7 +128,8 @@ Q3BSPFileImporter::Q3BSPFileImporter() :
 	m_pCurrentMesh( NULL ),
 	m_pCurrentFace( NULL ),
 	m_MaterialLookupMap(),
-	mTextures()
+	mTextures(),
+	m_NumThreads( 1 )
 {
 	// empty
 }
@@ -174,12 +176,20 @@ void Q3BSPFileImporter::GetExtensionList( std::set<std::string>& extensions )
 	extensions.insert( Q3BSPExtension  );
 }
 
+// ------------------------------------------------------------------------------------------------
+//	Setup configuration properties for the loader.
+void Q3BSPFileImporter::SetupProperties( const Importer* pImp )
+{
+	// Textures are decompressed on as many threads as post-processing uses
+	m_NumThreads = ThreadPool::GetThreadCountForConfig( pImp->GetPropertyInteger( AI_CONFIG_GLOB_MULTITHREADING, AI_MULTITHREADING_DEFAULT ) );
+}
+
 // ------------------------------------------------------------------------------------------------
 //	Import method.
-void Q3BSPFileImporter::InternReadFile(const std::string &rFile, aiScene* pScene, IOSystem* /*pIOHandler*/)
+void Q3BSPFileImporter::InternReadFile(const std::string &rFile, aiScene* pScene, IOSystem* pIOHandler)
 {
-	Q3BSPZipArchive Archive( rFile );
-	if ( !Archive.isOpen() )
+	ZipArchiveIOSystem Archive( pIOHandler, rFile, m_NumThreads );
+	if ( !Archive.IsOpen() )
 	{
 		throw DeadlyImportError( "Failed to open file " + rFile + "." );
 	}
@@ -226,11 +236,11 @@ void Q3BSPFileImporter::separateMapName( const std::string &rImportName, std::st
 
 // ------------------------------------------------------------------------------------------------
 //	Returns the first map in the map archive.
-bool Q3BSPFileImporter::findFirstMapInArchive( Q3BSPZipArchive &rArchive, std::string &rMapName )
+bool Q3BSPFileImporter::findFirstMapInArchive( ZipArchiveIOSystem &rArchive, std::string &rMapName )
 {
 	rMapName = "";
 	std::vector<std::string> fileList;
-	rArchive.getFileList( fileList );
+	rArchive.GetFileList( fileList );
 	if ( fileList.empty() )  
 		return false;
 
@@ -255,7 +265,7 @@ bool Q3BSPFileImporter::findFirstMapInArchive( Q3BSPZipArchive &rArchive, std::s
 // ------------------------------------------------------------------------------------------------
 //	Creates the assimp specific data.
 void Q3BSPFileImporter::CreateDataFromImport( const Q3BSP::Q3BSPModel *pModel, aiScene* pScene, 
-											 Q3BSPZipArchive *pArchive )
+											 ZipArchiveIOSystem *pArchive )
 {
 	if ( NULL == pModel || NULL == pScene )
 		return;
@@ -461,13 +471,27 @@ void Q3BSPFileImporter::createTriangleTopology( const Q3BSP::Q3BSPModel *pModel,
 // ------------------------------------------------------------------------------------------------
 //	Creates all referenced materials.
 void Q3BSPFileImporter::createMaterials( const Q3BSP::Q3BSPModel *pModel, aiScene* pScene,
-										Q3BSPZipArchive *pArchive )
+										ZipArchiveIOSystem *pArchive )
 {
 	if ( m_MaterialLookupMap.empty() )
 	{
 		return;
 	}
 
+	// Decompress all textures stored in the archive at once, on multiple threads
+	std::vector<std::string> supportedExtensions, textureFiles;
+	supportedExtensions.push_back( ".jpg" );
+	supportedExtensions.push_back( ".png" );
+	for ( std::vector<sQ3BSPTexture*>::const_iterator it = pModel->m_Textures.begin(); it != pModel->m_Textures.end(); ++it )
+	{
+		std::string textureName, ext;
+		if ( NULL != *it && expandFile( pArchive, (*it)->strName, supportedExtensions, textureName, ext ) )
+		{
+			textureFiles.push_back( textureName );
+		}
+	}
+	pArchive->Prefetch( textureFiles );
+
 	pScene->mMaterials = new aiMaterial*[ m_MaterialLookupMap.size() ];
 	aiString aiMatName;
 	int textureId( -1 ), lightmapId( -1 );
@@ -622,7 +646,7 @@ aiFace *Q3BSPFileImporter::getNextFace( aiMesh *pMesh, unsigned int &rFaceIdx )
 // ------------------------------------------------------------------------------------------------
 //	Imports a texture file.
 bool Q3BSPFileImporter::importTextureFromArchive( const Q3BSP::Q3BSPModel *pModel,
-												 Q3BSP::Q3BSPZipArchive *pArchive, aiScene* /*pScene*/,
+												 ZipArchiveIOSystem *pArchive, aiScene* /*pScene*/,
 												 aiMaterial *pMatHelper, int textureId )
 {
 	std::vector<std::string> supportedExtensions;
@@ -737,7 +761,7 @@ bool Q3BSPFileImporter::importLightmap( const Q3BSP::Q3BSPModel *pModel, aiScene
 
 // ------------------------------------------------------------------------------------------------
 //	Will search for a supported extension.
-bool Q3BSPFileImporter::expandFile(  Q3BSP::Q3BSPZipArchive *pArchive, const std::string &rFilename, 
+bool Q3BSPFileImporter::expandFile(  ZipArchiveIOSystem *pArchive, const std::string &rFilename, 
 								   const std::vector<std::string> &rExtList, std::string &rFile,
 								   std::string &rExt )
 {
@@ -41,7 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Q3BSPFileParser.h"
 #include "DefaultIOSystem.h"
 #include "Q3BSPFileData.h"
-#include "Q3BSPZipArchive.h"
+#include "ZipArchiveIOSystem.h"
 #include <vector>
 
 namespace Assimp
@@ -50,7 +50,7 @@ namespace Assimp
 using namespace Q3BSP;
 
 // ------------------------------------------------------------------------------------------------
-Q3BSPFileParser::Q3BSPFileParser( const std::string &rMapName, Q3BSPZipArchive *pZipArchive ) :
+Q3BSPFileParser::Q3BSPFileParser( const std::string &rMapName, ZipArchiveIOSystem *pZipArchive ) :
 	m_sOffset( 0 ),
 	m_Data(),
 	m_pModel( NULL ),
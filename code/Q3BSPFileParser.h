@@ -49,18 +49,18 @@ namespace Assimp
 namespace Q3BSP
 {
 
-class Q3BSPZipArchive;
 struct Q3BSPModel;
-class ZipFile;
 
 }
 
+class ZipArchiveIOSystem;
+
 // -------------------------------------------------------------------
 // -------------------------------------------------------------------
 class Q3BSPFileParser
 {
 public:
-	Q3BSPFileParser( const std::string &rMapName, Q3BSP::Q3BSPZipArchive *pZipArchive );
+	Q3BSPFileParser( const std::string &rMapName, ZipArchiveIOSystem *pZipArchive );
 	~Q3BSPFileParser();
 	Q3BSP::Q3BSPModel *getModel() const;
 
@@ -81,7 +81,7 @@ private:
 	size_t m_sOffset;
 	std::vector<char> m_Data;
 	Q3BSP::Q3BSPModel *m_pModel;
-	Q3BSP::Q3BSPZipArchive *m_pZipArchive;
+	ZipArchiveIOSystem *m_pZipArchive;
 };
 
 } // Namespace Assimp
@@ -1062,50 +1062,37 @@ void SMDImporter::ParseVertex(const char* szCurrent,
 		LogErrorNoThrow("Unexpected EOF/EOL while parsing vertex.parent");
 		SMDI_PARSE_RETURN;
 	}
-	if(!ParseFloat(szCurrent,&szCurrent,(float&)vertex.pos.x))
+	// position and normal, plus the texture coordinate if this isn't a VA section
+	static const char* const aszNames[] = {
+		"Unexpected EOF/EOL while parsing vertex.pos.x",
+		"Unexpected EOF/EOL while parsing vertex.pos.y",
+		"Unexpected EOF/EOL while parsing vertex.pos.z",
+		"Unexpected EOF/EOL while parsing vertex.nor.x",
+		"Unexpected EOF/EOL while parsing vertex.nor.y",
+		"Unexpected EOF/EOL while parsing vertex.nor.z",
+		"Unexpected EOF/EOL while parsing vertex.uv.x",
+		"Unexpected EOF/EOL while parsing vertex.uv.y"
+	};
+	// values which aren't there are left untouched
+	float afValues[8] = {
+		vertex.pos.x, vertex.pos.y, vertex.pos.z,
+		vertex.nor.x, vertex.nor.y, vertex.nor.z,
+		vertex.uv.x,  vertex.uv.y
+	};
+	const unsigned int iNum = bVASection ? 6 : 8;
+	const unsigned int iRead = fast_atoreal_span<float>(szCurrent,afValues,iNum,false);
+	vertex.pos = aiVector3D(afValues[0],afValues[1],afValues[2]);
+	vertex.nor = aiVector3D(afValues[3],afValues[4],afValues[5]);
+	vertex.uv.x = afValues[6];
+	vertex.uv.y = afValues[7];
+	if (iRead < iNum)
 	{
-		LogErrorNoThrow("Unexpected EOF/EOL while parsing vertex.pos.x");
-		SMDI_PARSE_RETURN;
-	}
-	if(!ParseFloat(szCurrent,&szCurrent,(float&)vertex.pos.y))
-	{
-		LogErrorNoThrow("Unexpected EOF/EOL while parsing vertex.pos.y");
-		SMDI_PARSE_RETURN;
-	}
-	if(!ParseFloat(szCurrent,&szCurrent,(float&)vertex.pos.z))
-	{
-		LogErrorNoThrow("Unexpected EOF/EOL while parsing vertex.pos.z");
-		SMDI_PARSE_RETURN;
-	}
-	if(!ParseFloat(szCurrent,&szCurrent,(float&)vertex.nor.x))
-	{
-		LogErrorNoThrow("Unexpected EOF/EOL while parsing vertex.nor.x");
-		SMDI_PARSE_RETURN;
-	}
-	if(!ParseFloat(szCurrent,&szCurrent,(float&)vertex.nor.y))
-	{
-		LogErrorNoThrow("Unexpected EOF/EOL while parsing vertex.nor.y");
-		SMDI_PARSE_RETURN;
-	}
-	if(!ParseFloat(szCurrent,&szCurrent,(float&)vertex.nor.z))
-	{
-		LogErrorNoThrow("Unexpected EOF/EOL while parsing vertex.nor.z");
+		LogErrorNoThrow(aszNames[iRead]);
 		SMDI_PARSE_RETURN;
 	}
 
 	if (bVASection)SMDI_PARSE_RETURN;
 
-	if(!ParseFloat(szCurrent,&szCurrent,(float&)vertex.uv.x))
-	{
-		LogErrorNoThrow("Unexpected EOF/EOL while parsing vertex.uv.x");
-		SMDI_PARSE_RETURN;
-	}
-	if(!ParseFloat(szCurrent,&szCurrent,(float&)vertex.uv.y))
-	{
-		LogErrorNoThrow("Unexpected EOF/EOL while parsing vertex.uv.y");
-		SMDI_PARSE_RETURN;
-	}
-
 	// now read the number of bones affecting this vertex
 	// all elements from now are fully optional, we don't need them
 	unsigned int iSize = 0;
@@ -76,6 +76,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace Assimp {
 
+class ImportProgressHandler;
+
 // ********************************************************************************
 // before things get complicated, this is the basic outline:
 
@@ -195,13 +197,13 @@ namespace STEP {
 			// conversion support.
 			template <typename T>
 			const T& ResolveSelect(const DB& db) const {
-				return Couple<T>(db).MustGetObject(To<EXPRESS::ENTITY>())->To<T>();
+				return Couple<T>(db).MustGetObject(To<EXPRESS::ENTITY>())->template To<T>();
 			}
 
 			template <typename T>
 			const T* ResolveSelectPtr(const DB& db) const {
 				const EXPRESS::ENTITY* e = ToPtr<EXPRESS::ENTITY>();
-				return e?Couple<T>(db).MustGetObject(*e)->ToPtr<T>():(const T*)0;
+				return e?Couple<T>(db).MustGetObject(*e)->template ToPtr<T>():(const T*)0;
 			}
 
 		public:
@@ -824,7 +826,8 @@ namespace STEP {
 		friend DB* ReadFileHeader(boost::shared_ptr<IOStream> stream);
 		friend void ReadFile(DB& db,const EXPRESS::ConversionSchema& scheme,
 			const char* const* types_to_track, size_t len,
-			const char* const* inverse_indices_to_track, size_t len2
+			const char* const* inverse_indices_to_track, size_t len2,
+			ImportProgressHandler* progress
 		);
 
 		friend class LazyObject;
@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "STEPFileReader.h"
 #include "TinyFormatter.h"
 #include "fast_atof.h"
+#include "ImportProgressHandler.h"
 
 using namespace Assimp;
 namespace EXPRESS = STEP::EXPRESS;
@@ -163,7 +164,7 @@ STEP::DB* STEP::ReadFileHeader(boost::shared_ptr<IOStream> stream)
 // ------------------------------------------------------------------------------------------------
 void STEP::ReadFile(DB& db,const EXPRESS::ConversionSchema& scheme,
 	const char* const* types_to_track, size_t len,
-	const char* const* inverse_indices_to_track, size_t len2)
+	const char* const* inverse_indices_to_track, size_t len2, ImportProgressHandler* progress /*= NULL*/)
 {
 	db.SetSchema(scheme);
 	db.SetTypesToTrack(types_to_track,len);
@@ -177,6 +178,10 @@ void STEP::ReadFile(DB& db,const EXPRESS::ConversionSchema& scheme,
 			break;
 		}
 
+		if (progress) {
+			progress->Poll();
+		}
+
 		// want one-based line numbers for human readers, so +1
 		const uint64_t line = splitter.get_index()+1;
 
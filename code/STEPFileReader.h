@@ -44,6 +44,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "STEPFile.h"
 
 namespace Assimp {
+
+	class ImportProgressHandler;
+
 namespace STEP {
 
 	// ### Parsing a STEP file is a twofold procedure ###
@@ -55,10 +58,11 @@ namespace STEP {
 
 	// --------------------------------------------------------------------------
 	// 2) read the actual file contents using a user-supplied set of
-	//    conversion functions to interpret the data.
-	void ReadFile(DB& db,const EXPRESS::ConversionSchema& scheme, const char* const* types_to_track, size_t len, const char* const* inverse_indices_to_track, size_t len2);
-	template <size_t N, size_t N2> inline void ReadFile(DB& db,const EXPRESS::ConversionSchema& scheme, const char* const (&arr)[N], const char* const (&arr2)[N2]) {
-		return ReadFile(db,scheme,arr,N,arr2,N2);
+	//    conversion functions to interpret the data. If a progress handler
+	//    is given, it is polled for every record and may abort the read.
+	void ReadFile(DB& db,const EXPRESS::ConversionSchema& scheme, const char* const* types_to_track, size_t len, const char* const* inverse_indices_to_track, size_t len2, ImportProgressHandler* progress = NULL);
+	template <size_t N, size_t N2> inline void ReadFile(DB& db,const EXPRESS::ConversionSchema& scheme, const char* const (&arr)[N], const char* const (&arr2)[N2], ImportProgressHandler* progress = NULL) {
+		return ReadFile(db,scheme,arr,N,arr2,N2,progress);
 	}
 	
 
@@ -52,27 +52,25 @@ namespace Assimp	{
 // Worker function for exporting a scene to Stereolithograpy. Prototyped and registered in Exporter.cpp
 void ExportSceneSTL(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene)
 {
-	// invoke the exporter 
-	STLExporter exporter(pFile, pScene);
-
-	// we're still here - export successfully completed. Write the file.
 	boost::scoped_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
-	outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+	if(!outfile) {
+		throw DeadlyExportError("could not open output .stl file: " + std::string(pFile));
+	}
+
+	// invoke the exporter, it writes straight to the file
+	STLExporter exporter(pFile, pScene, outfile.get());
 }
 
 } // end of namespace Assimp
 
 
 // ------------------------------------------------------------------------------------------------
-STLExporter :: STLExporter(const char* _filename, const aiScene* pScene)
-: filename(_filename)
+STLExporter :: STLExporter(const char* _filename, const aiScene* pScene, IOStream* outfile)
+: mOutput(outfile)
+, filename(_filename)
 , pScene(pScene)
 , endl("\n") 
 {
-	// make sure that all formatting happens using the standard, C locale and not the user's current locale
-	const std::locale& l = std::locale("C");
-	mOutput.imbue(l);
-
 	const std::string& name = "AssimpScene";
 	
 	mOutput << "solid " << name << endl;
@@ -80,6 +78,7 @@ STLExporter :: STLExporter(const char* _filename, const aiScene* pScene)
 		WriteMesh(pScene->mMeshes[i]);
 	}
 	mOutput << "endsolid " << name << endl;
+	mOutput.Flush();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -44,7 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_STLEXPORTER_H_INC
 #define AI_STLEXPORTER_H_INC
 
-#include <sstream>
+#include "TextWriter.h"
 
 struct aiScene;
 struct aiNode;
@@ -59,12 +59,7 @@ class STLExporter
 {
 public:
 	/// Constructor for a specific scene to export
-	STLExporter(const char* filename, const aiScene* pScene);
-
-public:
-
-	/// public stringstreams to write all output into
-	std::ostringstream mOutput;
+	STLExporter(const char* filename, const aiScene* pScene, IOStream* outfile);
 
 private:
 
@@ -72,6 +67,9 @@ private:
 
 private:
 
+	/// buffered writer to send all output through
+	TextWriter mOutput;
+
 	const std::string filename;
 	const aiScene* const pScene;
 
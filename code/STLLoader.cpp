@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "STLLoader.h"
 #include "ParsingUtils.h"
 #include "fast_atof.h"
+#include "WindowedStreamReader.h"
 
 using namespace Assimp;
 
@@ -90,22 +91,32 @@ void STLImporter::GetExtensionList(std::set<std::string>& extensions)
 void STLImporter::InternReadFile( const std::string& pFile, 
 	aiScene* pScene, IOSystem* pIOHandler)
 {
-	boost::scoped_ptr<IOStream> file( pIOHandler->Open( pFile, "rb"));
+	boost::shared_ptr<IOStream> file( pIOHandler->Open( pFile, "rb"));
 
 	// Check whether we can read from the file
 	if( file.get() == NULL)	{
 		throw DeadlyImportError( "Failed to open STL file " + pFile + ".");
 	}
 
-	fileSize = (unsigned int)file->FileSize();
+	fileSize = file->FileSize();
 
-	// allocate storage and copy the contents of the file to a memory buffer
-	// (terminate it with zero)
+	// check whether the file starts with 'solid' -
+	// in this case we can simply assume it IS a text file. 
+	char magic[5];
+	const bool isASCII = 5 == file->Read(magic,1,5) && !::strncmp(magic,"solid",5);
+	file->Seek(0,aiOrigin_SET);
+
+	// allocate storage and copy the contents of text files to a memory buffer
+	// (terminate it with zero). Binary files are streamed, so they needn't 
+	// fit into memory as a whole.
 	std::vector<char> mBuffer2;
-	TextFileToBuffer(file.get(),mBuffer2);
+	if (isASCII) {
+		TextFileToBuffer(file.get(),mBuffer2);
+		this->mBuffer = &mBuffer2[0];
+	}
+	else this->mBuffer = NULL;
 
 	this->pScene = pScene;
-	this->mBuffer = &mBuffer2[0];
 
 	// the default vertex color is white
 	clrColorDefault.r = clrColorDefault.g = clrColorDefault.b = clrColorDefault.a = 1.0f;
@@ -123,13 +134,10 @@ void STLImporter::InternReadFile( const std::string& pFile,
 	pScene->mRootNode->mMeshes[0] = 0;
 
 	bool bMatClr = false;
-
-	// check whether the file starts with 'solid' -
-	// in this case we can simply assume it IS a text file. finished.
-	if (!::strncmp(mBuffer,"solid",5)) {
+	if (isASCII) {
 		LoadASCIIFile();
 	}
-	else bMatClr = LoadBinaryFile();
+	else bMatClr = LoadBinaryFile(file);
 
 	// now copy faces
 	pMesh->mFaces = new aiFace[pMesh->mNumFaces];
@@ -186,7 +194,8 @@ void STLImporter::LoadASCIIFile()
 
 	// try to guess how many vertices we could have
 	// assume we'll need 160 bytes for each face
-	pMesh->mNumVertices = ( pMesh->mNumFaces = std::max(1u,fileSize / 160u )) * 3;
+	pMesh->mNumFaces = static_cast<unsigned int>(std::max(static_cast<size_t>(1),std::min(fileSize / 160u,static_cast<size_t>(UINT_MAX / 3))));
+	pMesh->mNumVertices = pMesh->mNumFaces * 3;
 	pMesh->mVertices = new aiVector3D[pMesh->mNumVertices];
 	pMesh->mNormals  = new aiVector3D[pMesh->mNumVertices];
 	
@@ -210,10 +219,14 @@ void STLImporter::LoadASCIIFile()
 				ai_assert(pMesh->mNumFaces != 0);
 
 				// need to resize the arrays, our size estimate was wrong
-				unsigned int iNeededSize = (unsigned int)(sz-mBuffer) / pMesh->mNumFaces;
+				size_t iNeededSize = static_cast<size_t>(sz-mBuffer) / pMesh->mNumFaces;
 				if (iNeededSize <= 160)iNeededSize >>= 1; // prevent endless looping
-				unsigned int add = (unsigned int)((mBuffer+fileSize)-sz) / iNeededSize;
+				size_t add = static_cast<size_t>((mBuffer+fileSize)-sz) / std::max(iNeededSize,static_cast<size_t>(1));
 				add += add >> 3; // add 12.5% as buffer
+				add = std::max(add,static_cast<size_t>(1));
+				if (add > UINT_MAX / 3 - pMesh->mNumFaces) {
+					throw DeadlyImportError("STL: too many facets");
+				}
 				iNeededSize = (pMesh->mNumFaces + add)*3;
 				aiVector3D* pv = new aiVector3D[iNeededSize];
 				memcpy(pv,pMesh->mVertices,pMesh->mNumVertices*sizeof(aiVector3D));
@@ -224,8 +237,8 @@ void STLImporter::LoadASCIIFile()
 				delete[] pMesh->mNormals;
 				pMesh->mNormals = pv;
 
-				pMesh->mNumVertices = iNeededSize;
-				pMesh->mNumFaces += add;
+				pMesh->mNumVertices = static_cast<unsigned int>(iNeededSize);
+				pMesh->mNumFaces += static_cast<unsigned int>(add);
 			}
 			aiVector3D* vn = &pMesh->mNormals[curFace++*3];
 
@@ -287,16 +300,22 @@ void STLImporter::LoadASCIIFile()
 
 // ------------------------------------------------------------------------------------------------
 // Read a binary STL file
-bool STLImporter::LoadBinaryFile()
+bool STLImporter::LoadBinaryFile(boost::shared_ptr<IOStream> file)
 {
+	WindowedStreamReaderLE reader(file);
+
 	// skip the first 80 bytes
-	if (fileSize < 84) {
+	if (reader.GetRemainingSize() < 84) {
 		throw DeadlyImportError("STL: file is too small for the header");
 	}
 	bool bIsMaterialise = false;
 
+	// the padding catches reads past the end of the header below
+	char header[96] = {0};
+	reader.CopyAndAdvance(header,80);
+
 	// search for an occurence of "COLOR=" in the header
-	const char* sz2 = (const char*)mBuffer;
+	const char* sz2 = header;
 	const char* const szEnd = sz2+80;
 	while (sz2 < szEnd)	{
 
@@ -313,16 +332,15 @@ bool STLImporter::LoadBinaryFile()
 			break;
 		}
 	}
-	const unsigned char* sz = (const unsigned char*)mBuffer + 80;
 
 	// now read the number of facets
 	aiMesh* pMesh = pScene->mMeshes[0];
 	pScene->mRootNode->mName.Set("<STL_BINARY>");
 
-	pMesh->mNumFaces = *((uint32_t*)sz);
-	sz += 4;
+	pMesh->mNumFaces = reader.GetU4();
 
-	if (fileSize < 84 + pMesh->mNumFaces*50) {
+	// 64 bit arithmetic, so files larger than 4 GB are checked correctly on all platforms
+	if (static_cast<uint64_t>(reader.GetRemainingSize()) < static_cast<uint64_t>(pMesh->mNumFaces) * 50) {
 		throw DeadlyImportError("STL: file is too small to hold all facets");
 	}
 
@@ -330,6 +348,10 @@ bool STLImporter::LoadBinaryFile()
 		throw DeadlyImportError("STL: file is empty. There are no facets defined");
 	}
 
+	if (pMesh->mNumFaces > UINT_MAX / 3) {
+		throw DeadlyImportError("STL: too many facets");
+	}
+
 	pMesh->mNumVertices = pMesh->mNumFaces*3;
 
 	aiVector3D* vp,*vn;
@@ -340,23 +362,20 @@ bool STLImporter::LoadBinaryFile()
 
 		// NOTE: Blender sometimes writes empty normals ... this is not
 		// our fault ... the RemoveInvalidData helper step should fix that
-		*vn = *((aiVector3D*)sz);
-		sz += sizeof(aiVector3D);
+		vn->x = reader.GetF4();
+		vn->y = reader.GetF4();
+		vn->z = reader.GetF4();
 		*(vn+1) = *vn;
 		*(vn+2) = *vn;
 		vn += 3;
 
-		*vp++ = *((aiVector3D*)sz);
-		sz += sizeof(aiVector3D);
-
-		*vp++ = *((aiVector3D*)sz);
-		sz += sizeof(aiVector3D);
-
-		*vp++ = *((aiVector3D*)sz);
-		sz += sizeof(aiVector3D);
+		for (unsigned int o = 0; o < 3; ++o, ++vp) {
+			vp->x = reader.GetF4();
+			vp->y = reader.GetF4();
+			vp->z = reader.GetF4();
+		}
 
-		uint16_t color = *((uint16_t*)sz);
-		sz += 2;
+		const uint16_t color = reader.GetU2();
 
 		if (color & (1 << 15))
 		{
@@ -370,7 +389,7 @@ bool STLImporter::LoadBinaryFile()
 
 				DefaultLogger::get()->info("STL: Mesh has vertex colors");
 			}
-			aiColor4D* clr = &pMesh->mColors[0][pMesh->mNumFaces*3];
+			aiColor4D* clr = &pMesh->mColors[0][i*3];
 			clr->a = 1.0f;
 			if (bIsMaterialise) // fuck, this is reversed
 			{
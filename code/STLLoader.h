@@ -85,10 +85,11 @@ protected:
 
 
 	// -------------------------------------------------------------------
-	/** Loads a binary .stl file
+	/** Loads a binary .stl file, reading it from the stream piece by piece
+	 * @param file Stream positioned at the beginning of the file
 	 * @return true if the default vertex color must be used as material color
 	*/
-	bool LoadBinaryFile();
+	bool LoadBinaryFile(boost::shared_ptr<IOStream> file);
 
 	// -------------------------------------------------------------------
 	/** Loads a ASCII text .stl file
@@ -97,11 +98,11 @@ protected:
 
 protected:
 
-	/** Buffer to hold the loaded file */
+	/** Buffer to hold the loaded file, ASCII files only */
 	const char* mBuffer;
 
 	/** Size of the file, in bytes */
-	unsigned int fileSize;
+	size_t fileSize;
 
 	/** Output scene */
 	aiScene* pScene;
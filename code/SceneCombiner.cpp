@@ -994,8 +994,9 @@ void SceneCombiner::Copy     (aiMesh** _dest, const aiMesh* src)
 	while (dest->HasVertexColors(n))
 		GetArrayCopy( dest->mColors[n++],   dest->mNumVertices );
 
-	// make a deep copy of all bones
+	// make a deep copy of all bones and attached meshes
 	CopyPtrArray(dest->mBones,dest->mBones,dest->mNumBones);
+	CopyPtrArray(dest->mAnimMeshes,dest->mAnimMeshes,dest->mNumAnimMeshes);
 
 	// make a deep copy of all faces
 	GetArrayCopy(dest->mFaces,dest->mNumFaces);
@@ -1073,6 +1074,7 @@ void SceneCombiner::Copy     (aiAnimation** _dest, const aiAnimation* src)
 
 	// and reallocate all arrays
 	CopyPtrArray( dest->mChannels, src->mChannels, dest->mNumChannels );
+	CopyPtrArray( dest->mMeshChannels, src->mMeshChannels, dest->mNumMeshChannels );
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1091,6 +1093,43 @@ void SceneCombiner::Copy     (aiNodeAnim** _dest, const aiNodeAnim* src)
 	GetArrayCopy( dest->mRotationKeys, dest->mNumRotationKeys );
 }
 
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::Copy     (aiAnimMesh** _dest, const aiAnimMesh* src)
+{
+	ai_assert(NULL != _dest && NULL != src);
+
+	aiAnimMesh* dest = *_dest = new aiAnimMesh();
+
+	// get a flat copy
+	::memcpy(dest,src,sizeof(aiAnimMesh));
+
+	// and reallocate all arrays
+	GetArrayCopy( dest->mVertices,   dest->mNumVertices );
+	GetArrayCopy( dest->mNormals ,   dest->mNumVertices );
+	GetArrayCopy( dest->mTangents,   dest->mNumVertices );
+	GetArrayCopy( dest->mBitangents, dest->mNumVertices );
+
+	for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n)
+		GetArrayCopy( dest->mTextureCoords[n], dest->mNumVertices );
+
+	for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS; ++n)
+		GetArrayCopy( dest->mColors[n], dest->mNumVertices );
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::Copy     (aiMeshAnim** _dest, const aiMeshAnim* src)
+{
+	ai_assert(NULL != _dest && NULL != src);
+
+	aiMeshAnim* dest = *_dest = new aiMeshAnim();
+
+	// get a flat copy
+	::memcpy(dest,src,sizeof(aiMeshAnim));
+
+	// and reallocate all arrays
+	GetArrayCopy( dest->mKeys, dest->mNumKeys );
+}
+
 // ------------------------------------------------------------------------------------------------
 void SceneCombiner::Copy   (aiCamera** _dest,const  aiCamera* src)
 {
@@ -1140,6 +1179,11 @@ void SceneCombiner::Copy     (aiNode** _dest, const aiNode* src)
 	// and reallocate all arrays
 	GetArrayCopy( dest->mMeshes, dest->mNumMeshes );
 	CopyPtrArray( dest->mChildren, src->mChildren,dest->mNumChildren);
+
+	// the children still point to the parent of the source tree
+	for (unsigned int i = 0; i < dest->mNumChildren; ++i) {
+		dest->mChildren[i]->mParent = dest;
+	}
 }
 
 
@@ -89,6 +89,7 @@ public:
 	StreamReader(boost::shared_ptr<IOStream> stream, bool le = false)
 		: stream(stream)
 		, le(le)
+		, ownsBuffer()
 	{
 		ai_assert(stream); 
 		InternBegin();
@@ -98,6 +99,7 @@ public:
 	StreamReader(IOStream* stream, bool le = false)
 		: stream(boost::shared_ptr<IOStream>(stream))
 		, le(le)
+		, ownsBuffer()
 	{
 		ai_assert(stream);
 		InternBegin();
@@ -105,7 +107,9 @@ public:
 
 	// ---------------------------------------------------------------------
 	~StreamReader() {
-		delete[] buffer;
+		if (ownsBuffer) {
+			delete[] buffer;
+		}
 	}
 
 public:
@@ -201,7 +205,8 @@ public:
 	}
 
 	// ---------------------------------------------------------------------
-	/** Get the current file pointer */
+	/** Get the current file pointer. The data must not be modified
+	 *  through it, it may be the read-only view of the stream. */
 	int8_t* GetPtr() const	{
 		return current;
 	}
@@ -318,7 +323,16 @@ private:
 			throw DeadlyImportError("StreamReader: File is empty or EOF is already reached");
 		}
 
+		// streams which hold the file in memory anyway are read in place
+		const int8_t* view = static_cast<const int8_t*>(stream->GetView());
+		if (view) {
+			current = buffer = const_cast<int8_t*>(view) + stream->Tell();
+			end = limit = buffer + s;
+			return;
+		}
+
 		current = buffer = new int8_t[s];
+		ownsBuffer = true;
 		const size_t read = stream->Read(current,1,s);
 		// (read < s) can only happen if the stream was opened in text mode, in which case FileSize() is not reliable
 		ai_assert(read <= s);
@@ -331,6 +345,7 @@ private:
 	boost::shared_ptr<IOStream> stream;
 	int8_t *buffer, *current, *end, *limit;
 	bool le;
+	bool ownsBuffer;
 };
 
 
@@ -0,0 +1,200 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+
+/** @file  TextWriter.h
+ *  @brief Defines the TextWriter class which formats text output directly
+ *    into an IOStream.
+ */
+
+#ifndef AI_TEXTWRITER_H_INCLUDED
+#define AI_TEXTWRITER_H_INCLUDED
+
+#include "../include/assimp/IOStream.hpp"
+#include "Exceptional.h"
+#include "fast_ftoa.h"
+
+namespace Assimp {
+
+// --------------------------------------------------------------------------------------------
+/** Small replacement for std::ostringstream as used by the text exporters. Output is
+ *  collected in a fixed-size buffer which is handed to the underlying IOStream whenever
+ *  it runs full, so the file never exists in memory as a whole and there is no extra
+ *  copy at the end. Numbers are formatted by fast_ftoa.h directly into the buffer:
+ *  independent of the user's locale, and floating-point values with the shortest
+ *  representation that reads back to the exact same value.
+ *
+ *  The writer does not take ownership of the stream. Call Flush() once all output
+ *  has been written - the destructor does so as well, but has to swallow errors.*/
+// --------------------------------------------------------------------------------------------
+class TextWriter
+{
+public:
+
+	// ---------------------------------------------------------------------
+	/** Construction from a given output stream.
+	 *  @param stream Stream to write to, must remain valid until the
+	 *    writer has been flushed.
+	 *  @param bufferSize Number of bytes to collect before each write */
+	explicit TextWriter(IOStream* stream, size_t bufferSize = 1 << 16)
+		: stream(stream)
+		, buffer(new char[bufferSize])
+		, cur(buffer)
+		, end(buffer + bufferSize)
+		, written()
+	{
+		ai_assert(stream && bufferSize >= AI_FAST_FTOA_BUFFER_SIZE);
+	}
+
+	// ---------------------------------------------------------------------
+	~TextWriter()
+	{
+		try {
+			Flush();
+		}
+		catch (const DeadlyExportError&) {
+		}
+		delete[] buffer;
+	}
+
+public:
+
+	// ---------------------------------------------------------------------
+	/** Append raw characters to the output */
+	void Write(const char* data, size_t length)
+	{
+		if (length > static_cast<size_t>(end - cur)) {
+			Flush();
+
+			// too large for the buffer, bypass it
+			if (length > static_cast<size_t>(end - cur)) {
+				Emit(data,length);
+				return;
+			}
+		}
+		::memcpy(cur,data,length);
+		cur += length;
+	}
+
+	// ---------------------------------------------------------------------
+	/** Hand all buffered output to the underlying stream.
+	 *  @throw DeadlyExportError if the stream did not accept all of it */
+	void Flush()
+	{
+		if (cur != buffer) {
+			const size_t length = cur - buffer;
+			cur = buffer;
+			Emit(buffer,length);
+		}
+	}
+
+	// ---------------------------------------------------------------------
+	/** Get the total number of bytes written so far, including those
+	 *  which are still buffered. */
+	size_t Tell() const
+	{
+		return written + (cur - buffer);
+	}
+
+public:
+
+	TextWriter& operator << (const char* s) {
+		Write(s,::strlen(s));
+		return *this;
+	}
+
+	TextWriter& operator << (const std::string& s) {
+		Write(s.data(),s.length());
+		return *this;
+	}
+
+	TextWriter& operator << (char c) {
+		if (cur == end) {
+			Flush();
+		}
+		*cur++ = c;
+		return *this;
+	}
+
+	TextWriter& operator << (int i)                { cur = fast_itoa(Reserve(),i); return *this; }
+	TextWriter& operator << (long i)               { cur = fast_itoa(Reserve(),i); return *this; }
+	TextWriter& operator << (long long i)          { cur = fast_itoa(Reserve(),i); return *this; }
+	TextWriter& operator << (unsigned int i)       { cur = fast_utoa(Reserve(),i); return *this; }
+	TextWriter& operator << (unsigned long i)      { cur = fast_utoa(Reserve(),i); return *this; }
+	TextWriter& operator << (unsigned long long i) { cur = fast_utoa(Reserve(),i); return *this; }
+	TextWriter& operator << (float f)              { cur = fast_ftoa(Reserve(),f); return *this; }
+	TextWriter& operator << (double d)             { cur = fast_dtoa(Reserve(),d); return *this; }
+
+private:
+
+	// ---------------------------------------------------------------------
+	/** Make room for a number to be formatted in place */
+	char* Reserve() {
+		if (end - cur < AI_FAST_FTOA_BUFFER_SIZE) {
+			Flush();
+		}
+		return cur;
+	}
+
+	// ---------------------------------------------------------------------
+	void Emit(const char* data, size_t length) {
+		if (stream->Write(data,1,length) != length) {
+			throw DeadlyExportError("failed to write output file");
+		}
+		written += length;
+	}
+
+private:
+
+	// no copying
+	TextWriter(const TextWriter&);
+	TextWriter& operator = (const TextWriter&);
+
+	IOStream* const stream;
+	char* const buffer;
+	char* cur;
+	char* const end;
+	size_t written;
+};
+
+} // end namespace Assimp
+
+#endif // !! AI_TEXTWRITER_H_INCLUDED
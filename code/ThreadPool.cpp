@@ -0,0 +1,282 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the following 
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  ThreadPool.cpp
+ *  @brief Implementation of the ThreadPool helper class
+ */
+
+#include "AssimpPCH.h"
+#include "ThreadPool.h"
+#include "MemoryTracker.h"
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#	include <boost/bind.hpp>
+#	include <boost/thread/thread.hpp>
+#	include <boost/thread/mutex.hpp>
+#	include <boost/thread/condition_variable.hpp>
+#endif
+
+using namespace Assimp;
+
+namespace Assimp	{
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+
+// ------------------------------------------------------------------------------------------------
+// Shared state of a ThreadPool and its workers
+struct ThreadPoolData
+{
+	ThreadPoolData()
+		: task()
+		, tracker()
+		, count()
+		, next()
+		, busy()
+		, generation()
+		, shutdown()
+		, failed()
+	{}
+
+	// Main loop of a worker thread
+	void WorkerMain();
+
+	// Process items of the current job until there are none left
+	void Drain();
+
+	boost::thread_group workers;
+	boost::mutex mutex;
+
+	// signalled when a new job is available or the pool shuts down
+	boost::condition_variable wakeup;
+
+	// signalled when the last worker has finished the current job
+	boost::condition_variable done;
+
+	// the current job, protected by mutex
+	ParallelTask* task;
+
+	// memory tracker of the thread which started the job
+	MemoryTracker* tracker;
+	unsigned int count, next;
+
+	// number of workers that haven't finished the current job yet
+	unsigned int busy;
+
+	// incremented for every job to wake the workers up exactly once
+	unsigned int generation;
+
+	bool shutdown;
+
+	// set if a task threw, the first error message is kept
+	bool failed;
+	std::string error;
+};
+
+// ------------------------------------------------------------------------------------------------
+void ThreadPoolData::WorkerMain()
+{
+	unsigned int seen = 0;
+	for (;;) {
+		MemoryTracker* jobTracker;
+		{
+			boost::mutex::scoped_lock lock(mutex);
+			while (!shutdown && generation == seen) {
+				wakeup.wait(lock);
+			}
+			if (shutdown) {
+				return;
+			}
+			seen = generation;
+			jobTracker = tracker;
+		}
+
+		// account allocations to the import the job belongs to
+		MemoryTracker::Attach(jobTracker);
+		Drain();
+		MemoryTracker::Attach(NULL);
+
+		boost::mutex::scoped_lock lock(mutex);
+		if (!--busy) {
+			done.notify_all();
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void ThreadPoolData::Drain()
+{
+	for (;;) {
+		unsigned int index;
+		{
+			boost::mutex::scoped_lock lock(mutex);
+			if (failed || next >= count) {
+				return;
+			}
+			index = next++;
+		}
+
+		try {
+			task->Run(index);
+		}
+		catch (const std::exception& e) {
+			boost::mutex::scoped_lock lock(mutex);
+			if (!failed) {
+				failed = true;
+				error = e.what();
+			}
+		}
+		catch (...) {
+			boost::mutex::scoped_lock lock(mutex);
+			if (!failed) {
+				failed = true;
+				error = "Unknown exception in worker thread";
+			}
+		}
+	}
+}
+
+#else
+
+struct ThreadPoolData 
+{
+};
+
+#endif // !! ASSIMP_BUILD_SINGLETHREADED
+
+} // end of namespace Assimp
+
+// ------------------------------------------------------------------------------------------------
+ThreadPool::ThreadPool(unsigned int numThreads /*= 0*/)
+: numThreads(numThreads ? numThreads : GetHardwareConcurrency())
+, data(new ThreadPoolData())
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	// the calling thread does its share of the work, too
+	for (unsigned int i = 1; i < this->numThreads; ++i) {
+		data->workers.create_thread(boost::bind(&ThreadPoolData::WorkerMain,data));
+	}
+#else
+	this->numThreads = 1;
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+ThreadPool::~ThreadPool()
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	{
+		boost::mutex::scoped_lock lock(data->mutex);
+		data->shutdown = true;
+	}
+	data->wakeup.notify_all();
+	data->workers.join_all();
+#endif
+	delete data;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ThreadPool::ParallelFor(ParallelTask& task, unsigned int count)
+{
+	// run small jobs directly, there is nothing to gain from waking the workers up
+	if (numThreads <= 1 || count <= 1) {
+		for (unsigned int i = 0; i < count; ++i) {
+			task.Run(i);
+		}
+		return;
+	}
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	{
+		boost::mutex::scoped_lock lock(data->mutex);
+		data->task   = &task;
+		data->tracker = MemoryTracker::GetAttached();
+		data->count  = count;
+		data->next   = 0;
+		data->busy   = numThreads-1;
+		data->failed = false;
+		data->error.clear();
+		++data->generation;
+	}
+	data->wakeup.notify_all();
+
+	data->Drain();
+
+	bool failed;
+	std::string error;
+	{
+		boost::mutex::scoped_lock lock(data->mutex);
+		while (data->busy) {
+			data->done.wait(lock);
+		}
+		data->task = NULL;
+		data->tracker = NULL;
+		failed = data->failed;
+		error.swap(data->error);
+	}
+	if (failed) {
+		throw DeadlyImportError(error);
+	}
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int ThreadPool::GetHardwareConcurrency()
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	return std::max(1u,boost::thread::hardware_concurrency());
+#else
+	return 1;
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int ThreadPool::GetThreadCountForConfig(int config)
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	if (config < 0) {
+		return GetHardwareConcurrency();
+	}
+	return config ? static_cast<unsigned int>(config) : 1;
+#else
+	(void)config;
+	return 1;
+#endif
+}
@@ -0,0 +1,133 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file ThreadPool.h
+ *  @brief Defines a small worker pool to run independent tasks concurrently
+ */
+#ifndef AI_THREADPOOL_H_INC
+#define AI_THREADPOOL_H_INC
+
+namespace Assimp	{
+
+struct ThreadPoolData;
+
+// ---------------------------------------------------------------------------
+/** @brief Unit of work to be executed by #ThreadPool::ParallelFor.
+ *
+ *  Run() may be invoked concurrently for different indices, so
+ *  implementations must not touch any state shared between indices
+ *  without synchronization. Exceptions thrown by Run() are caught
+ *  and re-thrown as #DeadlyImportError in the calling thread.
+ */
+class ParallelTask
+{
+public:
+
+	virtual ~ParallelTask()
+	{}
+
+	// -------------------------------------------------------------------
+	/** Process a single work item
+	 *  @param index Index of the item, in [0,count) */
+	virtual void Run(unsigned int index) = 0;
+};
+
+// ---------------------------------------------------------------------------
+/** @brief Fixed-size pool of worker threads.
+ *
+ *  The calling thread always takes part in the work, so a pool of size
+ *  n spawns n-1 extra threads. If Assimp was built without threading
+ *  support (#ASSIMP_BUILD_SINGLETHREADED), all work is done serially
+ *  in the calling thread.
+ *
+ *  The size of the pool used by an #Importer is configured with
+ *  #AI_CONFIG_GLOB_MULTITHREADING.
+ */
+class ThreadPool
+{
+public:
+
+	// -------------------------------------------------------------------
+	/** Construct a pool
+	 *  @param numThreads Total number of threads to use, including
+	 *    the calling thread. 0 selects the number of hardware threads. */
+	explicit ThreadPool(unsigned int numThreads = 0);
+	~ThreadPool();
+
+public:
+
+	// -------------------------------------------------------------------
+	/** Execute a task for all indices in [0,count) and block until
+	 *  all of them have been processed.
+	 *
+	 *  Work items are handed out dynamically, so the order in which
+	 *  they are processed is not defined. ParallelFor() may not be
+	 *  called again from within a task of the same pool. */
+	void ParallelFor(ParallelTask& task, unsigned int count);
+
+	// -------------------------------------------------------------------
+	/** Get the number of threads working on a ParallelFor() call */
+	unsigned int GetNumThreads() const {
+		return numThreads;
+	}
+
+	// -------------------------------------------------------------------
+	/** Get the number of hardware threads available to the process,
+	 *  1 if this can't be determined or threading is disabled. */
+	static unsigned int GetHardwareConcurrency();
+
+	// -------------------------------------------------------------------
+	/** Map a value of #AI_CONFIG_GLOB_MULTITHREADING to a thread count.
+	 *  Negative values select the number of hardware threads. */
+	static unsigned int GetThreadCountForConfig(int config);
+
+private:
+
+	// no copying
+	ThreadPool(const ThreadPool&);
+	ThreadPool& operator = (const ThreadPool&);
+
+	unsigned int numThreads;
+	ThreadPoolData* data;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_THREADPOOL_H_INC
@@ -97,17 +97,36 @@ bool TriangulateProcess::IsActive( unsigned int pFlags) const
 }
 
 // ------------------------------------------------------------------------------------------------
-// Executes the post processing step on the given imported data.
-void TriangulateProcess::Execute( aiScene* pScene)
+// Prepares the post processing step for the given imported data.
+void TriangulateProcess::BeginMeshes( aiScene* pScene)
 {
 	DefaultLogger::get()->debug("TriangulateProcess begin");
 
+	results.reset(new bool[pScene->mNumMeshes]);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Executes the post processing step on a single mesh.
+void TriangulateProcess::ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex, MeshPipelineContext& context)
+{
+	// only the faces change, so derived vertex data stays valid
+	results[meshIndex] = TriangulateMesh(pMesh);
+	if (results[meshIndex]) {
+		context.Invalidate(MeshDataCache::Faces);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// Finishes the post processing step.
+void TriangulateProcess::EndMeshes( aiScene* pScene)
+{
 	bool bHas = false;
 	for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
 	{
-		if(	TriangulateMesh( pScene->mMeshes[a]))
+		if(	results[a])
 			bHas = true;
 	}
+	results.reset();
 	if (bHas)DefaultLogger::get()->info ("TriangulateProcess finished. All polygons have been triangulated.");
 	else     DefaultLogger::get()->debug("TriangulateProcess finished. There was nothing to be done.");
 }
@@ -44,7 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_TRIANGULATEPROCESS_H_INC
 #define AI_TRIANGULATEPROCESS_H_INC
 
-#include "BaseProcess.h"
+#include "PerMeshProcess.h"
 
 struct aiMesh;
 
@@ -57,7 +57,7 @@ namespace Assimp
  * into triangles. You usually want this to happen because the graphics cards
  * need their data as triangles.
  */
-class TriangulateProcess : public BaseProcess
+class TriangulateProcess : public PerMeshProcess
 {
 public:
 
@@ -74,11 +74,12 @@ public:
 	bool IsActive( unsigned int pFlags) const;
 
 	// -------------------------------------------------------------------
-	/** Executes the post processing step on the given imported data.
+	/** Parts of the post processing step, see PerMeshProcess.
 	* At the moment a process is not supposed to fail.
-	* @param pScene The imported data to work at.
 	*/
-	void Execute( aiScene* pScene);
+	void BeginMeshes( aiScene* pScene);
+	void ExecuteOnMesh( aiMesh* pMesh, unsigned int meshIndex, MeshPipelineContext& context);
+	void EndMeshes( aiScene* pScene);
 
 public:
 	// -------------------------------------------------------------------
@@ -86,6 +87,11 @@ public:
 	 * @param pMesh The mesh to triangulate.
 	 */
 	bool TriangulateMesh( aiMesh* pMesh);
+
+private:
+
+	/** Return value of TriangulateMesh() for each mesh */
+	boost::scoped_array<bool> results;
 };
 
 } // end of namespace Assimp
@@ -0,0 +1,360 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+
+/** @file Defines the WindowedStreamReader class which reads binary data 
+ *  sequentially from a stream of any size, holding only a part of it in memory. */
+
+#ifndef AI_WINDOWEDSTREAMREADER_H_INCLUDED
+#define AI_WINDOWEDSTREAMREADER_H_INCLUDED
+
+#include "ByteSwap.h"
+
+/** Default size of the window of WindowedStreamReader, in bytes */
+#define AI_WINDOWEDSTREAMREADER_SIZE (1024*1024)
+
+namespace Assimp {
+
+// --------------------------------------------------------------------------------------------
+/** Variant of #StreamReader for files which may be larger than the available memory. 
+ *  Instead of the whole file, only a window of a fixed size is held in memory, which is
+ *  refilled from the stream as reading goes on. The interface is the same as the one of
+ *  #StreamReader, except for the direct pointer access (GetPtr(), SetPtr()), which has
+ *  no equivalent here. All positions and sizes are 64 bit wide on 64 bit platforms.
+ *
+ *  Reading is meant to be sequential. Seeking back and forth works as well, but each 
+ *  jump out of the current window means a seek on the stream and a refill. Streams 
+ *  which provide a view of their contents (IOStream::GetView()) are read in place, 
+ *  without any window. Don't attempt to instance the template directly, use 
+ *  WindowedStreamReaderLE or WindowedStreamReaderBE. */
+// --------------------------------------------------------------------------------------------
+template <bool SwapEndianess = false, bool RuntimeSwitch = false>
+class WindowedStreamReader
+{
+public:
+
+	// ---------------------------------------------------------------------
+	/** Construction from a given stream with a well-defined endianess.
+	 * 
+	 *  @param stream Input stream. Reading starts at its current file
+	 *    pointer, just like for #StreamReader.
+	 *  @param le If @c RuntimeSwitch is true: specifies whether the
+	 *    stream is in little endian byte order. 
+	 *  @param windowSize Number of bytes held in memory at most */
+	WindowedStreamReader(boost::shared_ptr<IOStream> stream, bool le = false, 
+		size_t windowSize = AI_WINDOWEDSTREAMREADER_SIZE)
+		: stream(stream)
+		, le(le)
+	{
+		InternBegin(windowSize);
+	}
+
+	// ---------------------------------------------------------------------
+	WindowedStreamReader(IOStream* stream, bool le = false, 
+		size_t windowSize = AI_WINDOWEDSTREAMREADER_SIZE)
+		: stream(boost::shared_ptr<IOStream>(stream))
+		, le(le)
+	{
+		InternBegin(windowSize);
+	}
+
+public:
+
+	// ---------------------------------------------------------------------
+	/** Read a float from the stream  */
+	float GetF4()	{
+		return Get<float>();
+	}
+
+	// ---------------------------------------------------------------------
+	/** Read a double from the stream  */
+	double GetF8()	{
+		return Get<double>();
+	}
+
+	// ---------------------------------------------------------------------
+	/** Read a signed 16 bit integer from the stream */
+	int16_t GetI2()	{
+		return Get<int16_t>();
+	}
+
+	// ---------------------------------------------------------------------
+	/** Read a signed 8 bit integer from the stream */
+	int8_t GetI1()	{
+		return Get<int8_t>();
+	}
+
+	// ---------------------------------------------------------------------
+	/** Read an signed 32 bit integer from the stream */
+	int32_t GetI4()	{
+		return Get<int32_t>();
+	}
+
+	// ---------------------------------------------------------------------
+	/** Read a signed 64 bit integer from the stream */
+	int64_t GetI8()	{
+		return Get<int64_t>();
+	}
+
+	// ---------------------------------------------------------------------
+	/** Read a unsigned 16 bit integer from the stream */
+	uint16_t GetU2()	{
+		return Get<uint16_t>();
+	}
+
+	// ---------------------------------------------------------------------
+	/** Read a unsigned 8 bit integer from the stream */
+	uint8_t GetU1()	{
+		return Get<uint8_t>();
+	}
+
+	// ---------------------------------------------------------------------
+	/** Read an unsigned 32 bit integer from the stream */
+	uint32_t GetU4()	{
+		return Get<uint32_t>();
+	}
+
+	// ---------------------------------------------------------------------
+	/** Read a unsigned 64 bit integer from the stream */
+	uint64_t GetU8()	{
+		return Get<uint64_t>();
+	}
+
+public:
+
+	// ---------------------------------------------------------------------
+	/** Get the remaining stream size (to the end of the stream) */
+	size_t GetRemainingSize() const {
+		return end - current;
+	}
+
+	// ---------------------------------------------------------------------
+	/** Get the remaining stream size (to the current read limit) */
+	size_t GetRemainingSizeToLimit() const {
+		return limit - current;
+	}
+
+	// ---------------------------------------------------------------------
+	/** Increase the file pointer (relative seeking) */
+	void IncPtr(ptrdiff_t plus)	{
+		if (plus > 0 ? static_cast<size_t>(plus) > limit - current : static_cast<size_t>(-plus) > current) {
+			throw DeadlyImportError("End of file or read limit was reached");
+		}
+		current += plus;
+	}
+
+	// ---------------------------------------------------------------------
+	/** Copy n bytes to an external buffer
+	 *  @param out Destination for copying
+	 *  @param bytes Number of bytes to copy */
+	void CopyAndAdvance(void* out, size_t bytes)	{
+		if (bytes > limit - current) {
+			throw DeadlyImportError("End of file or read limit was reached");
+		}
+
+		int8_t* dest = static_cast<int8_t*>(out);
+		while (bytes) {
+			if (current >= windowEnd || current < windowBegin) {
+				Refill();
+			}
+			const size_t n = std::min(bytes,windowEnd - current);
+			::memcpy(dest,window + (current - windowBegin),n);
+
+			dest    += n;
+			current += n;
+			bytes   -= n;
+		}
+	}
+
+	// ---------------------------------------------------------------------
+	/** Get the current offset from the beginning of the file */
+	size_t GetCurrentPos() const	{
+		return current;
+	}
+
+	void SetCurrentPos(size_t pos) {
+		if (pos > limit) {
+			throw DeadlyImportError("End of file or read limit was reached");
+		}
+		current = pos;
+	}
+
+	// ---------------------------------------------------------------------
+	/** Setup a temporary read limit
+	 * 
+	 *  @param limit Maximum number of bytes to be read from
+	 *    the beginning of the file. Specifying SIZE_MAX
+	 *    resets the limit to the original end of the stream. */
+	void SetReadLimit(size_t _limit)	{
+		if (SIZE_MAX == _limit) {
+			limit = end;
+			return;
+		}
+		if (_limit > end) {
+			throw DeadlyImportError("StreamReader: Invalid read limit");
+		}
+		limit = _limit;
+	}
+
+	// ---------------------------------------------------------------------
+	/** Get the current read limit in bytes */
+	size_t GetReadLimit() const	{
+		return limit;
+	}
+
+	// ---------------------------------------------------------------------
+	/** Skip to the read limit */
+	void SkipToReadLimit()	{
+		current = limit;
+	}
+
+	// ---------------------------------------------------------------------
+	/** overload operator>> and allow chaining of >> ops. */
+	template <typename T>
+	WindowedStreamReader& operator >> (T& f) {
+		f = Get<T>(); 
+		return *this;
+	}
+
+private:
+
+	// ---------------------------------------------------------------------
+	/** Generic read method. ByteSwap::Swap(T*) *must* be defined */
+	template <typename T>
+	T Get()	{
+		if (sizeof(T) > limit - current) {
+			throw DeadlyImportError("End of file or stream limit was reached");
+		}
+		if (current + sizeof(T) > windowEnd || current < windowBegin) {
+			Refill();
+		}
+
+		T f;
+		::memcpy(&f,window + (current - windowBegin),sizeof(T));
+		Intern :: Getter<SwapEndianess,T,RuntimeSwitch>() (&f,le);
+
+		current += sizeof(T);
+		return f;
+	}
+
+	// ---------------------------------------------------------------------
+	/** Move the window to the current position and fill it */
+	void Refill() {
+		ai_assert(!buffer.empty());
+
+		const size_t want = std::min(buffer.size(),end - current);
+		if (AI_SUCCESS != stream->Seek(start + current,aiOrigin_SET)) {
+			throw DeadlyImportError("StreamReader: Failed to seek in file");
+		}
+
+		// everything up to the read limit has been validated, so a short read is an error
+		const size_t read = want ? stream->Read(&buffer[0],1,want) : 0;
+		if (read != want) {
+			throw DeadlyImportError("StreamReader: Failed to read from file");
+		}
+
+		windowBegin = current;
+		windowEnd   = current + read;
+	}
+
+	// ---------------------------------------------------------------------
+	void InternBegin(size_t windowSize) {
+		if (!stream) {
+			throw DeadlyImportError("StreamReader: Unable to open file");
+		}
+
+		start = stream->Tell();
+		current = 0;
+		end = limit = stream->FileSize() - start;
+		if (!end) {
+			throw DeadlyImportError("StreamReader: File is empty or EOF is already reached");
+		}
+
+		// streams which hold the file in memory anyway are read in place
+		const int8_t* view = static_cast<const int8_t*>(stream->GetView());
+		if (view) {
+			window = view + start;
+			windowBegin = 0;
+			windowEnd = end;
+			return;
+		}
+
+		// the window must hold the largest type we read at least
+		buffer.resize(std::min(end,std::max(windowSize,sizeof(uint64_t))));
+		window = &buffer[0];
+		windowBegin = windowEnd = 0;
+	}
+
+private:
+
+	boost::shared_ptr<IOStream> stream;
+	std::vector<int8_t> buffer;
+
+	// window into the file, either the buffer or the view of the stream
+	const int8_t* window;
+
+	// offset of the file pointer at construction time
+	size_t start;
+
+	// all other positions are relative to start
+	size_t windowBegin, windowEnd, current, end, limit;
+	bool le;
+};
+
+
+// --------------------------------------------------------------------------------------------
+// `static` WindowedStreamReaders. Their byte order is fixed and they might be a little bit faster.
+#ifdef AI_BUILD_BIG_ENDIAN
+	typedef WindowedStreamReader<true>  WindowedStreamReaderLE;
+	typedef WindowedStreamReader<false> WindowedStreamReaderBE;
+#else
+	typedef WindowedStreamReader<true>  WindowedStreamReaderBE;
+	typedef WindowedStreamReader<false> WindowedStreamReaderLE;
+#endif
+
+// `dynamic` WindowedStreamReader. The byte order of the input data is specified in the
+// c'tor. This involves runtime branching and might be a little bit slower than static
+// readers.
+typedef WindowedStreamReader<true,true> WindowedStreamReaderAny;
+
+} // end namespace Assimp
+
+#endif // !! AI_WINDOWEDSTREAMREADER_H_INCLUDED
@@ -1375,10 +1375,33 @@ float XFileParser::ReadFloat()
 	return result;
 }
 
+// ------------------------------------------------------------------------------------------------
+bool XFileParser::ReadFloatsFast( float* pOut, unsigned int pNum)
+{
+	if( mIsBinaryFormat)
+		return false;
+
+	// the usual "1.0;2.0;3.0;" on a single line. Everything else - comments, line breaks
+	// or the odd strings written by faulty exporters - is left to ReadFloat()
+	FindNextNoneWhiteSpace();
+	const char* p = P;
+	if( fast_atoreal_span<float>( p, pOut, pNum, false, ",;") != pNum || (*p != ';' && *p != ','))
+		return false;
+
+	P = p + 1;
+	TestForSeparator();
+	return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 aiVector2D XFileParser::ReadVector2()
 {
+	float v[2];
+	if( ReadFloatsFast( v, 2))
+		return aiVector2D( v[0], v[1]);
+
 	aiVector2D vector;
+
 	vector.x = ReadFloat();
 	vector.y = ReadFloat();
 	TestForSeparator();
@@ -1389,7 +1412,12 @@ aiVector2D XFileParser::ReadVector2()
 // ------------------------------------------------------------------------------------------------
 aiVector3D XFileParser::ReadVector3()
 {
+	float v[3];
+	if( ReadFloatsFast( v, 3))
+		return aiVector3D( v[0], v[1], v[2]);
+
 	aiVector3D vector;
+
 	vector.x = ReadFloat();
 	vector.y = ReadFloat();
 	vector.z = ReadFloat();
@@ -128,6 +128,7 @@ protected:
 	unsigned int ReadBinDWord();
 	unsigned int ReadInt();
 	float ReadFloat();
+	bool ReadFloatsFast( float* pOut, unsigned int pNum);
 	aiVector2D ReadVector2();
 	aiVector3D ReadVector3();
 	aiColor3D ReadRGB();
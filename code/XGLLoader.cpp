@@ -52,8 +52,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "MemoryIOWrapper.h"
 
 using namespace Assimp;
-using namespace irr;
-using namespace irr::io;
 
 
 // zlib is needed for compressed XGL files 
@@ -191,9 +189,8 @@ void XGLImporter::InternReadFile( const std::string& pFile,
 #endif
 	}
 
-	// construct the irrXML parser
-	CIrrXML_IOStreamReader st(stream.get());
-	boost::scoped_ptr<IrrXMLReader> read( createIrrXMLReader((IFileReadCallBack*) &st) );
+	// construct the XML parser
+	boost::scoped_ptr<XMLReader> read( new XMLReader(stream.get()) );
 	reader = read.get();
 
 	// parse the XML file
@@ -237,7 +234,7 @@ void XGLImporter::InternReadFile( const std::string& pFile,
 bool XGLImporter::ReadElement()
 {
 	while(reader->read()) {
-		if (reader->getNodeType() == EXN_ELEMENT) {
+		if (reader->getNodeType() == XML_ELEMENT) {
 			return true;
 		}
 	}
@@ -248,10 +245,10 @@ bool XGLImporter::ReadElement()
 bool XGLImporter::ReadElementUpToClosing(const char* closetag)
 {
 	while(reader->read()) {
-		if (reader->getNodeType() == EXN_ELEMENT) {
+		if (reader->getNodeType() == XML_ELEMENT) {
 			return true;
 		}
-		else if (reader->getNodeType() == EXN_ELEMENT_END && !ASSIMP_stricmp(reader->getNodeName(),closetag)) {
+		else if (reader->getNodeType() == XML_ELEMENT_END && !ASSIMP_stricmp(reader->getNodeName(),closetag)) {
 			return false;
 		}
 	}
@@ -263,10 +260,10 @@ bool XGLImporter::ReadElementUpToClosing(const char* closetag)
 bool XGLImporter::SkipToText()
 {
 	while(reader->read()) {
-		if (reader->getNodeType() == EXN_TEXT) {
+		if (reader->getNodeType() == XML_TEXT) {
 			return true;
 		}
-		else if (reader->getNodeType() == EXN_ELEMENT || reader->getNodeType() == EXN_ELEMENT_END) {
+		else if (reader->getNodeType() == XML_ELEMENT || reader->getNodeType() == XML_ELEMENT_END) {
 			ThrowException("expected text contents but found another element (or element end)");
 		}
 	}
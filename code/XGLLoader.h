@@ -45,7 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_XGLLOADER_H_INCLUDED
 
 #include "BaseImporter.h"
-#include "irrXMLWrapper.h"
+#include "XMLReader.h"
 #include "LogAux.h"
 
 namespace Assimp	{
@@ -190,7 +190,7 @@ private:
 
 private:
 
-	irr::io::IrrXMLReader* reader;
+	XMLReader* reader;
 	aiScene* scene;
 };
 
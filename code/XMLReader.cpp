@@ -0,0 +1,463 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  XMLReader.cpp
+ *  @brief Implementation of the XMLReader pull parser
+ */
+
+#include "AssimpPCH.h"
+#include "XMLReader.h"
+#include "fast_atof.h"
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+inline bool IsXMLSpace(char c)
+{
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// ------------------------------------------------------------------------------------------------
+// Replace the predefined entities in [begin,end) in place and terminate the result
+void DecodeInPlace(char* begin, char* end)
+{
+	static const struct {
+		const char* name;
+		unsigned int length;
+		char c;
+	} entities[] = {
+		{"&amp;",5,'&'},{"&lt;",4,'<'},{"&gt;",4,'>'},{"&quot;",6,'\"'},{"&apos;",6,'\''}
+	};
+
+	char* out = static_cast<char*>(memchr(begin,'&',end-begin));
+	if (!out) {
+		*end = '\0';
+		return;
+	}
+	for (const char* in = out; in != end; ) {
+		if (*in == '&') {
+			unsigned int i = 0;
+			for (; i < sizeof(entities)/sizeof(entities[0]); ++i) {
+				if (static_cast<size_t>(end-in) >= entities[i].length && !strncmp(in,entities[i].name,entities[i].length)) {
+					break;
+				}
+			}
+			if (i < sizeof(entities)/sizeof(entities[0])) {
+				*out++ = entities[i].c;
+				in += entities[i].length;
+				continue;
+			}
+		}
+		*out++ = *in++;
+	}
+	*out = '\0';
+}
+
+} // end of anonymous namespace
+
+// ------------------------------------------------------------------------------------------------
+XMLReader::XMLReader(IOStream* stream)
+	: cursor()
+	, tagPending()
+	, nodeType(XML_NONE)
+	, nodeName("")
+	, emptyElement()
+{
+	BaseImporter::TextFileToBuffer(stream,buffer);
+	cursor = &buffer[0];
+}
+
+// ------------------------------------------------------------------------------------------------
+XMLReader::~XMLReader()
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+bool XMLReader::read()
+{
+	if (!tagPending) {
+		char* const start = cursor;
+		while (*cursor != '<' && *cursor) {
+			++cursor;
+		}
+		if (!*cursor) {
+			return false;
+		}
+
+		// report text, unless it is just a line break or so
+		if (cursor - start > 0) {
+			bool text = cursor - start >= 3;
+			for (const char* p = start; !text && p != cursor; ++p) {
+				text = !IsXMLSpace(*p);
+			}
+
+			if (text) {
+				// the '<' is overwritten, so remember the tag has been entered
+				nodeType = XML_TEXT;
+				nodeName = start;
+				emptyElement = false;
+				attributes.clear();
+
+				char* const end = cursor++;
+				DecodeInPlace(start,end);
+				tagPending = true;
+				return true;
+			}
+		}
+		++cursor;
+	}
+	tagPending = false;
+
+	switch (*cursor)
+	{
+	case '/':
+		parseClosingElement();
+		break;
+
+	case '?':
+		// skip the XML declaration and processing instructions
+		nodeType = XML_UNKNOWN;
+		nodeName = "";
+		emptyElement = false;
+		attributes.clear();
+		while (*cursor != '>' && *cursor) {
+			++cursor;
+		}
+		if (*cursor) {
+			++cursor;
+		}
+		break;
+
+	case '!':
+		if (cursor[1] == '[') {
+			parseCDATA();
+		}
+		else {
+			parseComment();
+		}
+		break;
+
+	default:
+		parseOpeningElement();
+	}
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool XMLReader::skipElement()
+{
+	if (nodeType != XML_ELEMENT || emptyElement) {
+		return true;
+	}
+
+	// only count the nesting depth, nothing is terminated or decoded on the way
+	for (unsigned int depth = 1; ; ) {
+		char* const next = strchr(cursor,'<');
+		if (!next) {
+			cursor += strlen(cursor);
+			return false;
+		}
+		cursor = next + 1;
+
+		switch (*cursor)
+		{
+		case '/':
+			if (!--depth) {
+				parseClosingElement();
+				return true;
+			}
+			break;
+
+		case '!':
+			if (cursor[1] == '[') {
+				parseCDATA();
+			}
+			else {
+				parseComment();
+			}
+			continue;
+
+		case '?':
+			break;
+
+		default:
+			// an opening tag, '>' may appear in its attribute values
+			for (char quote = 0; *cursor && (quote || *cursor != '>'); ++cursor) {
+				if (quote) {
+					if (*cursor == quote) {
+						quote = 0;
+					}
+				}
+				else if (*cursor == '\"' || *cursor == '\'') {
+					quote = *cursor;
+				}
+			}
+			if (*cursor && cursor[-1] != '/') {
+				++depth;
+			}
+		}
+
+		while (*cursor != '>' && *cursor) {
+			++cursor;
+		}
+		if (!*cursor) {
+			return false;
+		}
+		++cursor;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void XMLReader::parseOpeningElement()
+{
+	nodeType = XML_ELEMENT;
+	emptyElement = false;
+	attributes.clear();
+
+	char* const name = cursor;
+	while (*cursor != '>' && !IsXMLSpace(*cursor) && *cursor) {
+		++cursor;
+	}
+	char* nameEnd = cursor;
+
+	// collect the attributes first, they are terminated when the whole tag has been read
+	while (*cursor != '>' && *cursor) {
+		if (IsXMLSpace(*cursor)) {
+			++cursor;
+		}
+		else if (*cursor == '/') {
+			// tag is closed directly
+			++cursor;
+			emptyElement = true;
+			break;
+		}
+		else {
+			Attribute attr;
+			attr.name = cursor;
+			while (!IsXMLSpace(*cursor) && *cursor != '=' && *cursor) {
+				++cursor;
+			}
+			attr.nameEnd = cursor;
+			if (*cursor) {
+				++cursor;
+			}
+
+			// the value may be enclosed in double or single quotes
+			while (*cursor != '\"' && *cursor != '\'' && *cursor) {
+				++cursor;
+			}
+			if (!*cursor) {
+				break;
+			}
+			const char quote = *cursor++;
+			attr.value = cursor;
+			while (*cursor != quote && *cursor) {
+				++cursor;
+			}
+			if (!*cursor) {
+				break;
+			}
+
+			attr.valueEnd = cursor++;
+			attributes.push_back(attr);
+		}
+	}
+
+	if (nameEnd > name && nameEnd[-1] == '/') {
+		// directly closing tag
+		emptyElement = true;
+		--nameEnd;
+	}
+	if (*cursor) {
+		++cursor;
+	}
+
+	*nameEnd = '\0';
+	nodeName = name;
+	for (std::vector<Attribute>::iterator it = attributes.begin(); it != attributes.end(); ++it) {
+		*(*it).nameEnd = '\0';
+		DecodeInPlace((*it).value,(*it).valueEnd);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void XMLReader::parseClosingElement()
+{
+	nodeType = XML_ELEMENT_END;
+	emptyElement = false;
+	attributes.clear();
+
+	char* const name = ++cursor;
+	while (*cursor != '>' && *cursor) {
+		++cursor;
+	}
+
+	// remove trailing whitespace, if any
+	char* end = cursor;
+	while (end > name && isspace(static_cast<unsigned char>(end[-1]))) {
+		--end;
+	}
+	if (*cursor) {
+		++cursor;
+	}
+	*end = '\0';
+	nodeName = name;
+}
+
+// ------------------------------------------------------------------------------------------------
+void XMLReader::parseComment()
+{
+	nodeType = XML_COMMENT;
+	emptyElement = false;
+	attributes.clear();
+
+	// the comment ends at the matching '>', which also skips DOCTYPE declarations
+	char* const begin = ++cursor;
+	for (unsigned int depth = 1; depth && *cursor; ++cursor) {
+		if (*cursor == '>') {
+			--depth;
+		}
+		else if (*cursor == '<') {
+			++depth;
+		}
+	}
+
+	// strip '--' and '-->' of regular comments
+	char* const end = cursor - 3;
+	if (end > begin + 2) {
+		*end = '\0';
+		nodeName = begin + 2;
+	}
+	else {
+		nodeName = "";
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void XMLReader::parseCDATA()
+{
+	nodeType = XML_CDATA;
+	emptyElement = false;
+	attributes.clear();
+	nodeName = "";
+
+	// skip '![CDATA['
+	for (unsigned int i = 0; i < 8 && *cursor; ++i) {
+		++cursor;
+	}
+
+	char* const begin = cursor;
+	for (; *cursor; ++cursor) {
+		if (*cursor == '>' && cursor - begin >= 2 && cursor[-1] == ']' && cursor[-2] == ']') {
+			cursor[-2] = '\0';
+			nodeName = begin;
+			++cursor;
+			break;
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* XMLReader::getAttributeName(int idx) const
+{
+	if (idx < 0 || idx >= getAttributeCount()) {
+		return NULL;
+	}
+	return attributes[idx].name;
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* XMLReader::getAttributeValue(int idx) const
+{
+	if (idx < 0 || idx >= getAttributeCount()) {
+		return NULL;
+	}
+	return attributes[idx].value;
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* XMLReader::getAttributeValue(const char* name) const
+{
+	if (!name) {
+		return NULL;
+	}
+	for (std::vector<Attribute>::const_iterator it = attributes.begin(); it != attributes.end(); ++it) {
+		if (!strcmp((*it).name,name)) {
+			return (*it).value;
+		}
+	}
+	return NULL;
+}
+
+// ------------------------------------------------------------------------------------------------
+const char* XMLReader::getAttributeValueSafe(const char* name) const
+{
+	const char* value = getAttributeValue(name);
+	return value ? value : "";
+}
+
+// ------------------------------------------------------------------------------------------------
+int XMLReader::getAttributeValueAsInt(const char* name) const
+{
+	// irrXML went through float as well, so does e.g. "1e3" 
+	return static_cast<int>(getAttributeValueAsFloat(name));
+}
+
+// ------------------------------------------------------------------------------------------------
+int XMLReader::getAttributeValueAsInt(int idx) const
+{
+	return static_cast<int>(getAttributeValueAsFloat(idx));
+}
+
+// ------------------------------------------------------------------------------------------------
+float XMLReader::getAttributeValueAsFloat(const char* name) const
+{
+	const char* value = getAttributeValue(name);
+	return value ? fast_atof(value) : 0.f;
+}
+
+// ------------------------------------------------------------------------------------------------
+float XMLReader::getAttributeValueAsFloat(int idx) const
+{
+	const char* value = getAttributeValue(idx);
+	return value ? fast_atof(value) : 0.f;
+}
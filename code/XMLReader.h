@@ -0,0 +1,206 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  XMLReader.h
+ *  @brief Defines XMLReader, a pull parser for the XML-based file formats
+ */
+#ifndef INCLUDED_AI_XML_READER_H
+#define INCLUDED_AI_XML_READER_H
+
+#include <vector>
+
+namespace Assimp	{
+
+	class IOStream;
+
+// ---------------------------------------------------------------------------
+/** Type of the node a #XMLReader is positioned at */
+enum XMLNodeType
+{
+	XML_NONE = 0,
+	XML_ELEMENT,
+	XML_ELEMENT_END,
+	XML_TEXT,
+	XML_COMMENT,
+	XML_CDATA,
+	XML_UNKNOWN
+};
+
+// ---------------------------------------------------------------------------
+/** @brief Pull parser for XML files.
+ *
+ *  The file is read into memory once and converted to UTF-8 (see 
+ *  #BaseImporter::ConvertToUTF8). It is then tokenized in place: names,
+ *  attribute values and text contents are not copied, but terminated by 
+ *  overwriting the delimiter behind them with a zero, and XML entities are 
+ *  replaced in place. All strings returned by the reader point into its 
+ *  buffer and remain valid as long as the reader exists.
+ *
+ *  The interface and the way nodes are reported are the same as with 
+ *  irrXML, which was used by the XML-based loaders before. Like irrXML, 
+ *  the reader does neither validate the file nor resolve other entities 
+ *  than the five predefined ones. Empty elements (&lt;foo/&gt;) do not
+ *  produce an #XML_ELEMENT_END node, use isEmptyElement() to detect them.
+ *  Text consisting of less than three whitespace characters is skipped.
+ */
+class XMLReader
+{
+public:
+
+	// -------------------------------------------------------------------
+	/** Construct from a stream. The stream is read immediately, but
+	 *  not closed. Throws #DeadlyImportError if it can't be read. */
+	explicit XMLReader(IOStream* stream);
+
+	~XMLReader();
+
+public:
+
+	// -------------------------------------------------------------------
+	/** Move to the next node.
+	 *  @return false if the end of the file has been reached. */
+	bool read();
+
+	// -------------------------------------------------------------------
+	/** Skip the contents of the current element without tokenizing them.
+	 *  Afterwards the reader is positioned at the element's end node. 
+	 *  Does nothing if the current node is no element or an empty one.
+	 *  @return false if the end of the file has been reached. */
+	bool skipElement();
+
+	// -------------------------------------------------------------------
+	/** Get the type of the current node */
+	XMLNodeType getNodeType() const {
+		return nodeType;
+	}
+
+	// -------------------------------------------------------------------
+	/** Get the name of the current element or the contents of the 
+	 *  current text, comment or CDATA node. */
+	const char* getNodeName() const {
+		return nodeName;
+	}
+
+	// -------------------------------------------------------------------
+	/** Same as getNodeName(), for text nodes */
+	const char* getNodeData() const {
+		return nodeName;
+	}
+
+	// -------------------------------------------------------------------
+	/** Check whether the current element is an empty element, 
+	 *  like &lt;foo/&gt; */
+	bool isEmptyElement() const {
+		return emptyElement;
+	}
+
+	// -------------------------------------------------------------------
+	/** Get the number of attributes of the current element */
+	int getAttributeCount() const {
+		return static_cast<int>(attributes.size());
+	}
+
+	// -------------------------------------------------------------------
+	/** Get the name of an attribute, NULL if the index is invalid */
+	const char* getAttributeName(int idx) const;
+
+	// -------------------------------------------------------------------
+	/** Get the value of an attribute, NULL if the index is invalid */
+	const char* getAttributeValue(int idx) const;
+
+	// -------------------------------------------------------------------
+	/** Get the value of an attribute, NULL if it doesn't exist */
+	const char* getAttributeValue(const char* name) const;
+
+	// -------------------------------------------------------------------
+	/** Get the value of an attribute, an empty string if it doesn't exist */
+	const char* getAttributeValueSafe(const char* name) const;
+
+	// -------------------------------------------------------------------
+	/** Get the value of an attribute as integer, 0 if it doesn't exist */
+	int getAttributeValueAsInt(const char* name) const;
+	int getAttributeValueAsInt(int idx) const;
+
+	// -------------------------------------------------------------------
+	/** Get the value of an attribute as float, 0 if it doesn't exist */
+	float getAttributeValueAsFloat(const char* name) const;
+	float getAttributeValueAsFloat(int idx) const;
+
+private:
+
+	void parseOpeningElement();
+	void parseClosingElement();
+	void parseComment();
+	void parseCDATA();
+
+	// no copying
+	XMLReader(const XMLReader&);
+	XMLReader& operator = (const XMLReader&);
+
+private:
+
+	// the ends are only needed while the element is parsed
+	struct Attribute
+	{
+		char* name;
+		char* nameEnd;
+		char* value;
+		char* valueEnd;
+	};
+
+	//! File contents, zero-terminated
+	std::vector<char> buffer;
+
+	//! Current position in the buffer
+	char* cursor;
+
+	//! True if the cursor is behind the '<' of a tag whose text was
+	//! terminated in its place
+	bool tagPending;
+
+	XMLNodeType nodeType;
+	const char* nodeName;
+	bool emptyElement;
+	std::vector<Attribute> attributes;
+};
+
+} // end of namespace Assimp
+
+#endif // INCLUDED_AI_XML_READER_H
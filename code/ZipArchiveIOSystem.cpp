@@ -0,0 +1,508 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+
+/** @file  ZipArchiveIOSystem.cpp
+ *  @brief Implementation of ZipArchiveIOSystem
+ */
+
+#include "AssimpPCH.h"
+#include "ZipArchiveIOSystem.h"
+#include "ThreadPool.h"
+
+#ifdef ASSIMP_BUILD_NO_OWN_ZLIB
+#	include <zlib.h>
+#else
+#	include "../contrib/zlib/zlib.h"
+#endif
+
+using namespace Assimp;
+
+namespace {
+
+// ----------------------------------------------------------------------------------
+// File access callbacks for unzip, all reads go through the IOSystem
+voidpf ZCALLBACK OpenCallback(voidpf opaque, const char* filename, int /*mode*/)
+{
+	return static_cast<IOSystem*>(opaque)->Open(filename,"rb");
+}
+
+uLong ZCALLBACK ReadCallback(voidpf /*opaque*/, voidpf stream, void* buf, uLong size)
+{
+	return static_cast<uLong>(static_cast<IOStream*>(stream)->Read(buf,1,size));
+}
+
+uLong ZCALLBACK WriteCallback(voidpf /*opaque*/, voidpf /*stream*/, const void* /*buf*/, uLong /*size*/)
+{
+	return 0;
+}
+
+long ZCALLBACK TellCallback(voidpf /*opaque*/, voidpf stream)
+{
+	return static_cast<long>(static_cast<IOStream*>(stream)->Tell());
+}
+
+long ZCALLBACK SeekCallback(voidpf /*opaque*/, voidpf stream, uLong offset, int origin)
+{
+	aiOrigin o = aiOrigin_SET;
+	switch (origin) {
+	case ZLIB_FILEFUNC_SEEK_CUR:
+		o = aiOrigin_CUR;
+		break;
+	case ZLIB_FILEFUNC_SEEK_END:
+		o = aiOrigin_END;
+		break;
+	};
+	return AI_SUCCESS == static_cast<IOStream*>(stream)->Seek(offset,o) ? 0 : -1;
+}
+
+int ZCALLBACK CloseCallback(voidpf opaque, voidpf stream)
+{
+	static_cast<IOSystem*>(opaque)->Close(static_cast<IOStream*>(stream));
+	return 0;
+}
+
+int ZCALLBACK ErrorCallback(voidpf /*opaque*/, voidpf /*stream*/)
+{
+	return 0;
+}
+
+// ----------------------------------------------------------------------------------
+// Key for the member index: lower case, '/' separators, no '.' and '..' 
+std::string NormalizePath(const std::string& path)
+{
+	std::vector<std::string> parts;
+	std::string part;
+	for (std::string::const_iterator it = path.begin();; ++it) {
+		if (it == path.end() || *it == '/' || *it == '\\') {
+			if (part == "..") {
+				if (!parts.empty() && parts.back() != "..") {
+					parts.pop_back();
+				}
+				else parts.push_back(part);
+			}
+			else if (!part.empty() && part != ".") {
+				parts.push_back(part);
+			}
+			part.clear();
+
+			if (it == path.end()) {
+				break;
+			}
+			continue;
+		}
+		part += static_cast<char>(::tolower(static_cast<unsigned char>(*it)));
+	}
+
+	std::string out;
+	for (std::vector<std::string>::const_iterator it = parts.begin(); it != parts.end(); ++it) {
+		if (!out.empty()) {
+			out += '/';
+		}
+		out += *it;
+	}
+	return out;
+}
+
+// ----------------------------------------------------------------------------------
+// Decompresses members on the worker threads
+class DecompressTask : public ParallelTask
+{
+public:
+	DecompressTask(const std::vector<ZipArchiveIOSystem::Entry*>& entries) 
+		: entries(entries) {}
+
+	void Run(unsigned int index);
+
+private:
+	const std::vector<ZipArchiveIOSystem::Entry*>& entries;
+};
+
+} // ! anon namespace
+
+// ----------------------------------------------------------------------------------
+ZipArchiveIOSystem::ZipArchiveIOSystem(IOSystem* io, const std::string& archive, unsigned int numThreads)
+	: io(io)
+	, prefix(NormalizePath(archive))
+	, archiveSize()
+	, handle()
+	, numThreads(numThreads)
+{
+	ai_assert(NULL != io);
+
+	zlib_filefunc_def functions;
+	functions.zopen_file = &OpenCallback;
+	functions.zread_file = &ReadCallback;
+	functions.zwrite_file = &WriteCallback;
+	functions.ztell_file = &TellCallback;
+	functions.zseek_file = &SeekCallback;
+	functions.zclose_file = &CloseCallback;
+	functions.zerror_file = &ErrorCallback;
+	functions.opaque = io;
+
+	handle = unzOpen2(archive.c_str(),&functions);
+	if (!handle) {
+		return;
+	}
+
+	// no member can be larger than the archive when compressed
+	if (IOStream* stream = io->Open(archive.c_str(),"rb")) {
+		archiveSize = stream->FileSize();
+		io->Close(stream);
+	}
+
+	// index the central directory
+	std::vector<char> name;
+	for (int ret = unzGoToFirstFile(handle); UNZ_OK == ret; ret = unzGoToNextFile(handle)) {
+		unz_file_info info;
+		if (UNZ_OK != unzGetCurrentFileInfo(handle,&info,NULL,0,NULL,0,NULL,0)) {
+			continue;
+		}
+		name.resize(info.size_filename+1);
+		unzGetCurrentFileInfo(handle,NULL,&name[0],static_cast<uLong>(name.size()),NULL,0,NULL,0);
+
+		Entry entry;
+		entry.name = &name[0];
+
+		// skip directories
+		if (entry.name.empty() || entry.name[entry.name.length()-1] == '/') {
+			continue;
+		}
+
+		unzGetFilePos(handle,&entry.pos);
+		entry.size = info.uncompressed_size;
+		entry.compressedSize = info.compressed_size;
+		entry.crc = info.crc;
+		entry.method = static_cast<int>(info.compression_method);
+		entry.encrypted = 0 != (info.flag & 1);
+
+		const std::string key = NormalizePath(entry.name);
+		entries[key] = entry;
+	}
+}
+
+// ----------------------------------------------------------------------------------
+ZipArchiveIOSystem::~ZipArchiveIOSystem()
+{
+	if (handle) {
+		unzClose(handle);
+	}
+}
+
+// ----------------------------------------------------------------------------------
+ZipArchiveIOSystem* ZipArchiveIOSystem::OpenForFile(IOSystem* io, const std::string& file, unsigned int numThreads)
+{
+	for (std::string::size_type s = file.find_first_of("/\\"); s != std::string::npos; s = file.find_first_of("/\\",s+1)) {
+		const std::string path = file.substr(0,s);
+		if (path.length() <= 4 || ASSIMP_stricmp(path.substr(path.length()-4),".zip") || !io->Exists(path.c_str())) {
+			continue;
+		}
+
+		ZipArchiveIOSystem* zip = new ZipArchiveIOSystem(io,path,numThreads);
+		if (zip->IsOpen() && zip->Exists(file.c_str())) {
+			return zip;
+		}
+		delete zip;
+	}
+	return NULL;
+}
+
+// ----------------------------------------------------------------------------------
+bool ZipArchiveIOSystem::IsOpen() const
+{
+	return NULL != handle;
+}
+
+// ----------------------------------------------------------------------------------
+void ZipArchiveIOSystem::GetFileList(std::vector<std::string>& files) const
+{
+	files.clear();
+	files.reserve(entries.size());
+	for (EntryMap::const_iterator it = entries.begin(); it != entries.end(); ++it) {
+		files.push_back((*it).second.name);
+	}
+}
+
+// ----------------------------------------------------------------------------------
+ZipArchiveIOSystem::Entry* ZipArchiveIOSystem::Find(const std::string& file, bool& inArchive) const
+{
+	std::string key = NormalizePath(file);
+
+	inArchive = false;
+	if (key.length() > prefix.length() && !key.compare(0,prefix.length(),prefix) && key[prefix.length()] == '/') {
+		key = key.substr(prefix.length()+1);
+		inArchive = true;
+	}
+
+	// bare member names must not shadow real files
+	Entry* const entry = FindMember(key);
+	if (!inArchive && entry && io->Exists(file.c_str())) {
+		return NULL;
+	}
+	return entry;
+}
+
+// ----------------------------------------------------------------------------------
+ZipArchiveIOSystem::Entry* ZipArchiveIOSystem::FindMember(const std::string& member) const
+{
+	EntryMap::iterator it = entries.find(NormalizePath(member));
+	return it == entries.end() ? NULL : &(*it).second;
+}
+
+// ----------------------------------------------------------------------------------
+bool ZipArchiveIOSystem::ReadRaw(Entry& entry)
+{
+	if (entry.encrypted || (entry.method != 0 && entry.method != Z_DEFLATED)) {
+		DefaultLogger::get()->error("ZIP: " + entry.name + " is encrypted or uses an unsupported compression method");
+		return false;
+	}
+
+	// The sizes are taken from the archive and can't be trusted, so check them 
+	// before allocating anything. Deflate doesn't compress better than ~1:1032.
+	if (entry.compressedSize > archiveSize || (entry.method == 0 && entry.size != entry.compressedSize) ||
+		entry.size / 1032 > entry.compressedSize) {
+		DefaultLogger::get()->error("ZIP: The sizes stored for " + entry.name + " are invalid");
+		return false;
+	}
+
+	// read the compressed data as is, it's decompressed separately
+	int method, level;
+	if (UNZ_OK != unzGoToFilePos(handle,&entry.pos) || UNZ_OK != unzOpenCurrentFile2(handle,&method,&level,1)) {
+		DefaultLogger::get()->error("ZIP: Failed to locate " + entry.name);
+		return false;
+	}
+
+	entry.raw.resize(entry.compressedSize);
+	const int read = entry.raw.empty() ? 0 : unzReadCurrentFile(handle,&entry.raw[0],static_cast<unsigned int>(entry.raw.size()));
+	unzCloseCurrentFile(handle);
+
+	if (read < 0 || static_cast<size_t>(read) != entry.raw.size()) {
+		DefaultLogger::get()->error("ZIP: Failed to read " + entry.name);
+		std::vector<uint8_t>().swap(entry.raw);
+		return false;
+	}
+	return true;
+}
+
+namespace {
+
+// ----------------------------------------------------------------------------------
+// Decompress a member whose compressed data has been read. Safe to call
+// concurrently for different members.
+void Decompress(ZipArchiveIOSystem::Entry& entry)
+{
+	entry.loaded = true;
+	if (entry.method == 0) {
+		entry.data.swap(entry.raw);
+	}
+	else {
+		entry.data.resize(entry.size);
+
+		z_stream zstream;
+		zstream.zalloc = Z_NULL;
+		zstream.zfree = Z_NULL;
+		zstream.opaque = Z_NULL;
+		zstream.next_in = entry.raw.empty() ? Z_NULL : &entry.raw[0];
+		zstream.avail_in = static_cast<uInt>(entry.raw.size());
+		zstream.next_out = entry.data.empty() ? Z_NULL : &entry.data[0];
+		zstream.avail_out = static_cast<uInt>(entry.data.size());
+
+		// zip stores raw deflate streams without zlib header
+		int ret = ::inflateInit2(&zstream,-MAX_WBITS);
+		if (Z_OK == ret) {
+			ret = ::inflate(&zstream,Z_FINISH);
+			::inflateEnd(&zstream);
+		}
+		if (Z_STREAM_END != ret || zstream.total_out != entry.size) {
+			entry.failed = true;
+		}
+		std::vector<uint8_t>().swap(entry.raw);
+	}
+
+	if (!entry.failed && entry.crc != ::crc32(::crc32(0L,Z_NULL,0),entry.data.empty() ? Z_NULL : &entry.data[0],
+		static_cast<uInt>(entry.data.size()))) {
+		entry.failed = true;
+	}
+	if (entry.failed) {
+		std::vector<uint8_t>().swap(entry.data);
+	}
+}
+
+} // ! anon namespace
+
+// ----------------------------------------------------------------------------------
+void DecompressTask::Run(unsigned int index)
+{
+	ZipArchiveIOSystem::Entry& entry = *entries[index];
+	if (!entry.loaded) {
+		Decompress(entry);
+	}
+}
+
+// ----------------------------------------------------------------------------------
+bool ZipArchiveIOSystem::Load(Entry& entry)
+{
+	if (!entry.loaded) {
+		if (!ReadRaw(entry)) {
+			entry.loaded = entry.failed = true;
+		}
+		else {
+			Decompress(entry);
+			if (entry.failed) {
+				DefaultLogger::get()->error("ZIP: Failed to decompress " + entry.name);
+			}
+		}
+	}
+	return !entry.failed;
+}
+
+// ----------------------------------------------------------------------------------
+void ZipArchiveIOSystem::Prefetch(const std::vector<std::string>& files)
+{
+	// reading is serial, unzip handles can't be shared - only decompression runs in parallel
+	std::vector<Entry*> pending;
+	for (std::vector<std::string>::const_iterator it = files.begin(); it != files.end(); ++it) {
+		Entry* const entry = FindMember(*it);
+		if (!entry || entry->loaded || std::find(pending.begin(),pending.end(),entry) != pending.end()) {
+			continue;
+		}
+		if (!ReadRaw(*entry)) {
+			entry->loaded = entry->failed = true;
+			continue;
+		}
+		pending.push_back(entry);
+	}
+
+	if (pending.size() > 1 && numThreads != 1) {
+		DecompressTask task(pending);
+		ThreadPool pool(numThreads);
+		pool.ParallelFor(task,static_cast<unsigned int>(pending.size()));
+	}
+	for (std::vector<Entry*>::iterator it = pending.begin(); it != pending.end(); ++it) {
+		Entry& entry = **it;
+		if (!entry.loaded) {
+			Decompress(entry);
+		}
+		if (entry.failed) {
+			DefaultLogger::get()->error("ZIP: Failed to decompress " + entry.name);
+		}
+	}
+}
+
+// ----------------------------------------------------------------------------------
+void ZipArchiveIOSystem::PrefetchRelated(const std::string& file)
+{
+	bool inArchive;
+	const Entry* const entry = Find(file,inArchive);
+	if (!entry) {
+		return;
+	}
+
+	// same directory and same name up to the first dot
+	const std::string key = NormalizePath(entry->name);
+	const std::string::size_type dir = key.find_last_of('/');
+	const std::string::size_type dot = key.find('.',dir == std::string::npos ? 0 : dir+1);
+	const std::string stem = key.substr(0,dot == std::string::npos ? key.length() : dot+1);
+
+	std::vector<std::string> related;
+	for (EntryMap::const_iterator it = entries.lower_bound(stem); it != entries.end() && !(*it).first.compare(0,stem.length(),stem); ++it) {
+		if ((*it).first.find('/',stem.length()) == std::string::npos) {
+			related.push_back((*it).first);
+		}
+	}
+	Prefetch(related);
+}
+
+// ----------------------------------------------------------------------------------
+bool ZipArchiveIOSystem::Exists( const char* pFile) const
+{
+	bool inArchive;
+	if (Find(pFile,inArchive)) {
+		return true;
+	}
+	return !inArchive && io->Exists(pFile);
+}
+
+// ----------------------------------------------------------------------------------
+char ZipArchiveIOSystem::getOsSeparator() const
+{
+	return '/';
+}
+
+// ----------------------------------------------------------------------------------
+IOStream* ZipArchiveIOSystem::Open( const char* pFile, const char* pMode)
+{
+	bool inArchive;
+	Entry* const entry = Find(pFile,inArchive);
+	if (!entry) {
+		return inArchive ? NULL : io->Open(pFile,pMode);
+	}
+
+	// members are read-only
+	if (strchr(pMode,'w') || strchr(pMode,'a') || strchr(pMode,'+') || !Load(*entry)) {
+		return NULL;
+	}
+	++entry->numStreams;
+	return new ZipMemberIOStream(*entry);
+}
+
+// ----------------------------------------------------------------------------------
+void ZipArchiveIOSystem::Close( IOStream* pFile)
+{
+	if (ZipMemberIOStream* member = dynamic_cast<ZipMemberIOStream*>(pFile)) {
+		Entry& entry = member->entry;
+		delete pFile;
+
+		// release the data with the last stream, it is decompressed again if needed
+		if (!--entry.numStreams) {
+			std::vector<uint8_t>().swap(entry.data);
+			entry.loaded = false;
+		}
+		return;
+	}
+	io->Close(pFile);
+}
+
+// ----------------------------------------------------------------------------------
+bool ZipArchiveIOSystem::ComparePaths (const char* one, const char* second) const
+{
+	return NormalizePath(one) == NormalizePath(second);
+}
@@ -0,0 +1,210 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+
+/** @file  ZipArchiveIOSystem.h
+ *  @brief IOSystem to read files from zip archives
+ */
+#ifndef AI_ZIPARCHIVEIOSYSTEM_H_INC
+#define AI_ZIPARCHIVEIOSYSTEM_H_INC
+
+#include "../contrib/unzip/unzip.h"
+#include "../include/assimp/IOStream.hpp"
+#include "../include/assimp/IOSystem.hpp"
+#include "MemoryIOWrapper.h"
+
+namespace Assimp	{
+
+// ---------------------------------------------------------------------------
+/** IOSystem to read the members of a zip archive, usable by all importers.
+ *
+ *  The central directory of the archive is read once on construction and
+ *  indexed by normalized path - lookups ignore case, accept both '/' and 
+ *  '\\' as separators and resolve '.' and '..'. Members are decompressed 
+ *  when they are opened and kept in memory as long as a stream is open for
+ *  them, so a file opened repeatedly while it is in use (i.e. for format 
+ *  detection and by the loader) is decompressed once. Members decompressed 
+ *  ahead by #Prefetch(), on multiple threads, are kept until they have been
+ *  opened and closed again. The sizes stored in the archive are checked for
+ *  plausibility before anything is allocated for a member.
+ *
+ *  Members are addressed by a path through the archive, i.e. 
+ *  'models.zip/spider/spider.obj' for an archive opened as 'models.zip'.
+ *  This is what #Importer::ReadFile() passes to the loaders, so files they
+ *  look up relative to the file being loaded are found in the archive as 
+ *  well. Their path inside the archive ('spider/spider.obj') works, too,
+ *  but only if there is no such file outside the archive - real files are
+ *  never shadowed by members. Any other file is passed through to the 
+ *  wrapped IOSystem. */
+class ZipArchiveIOSystem : public IOSystem
+{
+public:
+	/** Constructor.
+	 *  @param io IOSystem to read the archive from
+	 *  @param archive Path to the archive
+	 *  @param numThreads Number of threads #Prefetch() may use, 
+	 *    0 selects the number of hardware threads. */
+	ZipArchiveIOSystem (IOSystem* io, const std::string& archive, unsigned int numThreads = 1);
+
+	/** Destructor. */
+	~ZipArchiveIOSystem();
+
+	// -------------------------------------------------------------------
+	/** Look for a zip archive on the path to a file, i.e. 'models.zip'
+	 *  for 'models.zip/spider/spider.obj'.
+	 *  @return The opened archive if it contains the file, NULL otherwise */
+	static ZipArchiveIOSystem* OpenForFile(IOSystem* io, const std::string& file, unsigned int numThreads = 1);
+
+	// -------------------------------------------------------------------
+	/** Check whether the archive could be opened. */
+	bool IsOpen() const;
+
+	// -------------------------------------------------------------------
+	/** Get the paths of all members of the archive, as stored in it. */
+	void GetFileList(std::vector<std::string>& files) const;
+
+	// -------------------------------------------------------------------
+	/** Decompress a set of members in parallel ahead of opening them.
+	 *  @param files Paths inside the archive, as returned by GetFileList().
+	 *    Names which aren't members of the archive are ignored. */
+	void Prefetch(const std::vector<std::string>& files);
+
+	// -------------------------------------------------------------------
+	/** Decompress a member and all members in the same directory which
+	 *  share its base name (i.e. 'spider.mtl' for 'spider.obj'), these 
+	 *  are likely to be read along with it. */
+	void PrefetchRelated(const std::string& file);
+
+public:
+
+	// -------------------------------------------------------------------
+	/** Tests for the existence of a file at the given path. */
+	bool Exists( const char* pFile) const;
+
+	// -------------------------------------------------------------------
+	/** Returns the directory separator. */
+	char getOsSeparator() const;
+
+	// -------------------------------------------------------------------
+	/** Open a new file with a given path. */
+	IOStream* Open( const char* pFile, const char* pMode = "rb");
+
+	// -------------------------------------------------------------------
+	/** Closes the given file and releases all resources associated with it. */
+	void Close( IOStream* pFile);
+
+	// -------------------------------------------------------------------
+	/** Compare two paths */
+	bool ComparePaths (const char* one, const char* second) const;
+
+public:
+
+	/** A member of the archive */
+	struct Entry 
+	{
+		Entry() : size(), compressedSize(), crc(), method(), encrypted(), loaded(), failed(), numStreams() {}
+
+		std::string name;
+		unz_file_pos pos;
+		size_t size, compressedSize;
+		uLong crc;
+		int method;
+		bool encrypted;
+
+		// compressed data, only held until it is decompressed
+		std::vector<uint8_t> raw;
+		std::vector<uint8_t> data;
+		bool loaded, failed;
+
+		// open streams on data, it is released when the last one is closed
+		unsigned int numStreams;
+	};
+
+private:
+
+	// -------------------------------------------------------------------
+	/** Get the member for a path. inArchive is set if the path runs
+	 *  through the archive, even if there is no such member. */
+	Entry* Find(const std::string& file, bool& inArchive) const;
+
+	// -------------------------------------------------------------------
+	/** Get the member for a path inside the archive */
+	Entry* FindMember(const std::string& member) const;
+
+	// -------------------------------------------------------------------
+	/** Read the compressed data of a member, only from a single thread */
+	bool ReadRaw(Entry& entry);
+
+	// -------------------------------------------------------------------
+	/** Read and decompress a single member if not done yet */
+	bool Load(Entry& entry);
+
+private:
+	IOSystem* io;
+
+	// normalized path to the archive
+	std::string prefix;
+	size_t archiveSize;
+	unzFile handle;
+	unsigned int numThreads;
+
+	typedef std::map<std::string,Entry> EntryMap;
+	mutable EntryMap entries;
+};
+
+// ----------------------------------------------------------------------------------
+/** Stream returned by ZipArchiveIOSystem for a member of the archive. The 
+ *  decompressed data is owned by the archive and shared by all streams 
+ *  opened for the member. */
+class ZipMemberIOStream : public MemoryIOStream
+{
+public:
+	ZipMemberIOStream (ZipArchiveIOSystem::Entry& entry)
+		: MemoryIOStream(entry.data.empty() ? NULL : &entry.data[0],entry.data.size()), entry(entry) {
+	}
+
+	/** The member read from */
+	ZipArchiveIOSystem::Entry& entry;
+};
+
+} // ns assimp
+
+#endif //!!AI_ZIPARCHIVEIOSYSTEM_H_INC
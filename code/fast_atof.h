@@ -9,6 +9,7 @@
 // Changes:
 //  22nd October 08 (Aramis_acg): Added temporary cast to double, added strtoul10_64
 //     to ensure long numbers are handled correctly
+//  fast_atoreal_move is correctly rounded now, added the bulk *_span functions
 // ------------------------------------------------------------------------------------
 
 
@@ -16,30 +17,13 @@
 #define __FAST_A_TO_F_H_INCLUDED__
 
 #include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 namespace Assimp
 {
 
-const float fast_atof_table[16] =	{  // we write [16] here instead of [] to work around a swig bug
-	0.f,
-	0.1f,
-	0.01f,
-	0.001f,
-	0.0001f,
-	0.00001f,
-	0.000001f,
-	0.0000001f,
-	0.00000001f,
-	0.000000001f,
-	0.0000000001f,
-	0.00000000001f,
-	0.000000000001f,
-	0.0000000000001f,
-	0.00000000000001f,
-	0.000000000000001f
-};
-
-
 // ------------------------------------------------------------------------------------
 // Convert a string in decimal format to a number
 // ------------------------------------------------------------------------------------
@@ -214,46 +198,124 @@ inline uint64_t strtoul10_64( const char* in, const char** out=0, unsigned int*
 	return value;
 }
 
-// Number of relevant decimals for floating-point parsing.
-#define AI_FAST_ATOF_RELAVANT_DECIMALS 15
+// ------------------------------------------------------------------------------------
+// Slow path of fast_atoreal_move, used for the rare numbers which can't be converted
+// exactly using double arithmetic. The digits are copied without the decimal point,
+// so the C runtime's conversion, which is correctly rounded, doesn't depend on the
+// current locale.
+// ------------------------------------------------------------------------------------
+template <typename Real>
+inline Real fast_atoreal_exact( const char* c, bool check_comma, int exp)
+{
+	// 780 significant digits are enough to round any double correctly,
+	// the remaining ones only matter as far as they are zero or not.
+	char digits[800];
+	unsigned int num = 0;
+	bool sticky = false;
+
+	for (; *c >= '0' && *c <= '9'; ++c) {
+		if (num < 780) {
+			if (num || *c != '0') {
+				digits[num++] = *c;
+			}
+		}
+		else {
+			sticky = sticky || *c != '0';
+			++exp;
+		}
+	}
+	if (*c == '.' || (check_comma && c[0] == ',' && c[1] >= '0' && c[1] <= '9')) {
+		for (++c; *c >= '0' && *c <= '9'; ++c) {
+			if (num < 780) {
+				if (num || *c != '0') {
+					digits[num++] = *c;
+				}
+				--exp;
+			}
+			else {
+				sticky = sticky || *c != '0';
+			}
+		}
+	}
+	if (sticky) {
+		digits[num++] = '1';
+		--exp;
+	}
+	::sprintf(digits+num,"e%i",exp);
+
+#if defined(_MSC_VER) && _MSC_VER < 1800
+	// no strtof(), the double is rounded once more. This can be off by one ulp if it
+	// ends up exactly half-way between two floats.
+	return static_cast<Real>( ::strtod(digits,NULL) );
+#else
+	return sizeof(Real) == sizeof(float) 
+		? static_cast<Real>( ::strtof(digits,NULL) ) 
+		: static_cast<Real>( ::strtod(digits,NULL) );
+#endif
+}
 
 // ------------------------------------------------------------------------------------
 //! Provides a fast function for converting a string into a float,
 //! about 6 times faster than atof in win32.
 // If you find any bugs, please send them to me, niko (at) irrlicht3d.org.
+//
+// The result is the correctly rounded value, i.e. exactly what strtod() or strtof() 
+// would yield. Up to 19 significant digits are collected in an integer, which is 
+// then scaled by an exact power of ten (Clinger's fast path). Everything else, i.e.
+// numbers with more digits or a huge exponent, takes the slow path. If check_comma
+// is true, a comma followed by a digit is accepted as decimal separator, too.
 // ------------------------------------------------------------------------------------
 template <typename Real>
-inline const char* fast_atoreal_move( const char* c, Real& out)
+inline const char* fast_atoreal_move( const char* c, Real& out, bool check_comma = true)
 {
-	Real f;
-
 	bool inv = (*c=='-');
 	if (inv || *c=='+') {
 		++c;
 	}
+	const char* const digits = c;
 
-	f = static_cast<Real>( strtoul10_64 ( c, &c) );
-	if (*c == '.' || (c[0] == ',' && c[1] >= '0' && c[1] <= '9')) // allow for commas, too
-	{
-		++c;
-
-		// NOTE: The original implementation is highly inaccurate here. The precision of a single
-		// IEEE 754 float is not high enough, everything behind the 6th digit tends to be more 
-		// inaccurate than it would need to be. Casting to double seems to solve the problem.
-		// strtol_64 is used to prevent integer overflow.
-
-		// Another fix: this tends to become 0 for long numbers if we don't limit the maximum 
-		// number of digits to be read. AI_FAST_ATOF_RELAVANT_DECIMALS can be a value between
-		// 1 and 15.
-		unsigned int diff = AI_FAST_ATOF_RELAVANT_DECIMALS;
-		double pl = static_cast<double>( strtoul10_64 ( c, &c, &diff ));
+	// collect the significand: mant * 10^exp, truncated is set if digits got lost
+	uint64_t mant = 0;
+	unsigned int num = 0;
+	int exp = 0;
+	bool truncated = false;
 
-		pl *= fast_atof_table[diff];
-		f += static_cast<Real>( pl );
+	// leading zeros aren't significant
+	while (*c == '0') {
+		++c;
+	}
+	for (; *c >= '0' && *c <= '9'; ++c) {
+		if (num < 19) {
+			mant = mant * 10 + (*c - '0');
+			++num;
+		}
+		else {
+			truncated = truncated || *c != '0';
+			++exp;
+		}
+	}
+	if (*c == '.' || (check_comma && c[0] == ',' && c[1] >= '0' && c[1] <= '9')) {
+		++c;
+		if (!num) {
+			for (; *c == '0'; ++c) {
+				--exp;
+			}
+		}
+		for (; *c >= '0' && *c <= '9'; ++c) {
+			if (num < 19) {
+				mant = mant * 10 + (*c - '0');
+				++num;
+				--exp;
+			}
+			else {
+				truncated = truncated || *c != '0';
+			}
+		}
 	}
 
 	// A major 'E' must be allowed. Necessary for proper reading of some DXF files.
 	// Thanks to Zhao Lei to point out that this if() must be outside the if (*c == '.' ..)
+	int e = 0;
 	if (*c == 'e' || *c == 'E')	{
 
 		++c;
@@ -262,16 +324,42 @@ inline const char* fast_atoreal_move( const char* c, Real& out)
 			++c;
 		}
 
-		// The reason float constants are used here is that we've seen cases where compilers
-		// would perform such casts on compile-time constants at runtime, which would be
-		// bad considering how frequently fast_atoreal_move<float> is called in Assimp.
-		Real exp = static_cast<Real>( strtoul10_64(c, &c) );
+		// anything beyond that is zero or infinity anyway
+		for (; *c >= '0' && *c <= '9'; ++c) {
+			if (e < 100000) {
+				e = e * 10 + (*c - '0');
+			}
+		}
 		if (einv) {
-			exp = -exp;
+			e = -e;
 		}
-		f *= pow(static_cast<Real>(10.0f), exp);
 	}
 
+	static const double pow10[23] = {
+		1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+
+	// Clinger's fast path: both the significand and the power of ten are exact 
+	// doubles, so a single multiplication or division rounds correctly
+	const int scale = exp + e;
+	bool exact = false;
+	double d = 0.0;
+	if (!truncated && mant <= (1ull << 53) && scale >= -22 && scale <= 22) {
+		d = static_cast<double>(mant);
+		d = scale < 0 ? d / pow10[-scale] : d * pow10[scale];
+		exact = true;
+
+		if (sizeof(Real) == sizeof(float) && d != 0.0) {
+			// rounding the double to float once more gives the correctly rounded float, 
+			// unless the double is exactly half-way between two floats or a denormal
+			uint64_t bits;
+			::memcpy(&bits,&d,sizeof(bits));
+			exact = (bits & 0x1fffffff) != 0x10000000 && (bits & 0x7fffffffffffffffull) >= 0x3810000000000000ull;
+		}
+	}
+
+	Real f = exact ? static_cast<Real>(d) : fast_atoreal_exact<Real>(digits,check_comma,e);
 	if (inv) {
 		f = -f;
 	}
@@ -330,6 +418,79 @@ inline double fast_atod( const char** inout)
 	return ret;
 }
 
+
+// ------------------------------------------------------------------------------------
+// Bulk parsing of delimited numbers, e.g. the contents of a Collada <float_array>, 
+// the components of an OBJ 'v' line or a row of an ASCII PLY file. Numbers may be 
+// separated by spaces and tabs, by line breaks if lineBreaks is true and by any of
+// the characters in separators (i.e. ",;" for X files). Parsing stops at the first
+// token which isn't a number or after count numbers have been read.
+// The return value is the number of values read, c points past the last of them.
+// ------------------------------------------------------------------------------------
+inline bool fast_atof_span_skip( const char*& c, bool lineBreaks, const char* separators)
+{
+	for (;;++c) {
+		if (*c == ' ' || *c == '\t' || (lineBreaks && (*c == '\r' || *c == '\n'))) {
+			continue;
+		}
+		if (*separators && *c && ::strchr(separators,*c)) {
+			continue;
+		}
+		break;
+	}
+
+	// is this a number?
+	if (*c >= '0' && *c <= '9') {
+		return true;
+	}
+	const char* p = c;
+	if (*p == '-' || *p == '+') {
+		++p;
+	}
+	if (*p == '.') {
+		++p;
+	}
+	return *p >= '0' && *p <= '9';
+}
+
+template <typename Real>
+inline unsigned int fast_atoreal_span( const char*& c, Real* out, unsigned int count, 
+	bool lineBreaks = true, const char* separators = "")
+{
+	const bool check_comma = !::strchr(separators,',');
+	unsigned int i = 0;
+	for (; i < count && fast_atof_span_skip(c,lineBreaks,separators); ++i) {
+		c = fast_atoreal_move<Real>(c,out[i],check_comma);
+	}
+	return i;
+}
+
+inline unsigned int fast_atof_span( const char*& c, float* out, unsigned int count, 
+	bool lineBreaks = true, const char* separators = "")
+{
+	return fast_atoreal_span<float>(c,out,count,lineBreaks,separators);
+}
+
+inline unsigned int strtol10_span( const char*& c, int* out, unsigned int count, 
+	bool lineBreaks = true, const char* separators = "")
+{
+	unsigned int i = 0;
+	for (; i < count && fast_atof_span_skip(c,lineBreaks,separators) && *c != '.'; ++i) {
+		out[i] = strtol10(c,&c);
+	}
+	return i;
+}
+
+inline unsigned int strtoul10_span( const char*& c, unsigned int* out, unsigned int count, 
+	bool lineBreaks = true, const char* separators = "")
+{
+	unsigned int i = 0;
+	for (; i < count && fast_atof_span_skip(c,lineBreaks,separators) && *c >= '0' && *c <= '9'; ++i) {
+		out[i] = strtoul10(c,&c);
+	}
+	return i;
+}
+
 } // end of namespace Assimp
 
 #endif
@@ -0,0 +1,491 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+
+/** @file  fast_ftoa.h
+ *  @brief Locale-independent conversion of numbers to text, the counterpart
+ *    of fast_atof.h. 
+ *
+ *  fast_ftoa() and fast_dtoa() write the shortest decimal representation 
+ *  which reads back to exactly the same value (the digit generation is 
+ *  the 'free-format' algorithm by Burger and Dybvig). All functions write
+ *  to a raw character buffer and return a pointer past the last character
+ *  written, no terminating zero is appended. 
+ */
+
+#ifndef AI_FAST_FTOA_H_INCLUDED
+#define AI_FAST_FTOA_H_INCLUDED
+
+#include <string.h>
+#include "../include/assimp/types.h"
+#include "../include/assimp/assert.h"
+
+/** Size of a buffer which is sufficient for all functions in this file */
+#define AI_FAST_FTOA_BUFFER_SIZE 32
+
+namespace Assimp {
+namespace Intern {
+
+// ------------------------------------------------------------------------------------
+/** Minimal arbitrary-precision unsigned integer, just the operations needed by
+ *  the digit generation below. Big enough for all doubles. */
+struct FtoaBignum
+{
+	enum { MaxWords = 36 };
+
+	uint32_t w[MaxWords];
+	unsigned int n;
+
+	explicit FtoaBignum(uint64_t v = 0) : n() {
+		for (; v; v >>= 32) {
+			w[n++] = static_cast<uint32_t>(v);
+		}
+	}
+
+	void ShiftLeft(unsigned int bits) {
+		if (!n) {
+			return;
+		}
+		const unsigned int words = bits / 32, rest = bits % 32;
+		if (rest) {
+			uint32_t carry = 0;
+			for (unsigned int i = 0; i < n; ++i) {
+				const uint32_t v = w[i];
+				w[i] = (v << rest) | carry;
+				carry = v >> (32 - rest);
+			}
+			if (carry) {
+				w[n++] = carry;
+			}
+		}
+		if (words) {
+			for (unsigned int i = n; i--; ) {
+				w[i + words] = w[i];
+			}
+			for (unsigned int i = 0; i < words; ++i) {
+				w[i] = 0;
+			}
+			n += words;
+		}
+		ai_assert(n <= MaxWords);
+	}
+
+	void MulSmall(uint32_t f) {
+		uint64_t carry = 0;
+		for (unsigned int i = 0; i < n; ++i) {
+			carry += static_cast<uint64_t>(w[i]) * f;
+			w[i] = static_cast<uint32_t>(carry);
+			carry >>= 32;
+		}
+		if (carry) {
+			w[n++] = static_cast<uint32_t>(carry);
+		}
+		ai_assert(n <= MaxWords);
+	}
+
+	void Add(const FtoaBignum& o) {
+		uint64_t carry = 0;
+		unsigned int i = 0;
+		for (; i < o.n || (carry && i < n); ++i) {
+			carry += (i < n ? w[i] : 0);
+			carry += (i < o.n ? o.w[i] : 0);
+			w[i] = static_cast<uint32_t>(carry);
+			carry >>= 32;
+		}
+		if (i > n) {
+			n = i;
+		}
+		if (carry) {
+			w[n++] = static_cast<uint32_t>(carry);
+		}
+		ai_assert(n <= MaxWords);
+	}
+
+	// requires *this >= o
+	void Sub(const FtoaBignum& o) {
+		int64_t borrow = 0;
+		for (unsigned int i = 0; i < n; ++i) {
+			borrow += static_cast<int64_t>(w[i]) - (i < o.n ? o.w[i] : 0);
+			w[i] = static_cast<uint32_t>(borrow);
+			borrow = borrow < 0 ? -1 : 0;
+		}
+		while (n && !w[n-1]) {
+			--n;
+		}
+	}
+
+	static int Compare(const FtoaBignum& a, const FtoaBignum& b) {
+		if (a.n != b.n) {
+			return a.n < b.n ? -1 : 1;
+		}
+		for (unsigned int i = a.n; i--; ) {
+			if (a.w[i] != b.w[i]) {
+				return a.w[i] < b.w[i] ? -1 : 1;
+			}
+		}
+		return 0;
+	}
+};
+
+// ------------------------------------------------------------------------------------
+// The digit generation is written once for both uint64_t, which suffices
+// for most numbers, and FtoaBignum. These are the operations it needs.
+inline void FtoaSet(uint64_t& out, uint64_t v, unsigned int shift) {
+	out = v << shift;
+}
+
+inline void FtoaSet(FtoaBignum& out, uint64_t v, unsigned int shift) {
+	out = FtoaBignum(v);
+	out.ShiftLeft(shift);
+}
+
+inline void FtoaMulPow10(uint64_t& v, unsigned int exp) {
+	for (; exp; --exp) {
+		v *= 10;
+	}
+}
+
+inline void FtoaMulPow10(FtoaBignum& v, unsigned int exp) {
+	for (; exp >= 9; exp -= 9) {
+		v.MulSmall(1000000000u);
+	}
+	static const uint32_t pow10[9] = {1,10,100,1000,10000,100000,1000000,10000000,100000000};
+	if (exp) {
+		v.MulSmall(pow10[exp]);
+	}
+}
+
+inline int FtoaCompare(uint64_t a, uint64_t b) {
+	return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+inline int FtoaCompare(const FtoaBignum& a, const FtoaBignum& b) {
+	return FtoaBignum::Compare(a,b);
+}
+
+// compare a+b against c
+inline int FtoaCompareSum(uint64_t a, uint64_t b, uint64_t c) {
+	return FtoaCompare(a+b,c);
+}
+
+inline int FtoaCompareSum(const FtoaBignum& a, const FtoaBignum& b, const FtoaBignum& c) {
+	FtoaBignum sum = a;
+	sum.Add(b);
+	return FtoaBignum::Compare(sum,c);
+}
+
+// r = r*10, return r/s and keep the remainder in r
+inline unsigned int FtoaNextDigit(uint64_t& r, uint64_t s) {
+	r *= 10;
+	const unsigned int d = static_cast<unsigned int>(r / s);
+	r %= s;
+	return d;
+}
+
+inline unsigned int FtoaNextDigit(FtoaBignum& r, const FtoaBignum& s) {
+	r.MulSmall(10);
+	unsigned int d = 0;
+	while (FtoaBignum::Compare(r,s) >= 0) {
+		r.Sub(s);
+		++d;
+	}
+	return d;
+}
+
+// ------------------------------------------------------------------------------------
+/** Generate the shortest digit string which uniquely identifies m * 2^e.
+ *  The value is 0.digits * 10^k afterwards.
+ *  @param lowerCloser The next smaller floating-point number is closer than
+ *    the next larger one (m is a power of two)
+ *  @param k Estimate for the decimal exponent, corrected on return 
+ *  @return Number of digits written */
+template <typename T>
+unsigned int FtoaDigits(uint64_t m, int e, bool lowerCloser, int& k, char* digits)
+{
+	T r, s, mp, mm;
+
+	// the value is r/s, the neighbours are half-way at (r-mm)/s and (r+mp)/s
+	const unsigned int extra = lowerCloser ? 1 : 0;
+	if (e >= 0) {
+		FtoaSet(r,m,e+1+extra);
+		FtoaSet(s,2,extra);
+		FtoaSet(mp,1,e+extra);
+		FtoaSet(mm,1,e);
+	}
+	else {
+		FtoaSet(r,m,1+extra);
+		FtoaSet(s,1,1+extra-e);
+		FtoaSet(mp,1,extra);
+		FtoaSet(mm,1,0);
+	}
+
+	if (k >= 0) {
+		FtoaMulPow10(s,k);
+	}
+	else {
+		FtoaMulPow10(r,-k);
+		FtoaMulPow10(mp,-k);
+		FtoaMulPow10(mm,-k);
+	}
+
+	// the boundaries belong to the interval if m is even (round-half-even)
+	const bool even = !(m & 1);
+
+	// k might be one too small
+	if (FtoaCompareSum(r,mp,s) >= (even ? 0 : 1)) {
+		FtoaMulPow10(s,1);
+		++k;
+	}
+
+	unsigned int n = 0;
+	for (;;) {
+		unsigned int d = FtoaNextDigit(r,s);
+		FtoaMulPow10(mp,1);
+		FtoaMulPow10(mm,1);
+
+		const bool low  = FtoaCompare(r,mm) < (even ? 1 : 0);
+		const bool high = FtoaCompareSum(r,mp,s) >= (even ? 0 : 1);
+		if (!low && !high) {
+			digits[n++] = static_cast<char>('0' + d);
+			continue;
+		}
+
+		if (low && high) {
+			// both candidates are in range, take the closer one
+			const int c = FtoaCompareSum(r,r,s);
+			if (c > 0 || (c == 0 && (d & 1))) {
+				++d;
+			}
+		}
+		else if (high) {
+			++d;
+		}
+		digits[n++] = static_cast<char>('0' + d);
+		return n;
+	}
+}
+
+// ------------------------------------------------------------------------------------
+/** Write the finite value (-1)^sign * m * 2^e */
+inline char* FtoaFormat(char* out, bool sign, uint64_t m, int e, bool lowerCloser)
+{
+	if (sign) {
+		*out++ = '-';
+	}
+	if (!m) {
+		*out++ = '0';
+		return out;
+	}
+
+	unsigned int bits = 0;
+	for (uint64_t t = m; t; t >>= 1) {
+		++bits;
+	}
+
+	// estimate the decimal exponent as ceil(log10(2^b)), which is correct
+	// or one too small. (b * 78913) >> 18 is floor(b * log10(2)) for the
+	// range of exponents that matter here.
+	const int b = e + static_cast<int>(bits) - 1;
+	int k = b > 0 ? ((b * 78913) >> 18) + 1 : -((-b * 78913) >> 18);
+
+	// check whether everything stays within 64 bits - 107/32 is slightly more
+	// than log2(10) and 9 more bits cover the factor 10 and the sums.
+	int rBits = static_cast<int>(bits) + 2, sBits = 3;
+	if (e >= 0) {
+		rBits += e;
+	}
+	else {
+		sBits -= e;
+	}
+	if (k >= 0) {
+		sBits += (k * 107 + 31) / 32;
+	}
+	else {
+		rBits += (-k * 107 + 31) / 32;
+	}
+
+	char digits[24];
+	const unsigned int n = (rBits > sBits ? rBits : sBits) + 9 <= 64 
+		? FtoaDigits<uint64_t>(m,e,lowerCloser,k,digits)
+		: FtoaDigits<FtoaBignum>(m,e,lowerCloser,k,digits);
+
+	// same choice of notation as ECMAScript's Number.toString()
+	const int x = k - 1;
+	if (x >= -6 && x < 21) {
+		if (x < 0) {
+			*out++ = '0';
+			*out++ = '.';
+			for (int i = -1; i > x; --i) {
+				*out++ = '0';
+			}
+			::memcpy(out,digits,n);
+			return out + n;
+		}
+
+		const unsigned int ints = static_cast<unsigned int>(x) + 1;
+		if (n <= ints) {
+			::memcpy(out,digits,n);
+			out += n;
+			for (unsigned int i = n; i < ints; ++i) {
+				*out++ = '0';
+			}
+			return out;
+		}
+		::memcpy(out,digits,ints);
+		out += ints;
+		*out++ = '.';
+		::memcpy(out,digits+ints,n-ints);
+		return out + n - ints;
+	}
+
+	*out++ = digits[0];
+	if (n > 1) {
+		*out++ = '.';
+		::memcpy(out,digits+1,n-1);
+		out += n-1;
+	}
+	*out++ = 'e';
+	*out++ = x < 0 ? '-' : '+';
+
+	unsigned int ax = static_cast<unsigned int>(x < 0 ? -x : x);
+	if (ax >= 100) {
+		*out++ = static_cast<char>('0' + ax / 100);
+		ax %= 100;
+		*out++ = static_cast<char>('0' + ax / 10);
+	}
+	else if (ax >= 10) {
+		*out++ = static_cast<char>('0' + ax / 10);
+	}
+	*out++ = static_cast<char>('0' + ax % 10);
+	return out;
+}
+
+// ------------------------------------------------------------------------------------
+inline char* FtoaSpecial(char* out, bool sign, bool nan)
+{
+	if (nan) {
+		::memcpy(out,"nan",3);
+		return out + 3;
+	}
+	if (sign) {
+		*out++ = '-';
+	}
+	::memcpy(out,"inf",3);
+	return out + 3;
+}
+
+} // end namespace Intern
+
+// ------------------------------------------------------------------------------------
+/** Write an unsigned integer in decimal notation.
+ *  @return Pointer past the last character written */
+inline char* fast_utoa(char* out, uint64_t value)
+{
+	char tmp[20], *p = tmp + sizeof(tmp);
+	do {
+		*--p = static_cast<char>('0' + value % 10);
+		value /= 10;
+	}
+	while (value);
+
+	const size_t length = tmp + sizeof(tmp) - p;
+	::memcpy(out,p,length);
+	return out + length;
+}
+
+// ------------------------------------------------------------------------------------
+/** Write a signed integer in decimal notation.
+ *  @return Pointer past the last character written */
+inline char* fast_itoa(char* out, int64_t value)
+{
+	if (value < 0) {
+		*out++ = '-';
+
+		// negate in unsigned arithmetic to get INT64_MIN right
+		return fast_utoa(out,0ull - static_cast<uint64_t>(value));
+	}
+	return fast_utoa(out,static_cast<uint64_t>(value));
+}
+
+// ------------------------------------------------------------------------------------
+/** Write the shortest representation of a single-precision number which
+ *  reads back to the same value. Large and small magnitudes are written in
+ *  exponential notation (1.5e+30), infinities and NaNs as inf, -inf, nan.
+ *  @return Pointer past the last character written */
+inline char* fast_ftoa(char* out, float value)
+{
+	uint32_t bits;
+	::memcpy(&bits,&value,sizeof(bits));
+
+	const bool sign = (bits >> 31) != 0;
+	const uint32_t exp = (bits >> 23) & 0xff, frac = bits & 0x7fffff;
+	if (exp == 0xff) {
+		return Intern::FtoaSpecial(out,sign,frac != 0);
+	}
+	if (!exp) {
+		return Intern::FtoaFormat(out,sign,frac,-149,false);
+	}
+	return Intern::FtoaFormat(out,sign,frac | 0x800000,static_cast<int>(exp) - 150,!frac && exp > 1);
+}
+
+// ------------------------------------------------------------------------------------
+/** Write the shortest representation of a double-precision number which
+ *  reads back to the same value, see fast_ftoa().
+ *  @return Pointer past the last character written */
+inline char* fast_dtoa(char* out, double value)
+{
+	uint64_t bits;
+	::memcpy(&bits,&value,sizeof(bits));
+
+	const bool sign = (bits >> 63) != 0;
+	const uint64_t exp = (bits >> 52) & 0x7ff, frac = bits & 0xfffffffffffffull;
+	if (exp == 0x7ff) {
+		return Intern::FtoaSpecial(out,sign,frac != 0);
+	}
+	if (!exp) {
+		return Intern::FtoaFormat(out,sign,frac,-1074,false);
+	}
+	return Intern::FtoaFormat(out,sign,frac | 0x10000000000000ull,static_cast<int>(exp) - 1075,!frac && exp > 1);
+}
+
+} // end namespace Assimp
+
+#endif // !! AI_FAST_FTOA_H_INCLUDED
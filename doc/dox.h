@@ -429,6 +429,22 @@ void DoTheImportThing( const std::string& pFile)
 }
 @endcode
 
+If your streams keep the whole file in memory anyway (i.e. because they read from an archive or a network cache), 
+consider overriding IOStream::GetView() as well. Binary loaders then read the data in place instead of copying 
+it into a buffer of their own first.
+
+Files compressed with gzip are decompressed on the fly, on top of whatever IOSystem is in use. They are recognized by their 
+'.gz' suffix or the gzip magic number and loaded as if they had their uncompressed name, i.e. 'model.obj.gz' is loaded 
+by the OBJ loader. Files referenced by a model (such as material libraries) may be stored compressed as well, 
+'file.gz' is opened if 'file' doesn't exist. Decompression is streamed, so loaders which read sequentially never
+hold the whole decompressed file in memory.
+
+Files can also be loaded directly from zip archives by passing their path through the archive, such as 
+'models.zip/spider/spider.obj'. Files the loader looks up relative to the model (the material library 'spider.mtl' 
+in this case) are taken from the archive as well. Members are decompressed when they are first opened,
+files sharing the model's base name are decompressed along with it on the threads configured with 
+#AI_CONFIG_GLOB_MULTITHREADING.
+
 
 @section custom_io_c Using custom IO logic with the plain-c function interface
 
@@ -1245,12 +1261,28 @@ configuration switch to <tt>true</tt> (nonzero). Results are dumped to the log f
 an appropriate logger implementation with at least one output stream first (see the @link logging Logging Page @endlink
 for the details.). 
 
+The same results can be retrieved after the import via Assimp::Importer::GetProfilingReport() (or #aiGetProfilingReport() 
+for the C-API). The report is a tree of #aiProfilingRegion's: the root region covers the whole import, its children are the 
+importer itself, the preprocessing and the post-processing pipeline, which in turn contains one region per step that 
+ran. Each region holds the elapsed wall-clock and processor time as well as the total number of vertices and faces before 
+and after it. Assimp::Importer::GetProfilingReportAsJSON() returns the whole tree as JSON, which is convenient for 
+collecting timings from production systems.
+
+Heap usage can be measured, too, by setting <tt>GLOB_MEASURE_MEMORY</tt> (#AI_CONFIG_GLOB_MEASURE_MEMORY). Each region 
+then also reports its peak heap usage and the number and total size of the allocations made while it was open, and 
+#aiMemoryInfo::peak receives the peak of the whole import. Because this requires replacing the global operator 
+<tt>new</tt>, it is only available if assimp was built with <tt>ENABLE_MEMORY_TRACKING</tt> (which defines 
+<tt>ASSIMP_BUILD_MEMORY_TRACKING</tt>), otherwise a warning is logged and the counters remain zero. The option 
+requires a static build (<tt>BUILD_STATIC_LIB</tt>): a shared library replacing the operators after the process 
+has started would be handed blocks it didn't allocate.
+
 Note that these measurements are based on a single run of the importer and each of the post processing steps, so 
 a single result set is far away from being significant in a statistic sense. While precision can be improved
 by running the test multiple times, the low accuracy of the timings may render the results useless
 for smaller files.
 
-A sample report looks like this (some unrelated log messages omitted, entries grouped for clarity):
+A sample log looks like this (some unrelated log messages omitted, entries grouped for clarity). Newer versions
+name each post-processing region after its step and also log the processor time:
 
 @verbatim
 Debug, T5488: START `total`
@@ -1319,6 +1351,26 @@ time got consumed by the #aiProcess_Triangulate, #aiProcess_JoinIdenticalVertice
 postprocessing steps. A wise selection of postprocessing steps is therefore essential to getting good performance. 
 Of course this depends on the individual requirements of your application, in many of the typical use cases of assimp performance won't 
 matter (i.e. in an offline content pipeline).
+
+@section perf_fused Fused post processing
+
+Consecutive steps which work on each mesh independently (#aiProcess_Triangulate, #aiProcess_GenSmoothNormals,
+#aiProcess_CalcTangentSpace, #aiProcess_JoinIdenticalVertices, #aiProcess_LimitBoneWeights and
+#aiProcess_ImproveCacheLocality) are executed in a single pass: each mesh runs through all of them before the
+next one is touched, and the spatial sort tree of a mesh is built only once for all steps which need it. 
+Such a pass shows up as one region in profiling reports, named after the steps it contains (i.e. 
+<tt>GenVertexNormalsProcess+CalcTangentsProcess+JoinVerticesProcess</tt>). Set <tt>GLOB_FUSE_MESH_STEPS</tt> 
+(#AI_CONFIG_GLOB_FUSE_MESH_STEPS) to false to run and measure the steps separately.
+
+@section perf_cache Import cache
+
+Applications which load the same files over and over again (i.e. editors or asset pipelines) can let the library 
+keep the post-processed scenes on disk. If <tt>GLOB_IMPORT_CACHE</tt> (#AI_CONFIG_GLOB_IMPORT_CACHE) names an existing
+directory, #Assimp::Importer::ReadFile() looks for an entry matching the contents of the file, the post-processing flags
+and the importer properties there before it does anything else. On a hit the scene is read back in a fraction of the
+import time, on a miss the regular import result is stored for the next time. Each entry remembers all other files
+the loader has read, so changing a referenced file (i.e. the material library of an OBJ file) invalidates it. Both 
+lookup and storing show up as <tt>cache</tt> region in profiling reports.
 */
 
 /** 
@@ -1348,10 +1400,25 @@ Multiple concurrent imports may or may not be beneficial, however. For certain f
 little or no post processing IO times tend to be the performance bottleneck. Intense post processing together 
 with 'slow' file formats like X or Collada might scale well with multiple concurrent imports.  
 
+To import a whole list of files, use #Assimp::Importer::ReadFiles resp. #aiImportFilesExWithProperties. 
+These functions take care of creating the required #Assimp::Importer instances and distribute the files
+over a number of threads, which is determined by the <tt>#AI_CONFIG_GLOB_MULTITHREADING</tt> property.
+
 
 @section automt Internal threading
 
-Internal multi-threading is not currently implemented.
+If assimp is built with threading support (define <tt>ASSIMP_BUILD_MULTITHREADED</tt>, 
+resp. set <tt>ENABLE_MULTITHREADING</tt> when building with CMake, boost.thread is required then), 
+each #Assimp::Importer maintains a small pool of worker threads. It is used by post processing steps 
+which process each mesh independently - these are #aiProcess_JoinIdenticalVertices, #aiProcess_GenSmoothNormals,
+#aiProcess_CalcTangentSpace, #aiProcess_ImproveCacheLocality, #aiProcess_Triangulate and #aiProcess_LimitBoneWeights. 
+Scenes with many meshes benefit most, a scene consisting of a single mesh is still processed by a single thread.
+
+The number of threads is controlled by the <tt>#AI_CONFIG_GLOB_MULTITHREADING</tt> configuration property.
+By default, no extra threads are used, as every #Assimp::Importer gets a pool of its own and several
+concurrent imports would quickly end up with far more threads than cores. Set it to -1 to use one thread 
+per hardware thread, a value of 0 disables internal threading entirely.
+The results of an import don't depend on the number of threads used.
 */
 
 /**
@@ -1506,7 +1573,7 @@ guarded by a #define
 @endcode
 Wrap the same guard around your .cpp!</li>
 
-<li>Now advance to the <i>(register_new_importers_here)</i> line in the Importer.cpp and register your importer there - just like all the others do.</li>
+<li>Now advance to the <i>(register_new_importers_here)</i> line in ImporterRegistry.cpp and register a factory for your importer there - just like all the others do. Importers are instantiated on demand, so keep CanRead() free of per-instance state.</li>
 <li>Setup a suitable test environment (i.e. use AssimpView or your own application), make sure to enable 
 the #aiProcess_ValidateDataStructure flag and enable verbose logging. That is, simply call before you import anything:
 @code
@@ -1549,7 +1616,7 @@ store the properties as a member variable of your importer, they are thread safe
 except if the file format has a strict definition, in which case you should always warn about spec violations.
 But the general rule of thumb is <i>be strict in what you write and tolerant in what you accept</i>.</li>
 <li>Call Assimp::BaseImporter::ConvertToUTF8() before you parse anything to convert foreign encodings to UTF-8. 
- That's not necessary for XML importers, which must use the provided IrrXML for reading. </li>
+ That's not necessary for XML importers, which must use the provided XMLReader for reading. </li>
 </ul>
 
 @section bnote Notes for binary importers
@@ -1570,7 +1637,7 @@ Mixed stuff for internal use by loaders, mostly documented (most of them are alr
 <ul>
 <li><b>ByteSwap</b> (<i>ByteSwap.h</i>) - manual byte swapping stuff for binary loaders.</li>
 <li><b>StreamReader</b> (<i>StreamReader.h</i>) - safe, endianess-correct, binary reading.</li>
-<li><b>IrrXML</b> (<i>irrXMLWrapper.h</i>)  - for XML-parsing (SAX.</li>
+<li><b>XMLReader</b> (<i>XMLReader.h</i>)  - for XML-parsing (pull-style, in-place on a private copy of the file).</li>
 <li><b>CommentRemover</b> (<i>RemoveComments.h</i>) - remove single-line and multi-line comments from a text file.</li>
 <li>fast_atof, strtoul10, strtoul16, SkipSpaceAndLineEnd, SkipToNextToken .. large family of low-level 
 parsing functions, mostly declared in <i>fast_atof.h</i>, <i>StringComparison.h</i> and <i>ParsingUtils.h</i> (a collection that grew
@@ -116,6 +116,21 @@ public:
 	 *	See fflush() for more details.
 	 */
 	virtual void Flush() = 0;
+
+	// -------------------------------------------------------------------
+	/**	@brief Get read-only access to the whole file without copying it
+	 *
+	 *  Streams which keep the contents of the file in memory anyway (i.e.
+	 *  memory buffers or memory-mapped files) may return a pointer to 
+	 *  them. Readers use it instead of Read() to avoid another copy. The
+	 *  view starts at the beginning of the file, is FileSize() bytes long
+	 *  and remains valid until the stream is closed or written to. It 
+	 *  doesn't depend on or move the read cursor.
+	 *  @return Pointer to the first byte of the file. The default 
+	 *    implementation returns NULL, which tells readers to use Read(). */
+	virtual const void* GetView() const {
+		return NULL;
+	}
 }; //! class IOStream
 
 // ----------------------------------------------------------------------------------
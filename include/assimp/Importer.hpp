@@ -361,6 +361,8 @@ public:
 	 * A human-readable error description can be retrieved by calling 
 	 * GetErrorString(). The previous scene will be deleted during this call.
 	 * @param pFile Path and filename to the file to be imported.
+	 *   Files inside a zip archive are addressed by their path through
+	 *   the archive, i.e. 'models.zip/spider/spider.obj'.
 	 * @param pFlags Optional post processing steps to be executed after 
 	 *   a successful import. Provide a bitwise combination of the 
 	 *   #aiPostProcessSteps flags. If you wish to inspect the imported
@@ -419,6 +421,40 @@ public:
 		unsigned int pFlags,
 		const char* pHint = "");
 
+	// -------------------------------------------------------------------
+	/** Reads a list of files concurrently.
+	 *
+	 * Each file is read by a separate, temporary #Importer instance
+	 * which uses a copy of the configuration properties and the IOSystem
+	 * of this instance. If a custom IOSystem is set, it must be 
+	 * thread-safe: the same instance is used by all of these Importers,
+	 * i.e. from several threads at once, and it remains owned by this 
+	 * instance. Streams opened from it are used by one thread only. Up to #AI_CONFIG_GLOB_MULTITHREADING files are 
+	 * imported at the same time, see the @link threading Threading 
+	 * page@endlink for more information. The scene and error string 
+	 * of this instance are not affected.
+	 *
+	 * @param pFiles Array of pNumFiles paths to the files to be imported.
+	 * @param pNumFiles Number of files to be imported.
+	 * @param pFlags Optional post processing steps to be executed after 
+	 *   each successful import. Provide a bitwise combination of the 
+	 *   #aiPostProcessSteps flags.
+	 * @param pScenesOut Array of pNumFiles pointers to receive the 
+	 *   imported scenes, NULL for each file which failed to import.
+	 *   The caller takes ownership of the scenes and must delete 
+	 *   them, just as for #GetOrphanedScene().
+	 * @param pErrorsOut Optional array of pNumFiles strings to receive 
+	 *   the error description for each file, or an empty string if the
+	 *   import succeeded. 
+	 * @return Number of files which have been imported successfully.
+	 */
+	unsigned int ReadFiles(
+		const char* const* pFiles,
+		unsigned int pNumFiles,
+		unsigned int pFlags,
+		aiScene** pScenesOut,
+		std::string* pErrorsOut = NULL);
+
 	// -------------------------------------------------------------------
 	/** Apply post-processing to an already-imported scene.
 	 *
@@ -559,6 +595,30 @@ public:
 	 *   is (naturally) not included.*/
 	void GetMemoryRequirements(aiMemoryInfo& in) const;
 
+	// -------------------------------------------------------------------
+	/** Returns the timings of the last call to #ReadFile() or 
+	 *  #ApplyPostProcessing().
+	 *
+	 * The report is only recorded if #AI_CONFIG_GLOB_MEASURE_TIME is
+	 * set. Its root region covers the whole call, with child regions for 
+	 * the importer, the preprocessing and every single post-processing
+	 * step that ran.
+	 * @return Root region of the report or NULL if there is none. The
+	 *   report is owned by the Importer and remains valid until
+	 *   #ReadFile() or #ApplyPostProcessing() are called again. */
+	const aiProfilingRegion* GetProfilingReport() const;
+
+	// -------------------------------------------------------------------
+	/** Returns the report from #GetProfilingReport() as JSON.
+	 *
+	 * Each region is an object with the keys 'name', 'wall_time' and 
+	 * 'cpu_time' (seconds), 'vertices_before', 'vertices_after',
+	 * 'faces_before', 'faces_after', 'peak_memory', 'allocated_memory'
+	 * (bytes), 'allocations' and 'children'.
+	 * @return JSON text, an empty string if there is no report. It 
+	 *   remains valid as long as the report does. */
+	const char* GetProfilingReportAsJSON() const;
+
 	// -------------------------------------------------------------------
 	/** Enables "extra verbose" mode. 
 	 *
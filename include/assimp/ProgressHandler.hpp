@@ -77,7 +77,10 @@ public:
 	 *   occasion (loaders and Assimp are generally allowed to perform
 	 *   all needed cleanup tasks prior to returning control to the
 	 *   caller). If the loading is aborted, #Importer::ReadFile()
-	 *   returns always NULL.
+	 *   returns always NULL. Assimp calls Update() between all stages
+	 *   of an import and regularly from within some long-running 
+	 *   loaders and post-processing steps. See also 
+	 *   #AI_CONFIG_GLOB_TIME_LIMIT.
 	 *
 	 *  @note Currently, percentage is always -1.f because there is 
 	 *   no reliable way to compute it.
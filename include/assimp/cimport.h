@@ -147,6 +147,40 @@ ASSIMP_API const C_STRUCT aiScene* aiImportFileExWithProperties(
 	C_STRUCT aiFileIO* pFS,
 	const C_STRUCT aiPropertyStore* pProps);
 
+// --------------------------------------------------------------------------------
+/** Reads a list of files concurrently.
+ *
+ * This is equivalent to calling #aiImportFileExWithProperties for each file, 
+ * except that up to #AI_CONFIG_GLOB_MULTITHREADING files are imported at the 
+ * same time. Each imported scene must be released with aiReleaseImport().
+ * @param pFiles Array of pNumFiles paths of the files to be imported.
+ * @param pNumFiles Number of files to be imported.
+ * @param pFlags Optional post processing steps to be executed after 
+ *   each successful import. Provide a bitwise combination of the 
+ *   #aiPostProcessSteps flags.
+ * @param pFS aiFileIO structure to be used for all imports, pass NULL to use
+ *   the default implementation. Note that the functions must be thread-safe,
+ *   they are called from several threads at once. Each file opened through
+ *   it is used by a single thread only.
+ * @param pProps #aiPropertyStore instance containing import settings for all
+ *   imports, may be NULL. 
+ * @param pScenesOut Array of pNumFiles pointers to receive the imported scenes,
+ *   NULL for each file which failed to import. All entries are initialized,
+ *   even if the function fails, so all non-NULL scenes can be released.
+ * @param pErrorsOut Optional array of pNumFiles strings to receive the error 
+ *   description for each file, or an empty string if the import succeeded. 
+ *   #aiGetErrorString() returns the error of the first file that failed.
+ * @return Number of files which have been imported successfully.
+ */
+ASSIMP_API unsigned int aiImportFilesExWithProperties( 
+	const char* const* pFiles,
+	unsigned int pNumFiles,
+	unsigned int pFlags,
+	C_STRUCT aiFileIO* pFS,
+	const C_STRUCT aiPropertyStore* pProps,
+	const C_STRUCT aiScene** pScenesOut,
+	C_STRUCT aiString* pErrorsOut);
+
 // --------------------------------------------------------------------------------
 /** Reads the given file from a given memory buffer,
  * 
@@ -330,6 +364,25 @@ ASSIMP_API void aiGetMemoryRequirements(
 	const C_STRUCT aiScene* pIn,
 	C_STRUCT aiMemoryInfo* in);
 
+// --------------------------------------------------------------------------------
+/** Get the timings recorded for an imported asset, see 
+ * #AI_CONFIG_GLOB_MEASURE_TIME.
+ * @param pIn Input asset.
+ * @return Root region of the report or NULL if there is none. The report 
+ *   is released together with the asset.
+ */
+ASSIMP_API const C_STRUCT aiProfilingRegion* aiGetProfilingReport(
+	const C_STRUCT aiScene* pIn);
+
+// --------------------------------------------------------------------------------
+/** Get the timings recorded for an imported asset as JSON.
+ * @param pIn Input asset.
+ * @return JSON text, see Importer::GetProfilingReportAsJSON(). NULL if the
+ *   asset is unknown. The string is released together with the asset.
+ */
+ASSIMP_API const char* aiGetProfilingReportAsJSON(
+	const C_STRUCT aiScene* pIn);
+
 
 
 // --------------------------------------------------------------------------------
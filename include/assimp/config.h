@@ -69,7 +69,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *
  *  If enabled, measures the time needed for each part of the loading
  *  process (i.e. IO time, importing, postprocessing, ..) and dumps
- *  these timings to the DefaultLogger. See the @link perf Performance
+ *  these timings to the DefaultLogger. The timings are also available
+ *  from Importer::GetProfilingReport(). See the @link perf Performance
  *  Page@endlink for more information on this topic.
  * 
  * Property type: bool. Default value: false.
@@ -77,26 +78,143 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_CONFIG_GLOB_MEASURE_TIME  \
 	"GLOB_MEASURE_TIME"
 
-# if 0 // not implemented yet
+// ---------------------------------------------------------------------------
+/** @brief Enables heap usage measurements.
+ *
+ *  If enabled, counts the heap allocations made during the import, 
+ *  including all temporary data of the loaders and post-processing steps.
+ *  Peak usage, allocated bytes and the number of allocations are added to
+ *  each region of the profiling report (see #AI_CONFIG_GLOB_MEASURE_TIME),
+ *  the peak usage is also returned by Importer::GetMemoryRequirements().
+ *
+ *  This is only available if assimp has been built with
+ *  ASSIMP_BUILD_MEMORY_TRACKING (CMake option ENABLE_MEMORY_TRACKING),
+ *  which replaces the global operator new and delete. Because this affects
+ *  the whole process, it is only supported for static builds of assimp
+ *  (BUILD_STATIC_LIB), the replacement must be in place before anything 
+ *  is allocated.
+ * 
+ * Property type: bool. Default value: false.
+ */
+#define AI_CONFIG_GLOB_MEASURE_MEMORY  \
+	"GLOB_MEASURE_MEMORY"
+
+// ---------------------------------------------------------------------------
+/** @brief Sets a wall-clock time limit for imports, in milliseconds.
+ *
+ *  An import which takes longer is aborted as if the #ProgressHandler had 
+ *  returned false: Importer::ReadFile() fails and the error string tells
+ *  that the time limit was exceeded. Loaders and post-processing steps 
+ *  check the limit regularly, so they stop shortly after it has passed.
+ *  The limit covers post-processing, Importer::ApplyPostProcessing() 
+ *  starts a new one when called on its own.
+ *
+ * Property type: int. Default value: 0 (no limit).
+ */
+#define AI_CONFIG_GLOB_TIME_LIMIT  \
+	"GLOB_TIME_LIMIT"
+
 // ---------------------------------------------------------------------------
 /** @brief Set Assimp's multithreading policy.
  *
  * This setting is ignored if Assimp was built without boost.thread
- * support (ASSIMP_BUILD_NO_THREADING, which is implied by ASSIMP_BUILD_BOOST_WORKAROUND).
- * Possible values are: -1 to let Assimp decide what to do, 0 to disable
+ * support (ASSIMP_BUILD_SINGLETHREADED, which is implied by ASSIMP_BUILD_BOOST_WORKAROUND).
+ * Possible values are: -1 to use one thread per hardware thread, 0 to disable
  * multithreading entirely and any number larger than 0 to force a specific
  * number of threads. Assimp is always free to ignore this settings, which is
- * merely a hint. Usually, the default value (-1) will be fine. However, if
- * Assimp is used concurrently from multiple user threads, it might be useful
- * to limit each Importer instance to a specific number of cores.
+ * merely a hint. Every Importer instance (and every file of a batch import)
+ * gets threads of its own, so a process running many imports concurrently
+ * would end up with far more threads than cores if each of them used -1. 
+ * The default value is thus AI_MULTITHREADING_DEFAULT (1, no extra threads), 
+ * which may be altered at compile-time.
+ *
+ * Currently, the threads are used by post processing steps which work on
+ * each mesh independently (i.e. #aiProcess_JoinIdenticalVertices, 
+ * #aiProcess_GenSmoothNormals, #aiProcess_CalcTangentSpace, 
+ * #aiProcess_ImproveCacheLocality, #aiProcess_Triangulate and
+ * #aiProcess_LimitBoneWeights). Members of zip archives (see 
+ * #Importer::ReadFile) are decompressed on them as well, and large
+ * OBJ files are parsed in parallel.
  *
  * For more information, see the @link threading Threading page@endlink.
- * Property type: int, default value: -1.
+ * Property type: int, default value: AI_MULTITHREADING_DEFAULT.
  */
 #define AI_CONFIG_GLOB_MULTITHREADING  \
 	"GLOB_MULTITHREADING"
+
+// default number of threads per Importer
+#if (!defined AI_MULTITHREADING_DEFAULT)
+#	define AI_MULTITHREADING_DEFAULT	1
 #endif
 
+// ---------------------------------------------------------------------------
+/** @brief Run consecutive per-mesh post processing steps in a single pass.
+ *
+ *  The steps which work on each mesh independently (see 
+ *  #AI_CONFIG_GLOB_MULTITHREADING) usually run one after another, each 
+ *  of them walking over all meshes. If enabled, consecutive steps of this
+ *  kind are fused: each mesh passes through all of them before the next 
+ *  mesh is processed, and the steps share derived data such as the
+ *  spatial sort tree of the vertices. The results are the same either way.
+ *  Disabling this may be useful to get separate timings for each step 
+ *  (see #AI_CONFIG_GLOB_MEASURE_TIME). 
+ *
+ * Property type: bool. Default value: true.
+ */
+#define AI_CONFIG_GLOB_FUSE_MESH_STEPS  \
+	"GLOB_FUSE_MESH_STEPS"
+
+// ---------------------------------------------------------------------------
+/** @brief Size from which on the default IOSystem memory-maps files.
+ *
+ *  Files opened for reading through the default IOSystem which are at 
+ *  least this many bytes large are mapped into memory instead of being 
+ *  read with the C runtime's file functions. The operating system then
+ *  pages them in as they are read and no copy of them is kept in the C
+ *  runtime's buffers. Use 0 to map all files and -1 to never map files.
+ *  The setting has no effect if a custom IOSystem is set or if the
+ *  platform doesn't support memory mappings.
+ *
+ *  Binary loaders which read through StreamReader parse the mapped file
+ *  in place. Most text loaders copy the whole file into a buffer of their 
+ *  own, so for them mapping only saves the C runtime's buffering.
+ *
+ *  Beware that a mapped file must not be truncated while it is being
+ *  imported. On POSIX systems, if another process shrinks it, reading
+ *  the missing part raises SIGBUS and terminates the application, 
+ *  instead of the loader failing with a 'file is truncated' error.
+ *  (Windows doesn't allow truncating mapped files.) For this reason,
+ *  files are only mapped on request. Don't enable it if input files 
+ *  may be modified concurrently.
+ *
+ * Property type: int. Default value: -1 (never map files).
+ */
+#define AI_CONFIG_GLOB_MEMORY_MAPPING  \
+	"GLOB_MEMORY_MAPPING"
+
+// ---------------------------------------------------------------------------
+/** @brief Keep post-processed scenes in an on-disk cache.
+ *
+ *  Specifies an existing directory to store the results of 
+ *  Importer::ReadFile() in. If the same file is read again with the same
+ *  post-processing flags and importer properties, the scene is loaded from
+ *  there instead of being imported and post-processed again. Entries are 
+ *  keyed on the contents and the absolute path of the file. They are 
+ *  discarded if any other file read by the loader has changed since (i.e.
+ *  material libraries), or if a file the loader looked for in vain has
+ *  been added. Importer::ApplyPostProcessing() doesn't use the
+ *  cache. Properties which don't affect the scene, such as
+ *  #AI_CONFIG_GLOB_MEASURE_TIME or #AI_CONFIG_GLOB_MULTITHREADING, are
+ *  ignored when looking for an entry.
+ *
+ *  Entries are only valid for the build of the library which wrote them.
+ *  The directory is never cleaned up by Assimp.
+ *
+ * Property type: string. Default value: empty (no cache).
+ */
+#define AI_CONFIG_GLOB_IMPORT_CACHE  \
+	"GLOB_IMPORT_CACHE"
+
 // ###########################################################################
 // POST PROCESSING SETTINGS
 // Various stuff to fine-tune the behavior of a specific post processing step.
@@ -686,6 +804,27 @@ enum aiComponent
 #define AI_CONFIG_IMPORT_OGRE_MATERIAL_FILE "IMPORT_OGRE_MATERIAL_FILE"
 
 
+// ---------------------------------------------------------------------------
+/** @brief Specifies which libraries of a Collada file are skipped.
+ *
+ * Skipped libraries are jumped over by the XML reader without being parsed,
+ * which makes e.g. a geometry-only preview of a file with large animation
+ * libraries much cheaper. The property is a bitwise combination of the 
+ * following #aiComponent flags, others are ignored:
+ * <ul>
+ * <li>#aiComponent_ANIMATIONS - library_animations, no animations are generated</li>
+ * <li>#aiComponent_BONEWEIGHTS - the skins in library_controllers, skinned 
+ *   meshes are loaded without bones</li>
+ * <li>#aiComponent_TEXTURES - library_images, materials don't reference 
+ *   any textures</li>
+ * <li>#aiComponent_LIGHTS - library_lights</li>
+ * <li>#aiComponent_CAMERAS - library_cameras</li>
+ * </ul>
+ * Property type: integer. Default value: 0
+ */
+#define AI_CONFIG_IMPORT_COLLADA_SKIP_LIBRARIES "IMPORT_COLLADA_SKIP_LIBRARIES"
+
+
 // ---------------------------------------------------------------------------
 /** @brief Specifies whether the IFC loader skips over IfcSpace elements.
  *
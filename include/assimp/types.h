@@ -456,6 +456,7 @@ struct aiMemoryInfo
 		, cameras	 (0)
 		, lights	 (0)
 		, total      (0)
+		, peak       (0)
 	{}
 
 #endif
@@ -483,8 +484,79 @@ struct aiMemoryInfo
 
 	/** Total storage allocated for the full import. */
 	unsigned int total;
+
+	/** Peak heap usage during the import, including all temporary data. 
+	 *  Only measured if #AI_CONFIG_GLOB_MEASURE_MEMORY is set, 0 otherwise.
+	 *  Clamped to UINT_MAX, see aiProfilingRegion::mPeakMemory for the full value. */
+	unsigned int peak;
 }; // !struct aiMemoryInfo 
 
+// ----------------------------------------------------------------------------------
+/** Timings and mesh statistics for one part of an import, i.e. the importer 
+ *  itself or a single post-processing step. Regions are nested, the root 
+ *  region covers the whole import. Only available if #AI_CONFIG_GLOB_MEASURE_TIME
+ *  is set. 
+ *  @see Importer::GetProfilingReport()
+*/
+struct aiProfilingRegion
+{
+#ifdef __cplusplus
+
+	/** Default constructor */
+	aiProfilingRegion()
+		: mWallTime          (0.)
+		, mCpuTime           (0.)
+		, mNumVerticesBefore (0)
+		, mNumVerticesAfter  (0)
+		, mNumFacesBefore    (0)
+		, mNumFacesAfter     (0)
+		, mPeakMemory        (0)
+		, mAllocatedMemory   (0)
+		, mNumAllocations    (0)
+		, mNumChildren       (0)
+		, mChildren          (NULL)
+	{}
+
+	/** Destructor, deletes all children */
+	~aiProfilingRegion()
+	{
+		for (unsigned int i = 0; i < mNumChildren; ++i) {
+			delete mChildren[i];
+		}
+		delete[] mChildren;
+	}
+
+#endif
+
+	/** Name of the region, e.g. 'import' or the name of a post-processing step */
+	C_STRUCT aiString mName;
+
+	/** Elapsed real time, in seconds */
+	double mWallTime;
+
+	/** Processor time consumed by the whole process meanwhile, in seconds.
+	 *  This includes all threads, so it can exceed mWallTime. */
+	double mCpuTime;
+
+	/** Total number of vertices and faces in all meshes of the scene 
+	 *  when the region was entered and left. */
+	unsigned int mNumVerticesBefore, mNumVerticesAfter;
+	unsigned int mNumFacesBefore, mNumFacesAfter;
+
+	/** Heap usage, only measured if #AI_CONFIG_GLOB_MEASURE_MEMORY is set.
+	 *  mPeakMemory is the highest number of bytes allocated during the 
+	 *  import and not yet released at any point within the region.
+	 *  mAllocatedMemory and mNumAllocations count all allocations made 
+	 *  within the region. */
+	size_t mPeakMemory;
+	size_t mAllocatedMemory;
+	size_t mNumAllocations;
+
+	/** Nested regions, in the order they were entered */
+	unsigned int mNumChildren;
+	C_STRUCT aiProfilingRegion** mChildren;
+}; // !struct aiProfilingRegion 
+
 #ifdef __cplusplus
 }
 #endif //!  __cplusplus
@@ -0,0 +1,86 @@
+
+#include "UnitTestPCH.h"
+#include "utColladaImport.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (ColladaImportTest);
+
+// ------------------------------------------------------------------------------------------------
+void ColladaImportTest::setUp (void)
+{
+	mReference = new Importer();
+
+	// make sure the test model really has bones and animations to skip
+	const aiScene* scene = Import(*mReference,0);
+	CPPUNIT_ASSERT(1 == scene->mNumAnimations);
+	CPPUNIT_ASSERT(1 == scene->mNumMeshes && 2 == scene->mMeshes[0]->mNumBones);
+}
+
+// ------------------------------------------------------------------------------------------------
+void ColladaImportTest::tearDown (void)
+{
+	delete mReference;
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiScene* ColladaImportTest::Import(Importer& imp, int skipLibraries)
+{
+	imp.SetPropertyInteger(AI_CONFIG_IMPORT_COLLADA_SKIP_LIBRARIES,skipLibraries);
+	const aiScene* scene = imp.ReadFile("../../test/models/Collada/cube_skinned_animated.dae",0);
+	CPPUNIT_ASSERT(NULL != scene);
+	return scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ColladaImportTest::CompareGeometry(const aiScene* a, const aiScene* b)
+{
+	CPPUNIT_ASSERT(a->mNumMeshes == b->mNumMeshes);
+	for (unsigned int i = 0; i < a->mNumMeshes; ++i) {
+		const aiMesh* ma = a->mMeshes[i], *mb = b->mMeshes[i];
+
+		CPPUNIT_ASSERT(ma->mNumVertices == mb->mNumVertices);
+		CPPUNIT_ASSERT(ma->mNumFaces == mb->mNumFaces);
+		for (unsigned int v = 0; v < ma->mNumVertices; ++v) {
+			CPPUNIT_ASSERT(ma->mVertices[v] == mb->mVertices[v]);
+		}
+		for (unsigned int f = 0; f < ma->mNumFaces; ++f) {
+			CPPUNIT_ASSERT(ma->mFaces[f].mNumIndices == mb->mFaces[f].mNumIndices);
+			CPPUNIT_ASSERT(0 == ::memcmp(ma->mFaces[f].mIndices,mb->mFaces[f].mIndices,
+				ma->mFaces[f].mNumIndices * sizeof(unsigned int)));
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void ColladaImportTest::testSkipAnimations (void)
+{
+	Importer imp;
+	const aiScene* scene = Import(imp,aiComponent_ANIMATIONS);
+
+	CPPUNIT_ASSERT(0 == scene->mNumAnimations);
+	CPPUNIT_ASSERT(2 == scene->mMeshes[0]->mNumBones);
+	CompareGeometry(scene,mReference->GetScene());
+}
+
+// ------------------------------------------------------------------------------------------------
+void ColladaImportTest::testSkipBoneWeights (void)
+{
+	Importer imp;
+	const aiScene* scene = Import(imp,aiComponent_BONEWEIGHTS);
+
+	CPPUNIT_ASSERT(1 == scene->mNumAnimations);
+	CPPUNIT_ASSERT(!scene->mMeshes[0]->HasBones());
+	CompareGeometry(scene,mReference->GetScene());
+}
+
+// ------------------------------------------------------------------------------------------------
+void ColladaImportTest::testSkipBoth (void)
+{
+	Importer imp;
+	const aiScene* scene = Import(imp,aiComponent_ANIMATIONS | aiComponent_BONEWEIGHTS);
+
+	CPPUNIT_ASSERT(0 == scene->mNumAnimations);
+	for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+		CPPUNIT_ASSERT(!scene->mMeshes[i]->HasBones());
+	}
+	CompareGeometry(scene,mReference->GetScene());
+}
@@ -0,0 +1,41 @@
+#ifndef TESTCOLLADAIMPORT_H
+#define TESTCOLLADAIMPORT_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <assimp/Importer.hpp>
+
+using namespace std;
+using namespace Assimp;
+
+class ColladaImportTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (ColladaImportTest);
+    CPPUNIT_TEST (testSkipAnimations);
+    CPPUNIT_TEST (testSkipBoneWeights);
+    CPPUNIT_TEST (testSkipBoth);
+    CPPUNIT_TEST_SUITE_END ();
+
+    public:
+        void setUp (void);
+        void tearDown (void);
+
+    protected:
+
+        void testSkipAnimations (void);
+        void testSkipBoneWeights (void);
+        void testSkipBoth (void);
+
+    private:
+
+        // import the skinned, animated test model skipping the given libraries
+        const aiScene* Import(Importer& imp, int skipLibraries);
+
+        // check that both scenes contain the same geometry
+        static void CompareGeometry(const aiScene* a, const aiScene* b);
+
+        Importer* mReference;
+};
+
+#endif 
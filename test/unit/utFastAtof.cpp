@@ -0,0 +1,246 @@
+
+#include "UnitTestPCH.h"
+#include "utFastAtof.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (FastAtofTest);
+
+// ------------------------------------------------------------------------------------------------
+void FastAtofTest::setUp (void)
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+void FastAtofTest::tearDown (void)
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+void FastAtofTest::CheckExact(const char* number)
+{
+	float f;
+	const char* end = fast_atoreal_move<float>(number,f);
+	CPPUNIT_ASSERT(*end == '\0');
+
+	const float fref = ::strtof(number,NULL);
+	CPPUNIT_ASSERT_MESSAGE(number,0 == ::memcmp(&f,&fref,sizeof(float)));
+
+	double d;
+	end = fast_atoreal_move<double>(number,d);
+	CPPUNIT_ASSERT(*end == '\0');
+
+	const double dref = ::strtod(number,NULL);
+	CPPUNIT_ASSERT_MESSAGE(number,0 == ::memcmp(&d,&dref,sizeof(double)));
+}
+
+// ------------------------------------------------------------------------------------------------
+void FastAtofTest::testSpanSeparators (void)
+{
+	float out[4] = {0.f,0.f,0.f,0.f};
+
+	// blanks and tabs always separate numbers
+	const char* c = " 1 \t2\t 3 ";
+	CPPUNIT_ASSERT(3 == fast_atof_span(c,out,4));
+	CPPUNIT_ASSERT(out[0] == 1.f && out[1] == 2.f && out[2] == 3.f);
+
+	// so do the given separator characters, in any number and order
+	c = "1.5;2.5,;3.5;";
+	CPPUNIT_ASSERT(3 == fast_atof_span(c,out,4,false,",;"));
+	CPPUNIT_ASSERT(out[0] == 1.5f && out[1] == 2.5f && out[2] == 3.5f);
+	CPPUNIT_ASSERT(*c == '\0');
+
+	// but not without them
+	c = "1.5;2.5";
+	CPPUNIT_ASSERT(1 == fast_atof_span(c,out,4,false));
+	CPPUNIT_ASSERT(*c == ';');
+
+	// count limits the number of values read, c points right after the last one
+	c = "1 2 3 4";
+	CPPUNIT_ASSERT(2 == fast_atof_span(c,out,2));
+	CPPUNIT_ASSERT(0 == ::strcmp(c," 3 4"));
+
+	int iout[3];
+	c = "-1,2,+3";
+	CPPUNIT_ASSERT(3 == strtol10_span(c,iout,3,false,","));
+	CPPUNIT_ASSERT(iout[0] == -1 && iout[1] == 2 && iout[2] == 3);
+
+	unsigned int uout[3];
+	c = "7;8;9";
+	CPPUNIT_ASSERT(3 == strtoul10_span(c,uout,3,false,";"));
+	CPPUNIT_ASSERT(uout[0] == 7 && uout[1] == 8 && uout[2] == 9);
+}
+
+// ------------------------------------------------------------------------------------------------
+void FastAtofTest::testSpanLineBreaks (void)
+{
+	float out[4];
+
+	const char* c = "1 2\r\n3\n4";
+	CPPUNIT_ASSERT(4 == fast_atof_span(c,out,4,true));
+	CPPUNIT_ASSERT(out[2] == 3.f && out[3] == 4.f);
+
+	// without lineBreaks the span ends at the end of the line
+	c = "1 2\r\n3\n4";
+	CPPUNIT_ASSERT(2 == fast_atof_span(c,out,4,false));
+	CPPUNIT_ASSERT(*c == '\r');
+
+	unsigned int uout[4];
+	c = "1\n2";
+	CPPUNIT_ASSERT(1 == strtoul10_span(c,uout,4,false));
+	CPPUNIT_ASSERT(*c == '\n');
+	CPPUNIT_ASSERT(2 == strtoul10_span(c = "1\n2",uout,4,true));
+}
+
+// ------------------------------------------------------------------------------------------------
+void FastAtofTest::testSpanStopAtNonNumber (void)
+{
+	float out[4];
+
+	// the first token which isn't a number ends the span, c points to it
+	const char* c = "1 2 foo 3";
+	CPPUNIT_ASSERT(2 == fast_atof_span(c,out,4));
+	CPPUNIT_ASSERT(0 == ::strncmp(c,"foo",3));
+
+	// a sign or a decimal point alone is no number
+	c = "1 - 2";
+	CPPUNIT_ASSERT(1 == fast_atof_span(c,out,4));
+	CPPUNIT_ASSERT(*c == '-');
+
+	c = "1 . 2";
+	CPPUNIT_ASSERT(1 == fast_atof_span(c,out,4));
+	CPPUNIT_ASSERT(*c == '.');
+
+	// but a number may start with either
+	c = ".5 -.25 +1e2 -0";
+	CPPUNIT_ASSERT(4 == fast_atof_span(c,out,4));
+	CPPUNIT_ASSERT(out[0] == .5f && out[1] == -.25f && out[2] == 100.f && out[3] == 0.f);
+
+	// integers stop at anything which isn't an integer, even in the middle of a number
+	int iout[4];
+	c = "1 2.5 3";
+	CPPUNIT_ASSERT(2 == strtol10_span(c,iout,4));
+	CPPUNIT_ASSERT(0 == ::strcmp(c,".5 3"));
+
+	c = "1 .5";
+	CPPUNIT_ASSERT(1 == strtol10_span(c,iout,4));
+	CPPUNIT_ASSERT(*c == '.');
+
+	unsigned int uout[4];
+	c = "1 -2";
+	CPPUNIT_ASSERT(1 == strtoul10_span(c,uout,4));
+	CPPUNIT_ASSERT(*c == '-');
+
+	// nothing at all
+	c = "";
+	CPPUNIT_ASSERT(0 == fast_atof_span(c,out,4));
+	CPPUNIT_ASSERT(*c == '\0');
+}
+
+// ------------------------------------------------------------------------------------------------
+void FastAtofTest::testCheckComma (void)
+{
+	float f;
+
+	// a comma followed by a digit is a decimal separator if check_comma is set
+	const char* c = fast_atoreal_move<float>("1,5",f,true);
+	CPPUNIT_ASSERT(f == 1.5f && *c == '\0');
+
+	c = fast_atoreal_move<float>("1,5",f,false);
+	CPPUNIT_ASSERT(f == 1.f && *c == ',');
+
+	// but not if no digit follows
+	c = fast_atoreal_move<float>("1, 5",f,true);
+	CPPUNIT_ASSERT(f == 1.f && *c == ',');
+
+	// the same applies to the slow path
+	c = fast_atoreal_move<float>("1,00000000000000000000000000001",f,true);
+	CPPUNIT_ASSERT(f == 1.f && *c == '\0');
+
+	c = fast_atoreal_move<float>("1,00000000000000000000000000001",f,false);
+	CPPUNIT_ASSERT(f == 1.f && *c == ',');
+
+	// spans don't take a comma as decimal separator if it is a separator itself
+	float out[2];
+	c = "1,5";
+	CPPUNIT_ASSERT(2 == fast_atof_span(c,out,2,false,","));
+	CPPUNIT_ASSERT(out[0] == 1.f && out[1] == 5.f);
+
+	c = "1,5";
+	CPPUNIT_ASSERT(1 == fast_atof_span(c,out,2,false));
+	CPPUNIT_ASSERT(out[0] == 1.5f);
+}
+
+// ------------------------------------------------------------------------------------------------
+void FastAtofTest::testSlowPath (void)
+{
+	// more than 19 significant digits
+	CheckExact("3.14159265358979323846264338327950288");
+	CheckExact("123456789012345678901234567890");
+	CheckExact("0.000000000000000000000000000000123456789012345678901");
+	CheckExact("1.00000000000000000000000000000000000000000000000000000000000000001");
+
+	// exponents beyond the exact powers of ten
+	CheckExact("1e23");
+	CheckExact("1e300");
+	CheckExact("1e-300");
+	CheckExact("1e-40");
+	CheckExact("1e400");
+	CheckExact("1e-400");
+
+	// float denormals and the double which is half-way between two floats
+	CheckExact("1.17549435e-38");
+	CheckExact("1.4e-45");
+	CheckExact("7e-46");
+	CheckExact("16777217");
+	CheckExact("-16777217");
+	CheckExact("0.100000001490116119384765625");
+
+	// double half-way and boundary cases
+	CheckExact("9007199254740993");
+	CheckExact("2.2250738585072011e-308");
+	CheckExact("2.2250738585072012e-308");
+	CheckExact("4.9406564584124654e-324");
+	CheckExact("1.7976931348623157e308");
+
+	// more than 780 digits, only the fact that the tail isn't zero matters
+	std::string s = "1.";
+	s.append(800,'0');
+	s += '1';
+	CheckExact(s.c_str());
+
+	s = "8.";
+	s.append(800,'0');
+	CheckExact(s.c_str());
+}
+
+// ------------------------------------------------------------------------------------------------
+void FastAtofTest::testMatchesStrtod (void)
+{
+	CheckExact("0");
+	CheckExact("-0");
+	CheckExact("0.1");
+	CheckExact("0.3");
+	CheckExact("1.5e5");
+	CheckExact("1E-5");
+	CheckExact("-123.456e+7");
+	CheckExact("0000123.0000");
+
+	// random doubles printed with different numbers of digits
+	uint64_t state = 0x853c49e6748fea9bull;
+	char buffer[64];
+	for (unsigned int i = 0; i < 20000; ++i) {
+		state = state * 6364136223846793005ull + 1442695040888963407ull;
+		uint64_t bits = state;
+
+		double d;
+		::memcpy(&d,&bits,sizeof(d));
+		if (d != d || d - d != 0.0) {
+			continue;
+		}
+		::sprintf(buffer,"%.*g",static_cast<int>(1 + i % 20),d);
+		CheckExact(buffer);
+
+		// and numbers of the typical magnitude of vertex data
+		::sprintf(buffer,"%.*f",static_cast<int>(i % 10),static_cast<double>(bits % 2000000) / 1000.0 - 1000.0);
+		CheckExact(buffer);
+	}
+}
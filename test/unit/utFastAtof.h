@@ -0,0 +1,42 @@
+#ifndef TESTFASTATOF_H
+#define TESTFASTATOF_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <fast_atof.h>
+
+using namespace std;
+using namespace Assimp;
+
+class FastAtofTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (FastAtofTest);
+    CPPUNIT_TEST (testSpanSeparators);
+    CPPUNIT_TEST (testSpanLineBreaks);
+    CPPUNIT_TEST (testSpanStopAtNonNumber);
+    CPPUNIT_TEST (testCheckComma);
+    CPPUNIT_TEST (testSlowPath);
+    CPPUNIT_TEST (testMatchesStrtod);
+    CPPUNIT_TEST_SUITE_END ();
+
+    public:
+        void setUp (void);
+        void tearDown (void);
+
+    protected:
+
+        void testSpanSeparators (void);
+        void testSpanLineBreaks (void);
+        void testSpanStopAtNonNumber (void);
+        void testCheckComma (void);
+        void testSlowPath (void);
+        void testMatchesStrtod (void);
+
+    private:
+
+        // parse the string as float and double and compare bitwise with strtof/strtod
+        static void CheckExact(const char* number);
+};
+
+#endif 
@@ -0,0 +1,214 @@
+
+#include "UnitTestPCH.h"
+#include "utFastFtoa.h"
+
+#include <float.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION (FastFtoaTest);
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Number of significant digits of a formatted number
+unsigned int CountDigits(const std::string& s)
+{
+	std::string digits;
+	for (std::string::const_iterator it = s.begin(); it != s.end() && *it != 'e'; ++it) {
+		if (*it >= '0' && *it <= '9') {
+			digits += *it;
+		}
+	}
+	const std::string::size_type first = digits.find_first_not_of('0');
+	if (first == std::string::npos) {
+		return 1;
+	}
+	const std::string::size_type last = digits.find_last_not_of('0');
+	return static_cast<unsigned int>(last - first + 1);
+}
+
+} // ! anon namespace
+
+// ------------------------------------------------------------------------------------------------
+void FastFtoaTest::setUp (void)
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+void FastFtoaTest::tearDown (void)
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string FastFtoaTest::Format(double d)
+{
+	char buffer[32];
+	return std::string(buffer,fast_dtoa(buffer,d));
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string FastFtoaTest::Format(float f)
+{
+	char buffer[32];
+	return std::string(buffer,fast_ftoa(buffer,f));
+}
+
+// ------------------------------------------------------------------------------------------------
+void FastFtoaTest::CheckShortest(double d)
+{
+	const std::string s = Format(d);
+
+	const double back = ::strtod(s.c_str(),NULL);
+	CPPUNIT_ASSERT_MESSAGE(s,0 == ::memcmp(&back,&d,sizeof(double)));
+
+	// the correctly rounded number with one digit less must not read back
+	const unsigned int n = CountDigits(s);
+	if (n > 1) {
+		char buffer[64];
+		::sprintf(buffer,"%.*e",n-2,d);
+		CPPUNIT_ASSERT_MESSAGE(s,::strtod(buffer,NULL) != d);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void FastFtoaTest::CheckShortest(float f)
+{
+	const std::string s = Format(f);
+
+	const float back = ::strtof(s.c_str(),NULL);
+	CPPUNIT_ASSERT_MESSAGE(s,0 == ::memcmp(&back,&f,sizeof(float)));
+
+	const unsigned int n = CountDigits(s);
+	if (n > 1) {
+		char buffer[64];
+		::sprintf(buffer,"%.*e",n-2,static_cast<double>(f));
+		CPPUNIT_ASSERT_MESSAGE(s,::strtof(buffer,NULL) != f);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void FastFtoaTest::testKnownValues (void)
+{
+	// smallest denormal, smallest normal and largest double
+	CPPUNIT_ASSERT_EQUAL(std::string("5e-324"),Format(5e-324));
+	CPPUNIT_ASSERT_EQUAL(std::string("-5e-324"),Format(-5e-324));
+	CPPUNIT_ASSERT_EQUAL(std::string("2.2250738585072014e-308"),Format(DBL_MIN));
+	CPPUNIT_ASSERT_EQUAL(std::string("2.225073858507201e-308"),Format(2.225073858507201e-308));
+	CPPUNIT_ASSERT_EQUAL(std::string("1.7976931348623157e+308"),Format(DBL_MAX));
+	CPPUNIT_ASSERT_EQUAL(std::string("8.98846567431158e+307"),Format(8.98846567431158e+307));
+
+	// 1e23 isn't exactly representable, the nearest double is below it
+	CPPUNIT_ASSERT_EQUAL(std::string("1e+23"),Format(1e23));
+	CPPUNIT_ASSERT_EQUAL(std::string("1.0000000000000001e+23"),Format(nextafter(1e23,DBL_MAX)));
+	CPPUNIT_ASSERT_EQUAL(std::string("9.999999999999997e+22"),Format(nextafter(1e23,0.0)));
+
+	// 2^53 + 1 rounds to 2^53
+	CPPUNIT_ASSERT_EQUAL(std::string("9007199254740992"),Format(9007199254740993.0));
+	CPPUNIT_ASSERT_EQUAL(std::string("9007199254740994"),Format(9007199254740994.0));
+
+	CPPUNIT_ASSERT_EQUAL(std::string("0.1"),Format(0.1));
+	CPPUNIT_ASSERT_EQUAL(std::string("0.30000000000000004"),Format(0.1 + 0.2));
+	CPPUNIT_ASSERT_EQUAL(std::string("0"),Format(0.0));
+	CPPUNIT_ASSERT_EQUAL(std::string("-0"),Format(-0.0));
+
+	// float denormals and boundaries
+	CPPUNIT_ASSERT_EQUAL(std::string("1e-45"),Format(1e-45f));
+	CPPUNIT_ASSERT_EQUAL(std::string("3e-45"),Format(3e-45f));
+	CPPUNIT_ASSERT_EQUAL(std::string("1.1754942e-38"),Format(1.1754942e-38f));
+	CPPUNIT_ASSERT_EQUAL(std::string("1.1754944e-38"),Format(FLT_MIN));
+	CPPUNIT_ASSERT_EQUAL(std::string("3.4028235e+38"),Format(FLT_MAX));
+	CPPUNIT_ASSERT_EQUAL(std::string("0.1"),Format(0.1f));
+	CPPUNIT_ASSERT_EQUAL(std::string("16777216"),Format(16777217.f));
+	CPPUNIT_ASSERT_EQUAL(std::string("10000000000"),Format(1e10f));
+
+	// special values
+	CPPUNIT_ASSERT_EQUAL(std::string("inf"),Format(std::numeric_limits<double>::infinity()));
+	CPPUNIT_ASSERT_EQUAL(std::string("-inf"),Format(-std::numeric_limits<float>::infinity()));
+	CPPUNIT_ASSERT_EQUAL(std::string("nan"),Format(std::numeric_limits<double>::quiet_NaN()));
+}
+
+// ------------------------------------------------------------------------------------------------
+void FastFtoaTest::testNotation (void)
+{
+	// plain notation for decimal exponents from -7 to 20, like ECMAScript
+	CPPUNIT_ASSERT_EQUAL(std::string("100000000000000000000"),Format(1e20));
+	CPPUNIT_ASSERT_EQUAL(std::string("1e+21"),Format(1e21));
+	CPPUNIT_ASSERT_EQUAL(std::string("123456789012345680000"),Format(123456789012345680000.0));
+	CPPUNIT_ASSERT_EQUAL(std::string("0.000001"),Format(1e-6));
+	CPPUNIT_ASSERT_EQUAL(std::string("1e-7"),Format(1e-7));
+	CPPUNIT_ASSERT_EQUAL(std::string("1.5e-7"),Format(1.5e-7));
+	CPPUNIT_ASSERT_EQUAL(std::string("0.0000015"),Format(1.5e-6));
+	CPPUNIT_ASSERT_EQUAL(std::string("1.5"),Format(1.5));
+	CPPUNIT_ASSERT_EQUAL(std::string("-1234.5"),Format(-1234.5f));
+	CPPUNIT_ASSERT_EQUAL(std::string("1e+100"),Format(1e100));
+	CPPUNIT_ASSERT_EQUAL(std::string("1.5e-100"),Format(1.5e-100));
+
+	char buffer[32];
+	CPPUNIT_ASSERT_EQUAL(std::string("-9223372036854775808"),std::string(buffer,fast_itoa(buffer,std::numeric_limits<int64_t>::min())));
+	CPPUNIT_ASSERT_EQUAL(std::string("18446744073709551615"),std::string(buffer,fast_utoa(buffer,std::numeric_limits<uint64_t>::max())));
+	CPPUNIT_ASSERT_EQUAL(std::string("0"),std::string(buffer,fast_utoa(buffer,0)));
+}
+
+// ------------------------------------------------------------------------------------------------
+void FastFtoaTest::testDoubleBoundaries (void)
+{
+	// every power of two from 2^-1074 to 2^1023 and its neighbours. At the powers of 
+	// two the next smaller double is closer than the next larger one.
+	for (int e = -1074; e <= 1023; ++e) {
+		const double d = ::ldexp(1.0,e);
+		CheckShortest(d);
+		CheckShortest(-d);
+		CheckShortest(nextafter(d,0.0));
+		CheckShortest(nextafter(d,DBL_MAX));
+	}
+	CheckShortest(DBL_MAX);
+	CheckShortest(nextafter(DBL_MIN,0.0));
+}
+
+// ------------------------------------------------------------------------------------------------
+void FastFtoaTest::testFloatBoundaries (void)
+{
+	for (int e = -149; e <= 127; ++e) {
+		const float f = static_cast<float>(::ldexp(1.0,e));
+		CheckShortest(f);
+		CheckShortest(-f);
+		CheckShortest(nextafterf(f,0.f));
+		CheckShortest(nextafterf(f,FLT_MAX));
+	}
+
+	// all denormals with few bits set and the largest ones
+	for (uint32_t bits = 1; bits < 0x800000; bits = bits * 3 + 1) {
+		float f;
+		::memcpy(&f,&bits,sizeof(f));
+		CheckShortest(f);
+	}
+	for (uint32_t bits = 0x7fff00; bits < 0x800100; ++bits) {
+		float f;
+		::memcpy(&f,&bits,sizeof(f));
+		CheckShortest(f);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void FastFtoaTest::testRandom (void)
+{
+	uint64_t state = 0x2545f4914f6cdd1dull;
+	for (unsigned int i = 0; i < 50000; ++i) {
+		state = state * 6364136223846793005ull + 1442695040888963407ull;
+
+		double d;
+		::memcpy(&d,&state,sizeof(d));
+		if (d == d && d - d == 0.0) {
+			CheckShortest(d);
+		}
+
+		float f;
+		const uint32_t bits = static_cast<uint32_t>(state >> 32);
+		::memcpy(&f,&bits,sizeof(f));
+		if (f == f && f - f == 0.f) {
+			CheckShortest(f);
+		}
+
+		// values of the typical magnitude of vertex data
+		CheckShortest(static_cast<float>(static_cast<double>(state >> 40) / 1000.0 - 8000.0));
+	}
+}
@@ -0,0 +1,44 @@
+#ifndef TESTFASTFTOA_H
+#define TESTFASTFTOA_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <fast_ftoa.h>
+
+using namespace std;
+using namespace Assimp;
+
+class FastFtoaTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (FastFtoaTest);
+    CPPUNIT_TEST (testKnownValues);
+    CPPUNIT_TEST (testNotation);
+    CPPUNIT_TEST (testDoubleBoundaries);
+    CPPUNIT_TEST (testFloatBoundaries);
+    CPPUNIT_TEST (testRandom);
+    CPPUNIT_TEST_SUITE_END ();
+
+    public:
+        void setUp (void);
+        void tearDown (void);
+
+    protected:
+
+        void testKnownValues (void);
+        void testNotation (void);
+        void testDoubleBoundaries (void);
+        void testFloatBoundaries (void);
+        void testRandom (void);
+
+    private:
+
+        static std::string Format(double d);
+        static std::string Format(float f);
+
+        // check that the value is written with as few digits as possible and reads back exactly
+        static void CheckShortest(double d);
+        static void CheckShortest(float f);
+};
+
+#endif 
@@ -0,0 +1,111 @@
+
+#include "UnitTestPCH.h"
+#include "utFuseMeshSteps.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (FuseMeshStepsTest);
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+bool SameArray(const T* a, const T* b, unsigned int num)
+{
+	if (!a || !b) {
+		return !a && !b;
+	}
+	return !::memcmp(a,b,sizeof(T) * num);
+}
+
+} // ! anon namespace
+
+// ------------------------------------------------------------------------------------------------
+void FuseMeshStepsTest :: setUp (void)
+{
+	// all steps which work on each mesh independently, in a single run of them
+	flags = aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_GenSmoothNormals | 
+		aiProcess_CalcTangentSpace | aiProcess_LimitBoneWeights | aiProcess_ImproveCacheLocality |
+		aiProcess_ValidateDataStructure;
+}
+
+// ------------------------------------------------------------------------------------------------
+void FuseMeshStepsTest :: tearDown (void)
+{
+	// nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiScene* FuseMeshStepsTest :: Import(Importer& imp, const char* file, bool fuse, int threads)
+{
+	imp.SetPropertyInteger(AI_CONFIG_GLOB_FUSE_MESH_STEPS,fuse ? 1 : 0);
+	imp.SetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING,threads);
+
+	// no post-processing yet, only the per-mesh steps are under test
+	CPPUNIT_ASSERT(imp.ReadFile(file,0));
+	const aiScene* scene = imp.ApplyPostProcessing(flags);
+	CPPUNIT_ASSERT(scene);
+	return scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+void FuseMeshStepsTest :: CompareMeshes(const aiMesh* a, const aiMesh* b)
+{
+	CPPUNIT_ASSERT(a->mPrimitiveTypes == b->mPrimitiveTypes);
+	CPPUNIT_ASSERT(a->mNumVertices == b->mNumVertices);
+	CPPUNIT_ASSERT(a->mNumFaces == b->mNumFaces);
+
+	const unsigned int num = a->mNumVertices;
+	CPPUNIT_ASSERT(SameArray(a->mVertices,  b->mVertices,  num));
+	CPPUNIT_ASSERT(SameArray(a->mNormals,   b->mNormals,   num));
+	CPPUNIT_ASSERT(SameArray(a->mTangents,  b->mTangents,  num));
+	CPPUNIT_ASSERT(SameArray(a->mBitangents,b->mBitangents,num));
+	for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
+		CPPUNIT_ASSERT(SameArray(a->mTextureCoords[n],b->mTextureCoords[n],num));
+	}
+	for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS; ++n) {
+		CPPUNIT_ASSERT(SameArray(a->mColors[n],b->mColors[n],num));
+	}
+
+	for (unsigned int i = 0; i < a->mNumFaces; ++i) {
+		const aiFace& fa = a->mFaces[i], &fb = b->mFaces[i];
+		CPPUNIT_ASSERT(fa.mNumIndices == fb.mNumIndices);
+		CPPUNIT_ASSERT(SameArray(fa.mIndices,fb.mIndices,fa.mNumIndices));
+	}
+
+	CPPUNIT_ASSERT(a->mNumBones == b->mNumBones);
+	for (unsigned int i = 0; i < a->mNumBones; ++i) {
+		const aiBone* ba = a->mBones[i], *bb = b->mBones[i];
+		CPPUNIT_ASSERT(ba->mName == bb->mName);
+		CPPUNIT_ASSERT(ba->mNumWeights == bb->mNumWeights);
+		CPPUNIT_ASSERT(SameArray(ba->mWeights,bb->mWeights,ba->mNumWeights));
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void FuseMeshStepsTest :: CompareFusedAndUnfused(const char* file, int threads)
+{
+	Importer fusedImp, unfusedImp;
+	const aiScene* fused = Import(fusedImp,file,true,threads);
+	const aiScene* unfused = Import(unfusedImp,file,false,threads);
+
+	CPPUNIT_ASSERT(fused->mNumMeshes == unfused->mNumMeshes);
+	for (unsigned int i = 0; i < fused->mNumMeshes; ++i) {
+		CompareMeshes(fused->mMeshes[i],unfused->mMeshes[i]);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void FuseMeshStepsTest :: testSameResults (void)
+{
+	// polygons, several meshes and skinned meshes with bones
+	CompareFusedAndUnfused("../../test/models/OBJ/spider.obj",-1);
+	CompareFusedAndUnfused("../../test/models/X/test.x",-1);
+	CompareFusedAndUnfused("../../test/models/X/BCN_Epileptic.X",-1);
+	CompareFusedAndUnfused("../../test/models/X/Testwuson.X",-1);
+}
+
+// ------------------------------------------------------------------------------------------------
+void FuseMeshStepsTest :: testSingleThreaded (void)
+{
+	CompareFusedAndUnfused("../../test/models/OBJ/spider.obj",0);
+	CompareFusedAndUnfused("../../test/models/X/Testwuson.X",0);
+}
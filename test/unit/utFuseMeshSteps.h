@@ -0,0 +1,43 @@
+#ifndef TESTFUSEMESHSTEPS_H
+#define TESTFUSEMESHSTEPS_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <Importer.hpp>
+#include <scene.h>
+
+using namespace std;
+using namespace Assimp;
+
+class FuseMeshStepsTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (FuseMeshStepsTest);
+    CPPUNIT_TEST (testSameResults);
+    CPPUNIT_TEST (testSingleThreaded);
+    CPPUNIT_TEST_SUITE_END ();
+
+    public:
+        void setUp (void);
+        void tearDown (void);
+
+    protected:
+
+        void testSameResults (void);
+        void testSingleThreaded (void);
+
+    private:
+
+        // import a file and post-process it with and without fusing the per-mesh steps
+        void CompareFusedAndUnfused(const char* file, int threads);
+
+        // import a file and post-process it with the given setting
+        const aiScene* Import(Importer& imp, const char* file, bool fuse, int threads);
+
+        // check whether two meshes are exactly identical
+        void CompareMeshes(const aiMesh* a, const aiMesh* b);
+
+        unsigned int flags;
+};
+
+#endif 
@@ -0,0 +1,314 @@
+
+#include "UnitTestPCH.h"
+#include "utGzipIOStream.h"
+
+#include <MemoryIOWrapper.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION (GzipIOStreamTest);
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// IOSystem serving a few files from memory
+class TestIOSystem : public IOSystem
+{
+public:
+	bool Exists( const char* pFile) const {
+		return files.find(pFile) != files.end();
+	}
+
+	char getOsSeparator() const {
+		return '/';
+	}
+
+	IOStream* Open( const char* pFile, const char* /*pMode*/ = "rb") {
+		std::map<std::string, std::vector<uint8_t> >::const_iterator it = files.find(pFile);
+		if (it == files.end()) {
+			return NULL;
+		}
+		return new MemoryIOStream(&(*it).second[0],(*it).second.size());
+	}
+
+	void Close( IOStream* pFile) {
+		delete pFile;
+	}
+
+	std::map<std::string, std::vector<uint8_t> > files;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Memory stream which counts the bytes read from it
+class CountingStream : public MemoryIOStream
+{
+public:
+	CountingStream(const std::vector<uint8_t>& data, size_t& bytesRead)
+		: MemoryIOStream(&data[0],data.size())
+		, bytesRead(bytesRead)
+	{}
+
+	size_t Read(void* pvBuffer, size_t pSize, size_t pCount) {
+		const size_t cnt = MemoryIOStream::Read(pvBuffer,pSize,pCount);
+		bytesRead += cnt*pSize;
+		return cnt;
+	}
+
+	size_t& bytesRead;
+};
+
+} // ! anon namespace
+
+// ------------------------------------------------------------------------------------------------
+std::vector<uint8_t> GzipIOStreamTest :: Compress(const std::vector<uint8_t>& data, bool gzip)
+{
+	z_stream zstream;
+	zstream.zalloc = Z_NULL;
+	zstream.zfree = Z_NULL;
+	zstream.opaque = Z_NULL;
+
+	// adding 16 to the window bits writes a gzip header and trailer
+	CPPUNIT_ASSERT(Z_OK == deflateInit2(&zstream,Z_DEFAULT_COMPRESSION,Z_DEFLATED,
+		gzip ? 16+MAX_WBITS : MAX_WBITS,8,Z_DEFAULT_STRATEGY));
+
+	std::vector<uint8_t> out(deflateBound(&zstream,static_cast<uLong>(data.size()))+32);
+	zstream.next_in = const_cast<Bytef*>(&data[0]);
+	zstream.avail_in = static_cast<uInt>(data.size());
+	zstream.next_out = &out[0];
+	zstream.avail_out = static_cast<uInt>(out.size());
+
+	CPPUNIT_ASSERT(Z_STREAM_END == deflate(&zstream,Z_FINISH));
+	out.resize(zstream.total_out);
+	deflateEnd(&zstream);
+	return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+GzipIOStream* GzipIOStreamTest :: Open(const std::vector<uint8_t>& compressed)
+{
+	return new GzipIOStream(boost::shared_ptr<IOStream>(new MemoryIOStream(&compressed[0],compressed.size())));
+}
+
+// ------------------------------------------------------------------------------------------------
+void GzipIOStreamTest :: setUp (void)
+{
+	data.resize(AI_GZIPIOSTREAM_BUFFER_SIZE*3 + 1234);
+
+	unsigned int seed = 1;
+	for (size_t i = 0; i < data.size(); ++i) {
+		seed = seed * 1103515245 + 12345;
+		data[i] = static_cast<uint8_t>((seed >> 16) & 0x3f);
+	}
+	compressed = Compress(data);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GzipIOStreamTest :: tearDown (void)
+{
+	// nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+void GzipIOStreamTest :: testReadAcrossWindow (void)
+{
+	boost::scoped_ptr<GzipIOStream> stream(Open(compressed));
+	CPPUNIT_ASSERT(stream->FileSize() == data.size());
+
+	// odd-sized reads never line up with the window
+	std::vector<uint8_t> out(data.size());
+	size_t pos = 0;
+	while (pos < out.size()) {
+		const size_t n = std::min(static_cast<size_t>(7001),out.size()-pos);
+		CPPUNIT_ASSERT(1 == stream->Read(&out[pos],n,1));
+		pos += n;
+	}
+	CPPUNIT_ASSERT(out == data);
+	CPPUNIT_ASSERT(stream->Tell() == data.size());
+
+	// nothing left to read
+	uint8_t c;
+	CPPUNIT_ASSERT(0 == stream->Read(&c,1,1));
+	CPPUNIT_ASSERT(!stream->Failed());
+}
+
+// ------------------------------------------------------------------------------------------------
+void GzipIOStreamTest :: testSeekForward (void)
+{
+	boost::scoped_ptr<GzipIOStream> stream(Open(compressed));
+
+	const size_t at = AI_GZIPIOSTREAM_BUFFER_SIZE*2 + 17;
+	CPPUNIT_ASSERT(AI_SUCCESS == stream->Seek(at,aiOrigin_SET));
+	CPPUNIT_ASSERT(stream->Tell() == at);
+
+	uint8_t out[100];
+	CPPUNIT_ASSERT(1 == stream->Read(out,sizeof(out),1));
+	CPPUNIT_ASSERT(!::memcmp(out,&data[at],sizeof(out)));
+
+	CPPUNIT_ASSERT(AI_SUCCESS == stream->Seek(50,aiOrigin_END));
+	CPPUNIT_ASSERT(1 == stream->Read(out,50,1));
+	CPPUNIT_ASSERT(!::memcmp(out,&data[data.size()-50],50));
+
+	// beyond the end of the file
+	CPPUNIT_ASSERT(AI_FAILURE == stream->Seek(data.size()+1,aiOrigin_SET));
+}
+
+// ------------------------------------------------------------------------------------------------
+void GzipIOStreamTest :: testSeekBackward (void)
+{
+	boost::scoped_ptr<GzipIOStream> stream(Open(compressed));
+
+	// read far beyond the first window, then go back before it
+	std::vector<uint8_t> out(AI_GZIPIOSTREAM_BUFFER_SIZE*2);
+	CPPUNIT_ASSERT(1 == stream->Read(&out[0],out.size(),1));
+
+	CPPUNIT_ASSERT(AI_SUCCESS == stream->Seek(10,aiOrigin_SET));
+	CPPUNIT_ASSERT(1 == stream->Read(&out[0],100,1));
+	CPPUNIT_ASSERT(!::memcmp(&out[0],&data[10],100));
+
+	// and back within the window
+	CPPUNIT_ASSERT(AI_SUCCESS == stream->Seek(5,aiOrigin_SET));
+	CPPUNIT_ASSERT(1 == stream->Read(&out[0],100,1));
+	CPPUNIT_ASSERT(!::memcmp(&out[0],&data[5],100));
+	CPPUNIT_ASSERT(!stream->Failed());
+}
+
+// ------------------------------------------------------------------------------------------------
+void GzipIOStreamTest :: testTruncated (void)
+{
+	std::vector<uint8_t> truncated(compressed.begin(),compressed.begin()+compressed.size()/2);
+	boost::scoped_ptr<GzipIOStream> stream(Open(truncated));
+
+	// the stream ends early, everything up to there is still correct
+	CPPUNIT_ASSERT(stream->FileSize() > 0 && stream->FileSize() < data.size());
+	CPPUNIT_ASSERT(stream->Failed());
+
+	std::vector<uint8_t> out(stream->FileSize());
+	CPPUNIT_ASSERT(1 == stream->Read(&out[0],out.size(),1));
+	CPPUNIT_ASSERT(std::equal(out.begin(),out.end(),data.begin()));
+}
+
+// ------------------------------------------------------------------------------------------------
+void GzipIOStreamTest :: testZlib (void)
+{
+	const std::vector<uint8_t> zlib = Compress(data,false);
+
+	MemoryIOStream gzipStream(&compressed[0],compressed.size()), zlibStream(&zlib[0],zlib.size());
+	CPPUNIT_ASSERT(GzipIOStream::IsGzip(&gzipStream));
+	CPPUNIT_ASSERT(!GzipIOStream::IsGzip(&zlibStream));
+	CPPUNIT_ASSERT(gzipStream.Tell() == 0);
+
+	// zlib streams are decompressed as well
+	boost::scoped_ptr<GzipIOStream> stream(Open(zlib));
+	CPPUNIT_ASSERT(stream->FileSize() == data.size());
+
+	std::vector<uint8_t> out(data.size());
+	CPPUNIT_ASSERT(1 == stream->Read(&out[0],out.size(),1));
+	CPPUNIT_ASSERT(out == data);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GzipIOStreamTest :: testMultipleMembers (void)
+{
+	// the size stored in the trailer covers only the last member
+	const std::vector<uint8_t> first(data.begin(),data.begin()+1000), second(data.begin()+1000,data.end());
+	std::vector<uint8_t> members = Compress(first);
+	const std::vector<uint8_t> tail = Compress(second);
+	members.insert(members.end(),tail.begin(),tail.end());
+
+	boost::scoped_ptr<GzipIOStream> stream(Open(members));
+	CPPUNIT_ASSERT(stream->FileSize() == data.size());
+
+	std::vector<uint8_t> out(data.size());
+	CPPUNIT_ASSERT(1 == stream->Read(&out[0],out.size(),1));
+	CPPUNIT_ASSERT(out == data);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GzipIOStreamTest :: testGzipIOSystem (void)
+{
+	TestIOSystem io;
+	io.files["model.obj.gz"] = compressed;
+	io.files["model.mtl.gz"] = Compress(std::vector<uint8_t>(data.begin(),data.begin()+100));
+	io.files["texture.png"] = std::vector<uint8_t>(data.begin(),data.begin()+10);
+
+	CPPUNIT_ASSERT(GzipIOSystem::IsCompressed(&io,"model.obj.gz"));
+	CPPUNIT_ASSERT(!GzipIOSystem::IsCompressed(&io,"texture.png"));
+
+	GzipIOSystem gzip(&io,"model.obj.gz");
+	CPPUNIT_ASSERT(gzip.GetName() == "model.obj");
+	CPPUNIT_ASSERT(gzip.Exists("model.obj"));
+
+	IOStream* stream = gzip.Open("model.obj");
+	CPPUNIT_ASSERT(stream && stream->FileSize() == data.size());
+	gzip.Close(stream);
+
+	// files which don't exist are served from their compressed copy ...
+	CPPUNIT_ASSERT(gzip.Exists("model.mtl"));
+	stream = gzip.Open("model.mtl");
+	CPPUNIT_ASSERT(stream && stream->FileSize() == 100);
+	gzip.Close(stream);
+
+	// ... all others are passed through
+	stream = gzip.Open("texture.png");
+	CPPUNIT_ASSERT(stream && stream->FileSize() == 10 && !dynamic_cast<GzipIOStream*>(stream));
+	gzip.Close(stream);
+
+	CPPUNIT_ASSERT(!gzip.Exists("missing.txt"));
+	CPPUNIT_ASSERT(!gzip.Open("missing.txt"));
+}
+
+// ------------------------------------------------------------------------------------------------
+void GzipIOStreamTest :: testLazySize (void)
+{
+	// opening a gzip file reads nothing, sequential reads don't need the size
+	size_t bytesRead = 0;
+	GzipIOStream gzip(boost::shared_ptr<IOStream>(new CountingStream(compressed,bytesRead)));
+	CPPUNIT_ASSERT(0 == bytesRead);
+
+	std::vector<uint8_t> out(data.size());
+	CPPUNIT_ASSERT(1 == gzip.Read(&out[0],100,1));
+	CPPUNIT_ASSERT(std::equal(out.begin(),out.begin()+100,data.begin()));
+
+	// the size is taken from the trailer, the data is still streamed
+	CPPUNIT_ASSERT(gzip.FileSize() == data.size());
+	CPPUNIT_ASSERT(!gzip.GetView());
+	CPPUNIT_ASSERT(1 == gzip.Read(&out[100],data.size()-100,1));
+	CPPUNIT_ASSERT(out == data);
+
+	// zlib data has no trailer, it is decompressed once and kept
+	const std::vector<uint8_t> zlib = Compress(data,false);
+	bytesRead = 0;
+	GzipIOStream stream(boost::shared_ptr<IOStream>(new CountingStream(zlib,bytesRead)));
+	CPPUNIT_ASSERT(1 == stream.Read(&out[0],100,1));
+	CPPUNIT_ASSERT(stream.FileSize() == data.size());
+	const size_t afterSize = bytesRead;
+	CPPUNIT_ASSERT(afterSize < zlib.size()*2);
+
+	CPPUNIT_ASSERT(stream.GetView() && !::memcmp(stream.GetView(),&data[0],data.size()));
+	CPPUNIT_ASSERT(stream.Tell() == 100);
+	CPPUNIT_ASSERT(1 == stream.Read(&out[100],data.size()-100,1));
+	CPPUNIT_ASSERT(out == data);
+	CPPUNIT_ASSERT(AI_SUCCESS == stream.Seek(10,aiOrigin_END));
+	CPPUNIT_ASSERT(AI_FAILURE == stream.Seek(data.size()+1,aiOrigin_SET));
+	CPPUNIT_ASSERT(bytesRead == afterSize);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GzipIOStreamTest :: testSharedBuffer (void)
+{
+	TestIOSystem io;
+	io.files["model.obj.gz"] = Compress(data,false);
+
+	GzipIOSystem gzip(&io,"model.obj.gz");
+	IOStream* first = gzip.Open("model.obj");
+	CPPUNIT_ASSERT(first && first->FileSize() == data.size() && first->GetView());
+
+	// further streams for the same file are served from the same buffer
+	IOStream* second = gzip.Open("model.obj");
+	CPPUNIT_ASSERT(second && second->GetView() == first->GetView());
+	CPPUNIT_ASSERT(second->FileSize() == data.size());
+	gzip.Close(first);
+
+	std::vector<uint8_t> out(data.size());
+	CPPUNIT_ASSERT(1 == second->Read(&out[0],out.size(),1));
+	CPPUNIT_ASSERT(out == data);
+	gzip.Close(second);
+}
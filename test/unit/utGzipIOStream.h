@@ -0,0 +1,55 @@
+#ifndef TESTGZIPIOSTREAM_H
+#define TESTGZIPIOSTREAM_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <GzipIOWrapper.h>
+
+using namespace std;
+using namespace Assimp;
+
+class GzipIOStreamTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (GzipIOStreamTest);
+    CPPUNIT_TEST (testReadAcrossWindow);
+    CPPUNIT_TEST (testSeekForward);
+    CPPUNIT_TEST (testSeekBackward);
+    CPPUNIT_TEST (testTruncated);
+    CPPUNIT_TEST (testZlib);
+    CPPUNIT_TEST (testMultipleMembers);
+    CPPUNIT_TEST (testGzipIOSystem);
+    CPPUNIT_TEST (testLazySize);
+    CPPUNIT_TEST (testSharedBuffer);
+    CPPUNIT_TEST_SUITE_END ();
+
+    public:
+        void setUp (void);
+        void tearDown (void);
+
+    protected:
+
+        void testReadAcrossWindow (void);
+        void testSeekForward (void);
+        void testSeekBackward (void);
+        void testTruncated (void);
+        void testZlib (void);
+        void testMultipleMembers (void);
+        void testGzipIOSystem (void);
+        void testLazySize (void);
+        void testSharedBuffer (void);
+
+    private:
+
+        // compress data in gzip format (or zlib format if gzip is false)
+        static std::vector<uint8_t> Compress(const std::vector<uint8_t>& data, bool gzip = true);
+
+        // stream which decompresses the given data
+        static GzipIOStream* Open(const std::vector<uint8_t>& compressed);
+
+        // more than three windows of data which doesn't compress too well
+        std::vector<uint8_t> data;
+        std::vector<uint8_t> compressed;
+};
+
+#endif 
@@ -0,0 +1,336 @@
+
+#include "UnitTestPCH.h"
+#include "utImportCache.h"
+
+#include <DefaultIOSystem.h>
+#include <time.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION (ImportCacheTest);
+
+namespace {
+
+// cache entries go to the working directory, like the output of the other tests
+const char* const CacheDirectory = ".";
+const char* const ObjFile = "unittest_cache.obj";
+const char* const MtlFile = "unittest_cache.mtl";
+
+// ------------------------------------------------------------------------------------------------
+// File system which counts how often the file to be imported is opened
+class CountingIOSystem : public DefaultIOSystem
+{
+public:
+	CountingIOSystem(const std::string& file, unsigned int& opened)
+		: file(file)
+		, opened(opened)
+	{}
+
+	IOStream* Open( const char* pFile, const char* pMode = "rb") {
+		if (ComparePaths(pFile,file.c_str())) {
+			++opened;
+		}
+		return DefaultIOSystem::Open(pFile,pMode);
+	}
+
+	std::string file;
+	unsigned int& opened;
+};
+
+// ------------------------------------------------------------------------------------------------
+void WriteFile(const char* name, const std::string& contents)
+{
+	FILE* const f = ::fopen(name,"wb");
+	CPPUNIT_ASSERT(NULL != f);
+	CPPUNIT_ASSERT(contents.length() == ::fwrite(contents.c_str(),1,contents.length(),f));
+	::fclose(f);
+}
+
+} // ! anon namespace
+
+// ------------------------------------------------------------------------------------------------
+void ImportCacheTest::setUp (void)
+{
+	static unsigned int counter = 0;
+	char buffer[64];
+	::sprintf(buffer,"%lu %u",static_cast<unsigned long>(::time(NULL)),counter++);
+	token = buffer;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportCacheTest::tearDown (void)
+{
+	::remove(ObjFile);
+	::remove(MtlFile);
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiScene* ImportCacheTest::Import(Importer& imp, const std::string& file, unsigned int flags, bool& fromCache)
+{
+	// the key is computed from the file, so it is opened once even for cache hits
+	unsigned int opened = 0;
+	imp.SetIOHandler(new CountingIOSystem(file,opened));
+	imp.SetPropertyString(AI_CONFIG_GLOB_IMPORT_CACHE,CacheDirectory);
+
+	const aiScene* const scene = imp.ReadFile(file,flags);
+	fromCache = opened == 1;
+	return scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportCacheTest::WriteObj(const char* diffuse)
+{
+	WriteFile(ObjFile,"# " + token + "\nmtllib unittest_cache.mtl\nusemtl mat\n"
+		"v 0 0 0\nv 1 0 0\nv 0 1 0\nv 1 1 0\nvt 0 0\nvt 1 0\nvt 0 1\nvt 1 1\n"
+		"f 1/1 2/2 4/4 3/3\n");
+	WriteFile(MtlFile,std::string("newmtl mat\nKd ") + diffuse + "\nmap_Kd unittest_cache.png\n");
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportCacheTest::CompareNodes(const aiNode* a, const aiNode* b)
+{
+	CPPUNIT_ASSERT(0 == ::strcmp(a->mName.data,b->mName.data));
+	CPPUNIT_ASSERT(a->mTransformation == b->mTransformation);
+	CPPUNIT_ASSERT(a->mNumMeshes == b->mNumMeshes);
+	CPPUNIT_ASSERT(a->mNumMeshes == 0 || 0 == ::memcmp(a->mMeshes,b->mMeshes,a->mNumMeshes*sizeof(unsigned int)));
+	CPPUNIT_ASSERT(a->mNumChildren == b->mNumChildren);
+	for (unsigned int i = 0; i < a->mNumChildren; ++i) {
+		CPPUNIT_ASSERT(b->mChildren[i]->mParent == b);
+		CompareNodes(a->mChildren[i],b->mChildren[i]);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportCacheTest::CompareScenes(const aiScene* a, const aiScene* b)
+{
+	CPPUNIT_ASSERT(a->mFlags == b->mFlags);
+
+	CPPUNIT_ASSERT(a->mNumMeshes == b->mNumMeshes);
+	for (unsigned int i = 0; i < a->mNumMeshes; ++i) {
+		const aiMesh* const ma = a->mMeshes[i], *const mb = b->mMeshes[i];
+		const unsigned int nv = ma->mNumVertices;
+		CPPUNIT_ASSERT(0 == ::strcmp(ma->mName.data,mb->mName.data));
+		CPPUNIT_ASSERT(ma->mPrimitiveTypes == mb->mPrimitiveTypes);
+		CPPUNIT_ASSERT(ma->mMaterialIndex == mb->mMaterialIndex);
+		CPPUNIT_ASSERT(nv == mb->mNumVertices);
+		CPPUNIT_ASSERT(0 == ::memcmp(ma->mVertices,mb->mVertices,nv*sizeof(aiVector3D)));
+
+		const aiVector3D* const streamsA[] = {ma->mNormals,ma->mTangents,ma->mBitangents};
+		const aiVector3D* const streamsB[] = {mb->mNormals,mb->mTangents,mb->mBitangents};
+		for (unsigned int s = 0; s < 3; ++s) {
+			CPPUNIT_ASSERT(!streamsA[s] == !streamsB[s]);
+			CPPUNIT_ASSERT(!streamsA[s] || 0 == ::memcmp(streamsA[s],streamsB[s],nv*sizeof(aiVector3D)));
+		}
+		for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+			CPPUNIT_ASSERT(!ma->mColors[c] == !mb->mColors[c]);
+			CPPUNIT_ASSERT(!ma->mColors[c] || 0 == ::memcmp(ma->mColors[c],mb->mColors[c],nv*sizeof(aiColor4D)));
+		}
+		for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c) {
+			CPPUNIT_ASSERT(ma->mNumUVComponents[c] == mb->mNumUVComponents[c]);
+			CPPUNIT_ASSERT(!ma->mTextureCoords[c] == !mb->mTextureCoords[c]);
+			CPPUNIT_ASSERT(!ma->mTextureCoords[c] || 0 == ::memcmp(ma->mTextureCoords[c],mb->mTextureCoords[c],nv*sizeof(aiVector3D)));
+		}
+
+		CPPUNIT_ASSERT(ma->mNumFaces == mb->mNumFaces);
+		for (unsigned int f = 0; f < ma->mNumFaces; ++f) {
+			CPPUNIT_ASSERT(ma->mFaces[f].mNumIndices == mb->mFaces[f].mNumIndices);
+			CPPUNIT_ASSERT(0 == ::memcmp(ma->mFaces[f].mIndices,mb->mFaces[f].mIndices,
+				ma->mFaces[f].mNumIndices*sizeof(unsigned int)));
+		}
+
+		CPPUNIT_ASSERT(ma->mNumBones == mb->mNumBones);
+		for (unsigned int n = 0; n < ma->mNumBones; ++n) {
+			const aiBone* const ba = ma->mBones[n], *const bb = mb->mBones[n];
+			CPPUNIT_ASSERT(0 == ::strcmp(ba->mName.data,bb->mName.data));
+			CPPUNIT_ASSERT(ba->mOffsetMatrix == bb->mOffsetMatrix);
+			CPPUNIT_ASSERT(ba->mNumWeights == bb->mNumWeights);
+			CPPUNIT_ASSERT(0 == ::memcmp(ba->mWeights,bb->mWeights,ba->mNumWeights*sizeof(aiVertexWeight)));
+		}
+
+		CPPUNIT_ASSERT(ma->mNumAnimMeshes == mb->mNumAnimMeshes);
+	}
+
+	CPPUNIT_ASSERT(a->mNumMaterials == b->mNumMaterials);
+	for (unsigned int i = 0; i < a->mNumMaterials; ++i) {
+		const aiMaterial* const ma = a->mMaterials[i], *const mb = b->mMaterials[i];
+		CPPUNIT_ASSERT(ma->mNumProperties == mb->mNumProperties);
+		for (unsigned int p = 0; p < ma->mNumProperties; ++p) {
+			const aiMaterialProperty* const pa = ma->mProperties[p], *const pb = mb->mProperties[p];
+			CPPUNIT_ASSERT(0 == ::strcmp(pa->mKey.data,pb->mKey.data));
+			CPPUNIT_ASSERT(pa->mSemantic == pb->mSemantic && pa->mIndex == pb->mIndex && pa->mType == pb->mType);
+			CPPUNIT_ASSERT(pa->mDataLength == pb->mDataLength);
+			CPPUNIT_ASSERT(0 == ::memcmp(pa->mData,pb->mData,pa->mDataLength));
+		}
+	}
+
+	CPPUNIT_ASSERT(a->mNumAnimations == b->mNumAnimations);
+	for (unsigned int i = 0; i < a->mNumAnimations; ++i) {
+		const aiAnimation* const aa = a->mAnimations[i], *const ab = b->mAnimations[i];
+		CPPUNIT_ASSERT(0 == ::strcmp(aa->mName.data,ab->mName.data));
+		CPPUNIT_ASSERT(aa->mDuration == ab->mDuration && aa->mTicksPerSecond == ab->mTicksPerSecond);
+		CPPUNIT_ASSERT(aa->mNumChannels == ab->mNumChannels);
+		for (unsigned int c = 0; c < aa->mNumChannels; ++c) {
+			const aiNodeAnim* const ca = aa->mChannels[c], *const cb = ab->mChannels[c];
+			CPPUNIT_ASSERT(0 == ::strcmp(ca->mNodeName.data,cb->mNodeName.data));
+			CPPUNIT_ASSERT(ca->mNumPositionKeys == cb->mNumPositionKeys);
+			for (unsigned int k = 0; k < ca->mNumPositionKeys; ++k) {
+				CPPUNIT_ASSERT(ca->mPositionKeys[k] == cb->mPositionKeys[k] && ca->mPositionKeys[k].mTime == cb->mPositionKeys[k].mTime);
+			}
+			CPPUNIT_ASSERT(ca->mNumRotationKeys == cb->mNumRotationKeys);
+			for (unsigned int k = 0; k < ca->mNumRotationKeys; ++k) {
+				CPPUNIT_ASSERT(ca->mRotationKeys[k] == cb->mRotationKeys[k] && ca->mRotationKeys[k].mTime == cb->mRotationKeys[k].mTime);
+			}
+			CPPUNIT_ASSERT(ca->mNumScalingKeys == cb->mNumScalingKeys);
+			for (unsigned int k = 0; k < ca->mNumScalingKeys; ++k) {
+				CPPUNIT_ASSERT(ca->mScalingKeys[k] == cb->mScalingKeys[k] && ca->mScalingKeys[k].mTime == cb->mScalingKeys[k].mTime);
+			}
+			CPPUNIT_ASSERT(ca->mPreState == cb->mPreState && ca->mPostState == cb->mPostState);
+		}
+		CPPUNIT_ASSERT(aa->mNumMeshChannels == ab->mNumMeshChannels);
+	}
+
+	CPPUNIT_ASSERT(a->mNumTextures == b->mNumTextures);
+	for (unsigned int i = 0; i < a->mNumTextures; ++i) {
+		const aiTexture* const ta = a->mTextures[i], *const tb = b->mTextures[i];
+		CPPUNIT_ASSERT(ta->mWidth == tb->mWidth && ta->mHeight == tb->mHeight);
+		const size_t size = ta->mHeight ? ta->mWidth * ta->mHeight * sizeof(aiTexel) : ta->mWidth;
+		CPPUNIT_ASSERT(0 == ::memcmp(ta->pcData,tb->pcData,size));
+	}
+
+	CPPUNIT_ASSERT(a->mNumLights == b->mNumLights);
+	for (unsigned int i = 0; i < a->mNumLights; ++i) {
+		const aiLight* const la = a->mLights[i], *const lb = b->mLights[i];
+		CPPUNIT_ASSERT(0 == ::strcmp(la->mName.data,lb->mName.data));
+		CPPUNIT_ASSERT(la->mType == lb->mType);
+		CPPUNIT_ASSERT(la->mPosition == lb->mPosition && la->mDirection == lb->mDirection);
+		CPPUNIT_ASSERT(la->mColorDiffuse == lb->mColorDiffuse && la->mColorSpecular == lb->mColorSpecular);
+		CPPUNIT_ASSERT(la->mColorAmbient == lb->mColorAmbient);
+		CPPUNIT_ASSERT(0 == ::memcmp(&la->mAttenuationConstant,&lb->mAttenuationConstant,sizeof(float)*3));
+		CPPUNIT_ASSERT(0 == ::memcmp(&la->mAngleInnerCone,&lb->mAngleInnerCone,sizeof(float)*2));
+	}
+	CPPUNIT_ASSERT(a->mNumCameras == b->mNumCameras);
+	for (unsigned int i = 0; i < a->mNumCameras; ++i) {
+		const aiCamera* const ca = a->mCameras[i], *const cb = b->mCameras[i];
+		CPPUNIT_ASSERT(0 == ::strcmp(ca->mName.data,cb->mName.data));
+		CPPUNIT_ASSERT(ca->mPosition == cb->mPosition && ca->mUp == cb->mUp && ca->mLookAt == cb->mLookAt);
+		CPPUNIT_ASSERT(0 == ::memcmp(&ca->mHorizontalFOV,&cb->mHorizontalFOV,sizeof(float)*4));
+	}
+
+	CPPUNIT_ASSERT(NULL == b->mRootNode->mParent);
+	CompareNodes(a->mRootNode,b->mRootNode);
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportCacheTest::testRoundTrip (void)
+{
+	// skinned and animated meshes, materials and textures, cameras and lights
+	static const char* const files[] = {
+		"../../test/models/X/BCN_Epileptic.X",
+		"../../test/models/OBJ/spider.obj",
+		"../../test/models/Collada/duck.dae",
+		"../../test/models/Collada/COLLADA.dae",
+		"../../test/models/3DS/fels.3ds",
+		"../../test/models/MD5/SimpleCube.md5mesh",
+		"../../test/models/MDL/MDL3 (3DGS A4)/minigun.MDL"
+	};
+	static const unsigned int flags = aiProcessPreset_TargetRealtime_MaxQuality;
+
+	for (unsigned int i = 0; i < sizeof(files) / sizeof(files[0]); ++i) {
+		Importer reference;
+		const aiScene* const expected = reference.ReadFile(files[i],flags);
+		CPPUNIT_ASSERT_MESSAGE(files[i],NULL != expected);
+
+		// the first import stores the scene unless an earlier test run already did,
+		// the second one reads it back
+		bool fromCache;
+		Importer imp;
+		CPPUNIT_ASSERT(NULL != Import(imp,files[i],flags,fromCache));
+		CPPUNIT_ASSERT(NULL != Import(imp,files[i],flags,fromCache));
+		CPPUNIT_ASSERT_MESSAGE(files[i],fromCache);
+		CompareScenes(expected,imp.GetScene());
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportCacheTest::testChangedFile (void)
+{
+	WriteObj("1 0 0");
+
+	bool fromCache;
+	Importer imp;
+	CPPUNIT_ASSERT(NULL != Import(imp,ObjFile,0,fromCache));
+	CPPUNIT_ASSERT(!fromCache);
+	CPPUNIT_ASSERT(NULL != Import(imp,ObjFile,0,fromCache));
+	CPPUNIT_ASSERT(fromCache);
+	CPPUNIT_ASSERT(1 == imp.GetScene()->mMeshes[0]->mNumFaces);
+
+	// a different file with the same name
+	token += " changed";
+	WriteObj("1 0 0");
+	CPPUNIT_ASSERT(NULL != Import(imp,ObjFile,0,fromCache));
+	CPPUNIT_ASSERT(!fromCache);
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportCacheTest::testChangedDependency (void)
+{
+	WriteObj("1 0 0");
+
+	bool fromCache;
+	Importer imp;
+	CPPUNIT_ASSERT(NULL != Import(imp,ObjFile,0,fromCache));
+	CPPUNIT_ASSERT(!fromCache);
+
+	// a changed material library invalidates the entry
+	WriteFile(MtlFile,"newmtl mat\nKd 0 1 0\nmap_Kd unittest_cache.png\n");
+	CPPUNIT_ASSERT(NULL != Import(imp,ObjFile,0,fromCache));
+	CPPUNIT_ASSERT(!fromCache);
+
+	aiColor4D diffuse;
+	CPPUNIT_ASSERT(AI_SUCCESS == aiGetMaterialColor(imp.GetScene()->mMaterials[1],AI_MATKEY_COLOR_DIFFUSE,&diffuse));
+	CPPUNIT_ASSERT(diffuse.r == 0.f && diffuse.g == 1.f);
+
+	// and so does a missing one
+	CPPUNIT_ASSERT(NULL != Import(imp,ObjFile,0,fromCache));
+	CPPUNIT_ASSERT(fromCache);
+	::remove(MtlFile);
+	CPPUNIT_ASSERT(NULL != Import(imp,ObjFile,0,fromCache));
+	CPPUNIT_ASSERT(!fromCache);
+
+	// or one which the loader looked for in vain, but exists now
+	CPPUNIT_ASSERT(NULL != Import(imp,ObjFile,0,fromCache));
+	CPPUNIT_ASSERT(fromCache);
+	WriteFile(MtlFile,"newmtl mat\nKd 0 0 1\n");
+	CPPUNIT_ASSERT(NULL != Import(imp,ObjFile,0,fromCache));
+	CPPUNIT_ASSERT(!fromCache);
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportCacheTest::testChangedSettings (void)
+{
+	WriteObj("1 0 0");
+
+	bool fromCache;
+	Importer imp;
+	CPPUNIT_ASSERT(NULL != Import(imp,ObjFile,0,fromCache));
+	CPPUNIT_ASSERT(!fromCache);
+
+	// other post-processing steps
+	CPPUNIT_ASSERT(NULL != Import(imp,ObjFile,aiProcess_Triangulate,fromCache));
+	CPPUNIT_ASSERT(!fromCache);
+	CPPUNIT_ASSERT(2 == imp.GetScene()->mMeshes[0]->mNumFaces);
+	CPPUNIT_ASSERT(NULL != Import(imp,ObjFile,aiProcess_Triangulate,fromCache));
+	CPPUNIT_ASSERT(fromCache);
+	CPPUNIT_ASSERT(2 == imp.GetScene()->mMeshes[0]->mNumFaces);
+
+	// other properties
+	imp.SetPropertyFloat(AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE,45.f);
+	CPPUNIT_ASSERT(NULL != Import(imp,ObjFile,aiProcess_Triangulate,fromCache));
+	CPPUNIT_ASSERT(!fromCache);
+	CPPUNIT_ASSERT(NULL != Import(imp,ObjFile,aiProcess_Triangulate,fromCache));
+	CPPUNIT_ASSERT(fromCache);
+
+	// but properties which don't change the scene are ignored
+	imp.SetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME,1);
+	imp.SetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING,2);
+	CPPUNIT_ASSERT(NULL != Import(imp,ObjFile,aiProcess_Triangulate,fromCache));
+	CPPUNIT_ASSERT(fromCache);
+}
@@ -0,0 +1,48 @@
+#ifndef TESTIMPORTCACHE_H
+#define TESTIMPORTCACHE_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <assimp/Importer.hpp>
+
+using namespace std;
+using namespace Assimp;
+
+class ImportCacheTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (ImportCacheTest);
+    CPPUNIT_TEST (testRoundTrip);
+    CPPUNIT_TEST (testChangedFile);
+    CPPUNIT_TEST (testChangedDependency);
+    CPPUNIT_TEST (testChangedSettings);
+    CPPUNIT_TEST_SUITE_END ();
+
+    public:
+        void setUp (void);
+        void tearDown (void);
+
+    protected:
+
+        void testRoundTrip (void);
+        void testChangedFile (void);
+        void testChangedDependency (void);
+        void testChangedSettings (void);
+
+    private:
+
+        // Import a file through the cache. fromCache is set if the loader didn't read the file.
+        const aiScene* Import(Importer& imp, const std::string& file, unsigned int flags, bool& fromCache);
+
+        // write a small OBJ file and its material library, with a unique comment so
+        // cache entries of earlier test runs aren't used
+        void WriteObj(const char* diffuse);
+
+        // check if two scenes are identical
+        static void CompareScenes(const aiScene* a, const aiScene* b);
+        static void CompareNodes(const aiNode* a, const aiNode* b);
+
+        std::string token;
+};
+
+#endif 
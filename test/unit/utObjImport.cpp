@@ -0,0 +1,184 @@
+
+#include "UnitTestPCH.h"
+#include "utObjImport.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (ObjImportTest);
+
+// ------------------------------------------------------------------------------------------------
+void ObjImportTest::setUp (void)
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+void ObjImportTest::tearDown (void)
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiScene* ObjImportTest::Import(Importer& imp, const std::string& obj, int numThreads)
+{
+	imp.SetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING,numThreads);
+	return imp.ReadFileFromMemory(obj.c_str(),obj.length(),0,"obj");
+}
+
+// ------------------------------------------------------------------------------------------------
+void ObjImportTest::CompareNodes(const aiNode* a, const aiNode* b)
+{
+	CPPUNIT_ASSERT(0 == ::strcmp(a->mName.data,b->mName.data));
+	CPPUNIT_ASSERT(a->mNumMeshes == b->mNumMeshes);
+	CPPUNIT_ASSERT(a->mNumMeshes == 0 || 0 == ::memcmp(a->mMeshes,b->mMeshes,a->mNumMeshes*sizeof(unsigned int)));
+	CPPUNIT_ASSERT(a->mNumChildren == b->mNumChildren);
+	for (unsigned int i = 0; i < a->mNumChildren; ++i) {
+		CompareNodes(a->mChildren[i],b->mChildren[i]);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void ObjImportTest::CompareScenes(const aiScene* a, const aiScene* b)
+{
+	CPPUNIT_ASSERT(a->mNumMaterials == b->mNumMaterials);
+	CPPUNIT_ASSERT(a->mNumMeshes == b->mNumMeshes);
+	for (unsigned int i = 0; i < a->mNumMeshes; ++i) {
+		const aiMesh* const ma = a->mMeshes[i], *const mb = b->mMeshes[i];
+		CPPUNIT_ASSERT(ma->mMaterialIndex == mb->mMaterialIndex);
+		CPPUNIT_ASSERT(ma->mPrimitiveTypes == mb->mPrimitiveTypes);
+		CPPUNIT_ASSERT(ma->mNumVertices == mb->mNumVertices);
+		CPPUNIT_ASSERT(0 == ::memcmp(ma->mVertices,mb->mVertices,ma->mNumVertices*sizeof(aiVector3D)));
+		CPPUNIT_ASSERT(ma->HasNormals() == mb->HasNormals());
+		CPPUNIT_ASSERT(!ma->HasNormals() || 0 == ::memcmp(ma->mNormals,mb->mNormals,ma->mNumVertices*sizeof(aiVector3D)));
+		CPPUNIT_ASSERT(ma->HasTextureCoords(0) == mb->HasTextureCoords(0));
+		CPPUNIT_ASSERT(!ma->HasTextureCoords(0) || 
+			0 == ::memcmp(ma->mTextureCoords[0],mb->mTextureCoords[0],ma->mNumVertices*sizeof(aiVector3D)));
+
+		CPPUNIT_ASSERT(ma->mNumFaces == mb->mNumFaces);
+		for (unsigned int f = 0; f < ma->mNumFaces; ++f) {
+			CPPUNIT_ASSERT(ma->mFaces[f].mNumIndices == mb->mFaces[f].mNumIndices);
+			CPPUNIT_ASSERT(0 == ::memcmp(ma->mFaces[f].mIndices,mb->mFaces[f].mIndices,
+				ma->mFaces[f].mNumIndices*sizeof(unsigned int)));
+		}
+	}
+	CompareNodes(a->mRootNode,b->mRootNode);
+}
+
+// ------------------------------------------------------------------------------------------------
+void ObjImportTest::testMultipleChunks (void)
+{
+	// Several MB of objects, each with its own group and material and faces using both
+	// absolute and relative indices. Files this large are split into chunks which are
+	// read in parallel, so the statements and relative indices end up in different chunks.
+	static const unsigned int NumObjects = 40, NumTriangles = 1000;
+
+	std::string obj;
+	char line[256];
+	unsigned int numVertices = 0;
+	for (unsigned int o = 0; o < NumObjects; ++o) {
+		::sprintf(line,"o object%u\ng group%u\nusemtl %s\n",o,o,o % 2 ? "DefaultMaterial" : "missing");
+		obj += line;
+
+		for (unsigned int t = 0; t < NumTriangles; ++t, numVertices += 3) {
+			for (unsigned int v = numVertices; v < numVertices + 3; ++v) {
+				// the x coordinate is the index of each vertex, texture coordinate and normal
+				::sprintf(line,"v %u.0 %u.5 1.0\nvt %u.0 0.25\nvn %u.0 0.0 1.0\n",v,o,v,v);
+				obj += line;
+			}
+			if (t % 2) {
+				obj += "f -3/-3/-3 -2/-2/-2 -1/-1/-1\n";
+			}
+			else {
+				::sprintf(line,"f %u/%u/%u %u/%u/%u %u/%u/%u\n",
+					numVertices+1,numVertices+1,numVertices+1,
+					numVertices+2,numVertices+2,numVertices+2,
+					numVertices+3,numVertices+3,numVertices+3);
+				obj += line;
+			}
+		}
+	}
+
+	Importer multi, single;
+	const aiScene* const scene = Import(multi,obj,4);
+	CPPUNIT_ASSERT(NULL != scene);
+
+	// each object and each group is a node of its own, the faces go to the group. 
+	// Each triangle references the three vertices defined right before it.
+	CPPUNIT_ASSERT(scene->mRootNode->mNumChildren == NumObjects * 2);
+	unsigned int numFaces = 0;
+	for (unsigned int o = 0; o < NumObjects; ++o) {
+		::sprintf(line,"object%u",o);
+		CPPUNIT_ASSERT(0 == ::strcmp(scene->mRootNode->mChildren[o*2]->mName.data,line));
+		CPPUNIT_ASSERT(0 == scene->mRootNode->mChildren[o*2]->mNumMeshes);
+
+		const aiNode* const node = scene->mRootNode->mChildren[o*2+1];
+		::sprintf(line,"group%u",o);
+		CPPUNIT_ASSERT(0 == ::strcmp(node->mName.data,line));
+		CPPUNIT_ASSERT(1 == node->mNumMeshes);
+
+		for (unsigned int m = 0; m < node->mNumMeshes; ++m) {
+			const aiMesh* const mesh = scene->mMeshes[node->mMeshes[m]];
+			CPPUNIT_ASSERT(mesh->HasNormals() && mesh->HasTextureCoords(0));
+			for (unsigned int f = 0; f < mesh->mNumFaces; ++f, ++numFaces) {
+				const aiFace& face = mesh->mFaces[f];
+				CPPUNIT_ASSERT(3 == face.mNumIndices);
+				for (unsigned int i = 0; i < 3; ++i) {
+					const unsigned int idx = face.mIndices[i];
+					const float expected = static_cast<float>(numFaces * 3 + i);
+					CPPUNIT_ASSERT(mesh->mVertices[idx].x == expected);
+					CPPUNIT_ASSERT(mesh->mVertices[idx].y == o + 0.5f);
+					CPPUNIT_ASSERT(mesh->mTextureCoords[0][idx].x == expected);
+					CPPUNIT_ASSERT(mesh->mNormals[idx].x == expected);
+				}
+			}
+		}
+	}
+	CPPUNIT_ASSERT(numFaces == NumObjects * NumTriangles);
+
+	// and reading the file in a single chunk yields the same
+	CompareScenes(scene,Import(single,obj,1));
+}
+
+// ------------------------------------------------------------------------------------------------
+void ObjImportTest::testLinesAndPoints (void)
+{
+	// Lines and points are stored in the same flat index buffers as polygons, with
+	// texture coordinates and normals for some of the faces only
+	const std::string obj = 
+		"v 0 0 0\nv 1 0 0\nv 2 0 0\nv 3 0 0\n"
+		"vt 0 0\nvt 1 0\nvt 2 0\nvt 3 0\n"
+		"vn 0 0 1\n"
+		"l 1 2 3 4\n"
+		"p 4 3\n"
+		"f 1/1/1 2/2/1 3/3/1\n"
+		"l 4/4 1/1\n"
+		"p -1 -2\n";
+
+	Importer imp;
+	const aiScene* const scene = Import(imp,obj,1);
+	CPPUNIT_ASSERT(NULL != scene);
+	CPPUNIT_ASSERT(1 == scene->mNumMeshes);
+
+	const aiMesh* const mesh = scene->mMeshes[0];
+	CPPUNIT_ASSERT(mesh->mPrimitiveTypes == (aiPrimitiveType_POINT | aiPrimitiveType_LINE | aiPrimitiveType_TRIANGLE));
+
+	// a line with n vertices is split into n-1 segments, a point statement into single points
+	static const unsigned int numIndices[] = {2,2,2, 1,1, 3, 2, 1,1};
+	static const float x[] = {0,1, 1,2, 2,3, 3, 2, 0,1,2, 3,0, 3, 2};
+	CPPUNIT_ASSERT(sizeof(numIndices) / sizeof(numIndices[0]) == mesh->mNumFaces);
+	CPPUNIT_ASSERT(sizeof(x) / sizeof(x[0]) == mesh->mNumVertices);
+
+	unsigned int idx = 0;
+	for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+		CPPUNIT_ASSERT(numIndices[f] == mesh->mFaces[f].mNumIndices);
+		for (unsigned int i = 0; i < numIndices[f]; ++i, ++idx) {
+			CPPUNIT_ASSERT(idx == mesh->mFaces[f].mIndices[i]);
+			CPPUNIT_ASSERT(x[idx] == mesh->mVertices[idx].x);
+		}
+	}
+
+	// texture coordinates of the triangle and the second line, normals of the triangle only
+	CPPUNIT_ASSERT(mesh->HasTextureCoords(0) && mesh->HasNormals());
+	for (unsigned int i = 8; i < 13; ++i) {
+		CPPUNIT_ASSERT(x[i] == mesh->mTextureCoords[0][i].x);
+	}
+	for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+		CPPUNIT_ASSERT((i >= 8 && i < 11 ? 1.f : 0.f) == mesh->mNormals[i].z);
+	}
+}
@@ -0,0 +1,38 @@
+#ifndef TESTOBJIMPORT_H
+#define TESTOBJIMPORT_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <assimp/Importer.hpp>
+
+using namespace std;
+using namespace Assimp;
+
+class ObjImportTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (ObjImportTest);
+    CPPUNIT_TEST (testMultipleChunks);
+    CPPUNIT_TEST (testLinesAndPoints);
+    CPPUNIT_TEST_SUITE_END ();
+
+    public:
+        void setUp (void);
+        void tearDown (void);
+
+    protected:
+
+        void testMultipleChunks (void);
+        void testLinesAndPoints (void);
+
+    private:
+
+        // import an OBJ file from memory, using the given number of threads
+        const aiScene* Import(Importer& imp, const std::string& obj, int numThreads);
+
+        // check if two imported scenes are identical
+        static void CompareScenes(const aiScene* a, const aiScene* b);
+        static void CompareNodes(const aiNode* a, const aiNode* b);
+};
+
+#endif 
@@ -0,0 +1,343 @@
+
+#include "UnitTestPCH.h"
+#include "utPlyImport.h"
+
+#include <assimp/LogStream.hpp>
+
+CPPUNIT_TEST_SUITE_REGISTRATION (PlyImportTest);
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Builds a binary PLY file in memory. The DOM variant of a file gets an extra element 
+// with a list in front of all others. Its size isn't fixed, so the loader can't read 
+// the file without building the DOM, but the element is ignored and the result is the same.
+class PlyBuilder
+{
+public:
+
+	PlyBuilder(bool bigEndian, bool dom)
+		: mBigEndian(bigEndian)
+	{
+		if (dom) {
+			Header("element unknown_list 2");
+			Header("property list uchar ushort data");
+			Put<unsigned char>(1);
+			Put<unsigned short>(7);
+			Put<unsigned char>(3);
+			Put<unsigned short>(7);
+			Put<unsigned short>(8);
+			Put<unsigned short>(9);
+		}
+	}
+
+	void Header(const std::string& line) {
+		mHeader += line + "\n";
+	}
+
+	template <typename T>
+	void Put(T value) {
+		const uint16_t one = 1;
+		const bool hostBigEndian = 0 == *reinterpret_cast<const unsigned char*>(&one);
+
+		char* p = reinterpret_cast<char*>(&value);
+		if (hostBigEndian != mBigEndian) {
+			std::reverse(p,p+sizeof(T));
+		}
+		mData.append(p,sizeof(T));
+	}
+
+	std::string Str() const {
+		return std::string("ply\nformat binary_") + (mBigEndian ? "big" : "little") + 
+			"_endian 1.0\n" + mHeader + "end_header\n" + mData;
+	}
+
+private:
+
+	bool mBigEndian;
+	std::string mHeader, mData;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Watches the log for the message of the fixed-layout path
+class FixedLayoutLogStream : public LogStream
+{
+public:
+
+	FixedLayoutLogStream()
+		: mFound(false)
+	{}
+
+	void write(const char* message) {
+		if (::strstr(message,"fixed layout")) {
+			mFound = true;
+		}
+	}
+
+	bool mFound;
+};
+
+// ------------------------------------------------------------------------------------------------
+// A quad made of two triangles with normals and colors
+std::string MakeQuad(bool bigEndian, bool dom)
+{
+	PlyBuilder ply(bigEndian,dom);
+	ply.Header("element vertex 4");
+	ply.Header("property float x");
+	ply.Header("property float y");
+	ply.Header("property float z");
+	ply.Header("property float nx");
+	ply.Header("property float ny");
+	ply.Header("property float nz");
+	ply.Header("property uchar red");
+	ply.Header("property uchar green");
+	ply.Header("property uchar blue");
+	ply.Header("element face 2");
+	ply.Header("property list uchar int vertex_indices");
+
+	for (unsigned int i = 0; i < 4; ++i) {
+		ply.Put<float>(static_cast<float>(i & 1));
+		ply.Put<float>(static_cast<float>(i >> 1));
+		ply.Put<float>(-1.5f);
+		ply.Put<float>(0.f);
+		ply.Put<float>(0.f);
+		ply.Put<float>(1.f);
+		ply.Put<unsigned char>(static_cast<unsigned char>(i * 60));
+		ply.Put<unsigned char>(255);
+		ply.Put<unsigned char>(0);
+	}
+
+	ply.Put<unsigned char>(3);
+	ply.Put<int>(0);
+	ply.Put<int>(1);
+	ply.Put<int>(3);
+	ply.Put<unsigned char>(3);
+	ply.Put<int>(0);
+	ply.Put<int>(3);
+	ply.Put<int>(2);
+	return ply.Str();
+}
+
+} // ! anon namespace
+
+// ------------------------------------------------------------------------------------------------
+void PlyImportTest::setUp (void)
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+void PlyImportTest::tearDown (void)
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiScene* PlyImportTest::Import(Importer& imp, const std::string& ply, bool fixedLayout)
+{
+	FixedLayoutLogStream stream;
+	DefaultLogger::get()->attachStream(&stream,Logger::Debugging);
+
+	const aiScene* scene = imp.ReadFileFromMemory(ply.data(),ply.length(),0,"ply");
+
+	DefaultLogger::get()->detatchStream(&stream,Logger::Debugging);
+	CPPUNIT_ASSERT(NULL != scene);
+	CPPUNIT_ASSERT(fixedLayout == stream.mFound);
+	return scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+void PlyImportTest::CompareScenes(const aiScene* a, const aiScene* b)
+{
+	CPPUNIT_ASSERT(a->mNumMeshes == b->mNumMeshes);
+	for (unsigned int i = 0; i < a->mNumMeshes; ++i) {
+		const aiMesh* ma = a->mMeshes[i], *mb = b->mMeshes[i];
+
+		CPPUNIT_ASSERT(ma->mNumVertices == mb->mNumVertices);
+		CPPUNIT_ASSERT(ma->HasNormals() == mb->HasNormals());
+		CPPUNIT_ASSERT(ma->HasVertexColors(0) == mb->HasVertexColors(0));
+		CPPUNIT_ASSERT(ma->HasTextureCoords(0) == mb->HasTextureCoords(0));
+		for (unsigned int v = 0; v < ma->mNumVertices; ++v) {
+			CPPUNIT_ASSERT(ma->mVertices[v] == mb->mVertices[v]);
+			CPPUNIT_ASSERT(!ma->HasNormals() || ma->mNormals[v] == mb->mNormals[v]);
+			CPPUNIT_ASSERT(!ma->HasVertexColors(0) || ma->mColors[0][v] == mb->mColors[0][v]);
+			CPPUNIT_ASSERT(!ma->HasTextureCoords(0) || ma->mTextureCoords[0][v] == mb->mTextureCoords[0][v]);
+		}
+
+		CPPUNIT_ASSERT(ma->mNumFaces == mb->mNumFaces);
+		for (unsigned int f = 0; f < ma->mNumFaces; ++f) {
+			CPPUNIT_ASSERT(ma->mFaces[f].mNumIndices == mb->mFaces[f].mNumIndices);
+			CPPUNIT_ASSERT(0 == ::memcmp(ma->mFaces[f].mIndices,mb->mFaces[f].mIndices,
+				ma->mFaces[f].mNumIndices * sizeof(unsigned int)));
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void PlyImportTest::testEndianness (void)
+{
+	Importer le, be, leDom, beDom;
+	const aiScene* scene = Import(le,MakeQuad(false,false),true);
+	CompareScenes(scene,Import(be,MakeQuad(true,false),true));
+	CompareScenes(scene,Import(leDom,MakeQuad(false,true),false));
+	CompareScenes(scene,Import(beDom,MakeQuad(true,true),false));
+
+	// check the values themselves once
+	const aiMesh* mesh = scene->mMeshes[0];
+	CPPUNIT_ASSERT(6 == mesh->mNumVertices && 2 == mesh->mNumFaces);
+	CPPUNIT_ASSERT(mesh->mVertices[2] == aiVector3D(1.f,1.f,-1.5f));
+	CPPUNIT_ASSERT(mesh->mVertices[5] == aiVector3D(0.f,1.f,-1.5f));
+	CPPUNIT_ASSERT(mesh->mNormals[4] == aiVector3D(0.f,0.f,1.f));
+	CPPUNIT_ASSERT(mesh->mColors[0][1] == aiColor4D(60.f/255.f,1.f,0.f,1.f));
+	CPPUNIT_ASSERT(3 == mesh->mFaces[1].mNumIndices && 5 == mesh->mFaces[1].mIndices[2]);
+}
+
+// ------------------------------------------------------------------------------------------------
+void PlyImportTest::testUShort (void)
+{
+	// values above 32767 used to be sign-extended on the DOM path
+	for (unsigned int i = 0; i < 4; ++i) {
+		const bool bigEndian = 0 != (i & 1), dom = 0 != (i & 2);
+
+		PlyBuilder ply(bigEndian,dom);
+		ply.Header("element vertex 3");
+		ply.Header("property ushort x");
+		ply.Header("property ushort y");
+		ply.Header("property ushort z");
+		ply.Header("element face 1");
+		ply.Header("property list uchar ushort vertex_indices");
+		for (unsigned int v = 0; v < 3; ++v) {
+			ply.Put<unsigned short>(static_cast<unsigned short>(40000 + v));
+			ply.Put<unsigned short>(65535);
+			ply.Put<unsigned short>(static_cast<unsigned short>(v));
+		}
+		ply.Put<unsigned char>(3);
+		ply.Put<unsigned short>(2);
+		ply.Put<unsigned short>(1);
+		ply.Put<unsigned short>(0);
+
+		Importer imp;
+		const aiMesh* mesh = Import(imp,ply.Str(),!dom)->mMeshes[0];
+		CPPUNIT_ASSERT(3 == mesh->mNumVertices);
+		CPPUNIT_ASSERT(mesh->mVertices[0] == aiVector3D(40002.f,65535.f,2.f));
+		CPPUNIT_ASSERT(mesh->mVertices[2] == aiVector3D(40000.f,65535.f,0.f));
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void PlyImportTest::testNoFaces (void)
+{
+	// without a face list, every three vertices make a triangle. The DOM path 
+	// used to produce faces with six indices, the superfluous vertices are dropped.
+	Importer imp[4];
+	for (unsigned int i = 0; i < 4; ++i) {
+		const bool bigEndian = 0 != (i & 1), dom = 0 != (i & 2);
+
+		PlyBuilder ply(bigEndian,dom);
+		ply.Header("element vertex 7");
+		ply.Header("property float x");
+		ply.Header("property float y");
+		ply.Header("property float z");
+		for (unsigned int v = 0; v < 7; ++v) {
+			ply.Put<float>(static_cast<float>(v));
+			ply.Put<float>(static_cast<float>(v) * 0.5f);
+			ply.Put<float>(0.f);
+		}
+
+		const aiScene* scene = Import(imp[i],ply.Str(),!dom);
+		const aiMesh* mesh = scene->mMeshes[0];
+		CPPUNIT_ASSERT(2 == mesh->mNumFaces);
+		for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+			CPPUNIT_ASSERT(3 == mesh->mFaces[f].mNumIndices);
+			for (unsigned int n = 0; n < 3; ++n) {
+				CPPUNIT_ASSERT(mesh->mFaces[f].mIndices[n] < mesh->mNumVertices);
+				CPPUNIT_ASSERT(mesh->mVertices[mesh->mFaces[f].mIndices[n]].x == static_cast<float>(f * 3 + n));
+			}
+		}
+		if (i) {
+			CompareScenes(imp[0].GetScene(),scene);
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void PlyImportTest::testElementBeforeVertices (void)
+{
+	// fixed-size elements with unknown names must be skipped on both paths. The
+	// DOM path used to give such elements a count of zero.
+	Importer imp[4];
+	for (unsigned int i = 0; i < 4; ++i) {
+		const bool bigEndian = 0 != (i & 1), dom = 0 != (i & 2);
+
+		PlyBuilder ply(bigEndian,dom);
+		ply.Header("element range_grid_info 2");
+		ply.Header("property float scale");
+		ply.Header("property short id");
+		ply.Header("element vertex 3");
+		ply.Header("property double x");
+		ply.Header("property double y");
+		ply.Header("property double z");
+		ply.Header("property float s");
+		ply.Header("property float t");
+		ply.Header("element face 1");
+		ply.Header("property uchar flags");
+		ply.Header("property list uchar uint vertex_indices");
+
+		ply.Put<float>(7.f);
+		ply.Put<short>(-1);
+		ply.Put<float>(8.f);
+		ply.Put<short>(-2);
+		for (unsigned int v = 0; v < 3; ++v) {
+			ply.Put<double>(v + 0.25);
+			ply.Put<double>(-1.0);
+			ply.Put<double>(2.0);
+			ply.Put<float>(0.5f * v);
+			ply.Put<float>(1.f);
+		}
+		ply.Put<unsigned char>(0xff);
+		ply.Put<unsigned char>(3);
+		ply.Put<unsigned int>(0);
+		ply.Put<unsigned int>(1);
+		ply.Put<unsigned int>(2);
+
+		const aiScene* scene = Import(imp[i],ply.Str(),!dom);
+		const aiMesh* mesh = scene->mMeshes[0];
+		CPPUNIT_ASSERT(3 == mesh->mNumVertices && 1 == mesh->mNumFaces);
+		CPPUNIT_ASSERT(mesh->mVertices[1] == aiVector3D(1.25f,-1.f,2.f));
+		CPPUNIT_ASSERT(mesh->mTextureCoords[0][2] == aiVector3D(1.f,1.f,0.f));
+		if (i) {
+			CompareScenes(imp[0].GetScene(),scene);
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void PlyImportTest::testWhitespaceAfterHeader (void)
+{
+	// the first data bytes look like blanks and line ends, they used to be 
+	// swallowed by the header parser. The data must start with them on the
+	// DOM path as well, so a list in the vertices forces it instead.
+	for (unsigned int i = 0; i < 4; ++i) {
+		const bool bigEndian = 0 != (i & 1), dom = 0 != (i & 2);
+
+		PlyBuilder ply(bigEndian,false);
+		ply.Header("element vertex 3");
+		ply.Header("property uchar x");
+		ply.Header("property uchar y");
+		ply.Header("property uchar z");
+		if (dom) {
+			ply.Header("property list uchar uchar extra");
+		}
+		const unsigned char data[9] = {' ','\n','\r','\t',' ','\n','\r','\t',' '};
+		for (unsigned int n = 0; n < 9; ++n) {
+			ply.Put<unsigned char>(data[n]);
+			if (dom && 2 == n % 3) {
+				ply.Put<unsigned char>(0);
+			}
+		}
+
+		Importer imp;
+		const aiMesh* mesh = Import(imp,ply.Str(),!dom)->mMeshes[0];
+		CPPUNIT_ASSERT(3 == mesh->mNumVertices);
+		CPPUNIT_ASSERT(mesh->mVertices[0] == aiVector3D(' ','\n','\r'));
+		CPPUNIT_ASSERT(mesh->mVertices[2] == aiVector3D('\r','\t',' '));
+	}
+}
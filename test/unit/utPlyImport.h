@@ -0,0 +1,43 @@
+#ifndef TESTPLYIMPORT_H
+#define TESTPLYIMPORT_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <assimp/Importer.hpp>
+
+using namespace std;
+using namespace Assimp;
+
+class PlyImportTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (PlyImportTest);
+    CPPUNIT_TEST (testEndianness);
+    CPPUNIT_TEST (testUShort);
+    CPPUNIT_TEST (testNoFaces);
+    CPPUNIT_TEST (testElementBeforeVertices);
+    CPPUNIT_TEST (testWhitespaceAfterHeader);
+    CPPUNIT_TEST_SUITE_END ();
+
+    public:
+        void setUp (void);
+        void tearDown (void);
+
+    protected:
+
+        void testEndianness (void);
+        void testUShort (void);
+        void testNoFaces (void);
+        void testElementBeforeVertices (void);
+        void testWhitespaceAfterHeader (void);
+
+    private:
+
+        // import a PLY file from memory, check which path the loader took
+        const aiScene* Import(Importer& imp, const std::string& ply, bool fixedLayout);
+
+        // check if two imported meshes are identical
+        static void CompareScenes(const aiScene* a, const aiScene* b);
+};
+
+#endif 
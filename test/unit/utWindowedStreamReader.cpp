@@ -0,0 +1,196 @@
+
+#include "UnitTestPCH.h"
+#include "utWindowedStreamReader.h"
+
+#include <MemoryIOWrapper.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION (WindowedStreamReaderTest);
+
+namespace {
+
+	// tiny window to get many refills, it must hold a uint64_t at least
+	const size_t WindowSize = 16;
+
+// ------------------------------------------------------------------------------------------------
+// Memory stream which counts the reads and optionally hides its view, so the reader 
+// has to go through its window just as for files on disk
+class TestStream : public MemoryIOStream
+{
+public:
+	TestStream(const uint8_t* buff, size_t len, bool view)
+		: MemoryIOStream(buff,len)
+		, view(view)
+		, reads()
+	{}
+
+	size_t Read(void* pvBuffer, size_t pSize, size_t pCount) {
+		++reads;
+		return MemoryIOStream::Read(pvBuffer,pSize,pCount);
+	}
+
+	const void* GetView() const {
+		return view ? MemoryIOStream::GetView() : NULL;
+	}
+
+	bool view;
+	unsigned int reads;
+};
+
+} // ! anon namespace
+
+// ------------------------------------------------------------------------------------------------
+void WindowedStreamReaderTest :: setUp (void)
+{
+	for (unsigned int i = 0; i < sizeof(data); ++i) {
+		data[i] = static_cast<uint8_t>(i);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void WindowedStreamReaderTest :: tearDown (void)
+{
+	// nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+void WindowedStreamReaderTest :: testReadAcrossWindows (void)
+{
+	TestStream* stream = new TestStream(data,sizeof(data),false);
+	WindowedStreamReaderLE reader(stream,false,WindowSize);
+
+	// 14..17 straddles the boundary of the first window
+	reader.IncPtr(14);
+	CPPUNIT_ASSERT(reader.GetU4() == 0x11100f0e);
+	CPPUNIT_ASSERT(reader.GetU1() == 18);
+	CPPUNIT_ASSERT(reader.GetU2() == 0x1413);
+	CPPUNIT_ASSERT(reader.GetCurrentPos() == 21);
+
+	// copies spanning several windows
+	uint8_t out[100];
+	reader.CopyAndAdvance(out,sizeof(out));
+	CPPUNIT_ASSERT(!::memcmp(out,data + 21,sizeof(out)));
+
+	// the rest byte by byte
+	while (reader.GetRemainingSize()) {
+		const size_t pos = reader.GetCurrentPos();
+		CPPUNIT_ASSERT(reader.GetU1() == data[pos]);
+	}
+	CPPUNIT_ASSERT(reader.GetCurrentPos() == sizeof(data));
+
+	// the window has been refilled as reading went on
+	CPPUNIT_ASSERT(stream->reads >= (sizeof(data) - 14) / WindowSize);
+
+	bool thrown = false;
+	try {
+		reader.GetU1();
+	}
+	catch (const DeadlyImportError&) {
+		thrown = true;
+	}
+	CPPUNIT_ASSERT(thrown);
+}
+
+// ------------------------------------------------------------------------------------------------
+void WindowedStreamReaderTest :: testSeekBackward (void)
+{
+	TestStream* stream = new TestStream(data,sizeof(data),false);
+
+	// reading starts at the current file pointer, all positions are relative to it
+	stream->Seek(10,aiOrigin_SET);
+	WindowedStreamReaderLE reader(stream,false,WindowSize);
+	CPPUNIT_ASSERT(reader.GetRemainingSize() == sizeof(data) - 10);
+
+	reader.SetCurrentPos(200);
+	CPPUNIT_ASSERT(reader.GetU1() == 210);
+
+	// back to a position before the current window
+	reader.SetCurrentPos(3);
+	CPPUNIT_ASSERT(reader.GetU1() == 13);
+	CPPUNIT_ASSERT(reader.GetU8() == 0x1514131211100f0eULL);
+
+	reader.IncPtr(100);
+	CPPUNIT_ASSERT(reader.GetU1() == 122);
+	reader.IncPtr(-90);
+	CPPUNIT_ASSERT(reader.GetCurrentPos() == 23);
+	CPPUNIT_ASSERT(reader.GetU2() == 0x2221);
+
+	// neither before the beginning nor behind the end
+	bool thrown = false;
+	try {
+		reader.IncPtr(-26);
+	}
+	catch (const DeadlyImportError&) {
+		thrown = true;
+	}
+	CPPUNIT_ASSERT(thrown);
+	CPPUNIT_ASSERT(reader.GetCurrentPos() == 25);
+
+	thrown = false;
+	try {
+		reader.SetCurrentPos(sizeof(data));
+	}
+	catch (const DeadlyImportError&) {
+		thrown = true;
+	}
+	CPPUNIT_ASSERT(thrown);
+}
+
+// ------------------------------------------------------------------------------------------------
+void WindowedStreamReaderTest :: testReadLimit (void)
+{
+	WindowedStreamReaderLE reader(new TestStream(data,sizeof(data),false),false,WindowSize);
+
+	reader.SetReadLimit(20);
+	CPPUNIT_ASSERT(reader.GetReadLimit() == 20);
+	reader.IncPtr(18);
+	CPPUNIT_ASSERT(reader.GetRemainingSizeToLimit() == 2);
+	CPPUNIT_ASSERT(reader.GetRemainingSize() == sizeof(data) - 18);
+
+	// a read crossing the limit fails, but doesn't move the file pointer
+	bool thrown = false;
+	try {
+		reader.GetU4();
+	}
+	catch (const DeadlyImportError&) {
+		thrown = true;
+	}
+	CPPUNIT_ASSERT(thrown);
+	CPPUNIT_ASSERT(reader.GetU2() == 0x1312);
+
+	reader.SetReadLimit(SIZE_MAX);
+	CPPUNIT_ASSERT(reader.GetReadLimit() == sizeof(data));
+	CPPUNIT_ASSERT(reader.GetU4() == 0x17161514);
+
+	reader.SetReadLimit(100);
+	reader.SkipToReadLimit();
+	CPPUNIT_ASSERT(reader.GetCurrentPos() == 100);
+
+	thrown = false;
+	try {
+		reader.SetReadLimit(sizeof(data) + 1);
+	}
+	catch (const DeadlyImportError&) {
+		thrown = true;
+	}
+	CPPUNIT_ASSERT(thrown);
+}
+
+// ------------------------------------------------------------------------------------------------
+void WindowedStreamReaderTest :: testView (void)
+{
+	TestStream* stream = new TestStream(data,sizeof(data),true);
+	stream->Seek(1,aiOrigin_SET);
+
+	// streams with a view are read in place, regardless of the window size
+	WindowedStreamReaderBE reader(stream,false,WindowSize);
+	CPPUNIT_ASSERT(reader.GetU4() == 0x01020304);
+
+	reader.SetCurrentPos(250);
+	CPPUNIT_ASSERT(reader.GetU2() == 0xfbfc);
+
+	uint8_t out[200];
+	reader.SetCurrentPos(10);
+	reader.CopyAndAdvance(out,sizeof(out));
+	CPPUNIT_ASSERT(!::memcmp(out,data + 11,sizeof(out)));
+	CPPUNIT_ASSERT(stream->reads == 0);
+}
@@ -0,0 +1,38 @@
+#ifndef TESTWINDOWEDSTREAMREADER_H
+#define TESTWINDOWEDSTREAMREADER_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <WindowedStreamReader.h>
+
+using namespace std;
+using namespace Assimp;
+
+class WindowedStreamReaderTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (WindowedStreamReaderTest);
+    CPPUNIT_TEST (testReadAcrossWindows);
+    CPPUNIT_TEST (testSeekBackward);
+    CPPUNIT_TEST (testReadLimit);
+    CPPUNIT_TEST (testView);
+    CPPUNIT_TEST_SUITE_END ();
+
+    public:
+        void setUp (void);
+        void tearDown (void);
+
+    protected:
+
+        void testReadAcrossWindows (void);
+        void testSeekBackward (void);
+        void testReadLimit (void);
+        void testView (void);
+
+    private:
+
+        // each byte holds its own offset
+        uint8_t data[256];
+};
+
+#endif 
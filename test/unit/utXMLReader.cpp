@@ -0,0 +1,220 @@
+
+#include "UnitTestPCH.h"
+#include "utXMLReader.h"
+
+#include <MemoryIOWrapper.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION (XMLReaderTest);
+
+// ------------------------------------------------------------------------------------------------
+void XMLReaderTest::setUp (void)
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+void XMLReaderTest::tearDown (void)
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+XMLReader* XMLReaderTest::Open(const char* xml)
+{
+	// the reader copies the stream contents
+	MemoryIOStream stream(reinterpret_cast<const uint8_t*>(xml),::strlen(xml));
+	return new XMLReader(&stream);
+}
+
+// ------------------------------------------------------------------------------------------------
+void XMLReaderTest::Expect(XMLReader* reader, XMLNodeType type, const char* name)
+{
+	CPPUNIT_ASSERT(reader->read());
+	CPPUNIT_ASSERT(type == reader->getNodeType());
+	CPPUNIT_ASSERT_EQUAL(std::string(name),std::string(reader->getNodeName()));
+}
+
+// ------------------------------------------------------------------------------------------------
+void XMLReaderTest::testEntities (void)
+{
+	boost::scoped_ptr<XMLReader> reader(Open(
+		"<a b=\"x &amp; &lt;y&gt; &quot;q&quot; &apos;s&apos;\" c='&amp;amp;'>"
+		"1 &lt; 2 &amp;&amp; 3 &gt; 2 &unknown; &amp</a>"));
+
+	Expect(reader.get(),XML_ELEMENT,"a");
+	CPPUNIT_ASSERT(2 == reader->getAttributeCount());
+	CPPUNIT_ASSERT_EQUAL(std::string("x & <y> \"q\" 's'"),std::string(reader->getAttributeValue("b")));
+
+	// entities are replaced only once
+	CPPUNIT_ASSERT_EQUAL(std::string("&amp;"),std::string(reader->getAttributeValue("c")));
+
+	// unknown entities are left as they are
+	Expect(reader.get(),XML_TEXT,"1 < 2 && 3 > 2 &unknown; &amp");
+	Expect(reader.get(),XML_ELEMENT_END,"a");
+	CPPUNIT_ASSERT(!reader->read());
+}
+
+// ------------------------------------------------------------------------------------------------
+void XMLReaderTest::testQuotes (void)
+{
+	boost::scoped_ptr<XMLReader> reader(Open(
+		"<a x='1' y=\"two words\" z='a>b' w=\"it's\" v='say \"hi\"' u = \"1.5\" t=\"\"/>"));
+
+	Expect(reader.get(),XML_ELEMENT,"a");
+	CPPUNIT_ASSERT(reader->isEmptyElement());
+	CPPUNIT_ASSERT(7 == reader->getAttributeCount());
+
+	CPPUNIT_ASSERT_EQUAL(std::string("x"),std::string(reader->getAttributeName(0)));
+	CPPUNIT_ASSERT(1 == reader->getAttributeValueAsInt("x"));
+	CPPUNIT_ASSERT_EQUAL(std::string("two words"),std::string(reader->getAttributeValue("y")));
+
+	// '>' and the other kind of quotes may appear inside values
+	CPPUNIT_ASSERT_EQUAL(std::string("a>b"),std::string(reader->getAttributeValue("z")));
+	CPPUNIT_ASSERT_EQUAL(std::string("it's"),std::string(reader->getAttributeValue("w")));
+	CPPUNIT_ASSERT_EQUAL(std::string("say \"hi\""),std::string(reader->getAttributeValue(4)));
+
+	// blanks around '='
+	CPPUNIT_ASSERT(1.5f == reader->getAttributeValueAsFloat("u"));
+	CPPUNIT_ASSERT_EQUAL(std::string(""),std::string(reader->getAttributeValue("t")));
+
+	CPPUNIT_ASSERT(NULL == reader->getAttributeValue("s"));
+	CPPUNIT_ASSERT(NULL == reader->getAttributeValue(7));
+	CPPUNIT_ASSERT_EQUAL(std::string(""),std::string(reader->getAttributeValueSafe("s")));
+	CPPUNIT_ASSERT(0 == reader->getAttributeValueAsInt("s"));
+	CPPUNIT_ASSERT(!reader->read());
+}
+
+// ------------------------------------------------------------------------------------------------
+void XMLReaderTest::testEmptyElements (void)
+{
+	boost::scoped_ptr<XMLReader> reader(Open("<r><a/><a></a><b x=\"1\"/><c /></r>"));
+
+	Expect(reader.get(),XML_ELEMENT,"r");
+	CPPUNIT_ASSERT(!reader->isEmptyElement());
+
+	// <a/> has no end node
+	Expect(reader.get(),XML_ELEMENT,"a");
+	CPPUNIT_ASSERT(reader->isEmptyElement());
+
+	// but <a></a> has
+	Expect(reader.get(),XML_ELEMENT,"a");
+	CPPUNIT_ASSERT(!reader->isEmptyElement());
+	Expect(reader.get(),XML_ELEMENT_END,"a");
+
+	Expect(reader.get(),XML_ELEMENT,"b");
+	CPPUNIT_ASSERT(reader->isEmptyElement());
+	CPPUNIT_ASSERT(1 == reader->getAttributeValueAsInt("x"));
+
+	Expect(reader.get(),XML_ELEMENT,"c");
+	CPPUNIT_ASSERT(reader->isEmptyElement());
+
+	Expect(reader.get(),XML_ELEMENT_END,"r");
+	CPPUNIT_ASSERT(!reader->read());
+}
+
+// ------------------------------------------------------------------------------------------------
+void XMLReaderTest::testSpecialNodes (void)
+{
+	boost::scoped_ptr<XMLReader> reader(Open(
+		"<?xml version=\"1.0\" encoding=\"utf-8\"?>"
+		"<!DOCTYPE r [<!ENTITY e \"x\"><!ELEMENT r ANY>]>"
+		"<r><!-- a comment --><![CDATA[<raw> & ]] >]]><?pi data?><a/></r>"));
+
+	// the declaration and processing instructions are reported as unknown nodes
+	Expect(reader.get(),XML_UNKNOWN,"");
+
+	// the DOCTYPE declaration is skipped as a whole, including its nested tags
+	CPPUNIT_ASSERT(reader->read());
+	CPPUNIT_ASSERT(XML_COMMENT == reader->getNodeType());
+
+	Expect(reader.get(),XML_ELEMENT,"r");
+	Expect(reader.get(),XML_COMMENT," a comment ");
+
+	// CDATA contents are returned as they are
+	Expect(reader.get(),XML_CDATA,"<raw> & ]] >");
+	Expect(reader.get(),XML_UNKNOWN,"");
+	Expect(reader.get(),XML_ELEMENT,"a");
+	Expect(reader.get(),XML_ELEMENT_END,"r");
+	CPPUNIT_ASSERT(!reader->read());
+}
+
+// ------------------------------------------------------------------------------------------------
+void XMLReaderTest::testShortWhitespace (void)
+{
+	boost::scoped_ptr<XMLReader> reader(Open(
+		"<r>\r\n<a/>\n\t\t<b>  </b><c> x</c><d>ab</d></r>"));
+
+	// whitespace runs shorter than three characters are skipped
+	Expect(reader.get(),XML_ELEMENT,"r");
+	Expect(reader.get(),XML_ELEMENT,"a");
+
+	// longer ones are not
+	Expect(reader.get(),XML_TEXT,"\n\t\t");
+	Expect(reader.get(),XML_ELEMENT,"b");
+	Expect(reader.get(),XML_ELEMENT_END,"b");
+
+	// and short text which isn't just whitespace is reported, too
+	Expect(reader.get(),XML_ELEMENT,"c");
+	Expect(reader.get(),XML_TEXT," x");
+	Expect(reader.get(),XML_ELEMENT_END,"c");
+	Expect(reader.get(),XML_ELEMENT,"d");
+	Expect(reader.get(),XML_TEXT,"ab");
+	Expect(reader.get(),XML_ELEMENT_END,"d");
+	Expect(reader.get(),XML_ELEMENT_END,"r");
+	CPPUNIT_ASSERT(!reader->read());
+}
+
+// ------------------------------------------------------------------------------------------------
+void XMLReaderTest::testTrailingText (void)
+{
+	// text after the root element ends the file, it isn't reported
+	boost::scoped_ptr<XMLReader> reader(Open("<r>x</r>\n  trailing text"));
+	Expect(reader.get(),XML_ELEMENT,"r");
+	Expect(reader.get(),XML_TEXT,"x");
+	Expect(reader.get(),XML_ELEMENT_END,"r");
+	CPPUNIT_ASSERT(!reader->read());
+	CPPUNIT_ASSERT(!reader->read());
+
+	reader.reset(Open("<r/>trailing"));
+	Expect(reader.get(),XML_ELEMENT,"r");
+	CPPUNIT_ASSERT(!reader->read());
+
+	// an unterminated tag at the end doesn't read past the buffer
+	reader.reset(Open("<r><a x=\"1"));
+	Expect(reader.get(),XML_ELEMENT,"r");
+	Expect(reader.get(),XML_ELEMENT,"a");
+	CPPUNIT_ASSERT(!reader->read());
+}
+
+// ------------------------------------------------------------------------------------------------
+void XMLReaderTest::testSkipElement (void)
+{
+	boost::scoped_ptr<XMLReader> reader(Open(
+		"<r>"
+		"<a x=\"1\"><a><a/></a><b>text &amp; more</b><!-- </a> --><![CDATA[</a>]]>"
+		"<?pi </a>?><a y='>'></a><a z=\"/\"></a></a>"
+		"<c/>"
+		"<d/>"
+		"</r>"));
+
+	Expect(reader.get(),XML_ELEMENT,"r");
+	Expect(reader.get(),XML_ELEMENT,"a");
+	CPPUNIT_ASSERT(1 == reader->getAttributeValueAsInt("x"));
+
+	// nested elements with the same name, end tags in comments and CDATA, '>' and '/' 
+	// in attribute values don't end the element early
+	CPPUNIT_ASSERT(reader->skipElement());
+	CPPUNIT_ASSERT(XML_ELEMENT_END == reader->getNodeType());
+	CPPUNIT_ASSERT_EQUAL(std::string("a"),std::string(reader->getNodeName()));
+	Expect(reader.get(),XML_ELEMENT,"c");
+
+	// skipping an empty element does nothing
+	CPPUNIT_ASSERT(reader->skipElement());
+	Expect(reader.get(),XML_ELEMENT,"d");
+	Expect(reader.get(),XML_ELEMENT_END,"r");
+	CPPUNIT_ASSERT(!reader->read());
+
+	// an element which isn't closed runs into the end of the file
+	reader.reset(Open("<r><a><a></a>"));
+	Expect(reader.get(),XML_ELEMENT,"r");
+	CPPUNIT_ASSERT(!reader->skipElement());
+	CPPUNIT_ASSERT(!reader->read());
+}
@@ -0,0 +1,47 @@
+#ifndef TESTXMLREADER_H
+#define TESTXMLREADER_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <XMLReader.h>
+
+using namespace std;
+using namespace Assimp;
+
+class XMLReaderTest : public CPPUNIT_NS :: TestFixture
+{
+    CPPUNIT_TEST_SUITE (XMLReaderTest);
+    CPPUNIT_TEST (testEntities);
+    CPPUNIT_TEST (testQuotes);
+    CPPUNIT_TEST (testEmptyElements);
+    CPPUNIT_TEST (testSpecialNodes);
+    CPPUNIT_TEST (testShortWhitespace);
+    CPPUNIT_TEST (testTrailingText);
+    CPPUNIT_TEST (testSkipElement);
+    CPPUNIT_TEST_SUITE_END ();
+
+    public:
+        void setUp (void);
+        void tearDown (void);
+
+    protected:
+
+        void testEntities (void);
+        void testQuotes (void);
+        void testEmptyElements (void);
+        void testSpecialNodes (void);
+        void testShortWhitespace (void);
+        void testTrailingText (void);
+        void testSkipElement (void);
+
+    private:
+
+        // create a reader for the given document
+        static XMLReader* Open(const char* xml);
+
+        // read the next node and check its type and name
+        static void Expect(XMLReader* reader, XMLNodeType type, const char* name);
+};
+
+#endif 